@@ -0,0 +1,42 @@
+/**
+ * Tests that only clients authorized for internal actions can set the $admissionPriority of a
+ * command.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod({auth: ""});
+const adminDB = conn.getDB("admin");
+const testDB = conn.getDB("test");
+
+assert.commandWorked(adminDB.runCommand({createUser: "admin", pwd: "pwd", roles: ["root"]}));
+assert(adminDB.auth("admin", "pwd"));
+assert.commandWorked(adminDB.runCommand({createUser: "system", pwd: "pwd", roles: ["__system"]}));
+assert.commandWorked(
+    testDB.runCommand({createUser: "user", pwd: "pwd", roles: ["readWrite", "dbAdmin"]}));
+assert.commandWorked(testDB.coll.insert({_id: 0}));
+adminDB.logout();
+
+// Neither a regular user nor a root user may change the priority of their operations.
+assert(testDB.auth("user", "pwd"));
+assert.commandFailedWithCode(testDB.runCommand({find: "coll", $admissionPriority: "high"}),
+                             ErrorCodes.Unauthorized);
+assert.commandFailedWithCode(testDB.runCommand({find: "coll", $admissionPriority: "low"}),
+                             ErrorCodes.Unauthorized);
+assert.commandWorked(testDB.runCommand({find: "coll"}));
+testDB.logout();
+
+assert(adminDB.auth("admin", "pwd"));
+assert.commandFailedWithCode(testDB.runCommand({find: "coll", $admissionPriority: "high"}),
+                             ErrorCodes.Unauthorized);
+adminDB.logout();
+
+// An internal user may.
+assert(adminDB.auth("system", "pwd"));
+assert.commandWorked(testDB.runCommand({find: "coll", $admissionPriority: "high"}));
+assert.commandFailedWithCode(testDB.runCommand({find: "coll", $admissionPriority: "urgent"}),
+                             ErrorCodes.BadValue);
+adminDB.logout();
+
+MongoRunner.stopMongod(conn);
+}());
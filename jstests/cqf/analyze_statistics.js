@@ -0,0 +1,74 @@
+/**
+ * Tests the 'analyze' command and the lifetime of the statistics it persists.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/optimizer_utils.js");  // For checkCascadesOptimizerEnabled.
+if (!checkCascadesOptimizerEnabled(db)) {
+    jsTestLog("Skipping test because the optimizer is not enabled");
+    return;
+}
+
+const coll = db.cqf_analyze_statistics;
+const renamed = db.cqf_analyze_statistics_renamed;
+const statsName = "system.statistics." + coll.getName();
+const renamedStatsName = "system.statistics." + renamed.getName();
+coll.drop();
+renamed.drop();
+
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 1000; i++) {
+    bulk.insert({a: i % 10, b: i});
+}
+assert.commandWorked(bulk.execute());
+
+function collectionUUID(name) {
+    return db.getCollectionInfos({name: name})[0].info.uuid;
+}
+
+function statsExist(name) {
+    return db.getCollectionNames().includes(name);
+}
+
+// Invalid arguments.
+assert.commandFailedWithCode(db.runCommand({analyze: coll.getName()}), ErrorCodes.BadValue);
+assert.commandFailedWithCode(db.runCommand({analyze: coll.getName(), key: "a", numberBuckets: 0}),
+                             ErrorCodes.BadValue);
+assert.commandFailedWithCode(db.runCommand({analyze: coll.getName(), key: "a", sampleSize: 0}),
+                             ErrorCodes.BadValue);
+assert.commandFailedWithCode(db.runCommand({analyze: "cqf_analyze_statistics_missing", key: "a"}),
+                             ErrorCodes.NamespaceNotFound);
+
+// Statistics over the whole collection, tagged with the UUID of the collection.
+let res = assert.commandWorked(db.runCommand({analyze: coll.getName(), key: "a"}));
+assert.eq(1000, res.documents, res);
+const statsDoc = db[statsName].findOne({_id: "a"});
+assert.neq(null, statsDoc);
+assert.eq(collectionUUID(coll.getName()), statsDoc.collectionUUID, statsDoc);
+
+// Statistics over a bounded sample of the collection.
+res = assert.commandWorked(db.runCommand({analyze: coll.getName(), key: "b", sampleSize: 100}));
+assert.eq(100, res.documents, res);
+
+// The estimator only changes plan choices, not results.
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryEnableHistogramCardinalityEstimator: true}));
+try {
+    assert.eq(100, coll.aggregate([{$match: {a: 3}}]).itcount());
+    assert.eq(10, coll.aggregate([{$match: {a: 3, b: {$lt: 100}}}]).itcount());
+} finally {
+    assert.commandWorked(db.adminCommand(
+        {setParameter: 1, internalQueryEnableHistogramCardinalityEstimator: false}));
+}
+
+// Renaming the collection drops the statistics kept under the source name.
+assert.commandWorked(coll.renameCollection(renamed.getName()));
+assert(!statsExist(statsName));
+assert.commandWorked(db.runCommand({analyze: renamed.getName(), key: "a"}));
+assert(statsExist(renamedStatsName));
+
+// Dropping the collection drops its statistics.
+assert(renamed.drop());
+assert(!statsExist(renamedStatsName));
+}());
@@ -0,0 +1,51 @@
+/**
+ * Tests that index builds which generate their keys on several threads build the same indexes as
+ * builds which generate them on a single thread.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod(
+    {setParameter: {maxIndexBuildKeyGenerationThreads: 4, maxIndexBuildSortThreads: 4}});
+const db = conn.getDB(jsTestName());
+
+// Enough documents for several batches of the collection scan. Some documents hold arrays, so the
+// indexes become multikey, and some miss the indexed fields.
+const docs = [];
+for (let i = 0; i < 20000; ++i) {
+    if (i % 7 == 0) {
+        docs.push({_id: i});
+    } else if (i % 3 == 0) {
+        docs.push({_id: i, a: [i, -i, 'x' + i], b: i % 100});
+    } else {
+        docs.push({_id: i, a: i, b: {c: i % 10}});
+    }
+}
+
+const specs = [
+    {key: {a: 1, b: 1}, name: 'a_1_b_1'},
+    {key: {b: 1, a: -1}, name: 'b_1_a_-1', partialFilterExpression: {b: {$exists: true}}},
+    {key: {a: 1}, name: 'a_1', sparse: true},
+];
+
+const buildIndexes = (collName) => {
+    const coll = db.getCollection(collName);
+    assert.commandWorked(coll.insert(docs));
+    assert.commandWorked(db.runCommand({createIndexes: collName, indexes: specs}));
+
+    const res = assert.commandWorked(coll.validate({full: true}));
+    assert(res.valid, tojson(res));
+    return res.keysPerIndex;
+};
+
+const concurrentKeys = buildIndexes('concurrent');
+
+assert.commandWorked(db.adminCommand({setParameter: 1, maxIndexBuildKeyGenerationThreads: 1}));
+const serialKeys = buildIndexes('serial');
+
+for (const spec of specs) {
+    assert.eq(serialKeys[spec.name], concurrentKeys[spec.name], spec.name);
+}
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,19 @@
+/**
+ * Tests that mongod fails to start up when given an unknown initialSyncMethod, and starts up with
+ * each of the valid methods.
+ */
+(function() {
+"use strict";
+
+for (let initialSyncMethod of ["logical", "fileCopyBased"]) {
+    const conn = MongoRunner.runMongod({setParameter: {initialSyncMethod: initialSyncMethod}});
+    assert.neq(null, conn, "mongod failed to start up with initialSyncMethod=" + initialSyncMethod);
+    const res = assert.commandWorked(conn.adminCommand({getParameter: 1, initialSyncMethod: 1}));
+    assert.eq(initialSyncMethod, res.initialSyncMethod);
+    MongoRunner.stopMongod(conn);
+}
+
+assert.throws(() => MongoRunner.runMongod({setParameter: "initialSyncMethod=bogus"}),
+              [],
+              "Expected mongod to fail at startup because the initial sync method is unknown");
+}());
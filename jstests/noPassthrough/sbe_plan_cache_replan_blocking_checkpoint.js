@@ -0,0 +1,93 @@
+/**
+ * Test that a cached SBE plan with a blocking stage, which passes its trial period, is still
+ * replanned when the blocking stage later receives its input at a much lower rate than when the
+ * plan was cached, and that the reason is reported in the profiler.
+ * @tags: [
+ *   requires_profiling,
+ * ]
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");
+load("jstests/libs/profiler.js");
+load("jstests/libs/sbe_util.js");  // For checkSBEEnabled.
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB("test");
+const coll = db.sbe_plan_cache_replan_blocking_checkpoint;
+coll.drop();
+
+if (!checkSBEEnabled(db, ["featureFlagSbePlanCache"])) {
+    jsTest.log("Skipping test because either SBE or SBE plan cache is disabled.");
+    MongoRunner.stopMongod(conn);
+    return;
+}
+
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.createIndex({b: 1}));
+
+// Tenant 2 comes first in the {b: 1} index, so that the {a: 1} index wins for tenant 1. The first
+// documents of tenant 2 match the query just like tenant 1's, so that the cached plan passes its
+// trial for tenant 2 as well. The rest of tenant 2 does not match at all.
+const bulk = coll.initializeUnorderedBulkOp();
+for (let i = 0; i < 150; ++i) {
+    bulk.insert({a: 2, b: 1, c: i});
+}
+for (let i = 0; i < 200; ++i) {
+    bulk.insert({a: 1, b: 1, c: i});
+}
+for (let i = 0; i < 5000; ++i) {
+    bulk.insert({a: 2, b: 2, c: i});
+}
+assert.commandWorked(bulk.execute());
+
+function runQuery(tenant) {
+    return coll.find({a: tenant, b: 1}).sort({c: 1}).itcount();
+}
+
+function assertCachedPlan(isActive) {
+    const cachedPlans = coll.getPlanCache().list();
+    assert.eq(1, cachedPlans.length, cachedPlans);
+    assert.eq(isActive, cachedPlans[0].isActive, cachedPlans);
+    const cachedPlan = getCachedPlan(cachedPlans[0].cachedPlan);
+    assert.neq(null, getPlanStage(cachedPlan, "SORT"), cachedPlans);
+    assert.eq({a: 1}, getPlanStage(cachedPlan, "IXSCAN").keyPattern, cachedPlans);
+}
+
+function cacheTenantOnePlan() {
+    coll.getPlanCache().clear();
+    // Run the query twice for the cache entry to be marked active.
+    assert.eq(200, runQuery(1));
+    assert.eq(200, runQuery(1));
+    assertCachedPlan(true /* isActive */);
+}
+
+assert.commandWorked(db.setProfilingLevel(2));
+
+// Without checkpoints, the cached plan passes its trial for tenant 2 and drains the whole tenant.
+assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQuerySlotBasedExecutionMaxCachedPlanCheckpoints: 0}));
+cacheTenantOnePlan();
+assert.eq(150, runQuery(2));
+let profileObj = getLatestProfilerEntry(db, {op: "query", ns: coll.getFullName()});
+assert(!profileObj.replanned, profileObj);
+assertCachedPlan(true /* isActive */);
+
+// With checkpoints, the sort stage is found to be starved after the trial, and the query is
+// replanned before it returns any results.
+assert.commandWorked(db.adminCommand(
+    {setParameter: 1, internalQuerySlotBasedExecutionMaxCachedPlanCheckpoints: 10}));
+cacheTenantOnePlan();
+assert.eq(150, runQuery(2));
+profileObj = getLatestProfilerEntry(db, {op: "query", ns: coll.getFullName()});
+assert.eq(true, profileObj.replanned, profileObj);
+assert(/expected blocking stage to receive at least \d+ documents/.test(profileObj.replanReason),
+       profileObj);
+
+// Replanning deactivated the cache entry.
+const cachedPlans = coll.getPlanCache().list();
+assert(cachedPlans.some(entry => !entry.isActive), cachedPlans);
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,73 @@
+/**
+ * Tests that a $group on the metaField of a time-series collection is computed per bucket from the
+ * compressed columns, and that it returns the same results as unpacking every measurement.
+ */
+(function() {
+"use strict";
+
+load("jstests/libs/analyze_plan.js");  // For getAggPlanStage.
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB(jsTestName());
+const coll = db.getCollection('ts');
+
+const timeFieldName = 'time';
+const metaFieldName = 'meta';
+const t0 = ISODate('2022-06-01T12:00:00Z');
+
+assert.commandWorked(db.createCollection(
+    coll.getName(), {timeseries: {timeField: timeFieldName, metaField: metaFieldName}}));
+
+// More measurements than fit in one bucket, so that the full buckets are closed and compressed.
+// Doubles are halves so that their sums are exact whichever way they are computed.
+const docs = [];
+for (let i = 0; i < 1200; ++i) {
+    const time = new Date(t0.getTime() + i * 1000);
+    docs.push({[timeFieldName]: time, [metaFieldName]: 'ints', x: NumberInt(i % 50)});
+    docs.push({[timeFieldName]: time, [metaFieldName]: 'longs', x: NumberLong(i * 1000)});
+    docs.push({[timeFieldName]: time, [metaFieldName]: 'doubles', x: i % 7 + 0.5});
+    docs.push(i % 3 == 0 ? {[timeFieldName]: time, [metaFieldName]: 'sparse'}
+                         : {[timeFieldName]: time, [metaFieldName]: 'sparse', x: i});
+    docs.push({
+        [timeFieldName]: time,
+        [metaFieldName]: 'mixed',
+        x: i == 600 ? 'str' : (i % 2 == 0 ? NumberInt(i) : i + 0.5)
+    });
+}
+assert.commandWorked(coll.insert(docs));
+
+const pipeline = [
+    {
+        $group: {
+            _id: '$' + metaFieldName,
+            mn: {$min: '$x'},
+            mx: {$max: '$x'},
+            s: {$sum: '$x'},
+            avg: {$avg: '$x'},
+            n: {$sum: 1},
+        }
+    },
+    {$sort: {_id: 1}},
+];
+
+const setKnob = (value) => assert.commandWorked(
+    db.adminCommand({setParameter: 1, internalQueryEnableTimeseriesBlockAggregates: value}));
+
+setKnob(true);
+let unpack = getAggPlanStage(coll.explain().aggregate(pipeline), '$_internalUnpackBucket');
+assert.neq(null, unpack);
+assert.eq(5, unpack.$_internalUnpackBucket.blockAggregates.length, tojson(unpack));
+const withBlocks = coll.aggregate(pipeline).toArray();
+
+setKnob(false);
+unpack = getAggPlanStage(coll.explain().aggregate(pipeline), '$_internalUnpackBucket');
+assert.neq(null, unpack);
+assert(!unpack.$_internalUnpackBucket.hasOwnProperty('blockAggregates'), tojson(unpack));
+const withoutBlocks = coll.aggregate(pipeline).toArray();
+
+// tojson() spells out the numeric types, so this also checks that they are preserved.
+assert.eq(5, withBlocks.length, tojson(withBlocks));
+assert.eq(tojson(withoutBlocks), tojson(withBlocks));
+
+MongoRunner.stopMongod(conn);
+})();
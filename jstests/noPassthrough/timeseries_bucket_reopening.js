@@ -0,0 +1,62 @@
+/**
+ * Tests that a measurement which does not fit in the open bucket for its metadata is inserted into
+ * an archived bucket whose time range covers it, and that archived buckets are only looked up
+ * through an index on the metaField and the timeField.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB(jsTestName());
+
+const timeFieldName = 'time';
+const metaFieldName = 'meta';
+const t0 = ISODate('2022-06-01T12:00:00Z');
+const minutes = (n) => new Date(t0.getTime() + n * 60 * 1000);
+
+/**
+ * Opens a bucket at 't0', archives it by going back two hours, then inserts a measurement which
+ * belongs to the time range of the archived bucket. Returns the number of buckets.
+ */
+const runTest = (coll) => {
+    const bucketsColl = db.getCollection('system.buckets.' + coll.getName());
+
+    // Each bucket holds a single measurement when it is archived, so it is not compressed.
+    assert.commandWorked(coll.insert({[timeFieldName]: t0, [metaFieldName]: 'a', x: 0}));
+    assert.commandWorked(coll.insert({[timeFieldName]: minutes(-120), [metaFieldName]: 'a', x: 1}));
+    assert.eq(2, bucketsColl.find().itcount());
+
+    assert.commandWorked(coll.insert({[timeFieldName]: minutes(10), [metaFieldName]: 'a', x: 2}));
+    assert.eq(3, coll.find().itcount());
+    return bucketsColl.find().itcount();
+};
+
+const createCollection = (name) => {
+    assert.commandWorked(db.createCollection(
+        name, {timeseries: {timeField: timeFieldName, metaField: metaFieldName}}));
+    return db.getCollection(name);
+};
+
+// With an index on the metaField and the timeField, the archived bucket is reopened.
+let coll = createCollection('with_index');
+assert.commandWorked(coll.createIndex({[metaFieldName]: 1, [timeFieldName]: 1}));
+assert.eq(2, runTest(coll));
+let stats = assert.commandWorked(coll.stats()).timeseries;
+assert.eq(1, stats.numBucketReopeningHits, tojson(stats));
+
+// Without such an index, the lookup is skipped and a new bucket is opened.
+coll = createCollection('without_index');
+assert.commandWorked(coll.createIndex({[metaFieldName]: 1}));
+assert.eq(3, runTest(coll));
+stats = assert.commandWorked(coll.stats()).timeseries;
+assert.eq(0, stats.numBucketReopeningHits, tojson(stats));
+assert.eq(0, stats.numBucketReopeningMisses, tojson(stats));
+
+// Reopening can be turned off.
+assert.commandWorked(db.adminCommand({setParameter: 1, timeseriesEnableBucketReopening: false}));
+coll = createCollection('disabled');
+assert.commandWorked(coll.createIndex({[metaFieldName]: 1, [timeFieldName]: 1}));
+assert.eq(3, runTest(coll));
+
+MongoRunner.stopMongod(conn);
+})();
@@ -0,0 +1,112 @@
+/**
+ * Tests the { maxRecords }, { resumeAfter } and { indexResumeAfter } options of the validate
+ * command, which validate a collection in RecordId ranges and its indexes in key ranges across
+ * several invocations.
+ */
+(function() {
+"use strict";
+
+const conn = MongoRunner.runMongod();
+const db = conn.getDB(jsTestName());
+
+const runValidateInRanges = (coll, maxRecords) => {
+    let numRecords = 0;
+    let numKeys = {};
+    let resumeAfter;
+    let indexResumeAfter;
+    let numRuns = 0;
+    do {
+        const cmd = {validate: coll.getName(), maxRecords: maxRecords};
+        if (resumeAfter !== undefined) {
+            cmd.resumeAfter = resumeAfter;
+        }
+        if (indexResumeAfter !== undefined) {
+            cmd.indexResumeAfter = indexResumeAfter;
+        }
+        const res = assert.commandWorked(db.runCommand(cmd));
+        assert(res.valid, res);
+        assert.lte(res.nrecords, maxRecords, res);
+        numRecords += res.nrecords;
+        for (let [indexName, keys] of Object.entries(res.keysPerIndex)) {
+            assert.lte(keys, maxRecords, res);
+            numKeys[indexName] = (numKeys[indexName] || 0) + keys;
+        }
+        resumeAfter = res.resumeAfter;
+        indexResumeAfter = res.indexResumeAfter;
+        ++numRuns;
+    } while (resumeAfter !== undefined || indexResumeAfter !== undefined);
+    return {numRecords, numKeys, numRuns};
+};
+
+// A collection keyed by numeric RecordIds is validated in ranges covering all of its records.
+const coll = db.validate_range;
+coll.drop();
+assert.commandWorked(coll.createIndex({a: 1}));
+assert.commandWorked(coll.insert(Array.from({length: 10}, (_, i) => ({_id: i, a: i}))));
+let {numRecords, numKeys, numRuns} = runValidateInRanges(coll, 4);
+assert.eq(10, numRecords);
+assert.eq({_id_: 10, a_1: 10}, numKeys);
+assert.gte(numRuns, 3);
+
+// The traversal of an index with more entries than the collection has records continues after
+// the last record has been checked.
+const multikeyColl = db.validate_range_multikey;
+multikeyColl.drop();
+assert.commandWorked(multikeyColl.createIndex({a: 1}));
+assert.commandWorked(multikeyColl.insert(
+    Array.from({length: 3}, (_, i) => ({_id: i, a: [i, i + 3, i + 6, i + 9]}))));
+({numRecords, numKeys, numRuns} = runValidateInRanges(multikeyColl, 2));
+assert.eq(3, numRecords);
+assert.eq({_id_: 3, a_1: 12}, numKeys);
+assert.gte(numRuns, 6);
+
+// So is a clustered collection, whose RecordIds are strings reported as BinData.
+const clusteredColl = db.validate_range_clustered;
+clusteredColl.drop();
+assert.commandWorked(
+    db.createCollection(clusteredColl.getName(), {clusteredIndex: {key: {_id: 1}, unique: true}}));
+assert.commandWorked(clusteredColl.insert(Array.from({length: 10}, (_, i) => ({_id: i}))));
+({numRecords, numKeys, numRuns} = runValidateInRanges(clusteredColl, 3));
+assert.eq(10, numRecords);
+assert.gte(numRuns, 4);
+
+// Malformed resume points are rejected.
+for (let resumeAfter of [null, "", "not hex", "abc", {a: 1}, true, BinData(0, "")]) {
+    assert.commandFailedWithCode(db.runCommand({validate: coll.getName(), resumeAfter}),
+                                 ErrorCodes.InvalidOptions,
+                                 tojson(resumeAfter));
+}
+
+// Malformed index resume points are rejected.
+for (let indexResumeAfter of ["", {a_1: 1}, {a_1: ""}, {a_1: "not hex"}, {a_1: "abc"}]) {
+    assert.commandFailedWithCode(db.runCommand({validate: coll.getName(), indexResumeAfter}),
+                                 ErrorCodes.InvalidOptions,
+                                 tojson(indexResumeAfter));
+}
+
+// A resume point of the wrong RecordId format for the collection is rejected.
+assert.commandFailedWithCode(
+    db.runCommand({validate: coll.getName(), resumeAfter: BinData(0, "AAAA")}),
+    ErrorCodes.InvalidOptions);
+assert.commandFailedWithCode(
+    db.runCommand({validate: clusteredColl.getName(), resumeAfter: NumberLong(1)}),
+    ErrorCodes.InvalidOptions);
+
+// A positive number of records is required.
+for (let maxRecords of [0, -1, "1"]) {
+    assert.commandFailedWithCode(db.runCommand({validate: coll.getName(), maxRecords}),
+                                 ErrorCodes.InvalidOptions);
+}
+
+// Range-limited validation cannot be combined with options which need the whole collection.
+for (let option of [{full: true}, {enforceFastCount: true}, {repair: true}, {metadata: true}]) {
+    assert.commandFailedWithCode(
+        db.runCommand(Object.assign({validate: coll.getName(), maxRecords: 1}, option)),
+        ErrorCodes.InvalidOptions);
+}
+// Background validation reads from the last checkpoint.
+assert.commandWorked(db.adminCommand({fsync: 1}));
+assert.commandWorked(db.runCommand({validate: coll.getName(), maxRecords: 1, background: true}));
+
+MongoRunner.stopMongod(conn);
+}());
@@ -0,0 +1,214 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/bson/util/bsoncolumn_block.h"
+
+#include <array>
+
+#include "mongo/bson/util/bsoncolumn_util.h"
+#include "mongo/bson/util/simple8b.h"
+#include "mongo/bson/util/simple8b_type_util.h"
+#include "mongo/util/assert_util.h"
+
+namespace mongo::bsoncolumn {
+namespace {
+// Lookup table to go from Control byte (high 4 bits) to scale index, same as used by BSONColumn.
+constexpr uint8_t kInvalidScaleIndex = 0xFF;
+constexpr std::array<uint8_t, 16> kControlToScaleIndex = {
+    kInvalidScaleIndex,
+    kInvalidScaleIndex,
+    kInvalidScaleIndex,
+    kInvalidScaleIndex,
+    kInvalidScaleIndex,
+    kInvalidScaleIndex,
+    kInvalidScaleIndex,
+    kInvalidScaleIndex,
+    Simple8bTypeUtil::kMemoryAsInteger,  // 0b1000
+    0,                                   // 0b1001
+    1,                                   // 0b1010
+    2,                                   // 0b1011
+    3,                                   // 0b1100
+    4,                                   // 0b1101
+    kInvalidScaleIndex,
+    kInvalidScaleIndex};
+
+boost::optional<NumericBlock::Kind> kindForLiteralType(BSONType type) {
+    switch (type) {
+        case NumberInt:
+        case NumberLong:
+            return NumericBlock::Kind::kInt64;
+        case NumberDouble:
+            return NumericBlock::Kind::kDouble;
+        default:
+            return boost::none;
+    }
+}
+}  // namespace
+
+boost::optional<NumericBlock> decodeNumericBlock(BSONElement column) {
+    tassert(6610400,
+            "Invalid BSON type for column",
+            column.type() == BSONType::BinData && column.binDataType() == BinDataType::Column);
+
+    int size;
+    const char* pos = column.binData(size);
+    const char* end = pos + size;
+
+    NumericBlock block;
+    boost::optional<NumericBlock::Kind> kind;
+
+    // Decoding state, this follows what BSONColumn::Iterator keeps in its DecodingState but is
+    // limited to the numeric types. For doubles 'lastEncoded' holds the last value encoded with the
+    // scale factor of the current Simple-8b block.
+    BSONType lastType = EOO;
+    int64_t lastInt = 0;
+    double lastDouble = 0.0;
+    int64_t lastEncoded = 0;
+
+    // Last value of the previous run of Simple-8b blocks, needed when a run starts with RLE.
+    boost::optional<uint64_t> lastSimple8bValue = 0;
+
+    // Values are only stored once the kind of the column is known from its first literal, any
+    // leading missing values are back-filled at that point.
+    auto appendMissing = [&] {
+        if (kind == NumericBlock::Kind::kDouble) {
+            block.doubles.push_back(0.0);
+        } else if (kind == NumericBlock::Kind::kInt64) {
+            block.ints.push_back(0);
+        }
+        block.present.push_back(0);
+    };
+    auto appendLast = [&] {
+        if (lastType == NumberDouble) {
+            block.doubles.push_back(lastDouble);
+        } else {
+            block.ints.push_back(lastType == NumberInt ? static_cast<int32_t>(lastInt) : lastInt);
+        }
+        block.present.push_back(1);
+    };
+
+    while (true) {
+        if (pos >= end) {
+            return boost::none;
+        }
+
+        uint8_t control = *pos;
+        if (control == EOO) {
+            break;
+        }
+
+        if (isLiteralControlByte(control)) {
+            auto literalKind = kindForLiteralType(static_cast<BSONType>(control));
+            if (!literalKind || (kind && *kind != *literalKind)) {
+                return boost::none;
+            }
+            if (!kind) {
+                kind = literalKind;
+                block.ints.resize(*kind == NumericBlock::Kind::kInt64 ? block.size() : 0);
+                block.doubles.resize(*kind == NumericBlock::Kind::kDouble ? block.size() : 0);
+            }
+
+            BSONElement literal(pos, 1, -1);
+            if (pos + literal.size() >= end) {
+                return boost::none;
+            }
+            lastType = literal.type();
+            if (lastType == NumberDouble) {
+                lastDouble = literal._numberDouble();
+            } else {
+                lastInt = literal.safeNumberLong();
+                block.hasInt32Values |= lastType == NumberInt;
+                block.hasInt64Values |= lastType == NumberLong;
+            }
+            lastSimple8bValue = 0;
+            appendLast();
+            pos += literal.size();
+            continue;
+        }
+
+        // Simple-8b delta block, this also rejects the interleaved start control byte.
+        uint8_t scaleIndex = kControlToScaleIndex[(control & 0xF0) >> 4];
+        if (scaleIndex == kInvalidScaleIndex) {
+            return boost::none;
+        }
+        if (lastType == NumberDouble) {
+            auto encoded = Simple8bTypeUtil::encodeDouble(lastDouble, scaleIndex);
+            if (!encoded) {
+                return boost::none;
+            }
+            lastEncoded = *encoded;
+        }
+
+        int blocksSize = sizeof(uint64_t) * numSimple8bBlocksForControlByte(control);
+        if (pos + blocksSize + 1 >= end) {
+            return boost::none;
+        }
+
+        Simple8b<uint64_t> decoder(pos + 1, blocksSize, lastSimple8bValue);
+        for (auto it = decoder.begin(), itEnd = decoder.end(); it != itEnd; ++it) {
+            const auto& delta = *it;
+            lastSimple8bValue = delta;
+            if (!delta) {
+                appendMissing();
+                continue;
+            }
+
+            // A zero delta repeats the previous value, which is missing before the first literal.
+            if (*delta == 0) {
+                if (lastType == EOO) {
+                    appendMissing();
+                } else {
+                    appendLast();
+                }
+                continue;
+            }
+
+            if (lastType == EOO) {
+                return boost::none;
+            }
+            if (lastType == NumberDouble) {
+                lastEncoded = expandDelta(lastEncoded, Simple8bTypeUtil::decodeInt64(*delta));
+                lastDouble = Simple8bTypeUtil::decodeDouble(lastEncoded, scaleIndex);
+            } else {
+                lastInt = expandDelta(lastInt, Simple8bTypeUtil::decodeInt64(*delta));
+            }
+            appendLast();
+        }
+        pos += blocksSize + 1;
+    }
+
+    block.kind = kind.value_or(NumericBlock::Kind::kInt64);
+    if (!kind) {
+        // Every value is missing.
+        block.ints.resize(block.size());
+    }
+    return block;
+}
+
+}  // namespace mongo::bsoncolumn
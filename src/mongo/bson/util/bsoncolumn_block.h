@@ -0,0 +1,72 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "mongo/bson/bsonelement.h"
+
+namespace mongo::bsoncolumn {
+
+/**
+ * Numeric values of a BSONColumn decoded into contiguous typed storage, for processing a whole
+ * column at a time. Integral columns (NumberInt and NumberLong) are held in 'ints' and NumberDouble
+ * columns in 'doubles'; only the vector matching 'kind' is populated. 'present' holds one byte per
+ * row which is zero when the value at that position is missing. The original BSON types of integral
+ * values are recorded in 'hasInt32Values' and 'hasInt64Values'.
+ */
+struct NumericBlock {
+    enum class Kind { kInt64, kDouble };
+
+    size_t size() const {
+        return present.size();
+    }
+
+    Kind kind = Kind::kInt64;
+    bool hasInt32Values = false;
+    bool hasInt64Values = false;
+    std::vector<int64_t> ints;
+    std::vector<double> doubles;
+    std::vector<uint8_t> present;
+};
+
+/**
+ * Decodes the BSONColumn in 'column' straight from its literals and Simple-8b blocks into a
+ * NumericBlock, without materializing a BSONElement per value.
+ *
+ * Returns boost::none when the column cannot be represented as a NumericBlock, i.e. it holds
+ * non-numeric values, mixes integral and double values, uses interleaved mode or is malformed.
+ * Callers are expected to fall back to BSONColumn iteration in that case.
+ */
+boost::optional<NumericBlock> decodeNumericBlock(BSONElement column);
+
+}  // namespace mongo::bsoncolumn
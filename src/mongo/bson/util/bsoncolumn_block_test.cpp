@@ -0,0 +1,202 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/bson/util/bsoncolumn_block.h"
+
+#include <cmath>
+#include <forward_list>
+
+#include "mongo/bson/util/bsoncolumn.h"
+#include "mongo/bson/util/bsoncolumnbuilder.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using bsoncolumn::NumericBlock;
+
+/**
+ * Compresses 'values' into a BSONColumn, where EOO elements are appended as skips. Decodes the
+ * column as a NumericBlock and verifies it against regular BSONColumn iteration.
+ */
+class NumericBlockTest : public unittest::Test {
+public:
+    boost::optional<NumericBlock> compressAndDecode(const std::vector<BSONElement>& values) {
+        BSONColumnBuilder cb("test"_sd);
+        for (auto&& value : values) {
+            if (value.eoo()) {
+                cb.skip();
+            } else {
+                cb.append(value);
+            }
+        }
+        _columns.emplace_front(BSON("test" << cb.finalize()));
+        return bsoncolumn::decodeNumericBlock(_columns.front().firstElement());
+    }
+
+    void assertMatchesColumn(const NumericBlock& block) {
+        BSONColumn column(_columns.front().firstElement());
+        size_t i = 0;
+        for (auto&& elem : column) {
+            ASSERT_LT(i, block.size());
+            if (elem.eoo()) {
+                ASSERT_EQ(block.present[i], 0);
+            } else {
+                ASSERT_EQ(block.present[i], 1);
+                if (block.kind == NumericBlock::Kind::kDouble) {
+                    ASSERT_EQ(block.doubles[i], elem.numberDouble());
+                } else {
+                    ASSERT_EQ(block.ints[i], elem.numberLong());
+                }
+            }
+            ++i;
+        }
+        ASSERT_EQ(i, block.size());
+        ASSERT_EQ(block.kind == NumericBlock::Kind::kDouble ? block.doubles.size()
+                                                            : block.ints.size(),
+                  block.size());
+    }
+
+    template <typename T>
+    BSONElement createElement(T val) {
+        _elementMemory.emplace_front(BSON("0" << val));
+        return _elementMemory.front().firstElement();
+    }
+
+    BSONElement missing() {
+        return BSONElement();
+    }
+
+private:
+    std::forward_list<BSONObj> _elementMemory;
+    std::forward_list<BSONObj> _columns;
+};
+
+TEST_F(NumericBlockTest, DecodesInt64Deltas) {
+    std::vector<BSONElement> values;
+    for (int64_t i = 0; i < 500; ++i) {
+        values.push_back(createElement(i * i - 1000));
+    }
+    auto block = compressAndDecode(values);
+    ASSERT(block);
+    ASSERT(block->kind == NumericBlock::Kind::kInt64);
+    ASSERT_FALSE(block->hasInt32Values);
+    ASSERT_TRUE(block->hasInt64Values);
+    ASSERT_EQ(block->size(), 500U);
+    assertMatchesColumn(*block);
+}
+
+TEST_F(NumericBlockTest, RecordsInt32Values) {
+    std::vector<BSONElement> values;
+    for (int32_t i = 0; i < 100; ++i) {
+        values.push_back(createElement(i * 3));
+    }
+    auto block = compressAndDecode(values);
+    ASSERT(block);
+    ASSERT(block->kind == NumericBlock::Kind::kInt64);
+    ASSERT_TRUE(block->hasInt32Values);
+    ASSERT_FALSE(block->hasInt64Values);
+    assertMatchesColumn(*block);
+}
+
+TEST_F(NumericBlockTest, DecodesInt32WithSkipsAndRepeats) {
+    std::vector<BSONElement> values{missing(),
+                                    missing(),
+                                    createElement(int32_t{5}),
+                                    createElement(int32_t{5}),
+                                    missing(),
+                                    createElement(int32_t{-7}),
+                                    createElement(int64_t{1} << 40)};
+    // A long run of repeats to produce RLE blocks.
+    for (int i = 0; i < 1000; ++i) {
+        values.push_back(createElement(int32_t{42}));
+    }
+    auto block = compressAndDecode(values);
+    ASSERT(block);
+    ASSERT(block->kind == NumericBlock::Kind::kInt64);
+    ASSERT_TRUE(block->hasInt32Values);
+    ASSERT_TRUE(block->hasInt64Values);
+    ASSERT_EQ(block->size(), values.size());
+    assertMatchesColumn(*block);
+}
+
+TEST_F(NumericBlockTest, DecodesDoublesAcrossScaleFactors) {
+    std::vector<BSONElement> values{createElement(1.0),
+                                    createElement(1.5),
+                                    createElement(2.25),
+                                    missing(),
+                                    createElement(3.125),
+                                    createElement(1.0 / 3.0),
+                                    createElement(std::numeric_limits<double>::quiet_NaN()),
+                                    createElement(-0.1),
+                                    createElement(100.0)};
+    auto block = compressAndDecode(values);
+    ASSERT(block);
+    ASSERT(block->kind == NumericBlock::Kind::kDouble);
+    ASSERT_EQ(block->size(), values.size());
+
+    // NaN never compares equal, check it separately from the other values.
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (values[i].eoo()) {
+            ASSERT_EQ(block->present[i], 0);
+            continue;
+        }
+        ASSERT_EQ(block->present[i], 1);
+        if (std::isnan(values[i].numberDouble())) {
+            ASSERT(std::isnan(block->doubles[i]));
+        } else {
+            ASSERT_EQ(block->doubles[i], values[i].numberDouble());
+        }
+    }
+}
+
+TEST_F(NumericBlockTest, AllMissingDecodesToEmptyInts) {
+    auto block = compressAndDecode({missing(), missing(), missing()});
+    ASSERT(block);
+    ASSERT_EQ(block->size(), 3U);
+    assertMatchesColumn(*block);
+}
+
+TEST_F(NumericBlockTest, RejectsNonNumericValues) {
+    ASSERT_FALSE(compressAndDecode({createElement(1), createElement("str"_sd)}));
+    ASSERT_FALSE(compressAndDecode({createElement(Date_t::fromMillisSinceEpoch(1))}));
+    ASSERT_FALSE(compressAndDecode({createElement(Decimal128(1))}));
+}
+
+TEST_F(NumericBlockTest, RejectsMixedIntegralAndDouble) {
+    ASSERT_FALSE(compressAndDecode({createElement(1), createElement(2.5)}));
+    ASSERT_FALSE(compressAndDecode({createElement(2.5), createElement(int64_t{1})}));
+}
+
+TEST_F(NumericBlockTest, RejectsInterleavedObjects) {
+    ASSERT_FALSE(compressAndDecode({createElement(BSON("x" << 1)), createElement(BSON("x" << 2))}));
+}
+
+}  // namespace
+}  // namespace mongo
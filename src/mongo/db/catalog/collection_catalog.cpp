@@ -259,12 +259,12 @@ public:
                 case UncommittedCatalogUpdates::Entry::Action::kWritable:
                     writeJobs.push_back(
                         [collection = std::move(entry.collection)](CollectionCatalog& catalog) {
-                            catalog._collections[collection->ns()] = collection;
-                            catalog._catalog[collection->uuid()] = collection;
+                            catalog._collections.insert_or_assign(collection->ns(), collection);
+                            catalog._catalog.insert_or_assign(collection->uuid(), collection);
                             auto dbIdPair =
                                 std::make_pair(collection->tenantNs().createTenantDatabaseName(),
                                                collection->uuid());
-                            catalog._orderedCollections[dbIdPair] = collection;
+                            catalog._orderedCollections.insert_or_assign(dbIdPair, collection);
                         });
                     break;
                 case UncommittedCatalogUpdates::Entry::Action::kRenamed:
@@ -336,8 +336,7 @@ CollectionCatalog::iterator::iterator(OperationContext* opCtx,
 }
 
 CollectionCatalog::iterator::iterator(OperationContext* opCtx,
-                                      std::map<std::pair<TenantDatabaseName, UUID>,
-                                               std::shared_ptr<Collection>>::const_iterator mapIter,
+                                      OrderedCollectionMap::const_iterator mapIter,
                                       const CollectionCatalog& catalog)
     : _opCtx(opCtx), _mapIter(mapIter), _catalog(&catalog) {}
 
@@ -990,9 +989,9 @@ void CollectionCatalog::registerCollection(OperationContext* opCtx,
     invariant(_catalog.find(uuid) == _catalog.end());
     invariant(_orderedCollections.find(dbIdPair) == _orderedCollections.end());
 
-    _catalog[uuid] = coll;
-    _collections[tenantNs.getNss()] = coll;
-    _orderedCollections[dbIdPair] = coll;
+    _catalog.insert_or_assign(uuid, coll);
+    _collections.insert_or_assign(tenantNs.getNss(), coll);
+    _orderedCollections.insert_or_assign(dbIdPair, coll);
 
     if (!tenantNs.getNss().isOnInternalDb() && !tenantNs.getNss().isSystem()) {
         _stats.userCollections += 1;
@@ -1018,9 +1017,10 @@ void CollectionCatalog::registerCollection(OperationContext* opCtx,
 
 std::shared_ptr<Collection> CollectionCatalog::deregisterCollection(OperationContext* opCtx,
                                                                     const UUID& uuid) {
-    invariant(_catalog.find(uuid) != _catalog.end());
+    auto it = _catalog.find(uuid);
+    invariant(it != _catalog.end());
 
-    auto coll = std::move(_catalog[uuid]);
+    auto coll = it->second;
     auto ns = coll->ns();
     auto tenantDbName = coll->tenantNs().createTenantDatabaseName();
     auto dbIdPair = std::make_pair(tenantDbName, uuid);
@@ -1064,8 +1064,6 @@ void CollectionCatalog::deregisterAllCollectionsAndViews() {
         auto ns = entry.second->ns();
 
         LOGV2_DEBUG(20283, 1, "Deregistering collection", logAttrs(ns), "uuid"_attr = uuid);
-
-        entry.second.reset();
     }
 
     _collections.clear();
@@ -1141,16 +1139,18 @@ void CollectionCatalog::removeResource(const ResourceId& rid, const std::string&
     invariant(rid.getType() == RESOURCE_DATABASE || rid.getType() == RESOURCE_COLLECTION);
 
     auto search = _resourceInformation.find(rid);
-    if (search == _resourceInformation.end()) {
+    if (search == _resourceInformation.end() || search->second.count(entry) == 0) {
         return;
     }
 
-    std::set<std::string>& namespaces = search->second;
+    std::set<std::string> namespaces = search->second;
     namespaces.erase(entry);
 
     // Remove the map entry if this is the last namespace in the set for the ResourceId.
     if (namespaces.size() == 0) {
-        _resourceInformation.erase(search);
+        _resourceInformation.erase(rid);
+    } else {
+        _resourceInformation.insert_or_assign(rid, std::move(namespaces));
     }
 }
 
@@ -1160,16 +1160,17 @@ void CollectionCatalog::addResource(const ResourceId& rid, const std::string& en
     auto search = _resourceInformation.find(rid);
     if (search == _resourceInformation.end()) {
         std::set<std::string> newSet = {entry};
-        _resourceInformation.insert(std::make_pair(rid, newSet));
+        _resourceInformation.insert_or_assign(rid, std::move(newSet));
         return;
     }
 
-    std::set<std::string>& namespaces = search->second;
-    if (namespaces.count(entry) > 0) {
+    if (search->second.count(entry) > 0) {
         return;
     }
 
+    std::set<std::string> namespaces = search->second;
     namespaces.insert(entry);
+    _resourceInformation.insert_or_assign(rid, std::move(namespaces));
 }
 
 CollectionCatalogStasher::CollectionCatalogStasher(OperationContext* opCtx)
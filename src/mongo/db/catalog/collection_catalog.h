@@ -38,6 +38,8 @@
 #include "mongo/db/service_context.h"
 #include "mongo/db/tenant_database_name.h"
 #include "mongo/stdx/unordered_map.h"
+#include "mongo/util/persistent_hash_map.h"
+#include "mongo/util/persistent_map.h"
 #include "mongo/util/uuid.h"
 
 namespace mongo {
@@ -65,6 +67,10 @@ public:
         kInplace
     };
 
+    // Collections ordered by <tenantDbName, collUUID> pair.
+    using OrderedCollectionMap =
+        PersistentMap<std::pair<TenantDatabaseName, UUID>, std::shared_ptr<Collection>>;
+
     class iterator {
     public:
         using value_type = CollectionPtr;
@@ -73,8 +79,7 @@ public:
                  const TenantDatabaseName& tenantDbName,
                  const CollectionCatalog& catalog);
         iterator(OperationContext* opCtx,
-                 std::map<std::pair<TenantDatabaseName, UUID>,
-                          std::shared_ptr<Collection>>::const_iterator mapIter,
+                 OrderedCollectionMap::const_iterator mapIter,
                  const CollectionCatalog& catalog);
         value_type operator*();
         iterator operator++();
@@ -96,8 +101,7 @@ public:
         OperationContext* _opCtx;
         TenantDatabaseName _tenantDbName;
         boost::optional<UUID> _uuid;
-        std::map<std::pair<TenantDatabaseName, UUID>, std::shared_ptr<Collection>>::const_iterator
-            _mapIter;
+        OrderedCollectionMap::const_iterator _mapIter;
         const CollectionCatalog* _catalog;
     };
 
@@ -430,11 +434,14 @@ private:
      */
     boost::optional<mongo::stdx::unordered_map<UUID, NamespaceString, UUID::Hash>> _shadowCatalog;
 
-    using CollectionCatalogMap = stdx::unordered_map<UUID, std::shared_ptr<Collection>, UUID::Hash>;
-    using OrderedCollectionMap =
-        std::map<std::pair<TenantDatabaseName, UUID>, std::shared_ptr<Collection>>;
-    using NamespaceCollectionMap =
-        stdx::unordered_map<NamespaceString, std::shared_ptr<Collection>>;
+    // The maps holding one entry per collection are persistent maps, so copying the catalog for a
+    // write is O(1) and each registration or removal copies only the map nodes on the path to the
+    // entry, sharing the rest with the catalog instances that are still in use by readers. Maps
+    // only used for point lookups are hashed, so that a lookup costs one hash and one key
+    // comparison; only _orderedCollections, which is iterated per database, is ordered.
+    using CollectionCatalogMap = PersistentHashMap<UUID, std::shared_ptr<Collection>, UUID::Hash>;
+    using NamespaceCollectionMap = PersistentHashMap<NamespaceString, std::shared_ptr<Collection>>;
+    using ResourceInformationMap = PersistentHashMap<ResourceId, std::set<std::string>>;
     using DatabaseProfileSettingsMap = StringMap<ProfileSettings>;
 
     CollectionCatalogMap _catalog;
@@ -457,7 +464,7 @@ private:
     uint64_t _epoch = 0;
 
     // Mapping from ResourceId to a set of strings that contains collection and database namespaces.
-    std::map<ResourceId, std::set<std::string>> _resourceInformation;
+    ResourceInformationMap _resourceInformation;
 
     /**
      * Contains non-default database profile settings. New collections, current collections and
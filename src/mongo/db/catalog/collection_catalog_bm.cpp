@@ -117,7 +117,61 @@ void BM_CollectionCatalogWriteBatchedWithGlobalExclusiveLock(benchmark::State& s
     }
 }
 
+void BM_CollectionCatalogCreateDropCollection(benchmark::State& state) {
+    auto serviceContext = setupServiceContext();
+    ThreadClient threadClient(serviceContext);
+    ServiceContext::UniqueOperationContext opCtx = threadClient->makeOperationContext();
+
+    createCollections(opCtx.get(), state.range(0));
+
+    const TenantNamespace tenantNs(boost::none,
+                                   NamespaceString("collection_catalog_bm", "createDrop"));
+    for (auto _ : state) {
+        benchmark::ClobberMemory();
+        auto uuid = UUID::gen();
+        CollectionCatalog::write(opCtx.get(), [&](CollectionCatalog& catalog) {
+            catalog.registerCollection(
+                opCtx.get(), uuid, std::make_shared<CollectionMock>(tenantNs));
+        });
+        CollectionCatalog::write(opCtx.get(), [&](CollectionCatalog& catalog) {
+            catalog.deregisterCollection(opCtx.get(), uuid);
+        });
+    }
+}
+
+void BM_CollectionCatalogLookupCollectionByNamespace(benchmark::State& state) {
+    auto serviceContext = setupServiceContext();
+    ThreadClient threadClient(serviceContext);
+    ServiceContext::UniqueOperationContext opCtx = threadClient->makeOperationContext();
+
+    createCollections(opCtx.get(), state.range(0));
+
+    const NamespaceString nss("collection_catalog_bm", std::to_string(state.range(0) / 2));
+    auto catalog = CollectionCatalog::get(opCtx.get());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(catalog->lookupCollectionByNamespaceForRead(opCtx.get(), nss));
+    }
+}
+
+void BM_CollectionCatalogLookupCollectionByUUID(benchmark::State& state) {
+    auto serviceContext = setupServiceContext();
+    ThreadClient threadClient(serviceContext);
+    ServiceContext::UniqueOperationContext opCtx = threadClient->makeOperationContext();
+
+    createCollections(opCtx.get(), state.range(0));
+
+    const NamespaceString nss("collection_catalog_bm", std::to_string(state.range(0) / 2));
+    auto catalog = CollectionCatalog::get(opCtx.get());
+    auto uuid = *catalog->lookupUUIDByNSS(opCtx.get(), nss);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(catalog->lookupCollectionByUUIDForRead(opCtx.get(), uuid));
+    }
+}
+
 BENCHMARK(BM_CollectionCatalogWrite)->Ranges({{{1}, {100'000}}});
 BENCHMARK(BM_CollectionCatalogWriteBatchedWithGlobalExclusiveLock)->Ranges({{{1}, {100'000}}});
+BENCHMARK(BM_CollectionCatalogCreateDropCollection)->Ranges({{{1}, {100'000}}});
+BENCHMARK(BM_CollectionCatalogLookupCollectionByNamespace)->Ranges({{{1}, {100'000}}});
+BENCHMARK(BM_CollectionCatalogLookupCollectionByUUID)->Ranges({{{1}, {100'000}}});
 
 }  // namespace mongo
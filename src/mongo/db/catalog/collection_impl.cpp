@@ -888,7 +888,7 @@ Status CollectionImpl::_insertDocuments(OperationContext* opCtx,
                 "Can't batch inserts into indexed capped collections"};
     }
 
-    if (_shared->_needCappedLock) {
+    if (_shouldTakeCappedLock(begin, end)) {
         // X-lock the metadata resource for this replicated, non-clustered capped collection until
         // the end of the WUOW. Non-clustered capped collections require writes to be serialized on
         // the secondary in order to guarantee insertion order (SERVER-21483); this exclusive access
@@ -914,6 +914,10 @@ Status CollectionImpl::_insertDocuments(OperationContext* opCtx,
             invariant(_shared->_recordStore->keyFormat() == KeyFormat::String);
             recordId = uassertStatusOK(record_id_helpers::keyForDoc(
                 doc, getClusteredInfo()->getIndexSpec(), getDefaultCollator()));
+        } else if (!it->recordId.isNull()) {
+            // The RecordId was reserved ahead of the insert.
+            invariant(_shared->_recordStore->keyFormat() == KeyFormat::Long);
+            recordId = it->recordId;
         }
 
         if (MONGO_unlikely(corruptDocumentOnInsert.shouldFail())) {
@@ -970,6 +974,20 @@ Status CollectionImpl::_insertDocuments(OperationContext* opCtx,
     return Status::OK();
 }
 
+bool CollectionImpl::_shouldTakeCappedLock(
+    const std::vector<InsertStatement>::const_iterator begin,
+    const std::vector<InsertStatement>::const_iterator end) const {
+    if (!_shared->_needCappedLock) {
+        return false;
+    }
+
+    // Only secondary oplog application reserves RecordIds for capped inserts, in oplog order, so
+    // those inserts keep the insertion order without being serialized. Every other writer,
+    // including the tenant migration oplog applier, must hold the capped lock.
+    return std::any_of(
+        begin, end, [](const InsertStatement& stmt) { return stmt.recordId.isNull(); });
+}
+
 bool CollectionImpl::_cappedAndNeedDelete(OperationContext* opCtx) const {
     if (MONGO_unlikely(skipCappedDeletes.shouldFail())) {
         return false;
@@ -499,6 +499,14 @@ private:
                             OpDebug* opDebug,
                             bool fromMigrate) const;
 
+    /**
+     * Returns whether the inserts in [begin, end) must hold the capped lock, an exclusive lock on
+     * the metadata resource of this collection, until the end of their WriteUnitOfWork. Inserts
+     * that all carry a RecordId reserved by secondary oplog application do not need it.
+     */
+    bool _shouldTakeCappedLock(std::vector<InsertStatement>::const_iterator begin,
+                               std::vector<InsertStatement>::const_iterator end) const;
+
     /**
      * Checks whether the collection is capped and if the current data size or number of records
      * exceeds _cappedMaxSize or _cappedMaxDocs respectively.
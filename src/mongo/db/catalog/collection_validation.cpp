@@ -51,6 +51,7 @@
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/hex.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
@@ -248,6 +249,44 @@ void _validateIndexKeyCount(OperationContext* opCtx,
     }
 }
 
+/**
+ * Reports where the next invocation of a range-limited validation should resume, unless every
+ * record and every index entry has been checked.
+ */
+void _appendRangeResumePoints(ValidateState* validateState,
+                              const RecordId& lastTraversedRecordId,
+                              BSONObjBuilder* output) {
+    const auto& indexResumeAfter = validateState->getIndexResumeAfter();
+    if (validateState->getLastRecordId().isNull() && indexResumeAfter.empty()) {
+        return;
+    }
+
+    // Once every record has been checked, the next invocation resumes after the last record, so
+    // that it only continues the traversal of the remaining indexes.
+    RecordId resumeAfter = validateState->getLastRecordId();
+    if (resumeAfter.isNull()) {
+        resumeAfter = lastTraversedRecordId.isNull() ? validateState->getRange().resumeAfter
+                                                     : lastTraversedRecordId;
+    }
+    if (!resumeAfter.isNull()) {
+        resumeAfter.serializeToken("resumeAfter", output);
+    }
+
+    BSONObjBuilder indexResumeAfterBuilder(output->subobjStart("indexResumeAfter"));
+    for (const auto& [indexName, keyString] : indexResumeAfter) {
+        indexResumeAfterBuilder.append(indexName, hexblob::encode(keyString));
+    }
+    indexResumeAfterBuilder.doneFast();
+
+    LOGV2_OPTIONS(6610804,
+                  {LogComponent::kIndex},
+                  "Validating a range of the collection",
+                  logAttrs(validateState->nss()),
+                  "resumeAfter"_attr = validateState->getRange().resumeAfter,
+                  "lastRecordId"_attr = resumeAfter,
+                  "unfinishedIndexes"_attr = indexResumeAfter.size());
+}
+
 void _reportValidationResults(OperationContext* opCtx,
                               ValidateState* validateState,
                               ValidateResults* results,
@@ -563,11 +602,23 @@ Status validate(OperationContext* opCtx,
                 ValidateResults* results,
                 BSONObjBuilder* output,
                 bool turnOnExtraLoggingForTest) {
+    return validate(
+        opCtx, nss, mode, repairMode, {}, results, output, turnOnExtraLoggingForTest);
+}
+
+Status validate(OperationContext* opCtx,
+                const NamespaceString& nss,
+                ValidateMode mode,
+                RepairMode repairMode,
+                const ValidateRange& range,
+                ValidateResults* results,
+                BSONObjBuilder* output,
+                bool turnOnExtraLoggingForTest) {
     invariant(!opCtx->lockState()->isLocked() || storageGlobalParams.repair);
 
     // This is deliberately outside of the try-catch block, so that any errors thrown in the
     // constructor fail the cmd, as opposed to returning OK with valid:false.
-    ValidateState validateState(opCtx, nss, mode, repairMode, turnOnExtraLoggingForTest);
+    ValidateState validateState(opCtx, nss, mode, repairMode, turnOnExtraLoggingForTest, range);
 
     const auto replCoord = repl::ReplicationCoordinator::get(opCtx);
     // Check whether we are allowed to read from this node after acquiring our locks. If we are
@@ -682,7 +733,9 @@ Status validate(OperationContext* opCtx,
             _validationIsPausedForTest.store(false);
         }
 
-        if (!results->valid) {
+        // A range-limited validation still traverses its part of the indexes when it found invalid
+        // records, so that it can report where the next invocation should resume.
+        if (!results->valid && !range.isLimited()) {
             _reportInvalidResults(opCtx, &validateState, results, output);
             return Status::OK();
         }
@@ -690,7 +743,14 @@ Status validate(OperationContext* opCtx,
         // Validate indexes and check for mismatches.
         _validateIndexes(opCtx, &validateState, &indexValidator, results);
 
-        if (indexConsistency.haveEntryMismatch()) {
+        if (range.isLimited()) {
+            // A range-limited validation records the inconsistencies as it finds them, so there is
+            // no second phase to gather them.
+            indexConsistency.setSecondPhase();
+            indexConsistency.addIndexEntryErrors(results);
+            _appendRangeResumePoints(
+                &validateState, indexValidator.getLastTraversedRecordId(), output);
+        } else if (indexConsistency.haveEntryMismatch()) {
             LOGV2_OPTIONS(20305,
                           {LogComponent::kIndex},
                           "Index inconsistencies were detected. "
@@ -705,8 +765,12 @@ Status validate(OperationContext* opCtx,
             return Status::OK();
         }
 
-        // Validate index key count.
-        _validateIndexKeyCount(opCtx, &validateState, &indexValidator, &results->indexResultsMap);
+        // Validate index key count. A range-limited validation does not see all records and index
+        // entries, so it cannot compare their counts.
+        if (!range.isLimited()) {
+            _validateIndexKeyCount(
+                opCtx, &validateState, &indexValidator, &results->indexResultsMap);
+        }
 
         if (!results->valid) {
             _reportInvalidResults(opCtx, &validateState, results, output);
@@ -29,8 +29,13 @@
 
 #pragma once
 
+#include <boost/optional.hpp>
+#include <map>
+#include <string>
+
 #include "mongo/db/catalog/validate_results.h"
 #include "mongo/db/namespace_string.h"
+#include "mongo/db/record_id.h"
 
 namespace mongo {
 
@@ -86,6 +91,43 @@ enum class RepairMode {
     kAdjustMultikey,
 };
 
+/**
+ * ValidateRange restricts the record store and index consistency checks to a part of the
+ * collection, so that a large collection can be validated across several invocations. Each
+ * invocation checks the records following 'resumeAfter' and the entries of each index following
+ * its key in 'indexResumeAfter', stopping once 'maxRecords' records and 'maxRecords' entries per
+ * index have been checked.
+ *
+ * Instead of matching the hashes of all document keys against those of all index entries, which
+ * needs a pass over every index, the two sides are checked separately:
+ *   - Every key generated from a record in the range is looked up in its index.
+ *   - Every index entry in the traversed part of an index is checked against the keys generated
+ *     from the record it points at.
+ *
+ * The points to resume after on the next invocation are reported as 'resumeAfter' and
+ * 'indexResumeAfter' in the output. Both are absent once every record and every index entry has
+ * been checked.
+ *
+ * A range-limited validation never repairs or adjusts metadata, and does not check key counts or
+ * $** multikey metadata entries, as it only observes part of the collection.
+ */
+struct ValidateRange {
+    bool isLimited() const {
+        return !resumeAfter.isNull() || maxRecords > 0 || indexResumeAfter;
+    }
+
+    // Validation starts at the first record after this RecordId. A null RecordId starts at the
+    // beginning of the collection.
+    RecordId resumeAfter;
+    // Set when continuing an earlier range-limited validation. Maps the name of each index whose
+    // traversal has not finished yet to the KeyString of the last entry checked. Indexes missing
+    // from the map have been fully traversed and are skipped. If unset, every index is traversed
+    // from its first entry.
+    boost::optional<std::map<std::string, std::string>> indexResumeAfter;
+    // The maximum number of records, and of entries per index, to check, or 0 for no limit.
+    long long maxRecords = 0;
+};
+
 /**
  * Expects the caller to hold no locks.
  *
@@ -105,6 +147,18 @@ Status validate(OperationContext* opCtx,
                 BSONObjBuilder* output,
                 bool turnOnExtraLoggingForTest = false);
 
+/**
+ * Same as above, but only validates the RecordIds described by 'range'.
+ */
+Status validate(OperationContext* opCtx,
+                const NamespaceString& nss,
+                ValidateMode mode,
+                RepairMode repairMode,
+                const ValidateRange& range,
+                ValidateResults* results,
+                BSONObjBuilder* output,
+                bool turnOnExtraLoggingForTest = false);
+
 /**
  * Checks whether a failpoint has been hit in the above validate() code..
  */
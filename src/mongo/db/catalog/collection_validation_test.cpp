@@ -34,9 +34,11 @@
 #include "mongo/db/catalog/catalog_test_fixture.h"
 #include "mongo/db/catalog/collection.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/index/index_access_method.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/hex.h"
 
 namespace mongo {
 
@@ -266,6 +268,122 @@ TEST_F(CollectionValidationTest, ValidateEnforceFastCount) {
                        {CollectionValidation::ValidateMode::kForegroundFullEnforceFastCount});
 }
 
+/**
+ * Validates collection kNss in ranges of at most 'maxRecords' records and index entries per index,
+ * resuming each validation where the previous one stopped, and returns the number of records
+ * validated per range.
+ */
+std::vector<int> rangeValidate(OperationContext* opCtx,
+                               CollectionValidation::ValidateMode mode,
+                               long long maxRecords) {
+    std::vector<int> numRecordsPerRange;
+    CollectionValidation::ValidateRange range;
+    range.maxRecords = maxRecords;
+    while (true) {
+        ValidateResults validateResults;
+        BSONObjBuilder output;
+        ASSERT_OK(CollectionValidation::validate(opCtx,
+                                                 kNss,
+                                                 mode,
+                                                 CollectionValidation::RepairMode::kNone,
+                                                 range,
+                                                 &validateResults,
+                                                 &output));
+        BSONObj obj = output.obj();
+        ASSERT(validateResults.valid) << obj;
+        ASSERT_EQ(validateResults.errors.size(), 0U) << obj;
+        numRecordsPerRange.push_back(obj.getIntField("nrecords"));
+        for (auto&& keys : obj.getObjectField("keysPerIndex")) {
+            ASSERT_LTE(keys.numberLong(), maxRecords) << obj;
+        }
+
+        BSONElement resumeAfter = obj["resumeAfter"];
+        BSONElement indexResumeAfter = obj["indexResumeAfter"];
+        if (!resumeAfter && !indexResumeAfter) {
+            return numRecordsPerRange;
+        }
+        if (resumeAfter) {
+            range.resumeAfter = RecordId::deserializeToken(resumeAfter);
+        }
+        range.indexResumeAfter.emplace();
+        for (auto&& key : indexResumeAfter.Obj()) {
+            range.indexResumeAfter->emplace(key.fieldName(), hexblob::decode(key.String()));
+        }
+    }
+}
+
+// Verify that a collection can be validated in ranges of records.
+TEST_F(CollectionValidationTest, ValidateRange) {
+    auto opCtx = operationContext();
+    insertDataRange(opCtx, 0, 10);
+    ASSERT_EQ(rangeValidate(opCtx, CollectionValidation::ValidateMode::kForeground, 4),
+              (std::vector<int>{4, 4, 2}));
+    ASSERT_EQ(rangeValidate(opCtx, CollectionValidation::ValidateMode::kForeground, 5),
+              (std::vector<int>{5, 5, 0}));
+    ASSERT_EQ(rangeValidate(opCtx, CollectionValidation::ValidateMode::kForeground, 20),
+              (std::vector<int>{10}));
+
+    // Validating a range must not reset the fast count to the number of records in the range.
+    foregroundValidate(opCtx,
+                       /*valid*/ true,
+                       /*numRecords*/ 10,
+                       /*numInvalidDocuments*/ 0,
+                       /*numErrors*/ 0,
+                       {CollectionValidation::ValidateMode::kForegroundFullEnforceFastCount});
+}
+// Verify that a range-limited validation finds the index entries missing for the records in its
+// range, and the entries in its part of an index that do not match their record.
+TEST_F(CollectionValidationTest, ValidateRangeFindsIndexInconsistencies) {
+    auto opCtx = operationContext();
+    insertDataRange(opCtx, 0, 10);
+    {
+        AutoGetCollection coll(opCtx, kNss, MODE_X);
+        const IndexCatalog* indexCatalog = coll->getIndexCatalog();
+        auto sdi = indexCatalog->getEntry(indexCatalog->findIdIndex(opCtx))
+                       ->accessMethod()
+                       ->asSortedData()
+                       ->getSortedDataInterface();
+        auto record = coll->getRecordStore()->getCursor(opCtx)->next();
+        ASSERT(record);
+        ASSERT_BSONOBJ_EQ(record->data.toBson(), BSON("_id" << 0));
+
+        // Replace the _id index entry of the first document with an entry for another key.
+        const Ordering ord = Ordering::make(BSON("_id" << 1));
+        KeyString::Builder missingKey(sdi->getKeyStringVersion(), BSON("" << 0), ord, record->id);
+        KeyString::Builder extraKey(sdi->getKeyStringVersion(), BSON("" << 100), ord, record->id);
+        WriteUnitOfWork wuow(opCtx);
+        sdi->unindex(opCtx, missingKey.getValueCopy(), /*dupsAllowed*/ false);
+        ASSERT_OK(sdi->insert(opCtx, extraKey.getValueCopy(), /*dupsAllowed*/ false).getStatus());
+        wuow.commit();
+    }
+
+    CollectionValidation::ValidateRange range;
+    range.maxRecords = 20;
+    ValidateResults validateResults;
+    BSONObjBuilder output;
+    ASSERT_OK(CollectionValidation::validate(opCtx,
+                                             kNss,
+                                             CollectionValidation::ValidateMode::kForeground,
+                                             CollectionValidation::RepairMode::kNone,
+                                             range,
+                                             &validateResults,
+                                             &output));
+    BSONObj obj = output.obj();
+    ASSERT_FALSE(validateResults.valid) << obj;
+    ASSERT_EQ(validateResults.missingIndexEntries.size(), 1U) << obj;
+    ASSERT_EQ(validateResults.extraIndexEntries.size(), 1U) << obj;
+    ASSERT_FALSE(obj.hasField("resumeAfter")) << obj;
+    ASSERT_FALSE(obj.hasField("indexResumeAfter")) << obj;
+}
+
+TEST_F(BackgroundCollectionValidationTest, BackgroundValidateRange) {
+    auto opCtx = operationContext();
+    insertDataRange(opCtx, 0, 10);
+    opCtx->recoveryUnit()->waitUntilUnjournaledWritesDurable(opCtx, /*stableTimestamp*/ false);
+    ASSERT_EQ(rangeValidate(opCtx, CollectionValidation::ValidateMode::kBackground, 3),
+              (std::vector<int>{3, 3, 3, 1}));
+}
+
 /**
  * Waits for a parallel running collection validation operation to start and then hang at a
  * failpoint.
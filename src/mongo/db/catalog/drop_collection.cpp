@@ -440,7 +440,12 @@ Status dropCollection(OperationContext* opCtx,
     const auto collectionName =
         nss.isTimeseriesBucketsCollection() ? nss.getTimeseriesViewNamespace() : nss;
 
-    return _dropCollection(opCtx, collectionName, expectedUUID, reply, systemCollectionMode);
+    auto status =
+        _dropCollection(opCtx, collectionName, expectedUUID, reply, systemCollectionMode);
+    if (status.isOK()) {
+        dropCollectionStatistics(opCtx, collectionName);
+    }
+    return status;
 }
 
 Status dropCollection(OperationContext* opCtx,
@@ -450,6 +455,28 @@ Status dropCollection(OperationContext* opCtx,
     return dropCollection(opCtx, nss, boost::none, reply, systemCollectionMode);
 }
 
+void dropCollectionStatistics(OperationContext* opCtx, const NamespaceString& collectionName) {
+    if (collectionName.isStatisticsCollection()) {
+        return;
+    }
+
+    const auto statsNss = collectionName.makeStatisticsNamespace();
+    DropReply statsReply;
+    auto status = _dropCollection(opCtx,
+                                  statsNss,
+                                  boost::none /* expectedUUID */,
+                                  &statsReply,
+                                  DropCollectionSystemCollectionMode::kAllowSystemCollectionDrops);
+    if (!status.isOK() && status != ErrorCodes::NamespaceNotFound) {
+        // The statistics are ignored once the collection they describe is gone, so failing to
+        // drop them only leaves them behind until the next drop of the same namespace.
+        LOGV2_WARNING(6610809,
+                      "Failed to drop collection statistics",
+                      "namespace"_attr = statsNss,
+                      "error"_attr = status);
+    }
+}
+
 Status dropCollectionIfUUIDNotMatching(OperationContext* opCtx,
                                        const NamespaceString& ns,
                                        const UUID& expectedUUID) {
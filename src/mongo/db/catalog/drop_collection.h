@@ -62,6 +62,13 @@ Status dropCollection(OperationContext* opCtx,
                       DropReply* reply,
                       DropCollectionSystemCollectionMode systemCollectionMode);
 
+/**
+ * Drops the statistics gathered by the 'analyze' command for the collection "collectionName", if
+ * there are any. Called once "collectionName" has been dropped or renamed, since the statistics
+ * describe a collection that no longer exists under that name.
+ */
+void dropCollectionStatistics(OperationContext* opCtx, const NamespaceString& collectionName);
+
 /**
  * Drops the collection "collectionName" only if its uuid is not matching "expectedUUID".
  */
@@ -272,6 +272,15 @@ void IndexConsistency::addIndexEntryErrors(ValidateResults* results) {
         }
     }
 
+    if (_rangeEntryErrorsTruncated) {
+        StringBuilder ss;
+        ss << "Not all index entry inconsistencies are reported due to memory limitations. "
+           << "Memory limit for validation is currently set to " << maxValidateMemoryUsageMB.load()
+           << "MB and can be configured via the 'maxValidateMemoryUsageMB' parameter.";
+        results->errors.push_back(ss.str());
+        results->valid = false;
+    }
+
     // Inform how many inconsistencies were detected.
     if (numMissingIndexEntryErrors > 0) {
         StringBuilder ss;
@@ -435,6 +444,61 @@ void IndexConsistency::addIndexKey(OperationContext* opCtx,
     }
 }
 
+void IndexConsistency::addMissingIndexEntry(OperationContext* opCtx,
+                                            const KeyString::Value& ks,
+                                            IndexInfo* indexInfo,
+                                            RecordId recordId) {
+    invariant(_validateState->getRange().isLimited());
+    if (!_reserveRangeEntryError(ks.getSize())) {
+        return;
+    }
+
+    auto record = _validateState->getSeekRecordStoreCursor()->seekExact(opCtx, recordId);
+    invariant(record);
+
+    BSONObj data = record->data.toBson();
+
+    BSONObjBuilder idKeyBuilder;
+    if (data.hasField("_id")) {
+        idKeyBuilder.append(data["_id"]);
+    }
+
+    _missingIndexEntries.insert(std::make_pair(
+        _generateKeyForMap(*indexInfo, ks),
+        IndexEntryInfo(*indexInfo, recordId, idKeyBuilder.obj(), ks)));
+
+    _validateState->getCollection()->getRecordStore()->printRecordMetadata(opCtx, recordId);
+}
+
+void IndexConsistency::addExtraIndexEntry(OperationContext* opCtx,
+                                          const KeyString::Value& ks,
+                                          IndexInfo* indexInfo,
+                                          RecordId recordId) {
+    invariant(_validateState->getRange().isLimited());
+    if (!_reserveRangeEntryError(ks.getSize())) {
+        return;
+    }
+
+    auto indexKey =
+        KeyString::toBsonSafe(ks.getBuffer(), ks.getSize(), indexInfo->ord, ks.getTypeBits());
+    BSONObj info =
+        _generateInfo(indexInfo->indexName, indexInfo->keyPattern, recordId, indexKey, BSONObj());
+    _extraIndexEntries[_generateKeyForMap(*indexInfo, ks)].insert(info);
+
+    _validateState->getCollection()->getRecordStore()->printRecordMetadata(opCtx, recordId);
+}
+
+bool IndexConsistency::_reserveRangeEntryError(size_t bytes) {
+    const uint64_t maxMemoryUsageBytes =
+        static_cast<uint64_t>(maxValidateMemoryUsageMB.load()) * 1024 * 1024;
+    if (_rangeEntryErrorsTruncated || _rangeEntryErrorBytes + bytes > maxMemoryUsageBytes) {
+        _rangeEntryErrorsTruncated = true;
+        return false;
+    }
+    _rangeEntryErrorBytes += bytes;
+    return true;
+}
+
 bool IndexConsistency::limitMemoryUsageForSecondPhase(ValidateResults* result) {
     invariant(!_firstPhase);
 
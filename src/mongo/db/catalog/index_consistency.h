@@ -122,6 +122,25 @@ public:
                      RecordId recordId,
                      ValidateResults* results);
 
+    /**
+     * Used by range-limited validations, which check the document keys and index entries directly
+     * instead of hashing them. Records that the document identified by 'recordId' generates the
+     * key 'ks', which is missing from the index.
+     */
+    void addMissingIndexEntry(OperationContext* opCtx,
+                              const KeyString::Value& ks,
+                              IndexInfo* indexInfo,
+                              RecordId recordId);
+
+    /**
+     * Used by range-limited validations. Records that the index entry 'ks' points at 'recordId',
+     * which does not exist or does not generate that key.
+     */
+    void addExtraIndexEntry(OperationContext* opCtx,
+                            const KeyString::Value& ks,
+                            IndexInfo* indexInfo,
+                            RecordId recordId);
+
     /**
      * During the first phase of validation, tracks the multikey paths for every observed document.
      */
@@ -218,6 +237,11 @@ private:
     // index entry for a given IndexKey for each index.
     std::map<IndexKey, IndexEntryInfo> _missingIndexEntries;
 
+    // The memory used by the inconsistencies recorded by a range-limited validation, which stops
+    // recording them once it reaches 'maxValidateMemoryUsageMB'.
+    uint64_t _rangeEntryErrorBytes = 0;
+    bool _rangeEntryErrorsTruncated = false;
+
     /**
      * Generates a key for the second phase of validation. The keys format is the following:
      * {
@@ -236,6 +260,12 @@ private:
                           const BSONObj& indexKey,
                           const BSONObj& idKey);
 
+    /**
+     * Accounts for an inconsistency of 'bytes' found by a range-limited validation. Returns false
+     * if recording it would exceed the memory limit.
+     */
+    bool _reserveRangeEntryError(size_t bytes);
+
     /**
      * Returns a hashed value from the given KeyString and index namespace.
      */
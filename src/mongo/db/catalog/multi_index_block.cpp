@@ -43,6 +43,7 @@
 #include "mongo/db/catalog/uncommitted_collections.h"
 #include "mongo/db/client.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/index/index_access_method_gen.h"
 #include "mongo/db/index/multikey_paths.h"
 #include "mongo/db/multi_key_path_tracker.h"
 #include "mongo/db/op_observer.h"
@@ -85,6 +86,18 @@ size_t getEachIndexBuildMaxMemoryUsageBytes(size_t numIndexSpecs) {
         numIndexSpecs;
 }
 
+// The most documents the collection scan buffers before handing them to the indexes when their
+// keys are generated concurrently.
+constexpr size_t kKeyGenerationBatchSize = 4096;
+
+/**
+ * Returns how many bytes of documents the collection scan may buffer for concurrent key
+ * generation. The buffer is kept to a small share of the memory the whole build may use.
+ */
+size_t getKeyGenerationBatchMaxBytes() {
+    return static_cast<std::size_t>(maxIndexBuildMemoryUsageMegabytes.load()) * 1024 * 1024 / 16;
+}
+
 Status timeseriesMixedSchemaDataFailure(const Collection* collection) {
     // TODO SERVER-61070: Re-word the error message below if necessary and add a URL for
     // workarounds.
@@ -605,6 +618,23 @@ void MultiIndexBlock::_doCollectionScan(OperationContext* opCtx,
               IndexBuildPhase_serializer(_phase).toString());
     _phase = IndexBuildPhaseEnum::kCollectionScan;
 
+    // With more than one key generation thread, documents are buffered and handed to the indexes
+    // in batches so that each index can generate the keys of a batch concurrently.
+    const bool insertInBatches = maxIndexBuildKeyGenerationThreads.load() > 1;
+    const size_t batchMaxBytes = getKeyGenerationBatchMaxBytes();
+    std::vector<std::pair<BSONObj, RecordId>> batch;
+    size_t batchBytes = 0;
+    auto insertBatch = [&] {
+        uassertStatusOK(_insertBatch(
+            opCtx,
+            collection,
+            batch,
+            /*saveCursorBeforeWrite*/ [&exec] { exec->saveState(); },
+            /*restoreCursorAfterWrite*/ [&] { exec->restoreState(&collection); }));
+        batch.clear();
+        batchBytes = 0;
+    };
+
     BSONObj objToIndex;
     RecordId loc;
     PlanExecutor::ExecState state;
@@ -633,21 +663,32 @@ void MultiIndexBlock::_doCollectionScan(OperationContext* opCtx,
         // cursor around the side table write in case any write conflict exception occurs that would
         // otherwise reposition the cursor unexpectedly. All WUOW and write conflict exception
         // handling for the side table write is handled internally.
-        uassertStatusOK(
-            _insert(opCtx,
-                    collection,
-                    objToIndex,
-                    loc,
-                    /*saveCursorBeforeWrite*/
-                    [&exec, &objToIndex] {
-                        // Update objToIndex so that it continues to point to valid data when the
-                        // cursor is closed. A WCE may occur during a write to index A, and
-                        // objToIndex must still be used when the write is retried or for a write to
-                        // another index (if creating multiple indexes at once)
-                        objToIndex = objToIndex.getOwned();
-                        exec->saveState();
-                    },
-                    /*restoreCursorAfterWrite*/ [&] { exec->restoreState(&collection); }));
+        if (insertInBatches) {
+            // The buffered documents must outlive the cursor position they were read from. Their
+            // keys only reach the sorter once the batch is full, so the failpoint below may run
+            // before this document is indexed.
+            batchBytes += objToIndex.objsize();
+            batch.emplace_back(objToIndex.getOwned(), loc);
+            if (batch.size() >= kKeyGenerationBatchSize || batchBytes >= batchMaxBytes) {
+                insertBatch();
+            }
+        } else {
+            uassertStatusOK(_insert(
+                opCtx,
+                collection,
+                objToIndex,
+                loc,
+                /*saveCursorBeforeWrite*/
+                [&exec, &objToIndex] {
+                    // Update objToIndex so that it continues to point to valid data when the
+                    // cursor is closed. A WCE may occur during a write to index A, and
+                    // objToIndex must still be used when the write is retried or for a write to
+                    // another index (if creating multiple indexes at once)
+                    objToIndex = objToIndex.getOwned();
+                    exec->saveState();
+                },
+                /*restoreCursorAfterWrite*/ [&] { exec->restoreState(&collection); }));
+        }
 
         _failPointHangDuringBuild(opCtx,
                                   &hangIndexBuildDuringCollectionScanPhaseAfterInsertion,
@@ -659,6 +700,8 @@ void MultiIndexBlock::_doCollectionScan(OperationContext* opCtx,
         // Go to the next document.
         progress->hit();
     }
+
+    insertBatch();
 }
 
 Status MultiIndexBlock::insertSingleDocumentForInitialSyncOrRecovery(
@@ -680,32 +723,10 @@ Status MultiIndexBlock::_insert(OperationContext* opCtx,
     invariant(!_buildIsCleanedUp);
 
     // The detection of mixed-schema data needs to be done before applying the partial filter
-    // expression below. Only check for mixed-schema data if it's possible for the time-series
-    // collection to have it.
-    if (_containsIndexBuildOnTimeseriesMeasurement &&
-        *collection->getTimeseriesBucketsMayHaveMixedSchemaData()) {
-        bool docHasMixedSchemaData =
-            collection->doesTimeseriesBucketsDocContainMixedSchemaData(doc);
-
-        if (docHasMixedSchemaData) {
-            LOGV2(6057700,
-                  "Detected mixed-schema data in time-series bucket collection",
-                  logAttrs(collection->ns()),
-                  logAttrs(collection->uuid()),
-                  "recordId"_attr = loc,
-                  "control"_attr = redact(doc.getObjectField(timeseries::kBucketControlFieldName)));
-
-            _timeseriesBucketContainsMixedSchemaData = true;
-        }
-
-        // Only enforce the mixed-schema data constraint on the primary. Index builds may not fail
-        // on the secondaries. The primary will replicate an abortIndexBuild oplog entry.
-        auto replCoord = repl::ReplicationCoordinator::get(opCtx);
-        const bool replSetAndNotPrimary = !replCoord->canAcceptWritesFor(opCtx, collection->ns());
-
-        if (docHasMixedSchemaData && !replSetAndNotPrimary) {
-            return timeseriesMixedSchemaDataFailure(collection.get());
-        }
+    // expression below.
+    if (auto status = _checkTimeseriesMixedSchemaData(opCtx, collection, doc, loc);
+        !status.isOK()) {
+        return status;
     }
 
     for (size_t i = 0; i < _indexes.size(); i++) {
@@ -739,6 +760,93 @@ Status MultiIndexBlock::_insert(OperationContext* opCtx,
     return Status::OK();
 }
 
+Status MultiIndexBlock::_insertBatch(OperationContext* opCtx,
+                                     const CollectionPtr& collection,
+                                     const std::vector<std::pair<BSONObj, RecordId>>& docs,
+                                     const std::function<void()>& saveCursorBeforeWrite,
+                                     const std::function<void()>& restoreCursorAfterWrite) {
+    invariant(!_buildIsCleanedUp);
+    if (docs.empty()) {
+        return Status::OK();
+    }
+
+    for (const auto& [doc, loc] : docs) {
+        if (auto status = _checkTimeseriesMixedSchemaData(opCtx, collection, doc, loc);
+            !status.isOK()) {
+            return status;
+        }
+    }
+
+    std::vector<BsonRecord> records;
+    records.reserve(docs.size());
+    for (size_t i = 0; i < _indexes.size(); i++) {
+        records.clear();
+        for (const auto& [doc, loc] : docs) {
+            if (!_indexes[i].filterExpression || _indexes[i].filterExpression->matchesBSON(doc)) {
+                records.push_back(BsonRecord{loc, Timestamp(), &doc});
+            }
+        }
+
+        Status idxStatus = Status::OK();
+
+        // When calling insertBatch, BulkBuilderImpl's Sorter performs file I/O that may result in
+        // an exception.
+        try {
+            idxStatus = _indexes[i].bulk->insertBatch(opCtx,
+                                                      collection,
+                                                      _indexes[i].block->getPooledBuilder(),
+                                                      records,
+                                                      _indexes[i].options,
+                                                      saveCursorBeforeWrite,
+                                                      restoreCursorAfterWrite);
+        } catch (...) {
+            return exceptionToStatus();
+        }
+
+        if (!idxStatus.isOK())
+            return idxStatus;
+    }
+
+    _lastRecordIdInserted = docs.back().second;
+
+    return Status::OK();
+}
+
+Status MultiIndexBlock::_checkTimeseriesMixedSchemaData(OperationContext* opCtx,
+                                                        const CollectionPtr& collection,
+                                                        const BSONObj& doc,
+                                                        const RecordId& loc) {
+    // Only check for mixed-schema data if it's possible for the time-series collection to have it.
+    if (!_containsIndexBuildOnTimeseriesMeasurement ||
+        !*collection->getTimeseriesBucketsMayHaveMixedSchemaData()) {
+        return Status::OK();
+    }
+
+    bool docHasMixedSchemaData = collection->doesTimeseriesBucketsDocContainMixedSchemaData(doc);
+
+    if (docHasMixedSchemaData) {
+        LOGV2(6057700,
+              "Detected mixed-schema data in time-series bucket collection",
+              logAttrs(collection->ns()),
+              logAttrs(collection->uuid()),
+              "recordId"_attr = loc,
+              "control"_attr = redact(doc.getObjectField(timeseries::kBucketControlFieldName)));
+
+        _timeseriesBucketContainsMixedSchemaData = true;
+    }
+
+    // Only enforce the mixed-schema data constraint on the primary. Index builds may not fail on
+    // the secondaries. The primary will replicate an abortIndexBuild oplog entry.
+    auto replCoord = repl::ReplicationCoordinator::get(opCtx);
+    const bool replSetAndNotPrimary = !replCoord->canAcceptWritesFor(opCtx, collection->ns());
+
+    if (docHasMixedSchemaData && !replSetAndNotPrimary) {
+        return timeseriesMixedSchemaDataFailure(collection.get());
+    }
+
+    return Status::OK();
+}
+
 Status MultiIndexBlock::dumpInsertsFromBulk(OperationContext* opCtx,
                                             const CollectionPtr& collection) {
     return dumpInsertsFromBulk(opCtx, collection, nullptr);
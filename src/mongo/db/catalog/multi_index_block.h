@@ -336,6 +336,25 @@ private:
                    const std::function<void()>& saveCursorBeforeWrite,
                    const std::function<void()>& restoreCursorAfterWrite);
 
+    /**
+     * Inserts each of 'docs' in order, as-if by calling _insert() on each of them, but lets each
+     * index generate the keys of the whole batch concurrently.
+     */
+    Status _insertBatch(OperationContext* opCtx,
+                        const CollectionPtr& collection,
+                        const std::vector<std::pair<BSONObj, RecordId>>& docs,
+                        const std::function<void()>& saveCursorBeforeWrite,
+                        const std::function<void()>& restoreCursorAfterWrite);
+
+    /**
+     * Returns an error if 'doc' is a time-series bucket with mixed-schema data and an index on
+     * time-series measurements is being built on a primary.
+     */
+    Status _checkTimeseriesMixedSchemaData(OperationContext* opCtx,
+                                           const CollectionPtr& collection,
+                                           const BSONObj& doc,
+                                           const RecordId& loc);
+
     /**
      * Performs a collection scan on the given collection and inserts the relevant index keys into
      * the external sorter.
@@ -34,7 +34,10 @@
 #include "mongo/db/catalog/catalog_test_fixture.h"
 #include "mongo/db/catalog_raii.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
+#include "mongo/db/index/index_access_method.h"
+#include "mongo/db/repl/oplog.h"
 #include "mongo/db/repl/replication_coordinator_mock.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/unittest.h"
 
 namespace mongo {
@@ -195,5 +198,49 @@ TEST_F(MultiIndexBlockTest, InitWriteConflictException) {
     indexer->abortIndexBuild(operationContext(), coll, MultiIndexBlock::kNoopOnCleanUpFn);
 }
 
+TEST_F(MultiIndexBlockTest, InsertAllDocumentsGeneratesKeysConcurrently) {
+    RAIIServerParameterControllerForTest controller("maxIndexBuildKeyGenerationThreads", 4);
+
+    // Every other document holds an array, so it generates two keys and makes the index multikey.
+    const int numDocs = 5000;
+    std::vector<InsertStatement> docs;
+    for (int i = 0; i < numDocs; ++i) {
+        docs.emplace_back(i % 2 ? BSON("_id" << i << "a" << BSON_ARRAY(i << -i) << "b" << i)
+                                : BSON("_id" << i << "a" << i << "b" << i));
+    }
+    ASSERT_OK(storageInterface()->insertDocuments(operationContext(), getNSS(), docs));
+
+    auto indexer = getIndexer();
+
+    AutoGetCollection autoColl(operationContext(), getNSS(), MODE_X);
+    CollectionWriter coll(operationContext(), autoColl);
+
+    BSONObj spec = BSON("key" << BSON("a" << 1 << "b" << 1) << "name"
+                              << "a_1_b_1"
+                              << "v" << static_cast<int>(IndexDescriptor::kLatestIndexVersion));
+    ASSERT_OK(indexer->init(operationContext(), coll, {spec}, MultiIndexBlock::kNoopOnInitFn)
+                  .getStatus());
+
+    ASSERT_OK(indexer->insertAllDocumentsInCollection(operationContext(), coll.get()));
+    ASSERT_OK(indexer->checkConstraints(operationContext(), coll.get()));
+
+    {
+        WriteUnitOfWork wunit(operationContext());
+        ASSERT_OK(indexer->commit(operationContext(),
+                                  coll.getWritableCollection(),
+                                  MultiIndexBlock::kNoopOnCreateEachFn,
+                                  MultiIndexBlock::kNoopOnCommitFn));
+        wunit.commit();
+    }
+
+    auto indexCatalog = coll->getIndexCatalog();
+    auto entry =
+        indexCatalog->getEntry(indexCatalog->findIndexByName(operationContext(), "a_1_b_1"));
+    ASSERT(entry->isMultikey(operationContext(), coll.get()));
+    ASSERT_EQ(numDocs + numDocs / 2,
+              entry->accessMethod()->asSortedData()->getSortedDataInterface()->numEntries(
+                  operationContext()));
+}
+
 }  // namespace
 }  // namespace mongo
@@ -890,11 +890,16 @@ Status renameCollection(OperationContext* opCtx,
           "targetNamespace"_attr = target,
           "dropTarget"_attr = dropTargetMsg);
 
-    if (source.db() == target.db())
-        return renameCollectionWithinDB(opCtx, source, target, options);
-    else {
-        return renameBetweenDBs(opCtx, source, target, options);
+    auto status = source.db() == target.db()
+        ? renameCollectionWithinDB(opCtx, source, target, options)
+        : renameBetweenDBs(opCtx, source, target, options);
+    if (status.isOK()) {
+        // Statistics gathered by 'analyze' are kept per namespace, so neither the ones left under
+        // the source name nor those of a dropped target describe a collection anymore.
+        dropCollectionStatistics(opCtx, source);
+        dropCollectionStatistics(opCtx, target);
     }
+    return status;
 }
 
 Status renameCollectionForApplyOps(OperationContext* opCtx,
@@ -227,18 +227,28 @@ Status ValidateAdaptor::validateRecord(OperationContext* opCtx,
             _indexConsistency->addDocumentMultikeyPaths(&indexInfo, *documentMultikeyPaths);
         }
 
-        for (const auto& keyString : *multikeyMetadataKeys) {
-            try {
-                _indexConsistency->addMultikeyMetadataPath(keyString, &indexInfo);
-            } catch (...) {
-                return exceptionToStatus();
+        // A range-limited validation looks each document key up in its index instead of hashing
+        // it, and does not check the multikey metadata keys, which need a pass over the whole
+        // collection.
+        const bool isRangeLimited = _validateState->getRange().isLimited();
+        if (!isRangeLimited) {
+            for (const auto& keyString : *multikeyMetadataKeys) {
+                try {
+                    _indexConsistency->addMultikeyMetadataPath(keyString, &indexInfo);
+                } catch (...) {
+                    return exceptionToStatus();
+                }
             }
         }
 
         for (const auto& keyString : *documentKeySet) {
             try {
                 _totalIndexKeys++;
-                _indexConsistency->addDocKey(opCtx, keyString, &indexInfo, recordId);
+                if (isRangeLimited) {
+                    _checkIndexEntryExists(opCtx, &indexInfo, keyString, recordId);
+                } else {
+                    _indexConsistency->addDocKey(opCtx, keyString, &indexInfo, recordId);
+                }
             } catch (...) {
                 return exceptionToStatus();
             }
@@ -300,6 +310,11 @@ void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
                                     const IndexCatalogEntry* index,
                                     int64_t* numTraversedKeys,
                                     ValidateResults* results) {
+    if (_validateState->getRange().isLimited()) {
+        _traverseIndexRange(opCtx, index, numTraversedKeys, results);
+        return;
+    }
+
     const IndexDescriptor* descriptor = index->descriptor();
     auto indexName = descriptor->indexName();
     auto& indexResults = results->indexResultsMap[indexName];
@@ -473,10 +488,185 @@ void ValidateAdaptor::traverseIndex(OperationContext* opCtx,
     }
 }
 
+void ValidateAdaptor::_traverseIndexRange(OperationContext* opCtx,
+                                          const IndexCatalogEntry* index,
+                                          int64_t* numTraversedKeys,
+                                          ValidateResults* results) {
+    const IndexDescriptor* descriptor = index->descriptor();
+    const std::string& indexName = descriptor->indexName();
+    auto& indexResults = results->indexResultsMap[indexName];
+    IndexInfo& indexInfo = _indexConsistency->getIndexInfo(indexName);
+    const CollectionValidation::ValidateRange& range = _validateState->getRange();
+    const auto sdi = index->accessMethod()->asSortedData()->getSortedDataInterface();
+    int64_t numKeys = 0;
+
+    ON_BLOCK_EXIT([&] {
+        if (numTraversedKeys) {
+            *numTraversedKeys = numKeys;
+        }
+    });
+
+    // Continue after the last entry checked by the previous invocation. Indexes it did not report
+    // have already been traversed to their end.
+    boost::optional<KeyString::Value> resumeKeyString;
+    if (range.indexResumeAfter) {
+        auto it = range.indexResumeAfter->find(indexName);
+        if (it == range.indexResumeAfter->end()) {
+            return;
+        }
+        KeyString::Builder resumeKeyStringBuilder(sdi->getKeyStringVersion());
+        resumeKeyStringBuilder.resetFromBuffer(it->second.data(), it->second.size());
+        resumeKeyString = resumeKeyStringBuilder.getValueCopy();
+    }
+
+    if (!_progress->isActive()) {
+        const char* curopMessage = "Validate: scanning index entries";
+        stdx::unique_lock<Client> lk(*opCtx->getClient());
+        _progress.set(CurOp::get(opCtx)->setProgress_inlock(curopMessage, _totalIndexKeys));
+    }
+
+    const std::unique_ptr<SortedDataInterfaceThrottleCursor>& indexCursor =
+        _validateState->getIndexCursors().at(indexName);
+
+    boost::optional<KeyStringEntry> indexEntry;
+    if (resumeKeyString) {
+        indexEntry = indexCursor->seekForKeyString(opCtx, *resumeKeyString);
+        if (indexEntry && indexEntry->keyString.compare(*resumeKeyString) == 0) {
+            indexEntry = indexCursor->nextKeyString(opCtx);
+        }
+    } else {
+        KeyString::Builder firstKeyStringBuilder(sdi->getKeyStringVersion(),
+                                                 BSONObj(),
+                                                 indexInfo.ord,
+                                                 KeyString::Discriminator::kExclusiveBefore);
+        indexEntry = indexCursor->seekForKeyString(opCtx, firstKeyStringBuilder.getValueCopy());
+    }
+
+    const RecordId kWildcardMultikeyMetadataRecordId = record_id_helpers::reservedIdFor(
+        record_id_helpers::ReservationId::kWildcardMultikeyMetadataId, sdi->rsKeyFormat());
+    boost::optional<KeyString::Value> prevIndexKeyStringValue = resumeKeyString;
+    while (indexEntry) {
+        if (prevIndexKeyStringValue) {
+            _validateKeyOrder(
+                opCtx, index, indexEntry->keyString, *prevIndexKeyStringValue, &indexResults);
+        }
+
+        const bool isMetadataKey = indexEntry->loc == kWildcardMultikeyMetadataRecordId;
+        if (descriptor->getIndexType() != IndexType::INDEX_WILDCARD || !isMetadataKey) {
+            try {
+                _checkIndexEntryHasRecord(
+                    opCtx, index, &indexInfo, indexEntry->keyString, indexEntry->loc);
+            } catch (const DBException& e) {
+                StringBuilder ss;
+                ss << "Checking index key for " << indexInfo.indexName << " recId "
+                   << indexEntry->loc << " threw exception " << e.toString();
+                results->errors.push_back(ss.str());
+                results->valid = false;
+            }
+        }
+
+        _progress->hit();
+        numKeys++;
+        prevIndexKeyStringValue = indexEntry->keyString;
+
+        if (range.maxRecords > 0 && numKeys >= range.maxRecords) {
+            _validateState->setIndexResumeAfter(indexName, indexEntry->keyString);
+            break;
+        }
+
+        if (numKeys % kInterruptIntervalNumRecords == 0) {
+            // Periodically checks for interrupts and yields.
+            opCtx->checkForInterrupt();
+            _validateState->yield(opCtx);
+        }
+
+        indexEntry = indexCursor->nextKeyString(opCtx);
+    }
+}
+
+void ValidateAdaptor::_checkIndexEntryExists(OperationContext* opCtx,
+                                             IndexInfo* indexInfo,
+                                             const KeyString::Value& keyString,
+                                             const RecordId& recordId) {
+    const auto sdi = indexInfo->accessMethod->asSortedData()->getSortedDataInterface();
+    auto sizeWithoutRecordId = [&](const KeyString::Value& ks) {
+        return KeyFormat::Long == sdi->rsKeyFormat()
+            ? KeyString::sizeWithoutRecordIdLongAtEnd(ks.getBuffer(), ks.getSize())
+            : KeyString::sizeWithoutRecordIdStrAtEnd(ks.getBuffer(), ks.getSize());
+    };
+
+    // Seek to the key without its RecordId, as unique indexes do not store it in the key, and
+    // check the entries with that key for the one pointing at 'recordId'.
+    KeyString::Builder keyBuilder(sdi->getKeyStringVersion());
+    keyBuilder.resetFromBuffer(keyString.getBuffer(), sizeWithoutRecordId(keyString));
+
+    const std::unique_ptr<SortedDataInterfaceThrottleCursor>& indexCursor =
+        _validateState->getIndexCursors().at(indexInfo->indexName);
+    for (auto indexEntry = indexCursor->seekForKeyString(opCtx, keyBuilder.getValueCopy());
+         indexEntry &&
+         KeyString::compare(indexEntry->keyString.getBuffer(),
+                            keyBuilder.getBuffer(),
+                            sizeWithoutRecordId(indexEntry->keyString),
+                            keyBuilder.getSize()) == 0;
+         indexEntry = indexCursor->nextKeyString(opCtx)) {
+        if (indexEntry->keyString.compare(keyString) == 0) {
+            return;
+        }
+    }
+
+    _indexConsistency->addMissingIndexEntry(opCtx, keyString, indexInfo, recordId);
+}
+
+void ValidateAdaptor::_checkIndexEntryHasRecord(OperationContext* opCtx,
+                                                const IndexCatalogEntry* index,
+                                                IndexInfo* indexInfo,
+                                                const KeyString::Value& keyString,
+                                                const RecordId& recordId) {
+    auto record = _validateState->getSeekRecordStoreCursor()->seekExact(opCtx, recordId);
+    if (record) {
+        // Corrupt records are reported by the traversal of the range that contains them.
+        if (!validateBSON(record->data.data(), record->data.size()).isOK()) {
+            return;
+        }
+
+        BSONObj recordBson = record->data.toBson();
+        if (index->descriptor()->isPartial() &&
+            !index->getFilterExpression()->matchesBSON(recordBson)) {
+            _indexConsistency->addExtraIndexEntry(opCtx, keyString, indexInfo, recordId);
+            return;
+        }
+
+        auto& executionCtx = StorageExecutionContext::get(opCtx);
+        SharedBufferFragmentBuilder pool(KeyString::HeapBuilder::kHeapAllocatorDefaultBytes);
+        auto documentKeySet = executionCtx.keys();
+        auto multikeyMetadataKeys = executionCtx.multikeyMetadataKeys();
+        auto documentMultikeyPaths = executionCtx.multikeyPaths();
+
+        index->accessMethod()->asSortedData()->getKeys(
+            opCtx,
+            _validateState->getCollection(),
+            pool,
+            recordBson,
+            InsertDeleteOptions::ConstraintEnforcementMode::kEnforceConstraints,
+            SortedDataIndexAccessMethod::GetKeysContext::kValidatingKeys,
+            documentKeySet.get(),
+            multikeyMetadataKeys.get(),
+            documentMultikeyPaths.get(),
+            recordId);
+
+        if (documentKeySet->count(keyString)) {
+            return;
+        }
+    }
+
+    _indexConsistency->addExtraIndexEntry(opCtx, keyString, indexInfo, recordId);
+}
+
 void ValidateAdaptor::traverseRecordStore(OperationContext* opCtx,
                                           ValidateResults* results,
                                           BSONObjBuilder* output) {
     _numRecords = 0;  // need to reset it because this function can be called more than once.
+    _lastTraversedRecordId = RecordId();
     long long dataSizeTotal = 0;
     long long interruptIntervalNumBytes = 0;
     long long nInvalid = 0;
@@ -513,9 +703,10 @@ void ValidateAdaptor::traverseRecordStore(OperationContext* opCtx,
     bool corruptRecordsSizeLimitWarning = false;
     const std::unique_ptr<SeekableRecordThrottleCursor>& traverseRecordStoreCursor =
         _validateState->getTraverseRecordStoreCursor();
+    const long long maxRecords = _validateState->getRange().maxRecords;
     for (auto record =
              traverseRecordStoreCursor->seekExact(opCtx, _validateState->getFirstRecordId());
-         record;
+         record && _validateState->isRecordIdInRange(record->id);
          record = traverseRecordStoreCursor->next(opCtx)) {
         _progress->hit();
         ++_numRecords;
@@ -596,6 +787,14 @@ void ValidateAdaptor::traverseRecordStore(OperationContext* opCtx,
         }
 
         prevRecordId = record->id;
+        _lastTraversedRecordId = record->id;
+
+        // A range-limited validation ends its range at the last record it has the budget to check.
+        if (maxRecords > 0 && _numRecords >= maxRecords &&
+            _validateState->getLastRecordId().isNull()) {
+            _validateState->setLastRecordId(record->id);
+            break;
+        }
 
         if (_numRecords % kInterruptIntervalNumRecords == 0 ||
             interruptIntervalNumBytes >= kInterruptIntervalNumBytes) {
@@ -624,8 +823,10 @@ void ValidateAdaptor::traverseRecordStore(OperationContext* opCtx,
     }
 
     // Do not update the record store stats if we're in the background as we've validated a
-    // checkpoint and it may not have the most up-to-date changes.
-    if (results->valid && !_validateState->isBackground()) {
+    // checkpoint and it may not have the most up-to-date changes, or if we have only validated a
+    // range of the collection.
+    if (results->valid && !_validateState->isBackground() &&
+        !_validateState->getRange().isLimited()) {
         _validateState->getCollection()->getRecordStore()->updateStatsAfterRepair(
             opCtx, _numRecords, dataSizeTotal);
     }
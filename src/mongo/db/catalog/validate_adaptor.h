@@ -36,6 +36,7 @@ namespace mongo {
 
 class IndexConsistency;
 class IndexDescriptor;
+struct IndexInfo;
 class OperationContext;
 
 /**
@@ -84,7 +85,44 @@ public:
                                const IndexCatalogEntry* index,
                                IndexValidateResults& results);
 
+    /**
+     * Returns the last record checked by traverseRecordStore(), or a null RecordId if it did not
+     * check any.
+     */
+    RecordId getLastTraversedRecordId() const {
+        return _lastTraversedRecordId;
+    }
+
 private:
+    /**
+     * Used instead of traverseIndex() by range-limited validations. Checks the entries of the index
+     * following its resume point, up to the range's record limit, against the records they point
+     * at.
+     */
+    void _traverseIndexRange(OperationContext* opCtx,
+                             const IndexCatalogEntry* index,
+                             int64_t* numTraversedKeys,
+                             ValidateResults* results);
+
+    /**
+     * Looks up the document key 'keyString' of the record 'recordId' in the index and records it as
+     * missing if it is not found.
+     */
+    void _checkIndexEntryExists(OperationContext* opCtx,
+                                IndexInfo* indexInfo,
+                                const KeyString::Value& keyString,
+                                const RecordId& recordId);
+
+    /**
+     * Records the index entry 'keyString' as extra if the record 'recordId' it points at does not
+     * exist or does not generate that key.
+     */
+    void _checkIndexEntryHasRecord(OperationContext* opCtx,
+                                   const IndexCatalogEntry* index,
+                                   IndexInfo* indexInfo,
+                                   const KeyString::Value& keyString,
+                                   const RecordId& recordId);
+
     IndexConsistency* _indexConsistency;
     CollectionValidation::ValidateState* _validateState;
 
@@ -92,6 +130,9 @@ private:
     // entries count. Reset every time traverseRecordStore() is called.
     long long _numRecords = 0;
 
+    // The last record checked by traverseRecordStore().
+    RecordId _lastTraversedRecordId;
+
     // For reporting progress during record store and index traversal.
     ProgressMeterHolder _progress;
 
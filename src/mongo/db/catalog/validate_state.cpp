@@ -54,10 +54,12 @@ ValidateState::ValidateState(OperationContext* opCtx,
                              const NamespaceString& nss,
                              ValidateMode mode,
                              RepairMode repairMode,
-                             bool turnOnExtraLoggingForTest)
+                             bool turnOnExtraLoggingForTest,
+                             const ValidateRange& range)
     : _nss(nss),
       _mode(mode),
       _repairMode(repairMode),
+      _range(range),
       _dataThrottle(opCtx),
       _extraLoggingForTest(turnOnExtraLoggingForTest) {
 
@@ -99,6 +101,21 @@ ValidateState::ValidateState(OperationContext* opCtx,
         invariant(!isBackground());
     }
 
+    // A range-limited validation only observes part of the collection, so it cannot repair or
+    // adjust metadata and cannot compare the record count against the fast count.
+    if (_range.isLimited()) {
+        invariant(_repairMode == RepairMode::kNone);
+        invariant(!isFullValidation() && !isFullIndexValidation() && !isMetadataValidation());
+    }
+
+    if (!_range.resumeAfter.isNull()) {
+        const bool expectLong = _collection->getRecordStore()->keyFormat() == KeyFormat::Long;
+        uassert(ErrorCodes::InvalidOptions,
+                str::stream() << "RecordId to resume validation after does not match the key "
+                              << "format of collection '" << _nss << "'",
+                expectLong ? _range.resumeAfter.isLong() : _range.resumeAfter.isStr());
+    }
+
     _uuid = _collection->uuid();
     _catalogGeneration = opCtx->getServiceContext()->getCatalogGeneration();
 }
@@ -262,7 +279,17 @@ void ValidateState::initializeCursors(OperationContext* opCtx) {
     // use cursor->next() to get subsequent Records. However, if the Record Store is empty,
     // there is no first record. In this case, we set the first Record Id to an invalid RecordId
     // (RecordId()), which will halt iteration at the initialization step.
-    const boost::optional<Record> record = _traverseRecordStoreCursor->next(opCtx);
+    //
+    // A range-limited validation instead starts at the first record after 'resumeAfter'.
+    boost::optional<Record> record;
+    if (_range.resumeAfter.isNull()) {
+        record = _traverseRecordStoreCursor->next(opCtx);
+    } else {
+        record = _traverseRecordStoreCursor->seekNear(opCtx, _range.resumeAfter);
+        if (record && record->id <= _range.resumeAfter) {
+            record = _traverseRecordStoreCursor->next(opCtx);
+        }
+    }
     _firstRecordId = record ? record->id : RecordId();
 }
 
@@ -63,7 +63,8 @@ public:
                   const NamespaceString& nss,
                   ValidateMode mode,
                   RepairMode repairMode,
-                  bool turnOnExtraLoggingForTest = false);
+                  bool turnOnExtraLoggingForTest = false,
+                  const ValidateRange& range = {});
 
     const NamespaceString& nss() const {
         return _nss;
@@ -143,6 +144,51 @@ public:
         return _firstRecordId;
     }
 
+    const ValidateRange& getRange() const {
+        return _range;
+    }
+
+    /**
+     * Returns the last RecordId checked by a range-limited validation that stopped before the end
+     * of the collection, or a null RecordId if the traversal reached the end of the collection.
+     */
+    RecordId getLastRecordId() const {
+        return _lastRecordId;
+    }
+
+    /**
+     * Ends the validated range at 'recordId'. Called once the record store traversal has checked
+     * 'getRange().maxRecords' records.
+     */
+    void setLastRecordId(const RecordId& recordId) {
+        invariant(_lastRecordId.isNull());
+        _lastRecordId = recordId;
+    }
+
+    /**
+     * Returns whether the record identified by 'recordId' belongs to the validated range.
+     */
+    bool isRecordIdInRange(const RecordId& recordId) const {
+        return (_range.resumeAfter.isNull() || recordId > _range.resumeAfter) &&
+            (_lastRecordId.isNull() || recordId <= _lastRecordId);
+    }
+
+    /**
+     * Ends the traversal of index 'indexName' at 'keyString'. Called once a range-limited
+     * validation has checked 'getRange().maxRecords' entries of the index.
+     */
+    void setIndexResumeAfter(const std::string& indexName, const KeyString::Value& keyString) {
+        _indexResumeAfter[indexName] = std::string(keyString.getBuffer(), keyString.getSize());
+    }
+
+    /**
+     * Returns the KeyString of the last entry checked of each index whose traversal stopped before
+     * the end of the index.
+     */
+    const std::map<std::string, std::string>& getIndexResumeAfter() const {
+        return _indexResumeAfter;
+    }
+
     /**
      * Yields locks for background validation; or cursors for foreground validation. Locks are
      * yielded to allow DDL ops to run concurrently with background validation. Cursors are yielded
@@ -237,6 +283,15 @@ private:
 
     RecordId _firstRecordId;
 
+    // The RecordIds to validate, and the last RecordId of the range once the traversal stopped
+    // early because 'maxRecords' was reached.
+    const ValidateRange _range;
+    RecordId _lastRecordId;
+
+    // The last entry checked of each index whose traversal stopped early because 'maxRecords' was
+    // reached.
+    std::map<std::string, std::string> _indexResumeAfter;
+
     DataThrottle _dataThrottle;
 
     // Used to detect when the catalog is re-opened while yielding locks.
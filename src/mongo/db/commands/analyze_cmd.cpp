@@ -0,0 +1,175 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/client/dbclient_cursor.h"
+#include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/commands.h"
+#include "mongo/db/commands/test_commands_enabled.h"
+#include "mongo/db/dbdirectclient.h"
+#include "mongo/db/pipeline/aggregate_command_gen.h"
+#include "mongo/db/query/ce/histogram.h"
+#include "mongo/db/query/ce/stats_catalog.h"
+#include "mongo/rpc/get_status_from_command_result.h"
+
+namespace mongo {
+namespace {
+
+constexpr size_t kDefaultNumberBuckets = 100;
+
+// Statistics are built over a random sample of at most this many documents by default, so that
+// memory use does not grow with the size of the collection.
+constexpr long long kDefaultSampleSize = 100'000;
+
+/**
+ * Returns the documents of a random sample of at most 'sampleSize' documents of 'nss', projected
+ * onto 'key'.
+ */
+std::vector<BSONObj> sampleDocuments(DBDirectClient& client,
+                                     const NamespaceString& nss,
+                                     StringData key,
+                                     long long sampleSize) {
+    BSONObjBuilder projection;
+    if (key != "_id"_sd && !key.startsWith("_id.")) {
+        projection.append("_id", 0);
+    }
+    projection.append(key, 1);
+
+    AggregateCommandRequest aggRequest(
+        nss,
+        {BSON("$sample" << BSON("size" << sampleSize)), BSON("$project" << projection.obj())});
+    auto cursor = uassertStatusOK(DBClientCursor::fromAggregationRequest(
+        &client, std::move(aggRequest), false /* secondaryOk */, false /* useExhaust */));
+
+    std::vector<BSONObj> docs;
+    while (cursor->more()) {
+        docs.push_back(cursor->nextSafe().getOwned());
+    }
+    return docs;
+}
+
+// Testing-only, enabled via command line.
+class CmdAnalyze : public BasicCommand {
+public:
+    CmdAnalyze() : BasicCommand("analyze") {}
+
+    AllowedOnSecondary secondaryAllowed(ServiceContext*) const override {
+        return AllowedOnSecondary::kNever;
+    }
+
+    bool supportsWriteConcern(const BSONObj& cmd) const override {
+        return false;
+    }
+
+    std::string help() const override {
+        return "internal. for testing only.\n"
+               "{ analyze : <collection>, key : <dotted path>, numberBuckets : <int>, "
+               "sampleSize : <int> }\n"
+               "Builds histograms over the values of 'key' in a random sample of the collection "
+               "and stores them in 'system.statistics.<collection>' for use by the histogram "
+               "cardinality estimator.";
+    }
+
+    // No auth needed because it only works when enabled via command line.
+    void addRequiredPrivileges(const std::string& dbname,
+                               const BSONObj& cmdObj,
+                               std::vector<Privilege>* out) const override {}
+
+    bool run(OperationContext* opCtx,
+             const std::string& dbname,
+             const BSONObj& cmdObj,
+             BSONObjBuilder& result) override {
+        const NamespaceString nss = CommandHelpers::parseNsCollectionRequired(dbname, cmdObj);
+
+        const BSONElement keyElem = cmdObj["key"];
+        uassert(ErrorCodes::BadValue,
+                "'key' must be a non-empty string",
+                keyElem.type() == BSONType::String && !keyElem.valueStringData().empty());
+        const std::string key = keyElem.str();
+
+        size_t numberBuckets = kDefaultNumberBuckets;
+        if (const BSONElement bucketsElem = cmdObj["numberBuckets"]; !bucketsElem.eoo()) {
+            uassert(ErrorCodes::BadValue,
+                    "'numberBuckets' must be a positive integer",
+                    bucketsElem.isNumber() && bucketsElem.safeNumberLong() > 0);
+            numberBuckets = bucketsElem.safeNumberLong();
+        }
+
+        long long sampleSize = kDefaultSampleSize;
+        if (const BSONElement sampleSizeElem = cmdObj["sampleSize"]; !sampleSizeElem.eoo()) {
+            uassert(ErrorCodes::BadValue,
+                    "'sampleSize' must be a positive integer",
+                    sampleSizeElem.isNumber() && sampleSizeElem.safeNumberLong() > 0);
+            sampleSize = sampleSizeElem.safeNumberLong();
+        }
+
+        auto getUUID = [&] {
+            auto uuid = CollectionCatalog::get(opCtx)->lookupUUIDByNSS(opCtx, nss);
+            uassert(ErrorCodes::NamespaceNotFound,
+                    str::stream() << "Collection " << nss << " does not exist",
+                    uuid);
+            return *uuid;
+        };
+        const UUID uuid = getUUID();
+
+        DBDirectClient client(opCtx);
+        const auto stats = ce::PathStatistics::make(
+            sampleDocuments(client, nss, key, sampleSize), key, numberBuckets);
+
+        uassert(ErrorCodes::NamespaceNotFound,
+                str::stream() << "Collection " << nss
+                              << " was dropped or renamed while it was being analyzed",
+                getUUID() == uuid);
+
+        BSONObjBuilder statsDoc;
+        statsDoc.append(ce::StatsCatalog::kPathField, key);
+        uuid.appendToBuilder(&statsDoc, ce::StatsCatalog::kCollectionUUIDField);
+        statsDoc.append(ce::StatsCatalog::kStatisticsField, stats.serialize());
+
+        const BSONObj reply = client.updateAcknowledged(nss.makeStatisticsNamespace().ns(),
+                                                        BSON(ce::StatsCatalog::kPathField << key),
+                                                        statsDoc.obj(),
+                                                        true /*upsert*/);
+        uassertStatusOK(getStatusFromWriteCommandReply(reply));
+
+        ce::StatsCatalog::get(opCtx).invalidate(nss);
+
+        result.append("documents", stats.getDocumentCount());
+        result.append("buckets",
+                      static_cast<long long>(stats.getScalarHistogram().getBuckets().size() +
+                                             stats.getArrayElementHistogram().getBuckets().size()));
+        return true;
+    }
+};
+
+MONGO_REGISTER_TEST_COMMAND(CmdAnalyze);
+
+}  // namespace
+}  // namespace mongo
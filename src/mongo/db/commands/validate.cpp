@@ -39,6 +39,7 @@
 #include "mongo/db/storage/record_store.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/hex.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
@@ -61,6 +62,50 @@ std::set<std::string> _validationsInProgress;
 // finishes on any namespace.
 stdx::condition_variable _validationNotifier;
 
+/**
+ * Parses the 'resumeAfter' option, which must be a RecordId token reported by an earlier
+ * range-limited validation: a number, or a non-empty string key as BinData or as a hex string.
+ */
+RecordId parseResumeAfter(const BSONElement& elem) {
+    auto isValidStrKeySize = [](size_t size) {
+        return size > 0 && size <= static_cast<size_t>(RecordId::kBigStrMaxSize);
+    };
+
+    bool isValid = elem.isNumber();
+    if (elem.type() == BinData) {
+        isValid = isValidStrKeySize(elem.valuestrsize());
+    } else if (elem.type() == String) {
+        isValid = hexblob::validate(elem.valueStringData()) &&
+            isValidStrKeySize(elem.valueStringData().size() / 2);
+    }
+    uassert(ErrorCodes::InvalidOptions,
+            str::stream() << "'resumeAfter' must be a RecordId reported by a previous validation, "
+                          << "found: " << elem,
+            isValid);
+    return RecordId::deserializeToken(elem);
+}
+
+/**
+ * Parses the 'indexResumeAfter' option, which must map index names to hex-encoded index keys, as
+ * reported by an earlier range-limited validation.
+ */
+std::map<std::string, std::string> parseIndexResumeAfter(const BSONElement& elem) {
+    uassert(ErrorCodes::InvalidOptions,
+            str::stream() << "'indexResumeAfter' must be an object, found: " << elem,
+            elem.type() == Object);
+
+    std::map<std::string, std::string> indexResumeAfter;
+    for (auto&& key : elem.Obj()) {
+        uassert(ErrorCodes::InvalidOptions,
+                str::stream() << "'indexResumeAfter' must map index names to index keys reported "
+                              << "by a previous validation, found: " << key,
+                key.type() == String && !key.valueStringData().empty() &&
+                    hexblob::validate(key.valueStringData()));
+        indexResumeAfter.emplace(key.fieldName(), hexblob::decode(key.valueStringData()));
+    }
+    return indexResumeAfter;
+}
+
 }  // namespace
 
 /**
@@ -69,6 +114,12 @@ stdx::condition_variable _validationNotifier;
  *       validate: "collectionNameWithoutTheDBPart",
  *       full: <bool>  // If true, a more thorough (and slower) collection validation is performed.
  *       background: <bool>  // If true, performs validation on the checkpoint of the collection.
+ *       resumeAfter: <RecordId>  // If set, only validates the records following this RecordId.
+ *       indexResumeAfter: <object>  // If set, only validates the entries of the listed indexes
+ *                                   // following the given keys.
+ *       maxRecords: <int>  // If set, stops after validating this many records and this many
+ *                          // entries per index, and reports the 'resumeAfter' RecordId and the
+ *                          // 'indexResumeAfter' keys for the next validation.
  *   }
  */
 class ValidateCmd : public BasicCommand {
@@ -85,6 +136,9 @@ public:
                              << "\tAdd {full: true} option to do a more thorough check.\n"
                              << "\tAdd {background: true} to validate in the background.\n"
                              << "\tAdd {repair: true} to run repair mode.\n"
+                             << "\tAdd {maxRecords: <n>} to validate at most n records, and\n"
+                             << "\t{resumeAfter: <recordId>, indexResumeAfter: <object>} to\n"
+                             << "\tcontinue a previous validation.\n"
                              << "Cannot specify both {full: true, background: true}.";
     }
 
@@ -179,6 +233,28 @@ public:
                                     << " supported with any other options");
         }
 
+        CollectionValidation::ValidateRange range;
+        if (auto resumeAfter = cmdObj["resumeAfter"]) {
+            range.resumeAfter = parseResumeAfter(resumeAfter);
+        }
+        if (auto indexResumeAfter = cmdObj["indexResumeAfter"]) {
+            range.indexResumeAfter = parseIndexResumeAfter(indexResumeAfter);
+        }
+        if (auto maxRecords = cmdObj["maxRecords"]) {
+            uassert(ErrorCodes::InvalidOptions,
+                    "'maxRecords' must be a positive number",
+                    maxRecords.isNumber() && maxRecords.safeNumberLong() > 0);
+            range.maxRecords = maxRecords.safeNumberLong();
+        }
+        if (range.isLimited() && (fullValidate || enforceFastCount || repair || metadata)) {
+            uasserted(ErrorCodes::InvalidOptions,
+                      str::stream() << "Running the validate command with { resumeAfter },"
+                                    << " { indexResumeAfter } or { maxRecords } is not"
+                                    << " supported with { full: true },"
+                                    << " { enforceFastCount: true }, { repair: true } or"
+                                    << " { metadata: true }");
+        }
+
         if (!serverGlobalParams.quiet.load()) {
             LOGV2(20514,
                   "CMD: validate",
@@ -186,7 +262,9 @@ public:
                   "background"_attr = background,
                   "full"_attr = fullValidate,
                   "enforceFastCount"_attr = enforceFastCount,
-                  "repair"_attr = repair);
+                  "repair"_attr = repair,
+                  "resumeAfter"_attr = range.resumeAfter,
+                  "maxRecords"_attr = range.maxRecords);
         }
 
         // Only one validation per collection can be in progress, the rest wait.
@@ -230,6 +308,10 @@ public:
                 // On read-only mode we can't make any adjustments.
                 return CollectionValidation::RepairMode::kNone;
             }
+            if (range.isLimited()) {
+                // Only part of the collection is observed, so no metadata can be adjusted.
+                return CollectionValidation::RepairMode::kNone;
+            }
             switch (mode) {
                 case CollectionValidation::ValidateMode::kForeground:
                 case CollectionValidation::ValidateMode::kForegroundFull:
@@ -255,8 +337,8 @@ public:
         }
 
         ValidateResults validateResults;
-        Status status =
-            CollectionValidation::validate(opCtx, nss, mode, repairMode, &validateResults, &result);
+        Status status = CollectionValidation::validate(
+            opCtx, nss, mode, repairMode, range, &validateResults, &result);
         if (!status.isOK()) {
             return CommandHelpers::appendCommandStatusNoThrow(result, status);
         }
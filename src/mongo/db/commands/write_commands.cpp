@@ -42,6 +42,7 @@
 #include "mongo/db/commands/write_commands_common.h"
 #include "mongo/db/curop.h"
 #include "mongo/db/db_raii.h"
+#include "mongo/db/dbdirectclient.h"
 #include "mongo/db/json.h"
 #include "mongo/db/matcher/doc_validation_error.h"
 #include "mongo/db/matcher/extensions_callback_real.h"
@@ -68,6 +69,7 @@
 #include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/timeseries/bucket_catalog.h"
 #include "mongo/db/timeseries/bucket_compression.h"
+#include "mongo/db/timeseries/catalog_helper.h"
 #include "mongo/db/timeseries/timeseries_constants.h"
 #include "mongo/db/timeseries/timeseries_stats.h"
 #include "mongo/db/transaction_participant.h"
@@ -968,6 +970,22 @@ public:
             TimeseriesStmtIds stmtIds;
             bool canContinue = true;
 
+            // Archived buckets are only looked up through an index on the metadata and control.min
+            // of the time field, as created for a {<metaField>: 1, <timeField>: 1} index on the
+            // time-series collection. Without one, no bucket is reopened, since every lookup would
+            // scan the whole buckets collection.
+            BucketCatalog::BucketFinder findBucket;
+            if (auto reopeningIndex = timeseries::getIndexForBucketReopening(opCtx, *bucketsColl)) {
+                findBucket = [&bucketsNs, hint = std::move(*reopeningIndex)](
+                                 OperationContext* opCtx, const BSONObj& filter) {
+                    FindCommandRequest findRequest{bucketsNs};
+                    findRequest.setFilter(filter);
+                    findRequest.setHint(hint);
+                    DBDirectClient client(opCtx);
+                    return client.findOne(std::move(findRequest));
+                };
+            }
+
             auto insert = [&](size_t index) {
                 invariant(start + index < request().getDocuments().size());
 
@@ -989,7 +1007,8 @@ public:
                     bucketsColl->getDefaultCollator(),
                     *bucketsColl->getTimeseriesOptions(),
                     request().getDocuments()[start + index],
-                    _canCombineTimeseriesInsertWithOtherClients(opCtx));
+                    _canCombineTimeseriesInsertWithOtherClients(opCtx),
+                    findBucket);
 
                 if (auto error = generateError(opCtx, result, start + index, errors->size())) {
                     errors->push_back(*error);
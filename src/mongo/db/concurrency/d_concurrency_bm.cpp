@@ -181,6 +181,40 @@ BENCHMARK_DEFINE_F(DConcurrencyTest, BM_CollectionExclusiveLock)(benchmark::Stat
     }
 }
 
+/**
+ * Acquires and releases the global, database and collection resources in 'mode' directly through
+ * the LockManager, which measures the intent lock fast path without the Locker bookkeeping.
+ */
+void runLockManagerIntentLocks(benchmark::State& state, Locker* locker, LockMode mode) {
+    static LockManager lockManager;
+    static const ResourceId resIdGlobal(RESOURCE_GLOBAL, static_cast<uint64_t>(1));
+    static const ResourceId resIdDb(RESOURCE_DATABASE, std::string("test"));
+    static const ResourceId resIdColl(RESOURCE_COLLECTION, std::string("test.coll"));
+
+    for (auto keepRunning : state) {
+        LockRequestCombo requestGlobal(locker);
+        LockRequestCombo requestDb(locker);
+        LockRequestCombo requestColl(locker);
+
+        invariant(lockManager.lock(resIdGlobal, &requestGlobal, mode) == LOCK_OK);
+        invariant(lockManager.lock(resIdDb, &requestDb, mode) == LOCK_OK);
+        invariant(lockManager.lock(resIdColl, &requestColl, mode) == LOCK_OK);
+
+        lockManager.unlock(&requestColl);
+        lockManager.unlock(&requestDb);
+        lockManager.unlock(&requestGlobal);
+    }
+}
+
+BENCHMARK_DEFINE_F(DConcurrencyTest, BM_LockManagerIntentSharedLock)(benchmark::State& state) {
+    runLockManagerIntentLocks(state, &locker[state.thread_index], MODE_IS);
+}
+
+BENCHMARK_DEFINE_F(DConcurrencyTest, BM_LockManagerIntentExclusiveLock)
+(benchmark::State& state) {
+    runLockManagerIntentLocks(state, &locker[state.thread_index], MODE_IX);
+}
+
 BENCHMARK_REGISTER_F(DConcurrencyTest, BM_StdMutex)->ThreadRange(1, kMaxPerfThreads);
 
 BENCHMARK_REGISTER_F(DConcurrencyTest, BM_ResourceMutexShared)->ThreadRange(1, kMaxPerfThreads);
@@ -191,6 +225,11 @@ BENCHMARK_REGISTER_F(DConcurrencyTest, BM_CollectionIntentSharedLock)
 BENCHMARK_REGISTER_F(DConcurrencyTest, BM_CollectionIntentExclusiveLock)
     ->ThreadRange(1, kMaxPerfThreads);
 
+BENCHMARK_REGISTER_F(DConcurrencyTest, BM_LockManagerIntentSharedLock)
+    ->ThreadRange(1, kMaxPerfThreads);
+BENCHMARK_REGISTER_F(DConcurrencyTest, BM_LockManagerIntentExclusiveLock)
+    ->ThreadRange(1, kMaxPerfThreads);
+
 BENCHMARK_REGISTER_F(DConcurrencyTest, BM_CollectionSharedLock)->ThreadRange(1, kMaxPerfThreads);
 BENCHMARK_REGISTER_F(DConcurrencyTest, BM_CollectionExclusiveLock)->ThreadRange(1, kMaxPerfThreads);
 
@@ -36,6 +36,10 @@
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
 #include "mongo/base/data_type_endian.h"
 #include "mongo/base/data_view.h"
 #include "mongo/base/static_assert.h"
@@ -46,6 +50,7 @@
 #include "mongo/db/concurrency/locker.h"
 #include "mongo/db/service_context.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/decorable.h"
 #include "mongo/util/str.h"
@@ -358,6 +363,7 @@ struct LockHead {
 struct PartitionedLockHead {
 
     void initNew(ResourceId resId) {
+        resourceId = resId;
         grantedList.reset();
     }
 
@@ -374,6 +380,9 @@ struct PartitionedLockHead {
     // of the queue. The PartitionedLockHead never contains anything but granted requests with
     // intent modes.
     LockRequestList grantedList;
+
+    // The id of the resource, used to validate hits in the partition's lock head cache
+    ResourceId resourceId;
 };
 
 void LockHead::migratePartitionedLockHeads() {
@@ -400,8 +409,7 @@ void LockHead::migratePartitionedLockHeads() {
                 LockResult res = newRequest(request);
                 invariant(res == LOCK_OK);  // Lock must still be granted
             }
-            partition->data.erase(it);
-            delete partitionedLock;
+            partition->erase(it);
         }
         // Don't pop-back to early as otherwise the lock will be considered not partitioned in
         // newRequest().
@@ -416,9 +424,20 @@ void LockHead::migratePartitionedLockHeads() {
 // Have more buckets than CPUs to reduce contention on lock and caches
 const unsigned LockManager::_numLockBuckets(128);
 
+namespace {
+
 // Balance scalability of intent locks against potential added cost of conflicting locks.
-// The exact value doesn't appear very important, but should be power of two
-const unsigned LockManager::_numPartitions = 32;
+// The exact value doesn't appear very important, but should be power of two. Intent lock
+// requests use the partition of the CPU they run on, so there must be at least one per CPU.
+unsigned computeNumPartitions() {
+    unsigned numPartitions = 32;
+    while (numPartitions < stdx::thread::hardware_concurrency()) {
+        numPartitions *= 2;
+    }
+    return numPartitions;
+}
+
+}  // namespace
 
 // static
 LockManager* LockManager::get(ServiceContext* service) {
@@ -462,7 +481,7 @@ std::map<LockerId, BSONObj> LockManager::getLockToClientMap(ServiceContext* serv
     return lockToClientMap;
 }
 
-LockManager::LockManager() {
+LockManager::LockManager() : _numPartitions(computeNumPartitions()) {
     _lockBuckets = new LockBucket[_numLockBuckets];
     _partitions = new Partition[_numPartitions];
 }
@@ -488,6 +507,7 @@ LockResult LockManager::lock(ResourceId resId, LockRequest* request, LockMode mo
 
     // For intent modes, try the PartitionedLockHead
     if (request->partitioned) {
+        request->partitionId = _getCurrentPartitionId(request);
         Partition* partition = _getPartition(request);
         stdx::lock_guard<SimpleMutex> scopedLock(partition->mutex);
         invariant(request->status == LockRequest::STATUS_NEW);
@@ -859,7 +879,17 @@ LockManager::LockBucket* LockManager::_getBucket(ResourceId resId) const {
 }
 
 LockManager::Partition* LockManager::_getPartition(LockRequest* request) const {
-    return &_partitions[request->locker->getId() % _numPartitions];
+    return &_partitions[request->partitionId];
+}
+
+unsigned LockManager::_getCurrentPartitionId(LockRequest* request) const {
+#if defined(__linux__)
+    int cpu = sched_getcpu();
+    if (cpu >= 0) {
+        return static_cast<unsigned>(cpu) & (_numPartitions - 1);
+    }
+#endif
+    return request->locker->getId() & (_numPartitions - 1);
 }
 
 void LockManager::dump() const {
@@ -930,8 +960,17 @@ void LockManager::_buildLocksArray(const std::map<LockerId, BSONObj>& lockToClie
 }
 
 PartitionedLockHead* LockManager::Partition::find(ResourceId resId) {
+    PartitionedLockHead*& cached = cache[static_cast<uint64_t>(resId) % kNumCachedLockHeads];
+    if (cached && cached->resourceId == resId) {
+        return cached;
+    }
+
     Map::iterator it = data.find(resId);
-    return it == data.end() ? nullptr : it->second;
+    if (it == data.end()) {
+        return nullptr;
+    }
+    cached = it->second;
+    return cached;
 }
 
 PartitionedLockHead* LockManager::Partition::findOrInsert(ResourceId resId) {
@@ -945,9 +984,19 @@ PartitionedLockHead* LockManager::Partition::findOrInsert(ResourceId resId) {
     } else {
         lock = it->second;
     }
+    cache[static_cast<uint64_t>(resId) % kNumCachedLockHeads] = lock;
     return lock;
 }
 
+void LockManager::Partition::erase(Map::iterator it) {
+    PartitionedLockHead*& cached = cache[static_cast<uint64_t>(it->first) % kNumCachedLockHeads];
+    if (cached == it->second) {
+        cached = nullptr;
+    }
+    delete it->second;
+    data.erase(it);
+}
+
 LockHead* LockManager::LockBucket::findOrInsert(ResourceId resId) {
     LockHead* lock;
     Map::iterator it = data.find(resId);
@@ -1004,6 +1053,7 @@ void LockRequest::initNew(Locker* locker, LockGrantNotification* notify) {
     next = nullptr;
     status = STATUS_NEW;
     partitioned = false;
+    partitionId = 0;
     mode = MODE_NONE;
     convertMode = MODE_NONE;
     unlockPending = 0;
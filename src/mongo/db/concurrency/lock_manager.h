@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <deque>
 #include <map>
@@ -42,6 +43,7 @@
 #include "mongo/platform/compiler.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
+#include "mongo/stdx/new.h"
 #include "mongo/stdx/unordered_map.h"
 #include "mongo/util/concurrency/mutex.h"
 
@@ -180,15 +182,30 @@ private:
         LockHead* findOrInsert(ResourceId resId);
     };
 
-    // Each locker maps to a partition that is used for resources acquired in intent modes
-    // modes and potentially other modes that don't conflict with themselves. This avoids
-    // contention on the regular LockHead in the lock manager.
-    struct Partition {
+    // Each request maps to a partition that is used for resources acquired in intent modes
+    // and potentially other modes that don't conflict with themselves. This avoids contention on
+    // the regular LockHead in the lock manager. Requests are assigned the partition of the CPU
+    // they are issued on, and partitions are cache line aligned, so that threads running on
+    // different CPUs do not share any state while taking intent locks on the same resource.
+    struct alignas(stdx::hardware_destructive_interference_size) Partition {
+        typedef stdx::unordered_map<ResourceId, PartitionedLockHead*> Map;
+
+        // Number of slots in the direct-mapped cache of partitioned lock heads. A handful of
+        // resources (global, database and collection) account for nearly all intent lock
+        // requests, so a small cache avoids most hash table lookups.
+        static constexpr size_t kNumCachedLockHeads = 16;
+
         PartitionedLockHead* find(ResourceId resId);
         PartitionedLockHead* findOrInsert(ResourceId resId);
-        typedef stdx::unordered_map<ResourceId, PartitionedLockHead*> Map;
+
+        /**
+         * Removes the entry at 'it' from the partition and deletes its lock head.
+         */
+        void erase(Map::iterator it);
+
         SimpleMutex mutex;
         Map data;
+        std::array<PartitionedLockHead*, kNumCachedLockHeads> cache{};
     };
 
     /**
@@ -203,6 +220,12 @@ private:
      */
     Partition* _getPartition(LockRequest* request) const;
 
+    /**
+     * Returns the index of the partition a new intent lock request from the current thread
+     * should use. This is the partition of the CPU the thread is running on, if known.
+     */
+    unsigned _getCurrentPartitionId(LockRequest* request) const;
+
     /**
      * The backend of `dump` and `getLockInfoBSON`.
      * If `mutableThis`, then we also clean the unused locks in the buckets while iterating.
@@ -235,7 +258,8 @@ private:
     static const unsigned _numLockBuckets;
     LockBucket* _lockBuckets;
 
-    static const unsigned _numPartitions;
+    // Power of two, and at least the number of CPUs on the machine.
+    const unsigned _numPartitions;
     Partition* _partitions;
 };
 }  // namespace mongo
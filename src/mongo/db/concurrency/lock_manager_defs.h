@@ -398,6 +398,15 @@ struct LockRequest {
     // No synchronization
     bool partitioned;
 
+    // Index of the LockManager partition used for this request, if it is partitioned. Chosen
+    // from the CPU the request was issued on, and kept so that the request is released from the
+    // same partition even if the thread has since migrated to another CPU.
+    //
+    // Written by LockManager on Locker thread
+    // Read by LockManager on Locker thread
+    // No synchronization
+    unsigned partitionId;
+
     // How many times has LockManager::lock been called for this request. Locks are released when
     // their recursive count drops to zero.
     //
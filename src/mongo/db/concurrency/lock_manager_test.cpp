@@ -952,4 +952,45 @@ TEST(LockManager, Fairness) {
     ASSERT(lockMgr.unlock(&requestIX1));
 }
 
+TEST(LockManager, PartitionedLockHeadsMigrateWithManyResources) {
+    LockManager lockMgr;
+
+    // Use more resources than there are cached lock heads per partition, so that some of them
+    // share a cache slot
+    const int kNumResources = 64;
+    std::vector<ResourceId> resIds;
+    for (int i = 0; i < kNumResources; i++) {
+        resIds.emplace_back(RESOURCE_COLLECTION, "TestDB.collection" + std::to_string(i));
+    }
+
+    LockerImpl lockerIS;
+    std::vector<std::unique_ptr<LockRequestCombo>> requestsIS;
+    for (const auto& resId : resIds) {
+        requestsIS.push_back(std::make_unique<LockRequestCombo>(&lockerIS));
+        ASSERT(LOCK_OK == lockMgr.lock(resId, requestsIS.back().get(), MODE_IS));
+    }
+
+    // A conflicting request migrates the partitioned lock heads and must wait for the intent locks
+    LockerImpl lockerX;
+    std::vector<std::unique_ptr<LockRequestCombo>> requestsX;
+    for (const auto& resId : resIds) {
+        requestsX.push_back(std::make_unique<LockRequestCombo>(&lockerX));
+        ASSERT(LOCK_WAITING == lockMgr.lock(resId, requestsX.back().get(), MODE_X));
+    }
+
+    for (int i = 0; i < kNumResources; i++) {
+        ASSERT(lockMgr.unlock(requestsIS[i].get()));
+        ASSERT_EQ(LOCK_OK, requestsX[i]->lastResult);
+        ASSERT_EQ(1, requestsX[i]->numNotifies);
+        ASSERT(lockMgr.unlock(requestsX[i].get()));
+    }
+
+    // Intent locks must be granted again once the conflicting requests are gone
+    for (int i = 0; i < kNumResources; i++) {
+        LockRequestCombo request(&lockerIS);
+        ASSERT(LOCK_OK == lockMgr.lock(resIds[i], &request, MODE_IX));
+        ASSERT(lockMgr.unlock(&request));
+    }
+}
+
 }  // namespace mongo
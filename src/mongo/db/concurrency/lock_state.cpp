@@ -385,9 +385,10 @@ bool LockerImpl::_acquireTicket(OperationContext* opCtx, LockMode mode, Date_t d
             invariant(!opCtx->recoveryUnit()->isTimestamped());
 
         OperationContext* interruptible = _uninterruptibleLocksRequested ? nullptr : opCtx;
+        const auto priority = getAdmissionPriority();
         if (deadline == Date_t::max()) {
-            holder->waitForTicket(interruptible);
-        } else if (!holder->waitForTicketUntil(interruptible, deadline)) {
+            holder->waitForTicket(interruptible, priority);
+        } else if (!holder->waitForTicketUntil(interruptible, deadline, priority)) {
             return false;
         }
         restoreStateOnErrorGuard.dismiss();
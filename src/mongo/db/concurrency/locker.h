@@ -37,6 +37,7 @@
 #include "mongo/db/concurrency/lock_stats.h"
 #include "mongo/db/operation_context.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/util/concurrency/admission_priority.h"
 
 namespace mongo {
 
@@ -523,6 +524,18 @@ public:
         return _shouldAcquireTicket;
     }
 
+    /**
+     * Sets the priority with which this locker queues for a ticket when no ticket is available.
+     * Takes effect the next time a ticket is acquired.
+     */
+    void setAdmissionPriority(AdmissionPriority priority) {
+        _admissionPriority = priority;
+    }
+
+    AdmissionPriority getAdmissionPriority() const {
+        return _admissionPriority;
+    }
+
     /**
      * Acquire a flow control admission ticket into the system. Flow control is used as a
      * backpressure mechanism to limit replication majority point lag.
@@ -572,6 +585,7 @@ private:
     bool _shouldConflictWithSecondaryBatchApplication = true;
     bool _shouldAllowLockAcquisitionOnTimestampedUnitOfWork = false;
     bool _shouldAcquireTicket = true;
+    AdmissionPriority _admissionPriority = AdmissionPriority::kNormal;
     std::string _debugInfo;  // Extra info about this locker for debugging purpose
 };
 
@@ -608,6 +622,29 @@ private:
     Locker* const _locker;
 };
 
+/**
+ * RAII-style class to set the priority with which an operation queues for tickets, restoring the
+ * previous priority when it goes out of scope.
+ */
+class ScopedAdmissionPriority {
+    ScopedAdmissionPriority(const ScopedAdmissionPriority&) = delete;
+    ScopedAdmissionPriority& operator=(const ScopedAdmissionPriority&) = delete;
+
+public:
+    ScopedAdmissionPriority(Locker* lockState, AdmissionPriority priority)
+        : _lockState(lockState), _originalPriority(_lockState->getAdmissionPriority()) {
+        _lockState->setAdmissionPriority(priority);
+    }
+
+    ~ScopedAdmissionPriority() {
+        _lockState->setAdmissionPriority(_originalPriority);
+    }
+
+private:
+    Locker* const _lockState;
+    const AdmissionPriority _originalPriority;
+};
+
 /**
  * RAII-style class to opt out of replication's use of the ParallelBatchWriterMode lock.
  */
@@ -0,0 +1,368 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/db/exec/bucket_block_filter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "mongo/db/exec/bucket_unpacker.h"
+#include "mongo/db/exec/document_value/document.h"
+#include "mongo/db/matcher/expression_leaf.h"
+#include "mongo/util/represent_as.h"
+#include "mongo/util/summation.h"
+
+namespace mongo {
+
+using bsoncolumn::NumericBlock;
+
+namespace {
+// 2^63, the smallest double which is larger than every 64-bit integer.
+constexpr double kInt64UpperBound = 9223372036854775808.0;
+
+// Field names of the partial results of $sum and $avg, as read by AccumulatorSum and AccumulatorAvg
+// in a merging $group.
+constexpr StringData kSubTotalName = "subTotal"_sd;
+constexpr StringData kSubTotalErrorName = "subTotalError"_sd;
+constexpr StringData kCountName = "count"_sd;
+
+boost::optional<BlockPredicate::Op> opForMatchType(MatchExpression::MatchType matchType) {
+    switch (matchType) {
+        case MatchExpression::EQ:
+            return BlockPredicate::Op::kEq;
+        case MatchExpression::LT:
+            return BlockPredicate::Op::kLt;
+        case MatchExpression::LTE:
+            return BlockPredicate::Op::kLte;
+        case MatchExpression::GT:
+            return BlockPredicate::Op::kGt;
+        case MatchExpression::GTE:
+            return BlockPredicate::Op::kGte;
+        default:
+            return boost::none;
+    }
+}
+
+void addBlockPredicate(const MatchExpression* expr,
+                       const BucketSpec& spec,
+                       std::vector<BlockPredicate>* predicates) {
+    auto op = opForMatchType(expr->matchType());
+    if (!op) {
+        return;
+    }
+
+    auto comparison = static_cast<const ComparisonMatchExpressionBase*>(expr);
+    auto path = comparison->path();
+    if (path.find('.') != std::string::npos || path == spec.timeField() ||
+        (spec.metaField() && path == *spec.metaField()) || spec.fieldIsComputed(path)) {
+        return;
+    }
+
+    const auto& rhs = comparison->getData();
+    BlockPredicate predicate{path.toString(), *op, 0.0, boost::none};
+    switch (rhs.type()) {
+        case NumberInt:
+        case NumberLong:
+            predicate.intValue = rhs.safeNumberLong();
+            predicate.doubleValue = rhs.numberDouble();
+            break;
+        case NumberDouble:
+            if (std::isnan(rhs._numberDouble())) {
+                return;
+            }
+            predicate.doubleValue = rhs._numberDouble();
+            predicate.intValue = representAs<int64_t>(predicate.doubleValue);
+            break;
+        default:
+            return;
+    }
+    predicates->push_back(std::move(predicate));
+}
+
+/**
+ * Clears 'selection' wherever 'keep' is false for the value or the value is missing. Written as a
+ * branch-free loop over contiguous storage so the compiler can vectorize it.
+ */
+template <typename T, typename Keep>
+void selectWhere(const std::vector<T>& values,
+                 const std::vector<uint8_t>& present,
+                 Keep keep,
+                 BlockSelection* selection) {
+    const T* v = values.data();
+    const uint8_t* p = present.data();
+    uint8_t* s = selection->data();
+    const size_t n = values.size();
+    for (size_t i = 0; i < n; ++i) {
+        s[i] &= p[i] & static_cast<uint8_t>(keep(v[i]));
+    }
+}
+
+template <typename T, typename Keep>
+void selectWithOp(const std::vector<T>& values,
+                  const std::vector<uint8_t>& present,
+                  BlockPredicate::Op op,
+                  T c,
+                  Keep keepAlso,
+                  BlockSelection* selection) {
+    switch (op) {
+        case BlockPredicate::Op::kEq:
+            selectWhere(values, present, [&](T v) { return (v == c) | keepAlso(v); }, selection);
+            break;
+        case BlockPredicate::Op::kLt:
+            selectWhere(values, present, [&](T v) { return (v < c) | keepAlso(v); }, selection);
+            break;
+        case BlockPredicate::Op::kLte:
+            selectWhere(values, present, [&](T v) { return (v <= c) | keepAlso(v); }, selection);
+            break;
+        case BlockPredicate::Op::kGt:
+            selectWhere(values, present, [&](T v) { return (v > c) | keepAlso(v); }, selection);
+            break;
+        case BlockPredicate::Op::kGte:
+            selectWhere(values, present, [&](T v) { return (v >= c) | keepAlso(v); }, selection);
+            break;
+    }
+}
+
+void applyToInts(const NumericBlock& block,
+                 const BlockPredicate& predicate,
+                 BlockSelection* selection) {
+    auto never = [](int64_t) { return false; };
+    if (predicate.intValue) {
+        selectWithOp(
+            block.ints, block.present, predicate.op, *predicate.intValue, never, selection);
+        return;
+    }
+
+    // The constant is not an integer, rewrite the comparison to an equivalent one against an
+    // integral bound.
+    const double c = predicate.doubleValue;
+    const bool lessThan =
+        predicate.op == BlockPredicate::Op::kLt || predicate.op == BlockPredicate::Op::kLte;
+    const bool greaterThan =
+        predicate.op == BlockPredicate::Op::kGt || predicate.op == BlockPredicate::Op::kGte;
+    if (c >= kInt64UpperBound || c < -kInt64UpperBound) {
+        // Every integer is on the same side of the constant.
+        const bool keep = c > 0 ? lessThan : greaterThan;
+        selectWhere(block.ints, block.present, [&](int64_t) { return keep; }, selection);
+    } else if (lessThan) {
+        auto bound = static_cast<int64_t>(std::floor(c));
+        selectWithOp(block.ints, block.present, BlockPredicate::Op::kLte, bound, never, selection);
+    } else if (greaterThan) {
+        auto bound = static_cast<int64_t>(std::ceil(c));
+        selectWithOp(block.ints, block.present, BlockPredicate::Op::kGte, bound, never, selection);
+    } else {
+        // No integer is equal to a non-integral constant.
+        selectWhere(block.ints, block.present, never, selection);
+    }
+}
+
+void applyToDoubles(const NumericBlock& block,
+                    const BlockPredicate& predicate,
+                    BlockSelection* selection) {
+    double c = predicate.doubleValue;
+    if (predicate.intValue) {
+        // Integral constants which can't be represented exactly as a double are left to the
+        // regular filter.
+        auto exact = representAs<double>(*predicate.intValue);
+        if (!exact) {
+            return;
+        }
+        c = *exact;
+    }
+    auto isNaN = [](double v) { return v != v; };
+    selectWithOp(block.doubles, block.present, predicate.op, c, isNaN, selection);
+}
+
+/**
+ * Folds 'reduce' over the values which are present and selected, substituting 'identity' for the
+ * others so the loop stays free of branches.
+ */
+template <typename T, typename Reduce>
+T reduceSelected(const std::vector<T>& values,
+                 const std::vector<uint8_t>& present,
+                 const BlockSelection& selection,
+                 T identity,
+                 Reduce reduce) {
+    T result = identity;
+    for (size_t i = 0; i < values.size(); ++i) {
+        result = reduce(result, (present[i] & (selection[i] != 0)) ? values[i] : identity);
+    }
+    return result;
+}
+
+long long countSelectedNaN(const NumericBlock& block, const BlockSelection& selection) {
+    long long count = 0;
+    for (size_t i = 0; i < block.doubles.size(); ++i) {
+        count += block.present[i] & (selection[i] != 0) & std::isnan(block.doubles[i]);
+    }
+    return count;
+}
+
+DoubleDoubleSummation sumSelected(const NumericBlock& block, const BlockSelection& selection) {
+    DoubleDoubleSummation sum;
+    for (size_t i = 0; i < block.size(); ++i) {
+        if (!block.present[i] || !selection[i]) {
+            continue;
+        }
+        if (block.kind == NumericBlock::Kind::kInt64) {
+            sum.addLong(block.ints[i]);
+        } else {
+            sum.addDouble(block.doubles[i]);
+        }
+    }
+    return sum;
+}
+
+Value integralValue(const NumericBlock& block, int64_t value) {
+    tassert(6610810,
+            "Integral values of a block must share a BSON type",
+            !block.hasInt32Values || !block.hasInt64Values);
+    return block.hasInt32Values ? Value(static_cast<int>(value))
+                                : Value(static_cast<long long>(value));
+}
+}  // namespace
+
+std::vector<BlockPredicate> extractBlockPredicates(const MatchExpression* expr,
+                                                   const BucketSpec& spec) {
+    std::vector<BlockPredicate> predicates;
+    if (expr->matchType() == MatchExpression::AND) {
+        for (size_t i = 0; i < expr->numChildren(); ++i) {
+            addBlockPredicate(expr->getChild(i), spec, &predicates);
+        }
+    } else {
+        addBlockPredicate(expr, spec, &predicates);
+    }
+    return predicates;
+}
+
+void applyBlockPredicate(const NumericBlock& block,
+                         const BlockPredicate& predicate,
+                         BlockSelection* selection) {
+    tassert(6610401,
+            "Block selection must have one entry per value",
+            selection->size() == block.size());
+    if (block.kind == NumericBlock::Kind::kInt64) {
+        applyToInts(block, predicate, selection);
+    } else {
+        applyToDoubles(block, predicate, selection);
+    }
+}
+
+long long blockCount(const NumericBlock& block, const BlockSelection& selection) {
+    long long count = 0;
+    for (size_t i = 0; i < block.size(); ++i) {
+        count += block.present[i] & (selection[i] != 0);
+    }
+    return count;
+}
+
+Value blockMin(const NumericBlock& block, const BlockSelection& selection) {
+    if (blockCount(block, selection) == 0) {
+        return Value();
+    }
+    if (block.kind == NumericBlock::Kind::kInt64) {
+        return integralValue(block,
+                             reduceSelected(block.ints,
+                                            block.present,
+                                            selection,
+                                            std::numeric_limits<int64_t>::max(),
+                                            [](int64_t a, int64_t b) { return std::min(a, b); }));
+    }
+    // NaN sorts before every other number.
+    if (countSelectedNaN(block, selection) > 0) {
+        return Value(std::numeric_limits<double>::quiet_NaN());
+    }
+    return Value(reduceSelected(block.doubles,
+                                block.present,
+                                selection,
+                                std::numeric_limits<double>::infinity(),
+                                [](double a, double b) { return std::min(a, b); }));
+}
+
+Value blockMax(const NumericBlock& block, const BlockSelection& selection) {
+    auto count = blockCount(block, selection);
+    if (count == 0) {
+        return Value();
+    }
+    if (block.kind == NumericBlock::Kind::kInt64) {
+        return integralValue(block,
+                             reduceSelected(block.ints,
+                                            block.present,
+                                            selection,
+                                            std::numeric_limits<int64_t>::min(),
+                                            [](int64_t a, int64_t b) { return std::max(a, b); }));
+    }
+    // NaN sorts before every other number so it is only the maximum when nothing else is selected.
+    if (countSelectedNaN(block, selection) == count) {
+        return Value(std::numeric_limits<double>::quiet_NaN());
+    }
+    return Value(reduceSelected(block.doubles,
+                                block.present,
+                                selection,
+                                -std::numeric_limits<double>::infinity(),
+                                [](double a, double b) { return b > a ? b : a; }));
+}
+
+Value blockSum(const NumericBlock& block, const BlockSelection& selection, bool toBeMerged) {
+    if (blockCount(block, selection) == 0) {
+        return Value(0);
+    }
+    auto sum = sumSelected(block, selection);
+    if (block.kind == NumericBlock::Kind::kDouble) {
+        return Value(sum.getDouble());
+    }
+    if (sum.fitsLong()) {
+        return block.hasInt64Values ? Value(sum.getLong()) : Value::createIntOrLong(sum.getLong());
+    }
+    if (toBeMerged) {
+        // Like AccumulatorSum, split a total which overflows a NumberLong into a double and the
+        // integral error which the double doesn't capture.
+        auto [total, error] = sum.getDoubleDouble();
+        return Value(Document{{kSubTotalName, total},
+                              {kSubTotalErrorName, static_cast<long long>(error)}});
+    }
+    return Value(sum.getDouble());
+}
+
+Value blockAvg(const NumericBlock& block, const BlockSelection& selection, bool toBeMerged) {
+    auto count = blockCount(block, selection);
+    auto sum = sumSelected(block, selection);
+    if (toBeMerged) {
+        auto [total, error] = sum.getDoubleDouble();
+        return Value(
+            Document{{kSubTotalName, total}, {kCountName, count}, {kSubTotalErrorName, error}});
+    }
+    if (count == 0) {
+        return Value(BSONNULL);
+    }
+    return Value(sum.getDouble() / static_cast<double>(count));
+}
+
+}  // namespace mongo
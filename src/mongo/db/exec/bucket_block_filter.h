@@ -0,0 +1,103 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mongo/bson/util/bsoncolumn_block.h"
+#include "mongo/db/exec/document_value/value.h"
+#include "mongo/db/matcher/expression.h"
+
+namespace mongo {
+
+class BucketSpec;
+
+/**
+ * One entry per measurement in a bucket, non-zero while the measurement may still pass a filter.
+ */
+using BlockSelection = std::vector<uint8_t>;
+
+/**
+ * A comparison between a top-level measurement field and a numeric constant, in a form that can be
+ * evaluated over a whole decoded column of a compressed bucket before any measurement is
+ * materialized.
+ */
+struct BlockPredicate {
+    enum class Op { kEq, kLt, kLte, kGt, kGte };
+
+    std::string field;
+    Op op;
+
+    // The constant as a double. NaN and Decimal128 constants are never turned into predicates.
+    double doubleValue;
+
+    // Set when the constant is integral and can be represented as a 64-bit integer.
+    boost::optional<int64_t> intValue;
+};
+
+/**
+ * Collects the comparisons which can be evaluated as BlockPredicates from 'expr', which is either a
+ * single comparison or a top-level $and. Comparisons on the time or meta field, on dotted paths and
+ * on fields computed from the metadata are ignored. Every returned predicate is implied by 'expr',
+ * so a measurement which fails one of them can't match 'expr'.
+ */
+std::vector<BlockPredicate> extractBlockPredicates(const MatchExpression* expr,
+                                                   const BucketSpec& spec);
+
+/**
+ * Clears the entries of 'selection' for the measurements whose value in 'block' fails 'predicate'.
+ * Missing values fail every predicate, NaN values are conservatively left selected. 'selection'
+ * must have one entry per value in 'block'.
+ */
+void applyBlockPredicate(const bsoncolumn::NumericBlock& block,
+                         const BlockPredicate& predicate,
+                         BlockSelection* selection);
+
+/**
+ * Aggregates over the values in 'block' which are both present and selected, with the semantics of
+ * the $min, $max, $sum and $avg accumulators over numeric input. $min and $max return a missing
+ * Value when no value qualifies, and require the integral values of 'block' to be either all
+ * NumberInt or all NumberLong. With 'toBeMerged', $sum and $avg return the partial result their
+ * accumulators produce for a merging $group.
+ */
+long long blockCount(const bsoncolumn::NumericBlock& block, const BlockSelection& selection);
+Value blockMin(const bsoncolumn::NumericBlock& block, const BlockSelection& selection);
+Value blockMax(const bsoncolumn::NumericBlock& block, const BlockSelection& selection);
+Value blockSum(const bsoncolumn::NumericBlock& block,
+               const BlockSelection& selection,
+               bool toBeMerged);
+Value blockAvg(const bsoncolumn::NumericBlock& block,
+               const BlockSelection& selection,
+               bool toBeMerged);
+
+}  // namespace mongo
@@ -0,0 +1,226 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <cmath>
+#include <limits>
+
+#include "mongo/bson/json.h"
+#include "mongo/db/exec/bucket_block_filter.h"
+#include "mongo/db/exec/bucket_unpacker.h"
+#include "mongo/db/exec/document_value/document_value_test_util.h"
+#include "mongo/db/matcher/expression_parser.h"
+#include "mongo/db/pipeline/expression_context_for_test.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/represent_as.h"
+
+namespace mongo {
+namespace {
+
+using bsoncolumn::NumericBlock;
+using Op = BlockPredicate::Op;
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+NumericBlock makeIntBlock(std::vector<boost::optional<int64_t>> values) {
+    NumericBlock block;
+    block.kind = NumericBlock::Kind::kInt64;
+    block.hasInt64Values = true;
+    for (auto&& value : values) {
+        block.ints.push_back(value.value_or(0));
+        block.present.push_back(value ? 1 : 0);
+    }
+    return block;
+}
+
+NumericBlock makeDoubleBlock(std::vector<boost::optional<double>> values) {
+    NumericBlock block;
+    block.kind = NumericBlock::Kind::kDouble;
+    for (auto&& value : values) {
+        block.doubles.push_back(value.value_or(0.0));
+        block.present.push_back(value ? 1 : 0);
+    }
+    return block;
+}
+
+BlockPredicate makePredicate(BlockPredicate::Op op, double c) {
+    return {"a", op, c, representAs<int64_t>(c)};
+}
+
+BlockSelection selectRows(const NumericBlock& block, const BlockPredicate& predicate) {
+    BlockSelection selection(block.size(), 1);
+    applyBlockPredicate(block, predicate, &selection);
+    return selection;
+}
+
+std::vector<BlockPredicate> extract(const BSONObj& filter) {
+    auto expCtx = make_intrusive<ExpressionContextForTest>();
+    auto expr = uassertStatusOK(MatchExpressionParser::parse(filter, expCtx));
+    BucketSpec spec{"time", std::string{"meta"}};
+    return extractBlockPredicates(expr.get(), spec);
+}
+
+TEST(BucketBlockFilterTest, IntComparisonsAgainstIntegralConstant) {
+    auto block = makeIntBlock({1, 5, boost::none, 7, -3});
+    ASSERT((selectRows(block, makePredicate(Op::kEq, 5)) == BlockSelection{0, 1, 0, 0, 0}));
+    ASSERT((selectRows(block, makePredicate(Op::kLt, 5)) == BlockSelection{1, 0, 0, 0, 1}));
+    ASSERT((selectRows(block, makePredicate(Op::kLte, 5)) == BlockSelection{1, 1, 0, 0, 1}));
+    ASSERT((selectRows(block, makePredicate(Op::kGt, 5)) == BlockSelection{0, 0, 0, 1, 0}));
+    ASSERT((selectRows(block, makePredicate(Op::kGte, 5)) == BlockSelection{0, 1, 0, 1, 0}));
+}
+
+TEST(BucketBlockFilterTest, IntComparisonsAgainstNonIntegralConstant) {
+    auto block = makeIntBlock({4, 5, 6});
+    ASSERT((selectRows(block, makePredicate(Op::kEq, 5.5)) == BlockSelection{0, 0, 0}));
+    ASSERT((selectRows(block, makePredicate(Op::kLt, 5.5)) == BlockSelection{1, 1, 0}));
+    ASSERT((selectRows(block, makePredicate(Op::kGte, 5.5)) == BlockSelection{0, 0, 1}));
+    ASSERT((selectRows(block, makePredicate(Op::kGt, -4.5)) == BlockSelection{1, 1, 1}));
+
+    auto inf = std::numeric_limits<double>::infinity();
+    ASSERT((selectRows(block, makePredicate(Op::kLt, inf)) == BlockSelection{1, 1, 1}));
+    ASSERT((selectRows(block, makePredicate(Op::kGt, inf)) == BlockSelection{0, 0, 0}));
+    ASSERT((selectRows(block, makePredicate(Op::kGt, -1e300)) == BlockSelection{1, 1, 1}));
+}
+
+TEST(BucketBlockFilterTest, DoubleComparisonsKeepNaN) {
+    auto block = makeDoubleBlock({1.5, kNaN, boost::none, 2.5});
+    ASSERT((selectRows(block, makePredicate(Op::kEq, 2.5)) == BlockSelection{0, 1, 0, 1}));
+    ASSERT((selectRows(block, makePredicate(Op::kLt, 2)) == BlockSelection{1, 1, 0, 0}));
+    ASSERT((selectRows(block, makePredicate(Op::kGte, 2)) == BlockSelection{0, 1, 0, 1}));
+}
+
+TEST(BucketBlockFilterTest, DoubleComparisonsSkipInexactIntegralConstant) {
+    auto block = makeDoubleBlock({1.0, 2.0});
+    BlockPredicate predicate{"a", Op::kEq, 0.0, (int64_t{1} << 53) + 1};
+    ASSERT((selectRows(block, predicate) == BlockSelection{1, 1}));
+}
+
+TEST(BucketBlockFilterTest, PredicatesAccumulateInSelection) {
+    auto block = makeIntBlock({1, 2, 3, 4, 5});
+    BlockSelection selection(block.size(), 1);
+    applyBlockPredicate(block, makePredicate(Op::kGt, 1), &selection);
+    applyBlockPredicate(block, makePredicate(Op::kLte, 4), &selection);
+    ASSERT((selection == BlockSelection{0, 1, 1, 1, 0}));
+}
+
+TEST(BucketBlockFilterTest, IntAggregates) {
+    auto block = makeIntBlock({3, boost::none, -2, 10, 7});
+    BlockSelection selection{1, 1, 1, 0, 1};
+    ASSERT_EQ(blockCount(block, selection), 3);
+    ASSERT_VALUE_EQ(blockMin(block, selection), Value(-2LL));
+    ASSERT_VALUE_EQ(blockMax(block, selection), Value(7LL));
+    ASSERT_VALUE_EQ(blockSum(block, selection, false), Value(8LL));
+    ASSERT_VALUE_EQ(blockAvg(block, selection, false), Value(8.0 / 3));
+}
+
+TEST(BucketBlockFilterTest, Int32AggregatesKeepTheirType) {
+    auto block = makeIntBlock({3, -2, std::numeric_limits<int32_t>::max()});
+    block.hasInt32Values = true;
+    block.hasInt64Values = false;
+    BlockSelection all{1, 1, 1};
+    ASSERT_EQ(blockMin(block, all).getType(), NumberInt);
+    ASSERT_EQ(blockMax(block, all).getType(), NumberInt);
+    ASSERT_VALUE_EQ(blockSum(block, BlockSelection{1, 1, 0}, false), Value(1));
+    ASSERT_EQ(blockSum(block, BlockSelection{1, 1, 0}, false).getType(), NumberInt);
+
+    // Like $sum, an int total which doesn't fit in a NumberInt becomes a NumberLong.
+    ASSERT_EQ(blockSum(block, BlockSelection{1, 0, 1}, false).getType(), NumberLong);
+}
+
+TEST(BucketBlockFilterTest, IntSumOverflowsToDouble) {
+    auto max = std::numeric_limits<int64_t>::max();
+    auto block = makeIntBlock({max, max});
+    auto sum = blockSum(block, BlockSelection{1, 1}, false);
+    ASSERT_EQ(sum.getType(), NumberDouble);
+    ASSERT_EQ(sum.getDouble(), 2.0 * max);
+}
+
+TEST(BucketBlockFilterTest, MergeableIntSumKeepsOverflowError) {
+    auto max = std::numeric_limits<int64_t>::max();
+    auto block = makeIntBlock({max, max, 1});
+    auto sum = blockSum(block, BlockSelection{1, 1, 1}, true);
+    ASSERT_EQ(sum.getType(), Object);
+    ASSERT_EQ(sum["subTotal"].getDouble(), 2.0 * max);
+    ASSERT_EQ(sum["subTotalError"].getType(), NumberLong);
+    ASSERT_EQ(sum["subTotalError"].getLong(), -1);
+}
+
+TEST(BucketBlockFilterTest, MergeableAvgIsSubTotalAndCount) {
+    auto block = makeDoubleBlock({1.5, boost::none, 4.0});
+    auto avg = blockAvg(block, BlockSelection{1, 1, 1}, true);
+    ASSERT_VALUE_EQ(avg,
+                    Value(Document{{"subTotal", 5.5}, {"count", 2LL}, {"subTotalError", 0.0}}));
+    ASSERT_VALUE_EQ(blockAvg(block, BlockSelection{1, 1, 1}, false), Value(2.75));
+}
+
+TEST(BucketBlockFilterTest, DoubleAggregatesHandleNaN) {
+    auto block = makeDoubleBlock({1.5, kNaN, 4.0});
+    BlockSelection all{1, 1, 1};
+    ASSERT(std::isnan(blockMin(block, all).getDouble()));
+    ASSERT_VALUE_EQ(blockMax(block, all), Value(4.0));
+    ASSERT_VALUE_EQ(blockSum(makeDoubleBlock({1.5, 4.0}), BlockSelection{1, 1}, false), Value(5.5));
+    ASSERT(std::isnan(blockMax(block, BlockSelection{0, 1, 0}).getDouble()));
+}
+
+TEST(BucketBlockFilterTest, AggregatesOverEmptySelection) {
+    auto block = makeIntBlock({1, 2});
+    BlockSelection none{0, 0};
+    ASSERT_EQ(blockCount(block, none), 0);
+    ASSERT(blockMin(block, none).missing());
+    ASSERT(blockMax(block, none).missing());
+    ASSERT_VALUE_EQ(blockSum(block, none, false), Value(0));
+    ASSERT_EQ(blockSum(makeDoubleBlock({1.5}), BlockSelection{0}, false).getType(), NumberInt);
+    ASSERT_VALUE_EQ(blockAvg(block, none, false), Value(BSONNULL));
+}
+
+TEST(BucketBlockFilterTest, ExtractsNumericComparisonsFromConjunction) {
+    auto predicates = extract(fromjson("{a: {$gt: 1, $lte: 2.5}, b: 3, c: 'str', 'd.e': 1}"));
+    ASSERT_EQ(predicates.size(), 3U);
+    ASSERT_EQ(predicates[0].field, "a");
+    ASSERT(predicates[0].op == Op::kGt);
+    ASSERT_EQ(*predicates[0].intValue, 1);
+    ASSERT_EQ(predicates[1].field, "a");
+    ASSERT(predicates[1].op == Op::kLte);
+    ASSERT_FALSE(predicates[1].intValue);
+    ASSERT_EQ(predicates[1].doubleValue, 2.5);
+    ASSERT_EQ(predicates[2].field, "b");
+    ASSERT(predicates[2].op == Op::kEq);
+}
+
+TEST(BucketBlockFilterTest, IgnoresTimeMetaAndNonConjunctivePredicates) {
+    ASSERT_EQ(extract(fromjson("{time: {$gt: 1}, meta: 1}")).size(), 0U);
+    ASSERT_EQ(extract(fromjson("{$or: [{a: 1}, {b: 1}]}")).size(), 0U);
+    ASSERT_EQ(extract(fromjson("{a: {$ne: 1}}")).size(), 0U);
+    ASSERT_EQ(extract(BSON("a" << std::numeric_limits<double>::quiet_NaN())).size(), 0U);
+    ASSERT_EQ(extract(BSON("a" << Decimal128(1))).size(), 0U);
+}
+
+}  // namespace
+}  // namespace mongo
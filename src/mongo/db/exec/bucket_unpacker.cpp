@@ -32,6 +32,7 @@
 #include <algorithm>
 
 #include "mongo/bson/util/bsoncolumn.h"
+#include "mongo/bson/util/bsoncolumn_block.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/expression_algo.h"
 #include "mongo/db/matcher/expression_expr.h"
@@ -682,6 +683,11 @@ public:
                          const Value& metaValue,
                          bool includeTimeField,
                          bool includeMetaField) = 0;
+
+    // Advances past the next measurement without materializing it. Returns whether there are more
+    // measurements, like 'getNext()'.
+    virtual bool skipNext() = 0;
+
     virtual void extractSingleMeasurement(MutableDocument& measurement,
                                           int j,
                                           const BucketSpec& spec,
@@ -734,6 +740,7 @@ public:
                  const Value& metaValue,
                  bool includeTimeField,
                  bool includeMetaField) override;
+    bool skipNext() override;
     void extractSingleMeasurement(MutableDocument& measurement,
                                   int j,
                                   const BucketSpec& spec,
@@ -820,6 +827,18 @@ bool BucketUnpackerV1::getNext(MutableDocument& measurement,
     return _timeFieldIter.more();
 }
 
+bool BucketUnpackerV1::skipNext() {
+    auto&& timeElem = _timeFieldIter.next();
+    auto& currentIdx = timeElem.fieldNameStringData();
+    for (auto&& [colName, colIter] : _fieldIters) {
+        if (auto&& elem = *colIter; colIter.more() && elem.fieldNameStringData() == currentIdx) {
+            colIter.advance(elem);
+        }
+    }
+
+    return _timeFieldIter.more();
+}
+
 void BucketUnpackerV1::extractSingleMeasurement(
     MutableDocument& measurement,
     int j,
@@ -868,6 +887,7 @@ public:
                  const Value& metaValue,
                  bool includeTimeField,
                  bool includeMetaField) override;
+    bool skipNext() override;
     void extractSingleMeasurement(MutableDocument& measurement,
                                   int j,
                                   const BucketSpec& spec,
@@ -948,6 +968,18 @@ bool BucketUnpackerV2::getNext(MutableDocument& measurement,
     return _timeColumn.it != _timeColumn.end;
 }
 
+bool BucketUnpackerV2::skipNext() {
+    ++_timeColumn.it;
+    for (auto& fieldColumn : _fieldColumns) {
+        uassert(6610402,
+                "Bucket unexpectedly contained fewer values than count",
+                fieldColumn.it != fieldColumn.end);
+        ++fieldColumn.it;
+    }
+
+    return _timeColumn.it != _timeColumn.end;
+}
+
 void BucketUnpackerV2::extractSingleMeasurement(
     MutableDocument& measurement,
     int j,
@@ -1106,6 +1138,8 @@ Document BucketUnpacker::getNext() {
     auto measurement = MutableDocument{2 * _unpackingImpl->numberOfFields()};
     _hasNext = _unpackingImpl->getNext(
         measurement, _spec, _metaValue, _includeTimeField, _includeMetaField);
+    ++_nextMeasurement;
+    skipUnselectedMeasurements();
 
     // Add computed meta projections.
     for (auto&& name : _spec.computedMetaProjFields()) {
@@ -1142,6 +1176,10 @@ Document BucketUnpacker::extractSingleMeasurement(int j) {
 
 void BucketUnpacker::reset(BSONObj&& bucket) {
     _unpackingImpl.reset();
+    _hasNext = false;
+    _numberOfMeasurements = 0;
+    _nextMeasurement = 0;
+    _selection.clear();
     _bucket = std::move(bucket);
     uassert(5346510, "An empty bucket cannot be unpacked", !_bucket.isEmpty());
 
@@ -1226,6 +1264,61 @@ void BucketUnpacker::reset(BSONObj&& bucket) {
     // Save the measurement count for the bucket.
     _numberOfMeasurements = _unpackingImpl->measurementCount(timeFieldElem);
     _hasNext = _numberOfMeasurements > 0;
+
+    // Only compressed buckets store their columns in a form which can be decoded as a block.
+    if (version == 2 && _hasNext && !_blockPredicates.empty()) {
+        evaluateBlockPredicates(dataRegion);
+        skipUnselectedMeasurements();
+    }
+}
+
+void BucketUnpacker::setBlockPredicates(std::vector<BlockPredicate> predicates) {
+    std::stable_sort(predicates.begin(), predicates.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.field < rhs.field;
+    });
+    _blockPredicates = std::move(predicates);
+}
+
+void BucketUnpacker::evaluateBlockPredicates(const BSONObj& dataRegion) {
+    _selection.assign(_numberOfMeasurements, 1);
+
+    // Predicates are sorted by field, so each column is decoded at most once.
+    StringData decodedField;
+    boost::optional<bsoncolumn::NumericBlock> block;
+    for (auto&& predicate : _blockPredicates) {
+        if (predicate.field != decodedField) {
+            decodedField = predicate.field;
+            block = boost::none;
+
+            auto column = dataRegion[predicate.field];
+            if (!column) {
+                // The field is missing from every measurement, so none of them can match.
+                std::fill(_selection.begin(), _selection.end(), 0);
+                break;
+            }
+            if (column.type() == BSONType::BinData &&
+                column.binDataType() == BinDataType::Column) {
+                block = bsoncolumn::decodeNumericBlock(column);
+            }
+        }
+
+        // Columns which can't be decoded as numbers are left to the caller's filter.
+        if (block && block->size() == _selection.size()) {
+            applyBlockPredicate(*block, predicate, &_selection);
+        }
+    }
+
+    if (std::none_of(_selection.begin(), _selection.end(), [](uint8_t s) { return s != 0; })) {
+        _hasNext = false;
+    }
+}
+
+void BucketUnpacker::skipUnselectedMeasurements() {
+    while (_hasNext && _nextMeasurement < static_cast<int32_t>(_selection.size()) &&
+           !_selection[_nextMeasurement]) {
+        _hasNext = _unpackingImpl->skipNext();
+        ++_nextMeasurement;
+    }
 }
 
 int BucketUnpacker::computeMeasurementCount(const BSONObj& bucket, StringData timeField) {
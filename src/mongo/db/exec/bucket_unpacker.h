@@ -34,6 +34,7 @@
 #include <set>
 
 #include "mongo/bson/bsonobj.h"
+#include "mongo/db/exec/bucket_block_filter.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/pipeline/expression_context.h"
@@ -280,6 +281,18 @@ public:
 
     void setBucketSpecAndBehavior(BucketSpec&& bucketSpec, Behavior behavior);
 
+    /**
+     * Sets predicates which are evaluated one column at a time when resetting to a compressed
+     * bucket, before any measurement is materialized. 'getNext()' skips the measurements which fail
+     * any of them. The predicates only serve to avoid unpacking measurements which can't match, the
+     * caller remains responsible for applying its full filter to the unpacked measurements.
+     */
+    void setBlockPredicates(std::vector<BlockPredicate> predicates);
+
+    const std::vector<BlockPredicate>& blockPredicates() const {
+        return _blockPredicates;
+    }
+
     // Add computed meta projection names to the bucket specification.
     void addComputedMetaProjFields(const std::vector<StringData>& computedFieldNames);
 
@@ -300,6 +313,13 @@ private:
     // Erase computed meta projection fields if they are present in the exclusion field set.
     void eraseExcludedComputedMetaProjFields();
 
+    // Evaluates '_blockPredicates' over the columns of the compressed bucket's data region and
+    // records the result in '_selection'.
+    void evaluateBlockPredicates(const BSONObj& dataRegion);
+
+    // Advances past the measurements rejected by '_selection', updating '_hasNext'.
+    void skipUnselectedMeasurements();
+
     BucketSpec _spec;
     Behavior _unpackerBehavior;
 
@@ -328,6 +348,16 @@ private:
     // The number of measurements in the bucket.
     int32_t _numberOfMeasurements = 0;
 
+    // Predicates evaluated per column of a compressed bucket, sorted by field name.
+    std::vector<BlockPredicate> _blockPredicates;
+
+    // Measurements of the current bucket which passed '_blockPredicates'. Empty when the
+    // predicates were not evaluated for this bucket, in which case every measurement is unpacked.
+    BlockSelection _selection;
+
+    // Index of the measurement the next call to 'getNext()' will materialize.
+    int32_t _nextMeasurement = 0;
+
     // Final list of fields to include/exclude during unpacking. This is computed once during the
     // first doGetNext call so we don't have to recalculate every time we reach a new bucket.
     boost::optional<std::set<std::string>> _unpackFieldsToIncludeExclude = boost::none;
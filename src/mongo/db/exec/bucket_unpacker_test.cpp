@@ -1052,5 +1052,62 @@ TEST_F(BucketUnpackerTest, TamperedCompressedElementMismatchTimeField) {
     ASSERT_FALSE(unpacker.hasNext());
 }
 
+TEST_F(BucketUnpackerTest, BlockPredicatesSkipMeasurementsInCompressedBucket) {
+    auto bucket = fromjson(
+        "{control: {'version': 1}, data: {time: {'0':1, '1':2, '2':3, '3':4}, "
+        "a:{'0':1, '1':5, '2':3, '3':8}, b:{'1':1, '3':2}}}");
+    auto compressedBucket =
+        timeseries::compressBucket(bucket, "time"_sd, {}, false).compressedBucket;
+
+    BucketUnpacker unpacker{BucketSpec{kUserDefinedTimeName.toString(), boost::none},
+                            BucketUnpacker::Behavior::kExclude};
+    unpacker.setBlockPredicates({{"a", BlockPredicate::Op::kGt, 4.0, 4}});
+    unpacker.reset(std::move(*compressedBucket));
+
+    ASSERT_EQ(unpacker.numberOfMeasurements(), 4);
+    ASSERT_TRUE(unpacker.hasNext());
+    assertGetNext(unpacker, Document{fromjson("{time: 2, a: 5, b: 1}")});
+    ASSERT_TRUE(unpacker.hasNext());
+    assertGetNext(unpacker, Document{fromjson("{time: 4, a: 8, b: 2}")});
+    ASSERT_FALSE(unpacker.hasNext());
+}
+
+TEST_F(BucketUnpackerTest, BlockPredicatesCanRejectWholeCompressedBucket) {
+    auto bucket = fromjson(
+        "{control: {'version': 1}, data: {time: {'0':1, '1':2}, a:{'0':1, '1':2}}}");
+    auto test = [&](std::vector<BlockPredicate> predicates) {
+        auto compressedBucket =
+            timeseries::compressBucket(bucket, "time"_sd, {}, false).compressedBucket;
+        BucketUnpacker unpacker{BucketSpec{kUserDefinedTimeName.toString(), boost::none},
+                                BucketUnpacker::Behavior::kExclude};
+        unpacker.setBlockPredicates(std::move(predicates));
+        unpacker.reset(std::move(*compressedBucket));
+        ASSERT_EQ(unpacker.numberOfMeasurements(), 2);
+        ASSERT_FALSE(unpacker.hasNext());
+    };
+
+    test({{"a", BlockPredicate::Op::kGte, 3.0, 3}});
+    test({{"a", BlockPredicate::Op::kGte, 2.0, 2}, {"a", BlockPredicate::Op::kLt, 2.0, 2}});
+    // No measurement has a value for 'c'.
+    test({{"c", BlockPredicate::Op::kLt, 2.0, 2}});
+}
+
+TEST_F(BucketUnpackerTest, BlockPredicatesAreIgnoredForUncompressedBucketsAndNonNumericColumns) {
+    auto bucket = fromjson(
+        "{control: {'version': 1}, data: {time: {'0':1, '1':2}, a:{'0':1, '1':'x'}}}");
+    auto test = [&](BSONObj bucket) {
+        BucketUnpacker unpacker{BucketSpec{kUserDefinedTimeName.toString(), boost::none},
+                                BucketUnpacker::Behavior::kExclude};
+        unpacker.setBlockPredicates({{"a", BlockPredicate::Op::kGt, 4.0, 4}});
+        unpacker.reset(std::move(bucket));
+        assertGetNext(unpacker, Document{fromjson("{time: 1, a: 1}")});
+        assertGetNext(unpacker, Document{fromjson("{time: 2, a: 'x'}")});
+        ASSERT_FALSE(unpacker.hasNext());
+    };
+
+    test(bucket);
+    test(*timeseries::compressBucket(bucket, "time"_sd, {}, false).compressedBucket);
+}
+
 }  // namespace
 }  // namespace mongo
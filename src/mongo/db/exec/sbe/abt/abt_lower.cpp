@@ -668,6 +668,7 @@ std::unique_ptr<sbe::PlanStage> SBENodeLowering::walk(const HashJoinNode& n,
                                           std::move(innerKeys),
                                           std::move(innerProjects),
                                           collatorSlot,
+                                          false /*allowDiskUse*/,
                                           planNodeId);
 }
 
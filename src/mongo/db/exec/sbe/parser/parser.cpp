@@ -1333,6 +1333,7 @@ void Parser::walkHashJoin(AstQuery& ast) {
                              lookupSlots(innerNode->nodes[0]->identifiers),  // inner conditions
                              lookupSlots(innerNode->nodes[1]->identifiers),  // inner projections
                              collatorSlot,                                   // collator
+                             false,                                          // allowDiskUse
                              getCurrentPlanNodeId());
 }
 
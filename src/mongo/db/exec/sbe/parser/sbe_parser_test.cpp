@@ -424,6 +424,7 @@ protected:
                                            sbe::makeSV(1, 2) /* inner conditions */,
                                            sbe::makeSV(5, 6) /* inner projections */,
                                            boost::none, /* optional collator slot */
+                                           false /* allowDiskUse */,
                                            planNodeId),
             // HJOIN with a collator slot.
             sbe::makeS<sbe::HashJoinStage>(sbe::makeS<sbe::CoScanStage>(planNodeId),
@@ -433,6 +434,7 @@ protected:
                                            sbe::makeSV(1, 2) /* inner conditions */,
                                            sbe::makeSV(5, 6) /* inner projections */,
                                            sbe::value::SlotId{7}, /* optional collator slot */
+                                           false /* allowDiskUse */,
                                            planNodeId),
             // FILTER
             sbe::makeS<sbe::FilterStage<false>>(
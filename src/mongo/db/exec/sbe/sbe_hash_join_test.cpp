@@ -37,6 +37,7 @@
 #include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
 #include "mongo/db/exec/sbe/stages/hash_join.h"
 #include "mongo/db/query/collation/collator_interface_mock.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo::sbe {
 
@@ -79,6 +80,7 @@ TEST_F(HashJoinStageTest, HashJoinCollationTest) {
                                      makeSV(innerCondSlot),
                                      makeSV(),
                                      boost::optional<value::SlotId>{useCollator, collatorSlot},
+                                     false /* allowDiskUse */,
                                      kEmptyPlanNodeId);
 
             return std::make_pair(makeSV(innerCondSlot, outerCondSlot), std::move(hashJoinStage));
@@ -137,4 +139,123 @@ TEST_F(HashJoinStageTest, HashJoinCollationTest) {
     }
 }
 
+TEST_F(HashJoinStageTest, HashJoinSpillTest) {
+    // Set the memory limit low enough that only a couple of rows fit in memory, so that the join
+    // has to spill and re-partition its spilled partitions.
+    const auto defaultMemoryLimit =
+        internalQuerySBEHashJoinApproxMemoryUseInBytesBeforeSpill.load();
+    const auto defaultNumPartitions = internalQuerySBEHashJoinNumPartitions.load();
+    internalQuerySBEHashJoinApproxMemoryUseInBytesBeforeSpill.store(128);
+    internalQuerySBEHashJoinNumPartitions.store(4);
+    ON_BLOCK_EXIT([&] {
+        internalQuerySBEHashJoinApproxMemoryUseInBytesBeforeSpill.store(defaultMemoryLimit);
+        internalQuerySBEHashJoinNumPartitions.store(defaultNumPartitions);
+    });
+
+    // The outer side holds 0..19 plus a second copy of 0..9. The inner side holds 0..29 plus a
+    // second copy of 5, so values 20..29 have no match.
+    BSONArrayBuilder outerBab;
+    std::multiset<int> outerValues;
+    for (int i = 0; i < 30; ++i) {
+        outerBab.append(i % 20);
+        outerValues.insert(i % 20);
+    }
+    BSONArrayBuilder innerBab;
+    std::vector<int> innerValues;
+    for (int i = 0; i < 30; ++i) {
+        innerBab.append(i);
+        innerValues.push_back(i);
+    }
+    innerBab.append(5);
+    innerValues.push_back(5);
+
+    std::multiset<std::pair<int, int>> expected;
+    for (auto inner : innerValues) {
+        for (size_t i = 0; i < outerValues.count(inner); ++i) {
+            expected.emplace(inner, inner);
+        }
+    }
+
+    auto ctx = makeCompileCtx();
+
+    auto [outerTag, outerVal] = stage_builder::makeValue(outerBab.arr());
+    auto [outerCondSlot, outerStage] = generateVirtualScan(outerTag, outerVal);
+    auto [innerTag, innerVal] = stage_builder::makeValue(innerBab.arr());
+    auto [innerCondSlot, innerStage] = generateVirtualScan(innerTag, innerVal);
+
+    auto stage = makeS<HashJoinStage>(std::move(outerStage),
+                                      std::move(innerStage),
+                                      makeSV(outerCondSlot),
+                                      makeSV(),
+                                      makeSV(innerCondSlot),
+                                      makeSV(),
+                                      boost::none,
+                                      true /* allowDiskUse */,
+                                      kEmptyPlanNodeId);
+
+    auto resultAccessors =
+        prepareTree(ctx.get(), stage.get(), makeSV(innerCondSlot, outerCondSlot));
+
+    std::multiset<std::pair<int, int>> results;
+    while (stage->getNext() == PlanState::ADVANCED) {
+        auto [innerResTag, innerResVal] = resultAccessors[0]->getViewOfValue();
+        auto [outerResTag, outerResVal] = resultAccessors[1]->getViewOfValue();
+        ASSERT_EQ(value::TypeTags::NumberInt32, innerResTag);
+        ASSERT_EQ(value::TypeTags::NumberInt32, outerResTag);
+        results.emplace(value::bitcastTo<int32_t>(innerResVal),
+                        value::bitcastTo<int32_t>(outerResVal));
+    }
+    ASSERT(expected == results);
+
+    auto stats = static_cast<const HashJoinStats*>(stage->getSpecificStats());
+    ASSERT_TRUE(stats->usedDisk);
+    ASSERT_GT(stats->spilledPartitions, 0);
+    ASSERT_GT(stats->spilledBuildRecords, 0);
+    ASSERT_GT(stats->spilledProbeRecords, 0);
+    ASSERT_GT(stats->maxRecursionDepth, 0);
+
+    stage->close();
+}
+
+TEST_F(HashJoinStageTest, HashJoinNoSpillWithoutAllowDiskUse) {
+    const auto defaultMemoryLimit =
+        internalQuerySBEHashJoinApproxMemoryUseInBytesBeforeSpill.load();
+    internalQuerySBEHashJoinApproxMemoryUseInBytesBeforeSpill.store(1);
+    ON_BLOCK_EXIT([&] {
+        internalQuerySBEHashJoinApproxMemoryUseInBytesBeforeSpill.store(defaultMemoryLimit);
+    });
+
+    auto ctx = makeCompileCtx();
+
+    auto [outerTag, outerVal] = stage_builder::makeValue(BSON_ARRAY(1 << 2 << 3));
+    auto [outerCondSlot, outerStage] = generateVirtualScan(outerTag, outerVal);
+    auto [innerTag, innerVal] = stage_builder::makeValue(BSON_ARRAY(2 << 3 << 4));
+    auto [innerCondSlot, innerStage] = generateVirtualScan(innerTag, innerVal);
+
+    auto stage = makeS<HashJoinStage>(std::move(outerStage),
+                                      std::move(innerStage),
+                                      makeSV(outerCondSlot),
+                                      makeSV(),
+                                      makeSV(innerCondSlot),
+                                      makeSV(),
+                                      boost::none,
+                                      false /* allowDiskUse */,
+                                      kEmptyPlanNodeId);
+
+    auto resultAccessor = prepareTree(ctx.get(), stage.get(), outerCondSlot);
+
+    std::set<int32_t> results;
+    while (stage->getNext() == PlanState::ADVANCED) {
+        auto [tag, val] = resultAccessor->getViewOfValue();
+        ASSERT_EQ(value::TypeTags::NumberInt32, tag);
+        results.insert(value::bitcastTo<int32_t>(val));
+    }
+    ASSERT(results == std::set<int32_t>({2, 3}));
+
+    auto stats = static_cast<const HashJoinStats*>(stage->getSpecificStats());
+    ASSERT_FALSE(stats->usedDisk);
+
+    stage->close();
+}
+
 }  // namespace mongo::sbe
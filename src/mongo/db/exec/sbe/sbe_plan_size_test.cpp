@@ -156,6 +156,7 @@ TEST_F(PlanSizeTest, HashJoin) {
                                       mockSV(),
                                       makeSV(),
                                       generateSlotId(),
+                                      false /* allowDiskUse */,
                                       kEmptyPlanNodeId);
     assertPlanSize(*stage);
 }
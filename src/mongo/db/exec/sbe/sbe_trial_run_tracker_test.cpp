@@ -166,6 +166,52 @@ TEST_F(TrialRunTrackerTest, TrialEndsDuringOpenPhaseOfBlockingStage) {
                        ErrorCodes::QueryTrialRunCompleted);
 }
 
+TEST_F(TrialRunTrackerTest, RaisingMaximumFromCallbackLetsTrialContinue) {
+    auto ctx = makeCompileCtx();
+
+    // Build a mock scan that will provide 9 values to its parent HashAggStage. The test
+    // TrialRunTracker starts with a 'numResults' limit of 4, which its callback raises to 6 and
+    // then leaves in place, so we expect the trial to end at the 7th value.
+    auto [inputTag, inputVal] =
+        stage_builder::makeValue(BSON_ARRAY(1 << 2 << 3 << 4 << 5 << 6 << 7 << 8 << 9));
+    auto [scanSlot, scanStage] = generateVirtualScan(inputTag, inputVal);
+
+    auto countsSlot = generateSlotId();
+    auto hashAggStage = makeS<HashAggStage>(
+        std::move(scanStage),
+        makeSV(scanSlot),
+        makeEM(countsSlot,
+               stage_builder::makeFunction(
+                   "sum",
+                   makeE<EConstant>(value::TypeTags::NumberInt64, value::bitcastFrom<int64_t>(1)))),
+        makeSV(),  // Seek slot
+        true,
+        boost::none,
+        false /* allowDiskUse */,
+        kEmptyPlanNodeId);
+
+    size_t numCallbacks = 0;
+    std::unique_ptr<TrialRunTracker> tracker;
+    tracker = std::make_unique<TrialRunTracker>(
+        [&](TrialRunTracker::TrialRunMetric metric) {
+            ASSERT_EQ(metric, TrialRunTracker::kNumResults);
+            if (++numCallbacks == 1) {
+                tracker->setMaxMetric<TrialRunTracker::kNumResults>(6);
+                return false;
+            }
+            return true;
+        },
+        size_t{4},
+        size_t{0});
+    hashAggStage->attachToTrialRunTracker(tracker.get());
+
+    ASSERT_THROWS_CODE(prepareTree(ctx.get(), hashAggStage.get(), countsSlot),
+                       DBException,
+                       ErrorCodes::QueryTrialRunCompleted);
+    ASSERT_EQ(numCallbacks, 2U);
+    ASSERT_EQ(tracker->getMetric<TrialRunTracker::kNumResults>(), 7U);
+}
+
 TEST_F(TrialRunTrackerTest, OnlyDeepestNestedBlockingStageHasTrialRunTracker) {
     auto ctx = makeCompileCtx();
 
@@ -33,6 +33,8 @@
 
 #include "mongo/db/exec/sbe/expressions/expression.h"
 #include "mongo/db/exec/sbe/size_estimator.h"
+#include "mongo/db/storage/storage_engine.h"
+#include "mongo/db/storage/write_unit_of_work.h"
 #include "mongo/util/str.h"
 
 namespace mongo {
@@ -44,6 +46,7 @@ HashJoinStage::HashJoinStage(std::unique_ptr<PlanStage> outer,
                              value::SlotVector innerCond,
                              value::SlotVector innerProjects,
                              boost::optional<value::SlotId> collatorSlot,
+                             bool allowDiskUse,
                              PlanNodeId planNodeId)
     : PlanStage("hj"_sd, planNodeId),
       _outerCond(std::move(outerCond)),
@@ -51,7 +54,8 @@ HashJoinStage::HashJoinStage(std::unique_ptr<PlanStage> outer,
       _innerCond(std::move(innerCond)),
       _innerProjects(std::move(innerProjects)),
       _collatorSlot(collatorSlot),
-      _probeKey(0) {
+      _probeKey(0),
+      _allowDiskUse(allowDiskUse) {
     if (_outerCond.size() != _innerCond.size()) {
         uasserted(4822823, "left and right size do not match");
     }
@@ -68,9 +72,41 @@ std::unique_ptr<PlanStage> HashJoinStage::clone() const {
                                            _innerCond,
                                            _innerProjects,
                                            _collatorSlot,
+                                           _allowDiskUse,
                                            _commonStats.nodeId);
 }
 
+void HashJoinStage::doSaveState(bool relinquishCursor) {
+    if (relinquishCursor) {
+        if (_probeCursor) {
+            _probeCursor->save();
+        }
+    }
+    if (_probeCursor) {
+        _probeCursor->setSaveStorageCursorOnDetachFromOperationContext(!relinquishCursor);
+    }
+}
+
+void HashJoinStage::doRestoreState(bool relinquishCursor) {
+    invariant(_opCtx);
+    if (_probeCursor && relinquishCursor) {
+        auto couldRestore = _probeCursor->restore();
+        uassert(6610200, "HashJoinStage could not restore cursor", couldRestore);
+    }
+}
+
+void HashJoinStage::doDetachFromOperationContext() {
+    if (_probeCursor) {
+        _probeCursor->detachFromOperationContext();
+    }
+}
+
+void HashJoinStage::doAttachToOperationContext(OperationContext* opCtx) {
+    if (_probeCursor) {
+        _probeCursor->reattachToOperationContext(opCtx);
+    }
+}
+
 void HashJoinStage::prepare(CompileCtx& ctx) {
     _children[0]->prepare(ctx);
     _children[1]->prepare(ctx);
@@ -99,7 +135,29 @@ void HashJoinStage::prepare(CompileCtx& ctx) {
         uassert(4822825, str::stream() << "duplicate field: " << slot, inserted);
 
         _inInnerKeyAccessors.emplace_back(_children[1]->getAccessor(ctx, slot));
+        _spilledProbeKeyAccessors.emplace_back(
+            std::make_unique<value::MaterializedSingleRowAccessor>(_spilledProbeKey, counter++));
+        _outInnerKeyAccessors.emplace_back(
+            std::make_unique<value::SwitchAccessor>(std::vector<value::SlotAccessor*>{
+                _inInnerKeyAccessors.back(), _spilledProbeKeyAccessors.back().get()}));
+        _outInnerAccessors[slot] = _outInnerKeyAccessors.back().get();
+    }
+
+    counter = 0;
+    for (auto& slot : _innerProjects) {
+        // Inner projections may overlap with the inner conditions, the same value is then read
+        // through either accessor.
+        _inInnerProjectAccessors.emplace_back(_children[1]->getAccessor(ctx, slot));
+        _spilledProbeProjectAccessors.emplace_back(
+            std::make_unique<value::MaterializedSingleRowAccessor>(_spilledProbeProject,
+                                                                   counter++));
+        _outInnerProjectAccessors.emplace_back(
+            std::make_unique<value::SwitchAccessor>(std::vector<value::SlotAccessor*>{
+                _inInnerProjectAccessors.back(), _spilledProbeProjectAccessors.back().get()}));
+        _outInnerAccessors.emplace(slot, _outInnerProjectAccessors.back().get());
     }
+    _spilledProbeKey.resize(_innerCond.size());
+    _spilledProbeProject.resize(_innerProjects.size());
 
     counter = 0;
     for (auto& slot : _outerProjects) {
@@ -123,15 +181,61 @@ value::SlotAccessor* HashJoinStage::getAccessor(CompileCtx& ctx, value::SlotId s
             return it->second;
         }
 
+        if (auto it = _outInnerAccessors.find(slot); it != _outInnerAccessors.end()) {
+            return it->second;
+        }
+
         return _children[1]->getAccessor(ctx, slot);
     }
 
     return ctx.getAccessor(slot);
 }
 
-void HashJoinStage::open(bool reOpen) {
-    auto optTimer(getOptTimer(_opCtx));
+namespace {
+// Proactively assert that this operation can safely write before hitting an assertion in the
+// storage engine. We can safely write if we are enforcing prepare conflicts by blocking or if we
+// are ignoring prepare conflicts and explicitly allowing writes. Ignoring prepare conflicts
+// without allowing writes will cause this operation to fail in the storage engine.
+void assertIgnorePrepareConflictsBehavior(OperationContext* opCtx) {
+    tassert(6610201,
+            "The operation must be ignoring conflicts and allowing writes or enforcing prepare "
+            "conflicts entirely",
+            opCtx->recoveryUnit()->getPrepareConflictBehavior() !=
+                PrepareConflictBehavior::kIgnoreConflicts);
+}
+
+std::unique_ptr<TemporaryRecordStore> makeTemporaryRecordStore(OperationContext* opCtx) {
+    tassert(6610202,
+            "No storage engine so HashJoinStage cannot spill to disk",
+            opCtx->getServiceContext()->getStorageEngine());
+    assertIgnorePrepareConflictsBehavior(opCtx);
+    return opCtx->getServiceContext()->getStorageEngine()->makeTemporaryRecordStore(
+        opCtx, KeyFormat::Long);
+}
+
+/**
+ * Mixes the partitioning depth into the hash of the join key, so that the rows of a partition
+ * which is re-partitioned are spread over all the partitions of the next level.
+ */
+size_t partitionHash(size_t hash, size_t depth) {
+    uint64_t x = hash ^ (0x9E3779B97F4A7C15ULL * (depth + 1));
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ULL;
+    x ^= x >> 33;
+    return x;
+}
 
+std::pair<value::MaterializedRow, value::MaterializedRow> readSpilledRow(const Record& record) {
+    BufReader reader(record.data.data(), record.data.size());
+    auto key = value::MaterializedRow::deserializeForSorter(reader, {});
+    auto project = value::MaterializedRow::deserializeForSorter(reader, {});
+    return {std::move(key), std::move(project)};
+}
+}  // namespace
+
+void HashJoinStage::makeHashTable() {
     if (_collatorAccessor) {
         auto [tag, collatorVal] = _collatorAccessor->getViewOfValue();
         uassert(5402504, "collatorSlot must be of collator type", tag == value::TypeTags::collator);
@@ -142,6 +246,132 @@ void HashJoinStage::open(bool reOpen) {
     } else {
         _ht.emplace();
     }
+    _htMemUsage = 0;
+    _htIt = _ht->end();
+    _htItEnd = _ht->end();
+}
+
+size_t HashJoinStage::getPartition(const value::MaterializedRow& key) const {
+    return partitionHash(_ht->hash_function()(key), _depth) % _partitions.size();
+}
+
+void HashJoinStage::insertBuildRow(value::MaterializedRow key, value::MaterializedRow project) {
+    const long long rowSize = key.memUsageForSorter() + project.memUsageForSorter();
+    if (!_partitions.empty()) {
+        auto& partition = _partitions[getPartition(key)];
+        if (partition.isSpilled()) {
+            spillRow(partition.buildRows.get(), ++partition.numBuildRows, key, project);
+            _specificStats.spilledBuildRecords++;
+            return;
+        }
+        partition.memUsage += rowSize;
+    }
+
+    _ht->emplace(std::move(key), std::move(project));
+    _htMemUsage += rowSize;
+    if (_htMemUsage > _approxMemoryUseInBytesBeforeSpill) {
+        spillIfNecessary();
+    }
+}
+
+void HashJoinStage::spillIfNecessary() {
+    // Re-partitioning cannot split rows which share the same join key, so past the maximum depth
+    // the remaining rows are joined in memory.
+    if (!_allowDiskUse || _depth > _maxRecursionDepth) {
+        return;
+    }
+
+    if (_partitions.empty()) {
+        _partitions.resize(_numPartitions);
+        for (auto& partition : _partitions) {
+            partition.depth = _depth;
+        }
+        for (auto& [key, project] : *_ht) {
+            _partitions[getPartition(key)].memUsage +=
+                key.memUsageForSorter() + project.memUsageForSorter();
+        }
+        _specificStats.usedDisk = true;
+        _specificStats.maxRecursionDepth =
+            std::max<long long>(_specificStats.maxRecursionDepth, _depth);
+    }
+
+    // Spill the largest resident partitions until the rest fits in memory.
+    while (_htMemUsage > _approxMemoryUseInBytesBeforeSpill) {
+        boost::optional<size_t> largest;
+        for (size_t idx = 0; idx < _partitions.size(); ++idx) {
+            if (!_partitions[idx].isSpilled() && _partitions[idx].memUsage > 0 &&
+                (!largest || _partitions[idx].memUsage > _partitions[*largest].memUsage)) {
+                largest = idx;
+            }
+        }
+        if (!largest) {
+            break;
+        }
+        spillPartition(*largest);
+    }
+}
+
+void HashJoinStage::spillPartition(size_t partitionIdx) {
+    auto& partition = _partitions[partitionIdx];
+    partition.buildRows = makeTemporaryRecordStore(_opCtx);
+    partition.probeRows = makeTemporaryRecordStore(_opCtx);
+
+    for (auto it = _ht->begin(); it != _ht->end();) {
+        if (getPartition(it->first) == partitionIdx) {
+            spillRow(partition.buildRows.get(), ++partition.numBuildRows, it->first, it->second);
+            _specificStats.spilledBuildRecords++;
+            it = _ht->erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    _htMemUsage -= partition.memUsage;
+    partition.memUsage = 0;
+    _specificStats.spilledPartitions++;
+}
+
+void HashJoinStage::spillRow(TemporaryRecordStore* rs,
+                             int64_t recordId,
+                             const value::MaterializedRow& key,
+                             const value::MaterializedRow& project) {
+    BufBuilder buf;
+    key.serializeForSorter(buf);
+    project.serializeForSorter(buf);
+
+    assertIgnorePrepareConflictsBehavior(_opCtx);
+
+    WriteUnitOfWork wuow(_opCtx);
+    auto status =
+        rs->rs()->insertRecord(_opCtx, RecordId(recordId), buf.buf(), buf.len(), Timestamp{});
+    wuow.commit();
+    tassert(6610203,
+            str::stream() << "Failed to write to disk because " << status.getStatus().reason(),
+            status.isOK());
+
+    _specificStats.spilledBytesApprox += buf.len();
+}
+
+void HashJoinStage::setProbeSource(size_t idx) {
+    for (auto& accessor : _outInnerKeyAccessors) {
+        accessor->setIndex(idx);
+    }
+    for (auto& accessor : _outInnerProjectAccessors) {
+        accessor->setIndex(idx);
+    }
+}
+
+void HashJoinStage::open(bool reOpen) {
+    auto optTimer(getOptTimer(_opCtx));
+
+    makeHashTable();
+    _depth = 0;
+    _partitions.clear();
+    _pendingPartitions.clear();
+    _currentPartition = boost::none;
+    _probeCursor.reset();
+    _innerChildExhausted = false;
+    setProbeSource(0);
 
     _commonStats.opens++;
     _children[0]->open(reOpen);
@@ -164,7 +394,7 @@ void HashJoinStage::open(bool reOpen) {
             project.reset(idx++, true, tag, val);
         }
 
-        _ht->emplace(std::move(key), std::move(project));
+        insertBuildRow(std::move(key), std::move(project));
     }
 
     _children[0]->close();
@@ -175,6 +405,96 @@ void HashJoinStage::open(bool reOpen) {
     _htItEnd = _ht->end();
 }
 
+bool HashJoinStage::probeRowIsResident() {
+    // Copy keys in order to do the lookup.
+    size_t idx = 0;
+    for (auto& p : _outInnerKeyAccessors) {
+        auto [tag, val] = p->getViewOfValue();
+        _probeKey.reset(idx++, false, tag, val);
+    }
+
+    if (_partitions.empty()) {
+        return true;
+    }
+
+    auto& partition = _partitions[getPartition(_probeKey)];
+    if (!partition.isSpilled()) {
+        return true;
+    }
+
+    // The matching outer rows, if any, are on disk. Spill the inner row to be joined later.
+    value::MaterializedRow project{_outInnerProjectAccessors.size()};
+    idx = 0;
+    for (auto& p : _outInnerProjectAccessors) {
+        auto [tag, val] = p->getViewOfValue();
+        project.reset(idx++, false, tag, val);
+    }
+    spillRow(partition.probeRows.get(), ++partition.numProbeRows, _probeKey, project);
+    _specificStats.spilledProbeRecords++;
+    return false;
+}
+
+void HashJoinStage::finishPartitioning() {
+    for (auto& partition : _partitions) {
+        // An inner join produces nothing for a partition with no rows on either side.
+        if (partition.isSpilled() && partition.numBuildRows > 0 && partition.numProbeRows > 0) {
+            _pendingPartitions.push_back(std::move(partition));
+        }
+    }
+    _partitions.clear();
+}
+
+void HashJoinStage::loadNextPartition() {
+    _currentPartition = std::move(_pendingPartitions.front());
+    _pendingPartitions.pop_front();
+
+    // Rows of this partition which still do not fit are partitioned again at the next depth.
+    makeHashTable();
+    _depth = _currentPartition->depth + 1;
+
+    auto cursor = _currentPartition->buildRows->rs()->getCursor(_opCtx);
+    while (auto record = cursor->next()) {
+        auto [key, project] = readSpilledRow(*record);
+        insertBuildRow(std::move(key), std::move(project));
+    }
+    cursor.reset();
+    _currentPartition->buildRows.reset();
+
+    _probeCursor = _currentPartition->probeRows->rs()->getCursor(_opCtx);
+    setProbeSource(1);
+}
+
+bool HashJoinStage::advanceProbe() {
+    while (true) {
+        if (!_innerChildExhausted) {
+            if (_children[1]->getNext() == PlanState::ADVANCED) {
+                if (probeRowIsResident()) {
+                    return true;
+                }
+                continue;
+            }
+            _innerChildExhausted = true;
+            finishPartitioning();
+        } else if (_probeCursor) {
+            if (auto record = _probeCursor->next()) {
+                std::tie(_spilledProbeKey, _spilledProbeProject) = readSpilledRow(*record);
+                if (probeRowIsResident()) {
+                    return true;
+                }
+                continue;
+            }
+            _probeCursor.reset();
+            _currentPartition = boost::none;
+            finishPartitioning();
+        }
+
+        if (_pendingPartitions.empty()) {
+            return false;
+        }
+        loadNextPartition();
+    }
+}
+
 PlanState HashJoinStage::getNext() {
     auto optTimer(getOptTimer(_opCtx));
 
@@ -182,27 +502,17 @@ PlanState HashJoinStage::getNext() {
         ++_htIt;
     }
 
-    if (_htIt == _htItEnd) {
-        while (_htIt == _htItEnd) {
-            auto state = _children[1]->getNext();
-            if (state == PlanState::IS_EOF) {
-                // LEFT and OUTER joins should enumerate "non-returned" rows here.
-                return trackPlanState(state);
-            }
-
-            // Copy keys in order to do the lookup.
-            size_t idx = 0;
-            for (auto& p : _inInnerKeyAccessors) {
-                auto [tag, val] = p->getViewOfValue();
-                _probeKey.reset(idx++, false, tag, val);
-            }
-
-            auto [low, hi] = _ht->equal_range(_probeKey);
-            _htIt = low;
-            _htItEnd = hi;
-            // If _htIt == _htItEnd (i.e. no match) then RIGHT and OUTER joins
-            // should enumerate "non-returned" rows here.
+    while (_htIt == _htItEnd) {
+        if (!advanceProbe()) {
+            // LEFT and OUTER joins should enumerate "non-returned" rows here.
+            return trackPlanState(PlanState::IS_EOF);
         }
+
+        auto [low, hi] = _ht->equal_range(_probeKey);
+        _htIt = low;
+        _htItEnd = hi;
+        // If _htIt == _htItEnd (i.e. no match) then RIGHT and OUTER joins
+        // should enumerate "non-returned" rows here.
     }
 
     return trackPlanState(PlanState::ADVANCED);
@@ -214,17 +524,37 @@ void HashJoinStage::close() {
     trackClose();
     _children[1]->close();
     _ht = boost::none;
+
+    // Drop any record stores created to spill to disk.
+    _probeCursor.reset();
+    _currentPartition = boost::none;
+    _pendingPartitions.clear();
+    _partitions.clear();
 }
 
 std::unique_ptr<PlanStageStats> HashJoinStage::getStats(bool includeDebugInfo) const {
     auto ret = std::make_unique<PlanStageStats>(_commonStats);
+    ret->specific = std::make_unique<HashJoinStats>(_specificStats);
+
+    if (includeDebugInfo) {
+        BSONObjBuilder bob;
+        // Spilling stats.
+        bob.appendBool("usedDisk", _specificStats.usedDisk);
+        bob.appendNumber("spilledPartitions", _specificStats.spilledPartitions);
+        bob.appendNumber("spilledBuildRecords", _specificStats.spilledBuildRecords);
+        bob.appendNumber("spilledProbeRecords", _specificStats.spilledProbeRecords);
+        bob.appendNumber("spilledBytesApprox", _specificStats.spilledBytesApprox);
+        bob.appendNumber("maxRecursionDepth", _specificStats.maxRecursionDepth);
+        ret->debugInfo = bob.obj();
+    }
+
     ret->children.emplace_back(_children[0]->getStats(includeDebugInfo));
     ret->children.emplace_back(_children[1]->getStats(includeDebugInfo));
     return ret;
 }
 
 const SpecificStats* HashJoinStage::getSpecificStats() const {
-    return nullptr;
+    return &_specificStats;
 }
 
 std::vector<DebugPrinter::Block> HashJoinStage::debugPrint() const {
@@ -29,10 +29,13 @@
 
 #pragma once
 
+#include <deque>
 #include <vector>
 
 #include "mongo/db/exec/sbe/stages/stages.h"
 #include "mongo/db/exec/sbe/vm/vm.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/storage/temporary_record_store.h"
 
 namespace mongo::sbe {
 /**
@@ -51,6 +54,15 @@ namespace mongo::sbe {
  * for string equality. For example, this can be used to perform a case-insensitive join on string
  * values.
  *
+ * If 'allowDiskUse' is true and the hash table grows past the memory limit, the join switches to a
+ * hybrid hash join. Both sides are split into partitions by hashing the join keys, and the largest
+ * partitions are spilled to temporary record stores until the rest fits in memory. Inner rows of
+ * in-memory partitions are joined as they stream in, while inner rows of spilled partitions are
+ * spilled alongside them. Spilled partitions are then joined one at a time once the inner side is
+ * exhausted, recursively re-partitioning any that still do not fit. While joining spilled rows
+ * only the 'innerCond' and 'innerProjects' slots of the inner side are visible to parent stages.
+ * If 'allowDiskUse' is false the whole outer side is kept in memory.
+ *
  * Debug string representation:
  *
  *   hj collatorSlot?
@@ -66,6 +78,7 @@ public:
                   value::SlotVector innerCond,
                   value::SlotVector innerProjects,
                   boost::optional<value::SlotId> collatorSlot,
+                  bool allowDiskUse,
                   PlanNodeId planNodeId);
 
     std::unique_ptr<PlanStage> clone() const final;
@@ -81,7 +94,70 @@ public:
     std::vector<DebugPrinter::Block> debugPrint() const final;
     size_t estimateCompileTimeSize() const final;
 
+protected:
+    void doSaveState(bool relinquishCursor) override;
+    void doRestoreState(bool relinquishCursor) override;
+    void doDetachFromOperationContext() override;
+    void doAttachToOperationContext(OperationContext* opCtx) override;
+
 private:
+    /**
+     * A hash partition of both sides of the join. A partition is resident while its outer rows
+     * live in '_ht', and spilled once its rows of both sides are written to its record stores.
+     */
+    struct Partition {
+        bool isSpilled() const {
+            return buildRows != nullptr;
+        }
+
+        // The recursion depth of the partitioning which created this partition.
+        size_t depth{0};
+
+        // Approximate memory used by the rows of this partition in '_ht' while it is resident.
+        long long memUsage{0};
+
+        std::unique_ptr<TemporaryRecordStore> buildRows;
+        std::unique_ptr<TemporaryRecordStore> probeRows;
+        int64_t numBuildRows{0};
+        int64_t numProbeRows{0};
+    };
+
+    void makeHashTable();
+
+    /**
+     * Inserts an outer row into '_ht', or into its partition's record store if that partition is
+     * spilled, and spills partitions if this pushes '_ht' past the memory limit.
+     */
+    void insertBuildRow(value::MaterializedRow key, value::MaterializedRow project);
+    void spillIfNecessary();
+    void spillPartition(size_t partitionIdx);
+    void spillRow(TemporaryRecordStore* rs,
+                  int64_t recordId,
+                  const value::MaterializedRow& key,
+                  const value::MaterializedRow& project);
+    size_t getPartition(const value::MaterializedRow& key) const;
+
+    /**
+     * Advances to the next inner row which belongs to a resident partition, spilling inner rows
+     * of spilled partitions along the way, and copies its keys into '_probeKey'. Returns false
+     * once all inner rows, including those of spilled partitions, have been joined.
+     */
+    bool advanceProbe();
+    bool probeRowIsResident();
+
+    /**
+     * Moves the spilled partitions of the current partitioning to '_pendingPartitions'.
+     */
+    void finishPartitioning();
+
+    /**
+     * Loads the outer rows of the next pending partition into '_ht' and positions '_probeCursor'
+     * on its inner rows.
+     */
+    void loadNextPartition();
+
+    void setProbeSource(size_t idx);
+
     using TableType = std::unordered_multimap<value::MaterializedRow,  // NOLINT
                                               value::MaterializedRow,
                                               value::MaterializedRowHasher,
@@ -114,6 +190,22 @@ private:
     // Accessors of input condition values (keys) that are being inserted into the hash table.
     std::vector<value::SlotAccessor*> _inInnerKeyAccessors;
 
+    // Accessors of inner projection values.
+    std::vector<value::SlotAccessor*> _inInnerProjectAccessors;
+
+    // Inner rows read back from a spilled partition, and accessors to their values.
+    value::MaterializedRow _spilledProbeKey{0};
+    value::MaterializedRow _spilledProbeProject{0};
+    std::vector<std::unique_ptr<value::MaterializedSingleRowAccessor>> _spilledProbeKeyAccessors;
+    std::vector<std::unique_ptr<value::MaterializedSingleRowAccessor>>
+        _spilledProbeProjectAccessors;
+
+    // Accessors of inner keys and projections which switch between the inner child (index 0) and
+    // the rows read from a spilled partition (index 1).
+    std::vector<std::unique_ptr<value::SwitchAccessor>> _outInnerKeyAccessors;
+    std::vector<std::unique_ptr<value::SwitchAccessor>> _outInnerProjectAccessors;
+    value::SlotAccessorMap _outInnerAccessors;
+
     // Accessor for collator. Only set if collatorSlot provided during construction.
     value::SlotAccessor* _collatorAccessor = nullptr;
 
@@ -127,5 +219,30 @@ private:
     vm::ByteCode _bytecode;
 
     bool _compiled{false};
+
+    // Memory tracking and spilling to disk.
+    const bool _allowDiskUse;
+    const long long _approxMemoryUseInBytesBeforeSpill =
+        internalQuerySBEHashJoinApproxMemoryUseInBytesBeforeSpill.load();
+    const size_t _numPartitions = internalQuerySBEHashJoinNumPartitions.load();
+    const size_t _maxRecursionDepth = internalQuerySBEHashJoinMaxRecursionDepth.load();
+
+    // Approximate memory used by the rows in '_ht'.
+    long long _htMemUsage{0};
+
+    // The recursion depth of the partitioning of the rows currently being joined.
+    size_t _depth{0};
+
+    // Empty until the first time '_ht' exceeds the memory limit.
+    std::vector<Partition> _partitions;
+
+    // Spilled partitions which remain to be joined, and the one whose inner rows are being read.
+    std::deque<Partition> _pendingPartitions;
+    boost::optional<Partition> _currentPartition;
+    std::unique_ptr<SeekableRecordCursor> _probeCursor;
+
+    bool _innerChildExhausted{false};
+
+    HashJoinStats _specificStats;
 };
 }  // namespace mongo::sbe
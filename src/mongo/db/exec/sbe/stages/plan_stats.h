@@ -282,6 +282,31 @@ struct HashAggStats : public SpecificStats {
     long long lastSpilledRecordSize{0};
 };
 
+struct HashJoinStats : public SpecificStats {
+    std::unique_ptr<SpecificStats> clone() const final {
+        return std::make_unique<HashJoinStats>(*this);
+    }
+
+    uint64_t estimateObjectSizeInBytes() const final {
+        return sizeof(*this);
+    }
+
+    void acceptVisitor(PlanStatsConstVisitor* visitor) const final {
+        visitor->visit(this);
+    }
+
+    void acceptVisitor(PlanStatsMutableVisitor* visitor) final {
+        visitor->visit(this);
+    }
+
+    bool usedDisk{false};
+    long long spilledPartitions{0};
+    long long spilledBuildRecords{0};
+    long long spilledProbeRecords{0};
+    long long spilledBytesApprox{0};
+    long long maxRecursionDepth{0};
+};
+
 /**
  * Visitor for calculating the number of storage reads during plan execution.
  */
@@ -34,6 +34,8 @@
 #include <functional>
 #include <type_traits>
 
+#include "mongo/util/assert_util.h"
+
 namespace mongo {
 /**
  * During the runtime planning phase this tracker is used to track the progress of the work done
@@ -122,8 +124,21 @@ public:
         return _metrics[metric];
     }
 
+    /**
+     * Sets a new maximum for the trial run metric specified as a template parameter 'metric'. This
+     * may be called from '_onMetricReached' in order to keep tracking a metric past its previous
+     * maximum rather than calling '_onMetricReached' on every subsequent increment. The metric
+     * must be tracked, so 'maxMetric' must not be zero.
+     */
+    template <TrialRunMetric metric>
+    void setMaxMetric(size_t maxMetric) {
+        static_assert(metric >= 0 && metric < sizeof(_maxMetrics) / sizeof(size_t));
+        invariant(_maxMetrics[metric] != 0 && maxMetric != 0);
+        _maxMetrics[metric] = maxMetric;
+    }
+
 private:
-    const size_t _maxMetrics[TrialRunMetric::kLastElem];
+    size_t _maxMetrics[TrialRunMetric::kLastElem];
     size_t _metrics[TrialRunMetric::kLastElem]{0};
     bool _done{false};
     std::function<bool(TrialRunMetric)> _onMetricReached{};
@@ -47,6 +47,11 @@ class BtreeAccessMethod : public SortedDataIndexAccessMethod {
 public:
     BtreeAccessMethod(IndexCatalogEntry* btreeState, std::unique_ptr<SortedDataInterface> btree);
 
+    bool supportsConcurrentKeyGeneration() const final {
+        // The key generator is immutable once constructed, and collators are thread-safe.
+        return true;
+    }
+
 private:
     void validateDocument(const CollectionPtr& collection,
                           const BSONObj& obj,
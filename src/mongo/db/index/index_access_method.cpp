@@ -33,6 +33,7 @@
 
 #include "mongo/db/index/btree_access_method.h"
 
+#include <algorithm>
 #include <utility>
 #include <vector>
 
@@ -43,6 +44,7 @@
 #include "mongo/db/client.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/curop.h"
+#include "mongo/db/index/index_access_method_gen.h"
 #include "mongo/db/index/index_build_interceptor.h"
 #include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/jsobj.h"
@@ -81,11 +83,36 @@ bool isMultikeyFromPaths(const MultikeyPaths& multikeyPaths) {
                        [](const MultikeyComponents& components) { return !components.empty(); });
 }
 
+/**
+ * Adds the path components in 'multikeyPaths' to those in 'indexMultikeyPaths'.
+ */
+void mergeMultikeyPaths(MultikeyPaths* indexMultikeyPaths, const MultikeyPaths& multikeyPaths) {
+    if (multikeyPaths.empty()) {
+        return;
+    }
+    if (indexMultikeyPaths->empty()) {
+        *indexMultikeyPaths = multikeyPaths;
+        return;
+    }
+
+    invariant(indexMultikeyPaths->size() == multikeyPaths.size());
+    for (size_t i = 0; i < multikeyPaths.size(); ++i) {
+        (*indexMultikeyPaths)[i].insert(boost::container::ordered_unique_range_t(),
+                                        multikeyPaths[i].begin(),
+                                        multikeyPaths[i].end());
+    }
+}
+
+// Below this many documents per thread, generating keys concurrently costs more in thread startup
+// than it saves.
+constexpr size_t kMinRecordsPerKeyGenerationThread = 256;
+
 SortOptions makeSortOptions(size_t maxMemoryUsageBytes, StringData dbName) {
     return SortOptions()
         .TempDir(storageGlobalParams.dbpath + "/_tmp")
         .ExtSortAllowed()
         .MaxMemoryUsageBytes(maxMemoryUsageBytes)
+        .NumSortThreads(static_cast<size_t>(maxIndexBuildSortThreads.load()))
         .DBName(dbName.toString());
 }
 
@@ -593,6 +620,14 @@ public:
                   const std::function<void()>& saveCursorBeforeWrite,
                   const std::function<void()>& restoreCursorAfterWrite) final;
 
+    Status insertBatch(OperationContext* opCtx,
+                       const CollectionPtr& collection,
+                       SharedBufferFragmentBuilder& pooledBuilder,
+                       const std::vector<BsonRecord>& records,
+                       const InsertDeleteOptions& options,
+                       const std::function<void()>& saveCursorBeforeWrite,
+                       const std::function<void()>& restoreCursorAfterWrite) final;
+
     Status commit(OperationContext* opCtx,
                   const CollectionPtr& collection,
                   bool dupsAllowed,
@@ -612,6 +647,18 @@ private:
                 const NamespaceString& ns) const;
     void _insertMultikeyMetadataKeysIntoSorter();
 
+    /**
+     * Records a document whose key generation error was suppressed as "skipped", so that the index
+     * builder can retry it at a point when data is consistent.
+     */
+    void _recordSuppressedKeyGenerationError(
+        OperationContext* opCtx,
+        const Status& status,
+        const BSONObj& obj,
+        const RecordId& loc,
+        const std::function<void()>& saveCursorBeforeWrite,
+        const std::function<void()>& restoreCursorAfterWrite);
+
     Sorter* _makeSorter(
         size_t maxMemoryUsageBytes,
         StringData dbName,
@@ -688,43 +735,18 @@ Status SortedDataIndexAccessMethod::BulkBuilderImpl::insert(
                       multikeyPaths.get(),
                       loc,
                       [&](Status status, const BSONObj&, boost::optional<RecordId>) {
-                          // If a key generation error was suppressed, record the document as
-                          // "skipped" so the index builder can retry at a point when data is
-                          // consistent.
-                          auto interceptor = _iam->_indexCatalogEntry->indexBuildInterceptor();
-                          if (interceptor && interceptor->getSkippedRecordTracker()) {
-                              LOGV2_DEBUG(
-                                  20684,
-                                  1,
-                                  "Recording suppressed key generation error to retry later: "
-                                  "{error} on {loc}: {obj}",
-                                  "error"_attr = status,
-                                  "loc"_attr = loc,
-                                  "obj"_attr = redact(obj));
-
-                              // Save and restore the cursor around the write in case it throws a
-                              // WCE internally and causes the cursor to be unpositioned.
-                              saveCursorBeforeWrite();
-                              interceptor->getSkippedRecordTracker()->record(opCtx, loc);
-                              restoreCursorAfterWrite();
-                          }
+                          _recordSuppressedKeyGenerationError(opCtx,
+                                                              status,
+                                                              obj,
+                                                              loc,
+                                                              saveCursorBeforeWrite,
+                                                              restoreCursorAfterWrite);
                       });
     } catch (...) {
         return exceptionToStatus();
     }
 
-    if (!multikeyPaths->empty()) {
-        if (_indexMultikeyPaths.empty()) {
-            _indexMultikeyPaths = *multikeyPaths;
-        } else {
-            invariant(_indexMultikeyPaths.size() == multikeyPaths->size());
-            for (size_t i = 0; i < multikeyPaths->size(); ++i) {
-                _indexMultikeyPaths[i].insert(boost::container::ordered_unique_range_t(),
-                                              (*multikeyPaths)[i].begin(),
-                                              (*multikeyPaths)[i].end());
-            }
-        }
-    }
+    mergeMultikeyPaths(&_indexMultikeyPaths, *multikeyPaths);
 
     for (const auto& keyString : *keys) {
         _sorter->add(keyString, mongo::NullValue());
@@ -737,6 +759,145 @@ Status SortedDataIndexAccessMethod::BulkBuilderImpl::insert(
     return Status::OK();
 }
 
+Status SortedDataIndexAccessMethod::BulkBuilderImpl::insertBatch(
+    OperationContext* opCtx,
+    const CollectionPtr& collection,
+    SharedBufferFragmentBuilder& pooledBuilder,
+    const std::vector<BsonRecord>& records,
+    const InsertDeleteOptions& options,
+    const std::function<void()>& saveCursorBeforeWrite,
+    const std::function<void()>& restoreCursorAfterWrite) {
+    const auto numThreads =
+        std::min(static_cast<size_t>(maxIndexBuildKeyGenerationThreads.load()),
+                 records.size() / kMinRecordsPerKeyGenerationThread);
+    if (numThreads <= 1 || !_iam->supportsConcurrentKeyGeneration()) {
+        for (const auto& record : records) {
+            auto status = insert(opCtx,
+                                 collection,
+                                 pooledBuilder,
+                                 *record.docPtr,
+                                 record.id,
+                                 options,
+                                 saveCursorBeforeWrite,
+                                 restoreCursorAfterWrite);
+            if (!status.isOK()) {
+                return status;
+            }
+        }
+        return Status::OK();
+    }
+
+    // Each thread generates the keys of a contiguous slice of 'records'. Neither the sorter nor the
+    // skipped record tracker are thread-safe, so the slices are only added to them afterwards, in
+    // order, by this thread.
+    struct Slice {
+        std::vector<KeyString::Value> keys;
+        KeyStringSet multikeyMetadataKeys;
+        MultikeyPaths multikeyPaths;
+        bool isMultikey = false;
+        std::vector<std::pair<Status, const BsonRecord*>> suppressedErrors;
+        Status status = Status::OK();
+    };
+    std::vector<Slice> slices(numThreads);
+
+    std::vector<std::function<void()>> tasks;
+    for (size_t i = 0; i < numThreads; ++i) {
+        tasks.push_back([&, i] {
+            auto& slice = slices[i];
+            SharedBufferFragmentBuilder sliceBuilder(
+                KeyString::HeapBuilder::kHeapAllocatorDefaultBytes);
+            KeyStringSet keys;
+            MultikeyPaths multikeyPaths;
+
+            const auto end = records.size() * (i + 1) / numThreads;
+            for (auto j = records.size() * i / numThreads; j < end; ++j) {
+                const auto& record = records[j];
+                keys.clear();
+                multikeyPaths.clear();
+                try {
+                    _iam->getKeys(opCtx,
+                                  collection,
+                                  sliceBuilder,
+                                  *record.docPtr,
+                                  options.getKeysMode,
+                                  GetKeysContext::kAddingKeys,
+                                  &keys,
+                                  &slice.multikeyMetadataKeys,
+                                  &multikeyPaths,
+                                  record.id,
+                                  [&](Status status, const BSONObj&, boost::optional<RecordId>) {
+                                      slice.suppressedErrors.emplace_back(std::move(status),
+                                                                          &record);
+                                  });
+                } catch (...) {
+                    slice.status = exceptionToStatus();
+                    return;
+                }
+
+                mergeMultikeyPaths(&slice.multikeyPaths, multikeyPaths);
+                slice.keys.insert(slice.keys.end(), keys.begin(), keys.end());
+                slice.isMultikey = slice.isMultikey ||
+                    _iam->shouldMarkIndexAsMultikey(
+                        keys.size(), slice.multikeyMetadataKeys, multikeyPaths);
+            }
+        });
+    }
+    sorter::runConcurrently(tasks);
+
+    for (auto& slice : slices) {
+        for (const auto& [status, record] : slice.suppressedErrors) {
+            _recordSuppressedKeyGenerationError(opCtx,
+                                                status,
+                                                *record->docPtr,
+                                                record->id,
+                                                saveCursorBeforeWrite,
+                                                restoreCursorAfterWrite);
+        }
+        if (!slice.status.isOK()) {
+            return slice.status;
+        }
+
+        mergeMultikeyPaths(&_indexMultikeyPaths, slice.multikeyPaths);
+        _multikeyMetadataKeys.insert(slice.multikeyMetadataKeys.begin(),
+                                     slice.multikeyMetadataKeys.end());
+        _isMultiKey = _isMultiKey || slice.isMultikey;
+
+        for (const auto& keyString : slice.keys) {
+            _sorter->add(keyString, mongo::NullValue());
+            ++_keysInserted;
+        }
+    }
+
+    return Status::OK();
+}
+
+void SortedDataIndexAccessMethod::BulkBuilderImpl::_recordSuppressedKeyGenerationError(
+    OperationContext* opCtx,
+    const Status& status,
+    const BSONObj& obj,
+    const RecordId& loc,
+    const std::function<void()>& saveCursorBeforeWrite,
+    const std::function<void()>& restoreCursorAfterWrite) {
+    auto interceptor = _iam->_indexCatalogEntry->indexBuildInterceptor();
+    if (!interceptor || !interceptor->getSkippedRecordTracker()) {
+        return;
+    }
+
+    LOGV2_DEBUG(20684,
+                1,
+                "Recording suppressed key generation error to retry later: "
+                "{error} on {loc}: {obj}",
+                "error"_attr = status,
+                "loc"_attr = loc,
+                "obj"_attr = redact(obj));
+
+    // Save and restore the cursor around the write in case it throws a WCE internally and causes
+    // the cursor to be unpositioned.
+    saveCursorBeforeWrite();
+    interceptor->getSkippedRecordTracker()->record(opCtx, loc);
+    restoreCursorAfterWrite();
+}
+
 const MultikeyPaths& SortedDataIndexAccessMethod::BulkBuilderImpl::getMultikeyPaths() const {
     return _indexMultikeyPaths;
 }
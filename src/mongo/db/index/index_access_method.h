@@ -193,6 +193,19 @@ public:
                               const std::function<void()>& saveCursorBeforeWrite,
                               const std::function<void()>& restoreCursorAfterWrite) = 0;
 
+        /**
+         * Inserts each of 'records' in order, as-if by calling insert() on each of them. The keys
+         * of the batch may be generated on several threads, but they are always added to the
+         * BulkBuilder by the calling thread, in the order of 'records'.
+         */
+        virtual Status insertBatch(OperationContext* opCtx,
+                                   const CollectionPtr& collection,
+                                   SharedBufferFragmentBuilder& pooledBuilder,
+                                   const std::vector<BsonRecord>& records,
+                                   const InsertDeleteOptions& options,
+                                   const std::function<void()>& saveCursorBeforeWrite,
+                                   const std::function<void()>& restoreCursorAfterWrite) = 0;
+
         /**
          * Call this when you are ready to finish your bulk work.
          * @param dupsAllowed - If false and 'dupRecords' is not null, append with the RecordIds of
@@ -467,6 +480,14 @@ public:
                                            const KeyStringSet& multikeyMetadataKeys,
                                            const MultikeyPaths& multikeyPaths) const;
 
+    /**
+     * Returns true if getKeys() may be called for different documents on several threads at once
+     * while this index is being built.
+     */
+    virtual bool supportsConcurrentKeyGeneration() const {
+        return false;
+    }
+
     /**
      * Provides direct access to the SortedDataInterface. This should not be used to insert
      * documents into an index, except for testing purposes.
@@ -377,6 +377,10 @@ IndexBuildsCoordinatorMongod::_startIndexBuild(OperationContext* opCtx,
         ShouldNotConflictWithSecondaryBatchApplicationBlock shouldNotConflictBlock(
             opCtx->lockState());
 
+        // Index builds are long-running background work and should not be admitted ahead of user
+        // operations when the storage engine is saturated.
+        ScopedAdmissionPriority admissionPriority(opCtx->lockState(), AdmissionPriority::kLow);
+
         if (indexBuildOptions.applicationMode != ApplicationMode::kStartupRepair) {
             status = _setUpIndexBuild(opCtx.get(), buildUUID, startTimestamp, indexBuildOptions);
             if (!status.isOK()) {
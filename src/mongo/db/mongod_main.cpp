@@ -111,6 +111,7 @@
 #include "mongo/db/pipeline/change_stream_expired_pre_image_remover.h"
 #include "mongo/db/pipeline/process_interface/replica_set_node_process_interface.h"
 #include "mongo/db/query/internal_plans.h"
+#include "mongo/db/query/sbe_plan_cache_persistence.h"
 #include "mongo/db/read_write_concern_defaults_cache_lookup_mongod.h"
 #include "mongo/db/repl/drop_pending_collection_reaper.h"
 #include "mongo/db/repl/initial_syncer_factory.h"
@@ -793,6 +794,34 @@ ExitCode _initAndListen(ServiceContext* serviceContext, int listenPort) {
         }
     }
 
+    // Warm up the SBE plan cache from the entries persisted by the previous run of the server, and
+    // start persisting the entries of this run, if plan cache persistence is enabled.
+    if (sbe::isPlanCachePersistenceEnabled()) {
+        auto& persistedPlanCache = sbe::PersistedPlanCache::get(serviceContext);
+        if (auto status = persistedPlanCache.load(sbe::PersistedPlanCache::getFilePath());
+            !status.isOK()) {
+            LOGV2_WARNING_OPTIONS(6610704,
+                                  {LogComponent::kQuery},
+                                  "Ignoring the persisted SBE plan cache",
+                                  "error"_attr = status);
+        } else {
+            LOGV2_OPTIONS(6610705,
+                          {LogComponent::kQuery},
+                          "Loaded the persisted SBE plan cache",
+                          "numEntries"_attr = persistedPlanCache.size());
+        }
+
+        try {
+            sbe::PeriodicPlanCachePersister::get(serviceContext)->start();
+        } catch (ExceptionFor<ErrorCodes::PeriodicJobIsStopped>&) {
+            LOGV2_WARNING(6610706, "Not starting periodic jobs as shutdown is in progress");
+            // Shutdown has already started before initialization is complete. Wait for the
+            // shutdown task to complete and return.
+            MONGO_IDLE_THREAD_BLOCK;
+            return waitForShutdown();
+        }
+    }
+
     // Set up the logical session cache
     LogicalSessionCacheServer kind = LogicalSessionCacheServer::kStandalone;
     if (serverGlobalParams.clusterRole == ClusterRole::ShardServer) {
@@ -1276,6 +1305,25 @@ void shutdownTask(const ShutdownTaskArgs& shutdownArgs) {
         PeriodicChangeStreamExpiredPreImagesRemover::get(serviceContext)->stop();
     }
 
+    if (sbe::isPlanCachePersistenceEnabled()) {
+        LOGV2_OPTIONS(
+            6610707, {LogComponent::kQuery}, "Shutting down the SBE plan cache persister");
+        sbe::PeriodicPlanCachePersister::get(serviceContext)->stop();
+
+        // Persist the plan cache one last time so that the next run starts from its latest state.
+        auto opCtx = client->makeOperationContext();
+        auto swNumEntries = sbe::PersistedPlanCache::get(serviceContext)
+                                .writeSnapshot(opCtx.get(),
+                                               sbe::getPlanCache(serviceContext),
+                                               sbe::PersistedPlanCache::getFilePath());
+        if (!swNumEntries.isOK()) {
+            LOGV2_WARNING_OPTIONS(6610708,
+                                  {LogComponent::kQuery},
+                                  "Failed to persist the SBE plan cache",
+                                  "error"_attr = swNumEntries.getStatus());
+        }
+    }
+
     if (auto storageEngine = serviceContext->getStorageEngine()) {
         if (storageEngine->supportsReadConcernSnapshot()) {
             LOGV2(4784908, "Shutting down the PeriodicThreadToAbortExpiredTransactions");
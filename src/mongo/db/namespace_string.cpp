@@ -194,6 +194,9 @@ bool NamespaceString::isLegalClientSystemNS(
     if (isTemporaryReshardingCollection()) {
         return true;
     }
+    if (isStatisticsCollection()) {
+        return true;
+    }
     if (isTimeseriesBucketsCollection() &&
         validCollectionName(coll().substr(kTimeseriesBucketsCollectionPrefix.size()))) {
         return true;
@@ -351,6 +354,10 @@ bool NamespaceString::isTimeseriesBucketsCollection() const {
     return coll().startsWith(kTimeseriesBucketsCollectionPrefix);
 }
 
+bool NamespaceString::isStatisticsCollection() const {
+    return coll().startsWith(kStatisticsCollectionPrefix);
+}
+
 bool NamespaceString::isChangeStreamPreImagesCollection() const {
     return ns() == kChangeStreamPreImagesNamespace.ns();
 }
@@ -372,6 +379,10 @@ NamespaceString NamespaceString::getTimeseriesViewNamespace() const {
     return {db(), coll().substr(kTimeseriesBucketsCollectionPrefix.size())};
 }
 
+NamespaceString NamespaceString::makeStatisticsNamespace() const {
+    return {db(), kStatisticsCollectionPrefix.toString() + coll()};
+}
+
 bool NamespaceString::isImplicitlyReplicated() const {
     if (isChangeStreamPreImagesCollection() || isConfigImagesCollection() || isChangeCollection()) {
         // Implicitly replicated namespaces are replicated, although they only replicate a subset of
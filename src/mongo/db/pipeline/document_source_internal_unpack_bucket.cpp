@@ -39,6 +39,8 @@
 
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsontypes.h"
+#include "mongo/bson/util/bsoncolumn_block.h"
+#include "mongo/db/exec/bucket_block_filter.h"
 #include "mongo/db/exec/document_value/document.h"
 #include "mongo/db/matcher/expression.h"
 #include "mongo/db/matcher/expression_algo.h"
@@ -46,6 +48,7 @@
 #include "mongo/db/matcher/expression_geo.h"
 #include "mongo/db/matcher/expression_internal_bucket_geo_within.h"
 #include "mongo/db/matcher/expression_internal_expr_comparison.h"
+#include "mongo/db/pipeline/accumulator.h"
 #include "mongo/db/pipeline/document_source_add_fields.h"
 #include "mongo/db/pipeline/document_source_geo_near.h"
 #include "mongo/db/pipeline/document_source_group.h"
@@ -58,6 +61,7 @@
 #include "mongo/db/pipeline/document_source_sort.h"
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/lite_parsed_document_source.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/util/make_data_structure.h"
 #include "mongo/db/timeseries/timeseries_constants.h"
 #include "mongo/db/timeseries/timeseries_options.h"
@@ -200,6 +204,108 @@ void optimizePrefix(Pipeline::SourceContainer::iterator itr, Pipeline::SourceCon
     container->splice(itr, prefix);
 }
 
+using BlockAggregate = DocumentSourceInternalUnpackBucket::BlockAggregate;
+
+constexpr StringData kCountOpName = "$count"_sd;
+
+StringData blockAggregateOpName(BlockAggregate::Op op) {
+    switch (op) {
+        case BlockAggregate::Op::kMin:
+            return AccumulatorMin::kName;
+        case BlockAggregate::Op::kMax:
+            return AccumulatorMax::kName;
+        case BlockAggregate::Op::kSum:
+            return AccumulatorSum::kName;
+        case BlockAggregate::Op::kAvg:
+            return AccumulatorAvg::kName;
+        case BlockAggregate::Op::kCount:
+            return kCountOpName;
+    }
+    MONGO_UNREACHABLE;
+}
+
+boost::optional<BlockAggregate::Op> parseBlockAggregateOp(StringData name) {
+    for (auto op : {BlockAggregate::Op::kMin,
+                    BlockAggregate::Op::kMax,
+                    BlockAggregate::Op::kSum,
+                    BlockAggregate::Op::kAvg,
+                    BlockAggregate::Op::kCount}) {
+        if (name == blockAggregateOpName(op)) {
+            return op;
+        }
+    }
+    return boost::none;
+}
+
+BlockAggregate parseBlockAggregate(const BSONObj& spec) {
+    BlockAggregate aggregate;
+    auto field = spec["field"];
+    uassert(6610811,
+            "blockAggregates field element must have a string 'field'",
+            field.type() == BSONType::String);
+    aggregate.outputField = field.str();
+
+    auto opElem = spec["op"];
+    auto op = opElem.type() == BSONType::String ? parseBlockAggregateOp(opElem.valueStringData())
+                                                : boost::none;
+    uassert(6610812,
+            str::stream() << "blockAggregates field element has an unsupported 'op': "
+                          << opElem.toString(false),
+            op);
+    aggregate.op = *op;
+
+    auto input = spec["input"];
+    if (aggregate.op == BlockAggregate::Op::kCount) {
+        uassert(6610813, "A $count block aggregate must not have an 'input'", input.eoo());
+    } else {
+        uassert(6610814,
+                "blockAggregates field element must have a string 'input'",
+                input.type() == BSONType::String);
+        aggregate.inputField = input.str();
+        uassert(6610815,
+                "blockAggregates 'input' must be a single-element field path",
+                aggregate.inputField.find('.') == std::string::npos);
+    }
+    return aggregate;
+}
+
+boost::intrusive_ptr<AccumulatorState> makeBlockAggregateAccumulator(BlockAggregate::Op op,
+                                                                     ExpressionContext* expCtx) {
+    switch (op) {
+        case BlockAggregate::Op::kMin:
+            return AccumulatorMin::create(expCtx);
+        case BlockAggregate::Op::kMax:
+            return AccumulatorMax::create(expCtx);
+        case BlockAggregate::Op::kSum:
+        case BlockAggregate::Op::kCount:
+            return AccumulatorSum::create(expCtx);
+        case BlockAggregate::Op::kAvg:
+            return AccumulatorAvg::create(expCtx);
+    }
+    MONGO_UNREACHABLE;
+}
+
+/**
+ * Decodes the column of a compressed bucket holding 'count' measurements. A field which is absent
+ * from the bucket decodes to a block where every value is missing.
+ */
+boost::optional<bsoncolumn::NumericBlock> decodeColumn(BSONElement column, size_t count) {
+    if (!column) {
+        bsoncolumn::NumericBlock block;
+        block.ints.resize(count);
+        block.present.resize(count);
+        return block;
+    }
+    if (column.type() != BSONType::BinData || column.binDataType() != BinDataType::Column) {
+        return boost::none;
+    }
+    auto block = bsoncolumn::decodeNumericBlock(column);
+    if (!block || block->size() != count) {
+        return boost::none;
+    }
+    return block;
+}
+
 }  // namespace
 
 DocumentSourceInternalUnpackBucket::DocumentSourceInternalUnpackBucket(
@@ -229,6 +335,7 @@ boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createF
     auto bucketMaxSpanSeconds = 0;
     auto assumeClean = false;
     std::vector<std::string> computedMetaProjFields;
+    std::vector<BlockAggregate> blockAggregates;
     for (auto&& elem : specElem.embeddedObject()) {
         auto fieldName = elem.fieldNameStringData();
         if (fieldName == kInclude || fieldName == kExclude) {
@@ -304,6 +411,19 @@ boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createF
                         field.find('.') == std::string::npos);
                 bucketSpec.addComputedMetaProjFields(field);
             }
+        } else if (fieldName == kBlockAggregates) {
+            uassert(6610816,
+                    str::stream() << "blockAggregates field must be an array, got: "
+                                  << elem.type(),
+                    elem.type() == BSONType::Array);
+
+            for (auto&& elt : elem.embeddedObject()) {
+                uassert(6610817,
+                        str::stream() << "blockAggregates field element must be an object, got: "
+                                      << elt.type(),
+                        elt.type() == BSONType::Object);
+                blockAggregates.push_back(parseBlockAggregate(elt.embeddedObject()));
+            }
         } else {
             uasserted(5346506,
                       str::stream()
@@ -318,11 +438,13 @@ boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createF
             "The $_internalUnpackBucket stage requires a bucketMaxSpanSeconds parameter",
             hasBucketMaxSpanSeconds);
 
-    return make_intrusive<DocumentSourceInternalUnpackBucket>(
+    auto unpack = make_intrusive<DocumentSourceInternalUnpackBucket>(
         expCtx,
         BucketUnpacker{std::move(bucketSpec), unpackerBehavior},
         bucketMaxSpanSeconds,
         assumeClean);
+    unpack->_blockAggregates = std::move(blockAggregates);
+    return unpack;
 }
 
 boost::intrusive_ptr<DocumentSource> DocumentSourceInternalUnpackBucket::createFromBsonExternal(
@@ -412,6 +534,20 @@ void DocumentSourceInternalUnpackBucket::serializeToArray(
                          return compFields;
                      }()});
 
+    if (!_blockAggregates.empty()) {
+        std::vector<Value> aggregates;
+        for (auto&& aggregate : _blockAggregates) {
+            MutableDocument aggregateSpec;
+            aggregateSpec.addField("field", Value{aggregate.outputField});
+            aggregateSpec.addField("op", Value{blockAggregateOpName(aggregate.op)});
+            if (aggregate.op != BlockAggregate::Op::kCount) {
+                aggregateSpec.addField("input", Value{aggregate.inputField});
+            }
+            aggregates.push_back(aggregateSpec.freezeToValue());
+        }
+        out.addField(kBlockAggregates, Value{std::move(aggregates)});
+    }
+
     if (!explain) {
         array.push_back(Value(DOC(getSourceName() << out.freeze())));
         if (_sampleSize) {
@@ -432,25 +568,134 @@ DocumentSource::GetNextResult DocumentSourceInternalUnpackBucket::doGetNext() {
 
     // Otherwise, fallback to unpacking every measurement in all buckets until the child stage is
     // exhausted.
-    if (_bucketUnpacker.hasNext()) {
+    if (_blockAggregates.empty() && _bucketUnpacker.hasNext()) {
         return _bucketUnpacker.getNext();
     }
 
     auto nextResult = pSource->getNext();
-    if (nextResult.isAdvanced()) {
+    while (nextResult.isAdvanced()) {
         auto bucket = nextResult.getDocument().toBson();
         _bucketUnpacker.reset(std::move(bucket));
         uassert(5346509,
                 str::stream() << "A bucket with _id "
                               << _bucketUnpacker.bucket()[timeseries::kBucketIdFieldName].toString()
                               << " contains an empty data region",
-                _bucketUnpacker.hasNext());
-        return _bucketUnpacker.getNext();
+                _bucketUnpacker.numberOfMeasurements() > 0);
+        if (!_blockAggregates.empty()) {
+            return aggregateBucket();
+        }
+        if (_bucketUnpacker.hasNext()) {
+            return _bucketUnpacker.getNext();
+        }
+
+        // The block predicates rejected every measurement in this bucket.
+        nextResult = pSource->getNext();
     }
 
     return nextResult;
 }
 
+Document DocumentSourceInternalUnpackBucket::aggregateBucket() {
+    auto partials = aggregateBlocks();
+    if (!partials) {
+        partials = aggregateMeasurements();
+    }
+
+    MutableDocument out;
+    if (auto metaField = _bucketUnpacker.bucketSpec().metaField()) {
+        if (auto meta = _bucketUnpacker.bucket()[timeseries::kBucketMetaFieldName]) {
+            out.addField(*metaField, Value{meta});
+        }
+    }
+    for (size_t i = 0; i < _blockAggregates.size(); ++i) {
+        if (!(*partials)[i].missing()) {
+            out.addField(_blockAggregates[i].outputField, std::move((*partials)[i]));
+        }
+    }
+    return out.freeze();
+}
+
+boost::optional<std::vector<Value>> DocumentSourceInternalUnpackBucket::aggregateBlocks() const {
+    const auto& bucket = _bucketUnpacker.bucket();
+
+    // Only compressed buckets store their columns in a form which can be decoded as a block.
+    auto control = bucket[timeseries::kBucketControlFieldName].Obj();
+    if (control[timeseries::kBucketControlVersionFieldName].numberInt() != 2) {
+        return boost::none;
+    }
+
+    auto dataRegion = bucket[timeseries::kBucketDataFieldName].Obj();
+    const size_t count = _bucketUnpacker.numberOfMeasurements();
+    const BlockSelection selection(count, 1);
+
+    std::vector<Value> partials;
+    StringMap<bsoncolumn::NumericBlock> blocks;
+    for (auto&& aggregate : _blockAggregates) {
+        if (aggregate.op == BlockAggregate::Op::kCount) {
+            // What $sum accumulates from a constant 1 per measurement.
+            partials.push_back(Value::createIntOrLong(count));
+            continue;
+        }
+
+        auto it = blocks.find(aggregate.inputField);
+        if (it == blocks.end()) {
+            auto block = decodeColumn(dataRegion[aggregate.inputField], count);
+            if (!block) {
+                return boost::none;
+            }
+            it = blocks.emplace(aggregate.inputField, std::move(*block)).first;
+        }
+
+        const auto& block = it->second;
+        switch (aggregate.op) {
+            case BlockAggregate::Op::kMin:
+            case BlockAggregate::Op::kMax:
+                // With both NumberInt and NumberLong values, the type of the result depends on
+                // which value wins.
+                if (block.hasInt32Values && block.hasInt64Values) {
+                    return boost::none;
+                }
+                partials.push_back(aggregate.op == BlockAggregate::Op::kMin
+                                       ? blockMin(block, selection)
+                                       : blockMax(block, selection));
+                break;
+            case BlockAggregate::Op::kSum:
+                partials.push_back(blockSum(block, selection, true /* toBeMerged */));
+                break;
+            case BlockAggregate::Op::kAvg:
+                partials.push_back(blockAvg(block, selection, true /* toBeMerged */));
+                break;
+            case BlockAggregate::Op::kCount:
+                MONGO_UNREACHABLE;
+        }
+    }
+    return partials;
+}
+
+std::vector<Value> DocumentSourceInternalUnpackBucket::aggregateMeasurements() {
+    std::vector<boost::intrusive_ptr<AccumulatorState>> accumulators;
+    for (auto&& aggregate : _blockAggregates) {
+        accumulators.push_back(makeBlockAggregateAccumulator(aggregate.op, pExpCtx.get()));
+    }
+
+    while (_bucketUnpacker.hasNext()) {
+        auto measurement = _bucketUnpacker.getNext();
+        for (size_t i = 0; i < _blockAggregates.size(); ++i) {
+            const auto& aggregate = _blockAggregates[i];
+            accumulators[i]->process(aggregate.op == BlockAggregate::Op::kCount
+                                         ? Value(1)
+                                         : measurement[aggregate.inputField],
+                                     false /* merging */);
+        }
+    }
+
+    std::vector<Value> partials;
+    for (auto&& accumulator : accumulators) {
+        partials.push_back(accumulator->getValue(true /* toBeMerged */));
+    }
+    return partials;
+}
+
 bool DocumentSourceInternalUnpackBucket::pushDownComputedMetaProjection(
     Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
     bool nextStageWasRemoved = false;
@@ -838,11 +1083,87 @@ bool DocumentSourceInternalUnpackBucket::optimizeLastpoint(Pipeline::SourceConta
     return true;
 }
 
+bool DocumentSourceInternalUnpackBucket::rewriteGroupAsBlockAggregates(
+    Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
+    auto groupPtr = dynamic_cast<DocumentSourceGroup*>(std::next(itr)->get());
+    if (!groupPtr || groupPtr->doingMerge() || _sampleSize) {
+        return false;
+    }
+
+    const auto& spec = _bucketUnpacker.bucketSpec();
+    if (!spec.computedMetaProjFields().empty()) {
+        return false;
+    }
+
+    // The partial results of a bucket only carry its metadata, which must be all the _id needs.
+    auto idDeps = groupPtr->getIdExpression()->getDependencies();
+    if (idDeps.needWholeDocument || idDeps.metadataDeps().any()) {
+        return false;
+    }
+    for (auto&& path : idDeps.fields) {
+        if (!spec.metaField() || FieldPath(path).getFieldName(0) != *spec.metaField()) {
+            return false;
+        }
+    }
+
+    std::vector<BlockAggregate> blockAggregates;
+    std::vector<AccumulationStatement> mergeStatements;
+    for (const AccumulationStatement& stmt : groupPtr->getAccumulatedFields()) {
+        BlockAggregate aggregate;
+        aggregate.outputField = str::stream() << "_blockAggregate" << blockAggregates.size();
+        if (spec.metaField() && aggregate.outputField == *spec.metaField()) {
+            return false;
+        }
+
+        const auto* exprArg = stmt.expr.argument.get();
+        const auto* exprArgConstant = dynamic_cast<const ExpressionConstant*>(exprArg);
+        const auto* exprArgPath = dynamic_cast<const ExpressionFieldPath*>(exprArg);
+        if (stmt.expr.name == AccumulatorSum::kName && exprArgConstant &&
+            exprArgConstant->getValue().getType() == BSONType::NumberInt &&
+            exprArgConstant->getValue().getInt() == 1) {
+            // {$sum: 1}, which is also what $count parses to.
+            aggregate.op = BlockAggregate::Op::kCount;
+        } else if (exprArgPath && !exprArgPath->isVariableReference() &&
+                   exprArgPath->getFieldPath().getPathLength() == 2) {
+            auto field = exprArgPath->getFieldPath().getFieldName(1);
+            auto op = parseBlockAggregateOp(stmt.expr.name);
+            if (!op || *op == BlockAggregate::Op::kCount || field == spec.timeField() ||
+                (spec.metaField() && field == *spec.metaField())) {
+                return false;
+            }
+            aggregate.op = *op;
+            aggregate.inputField = field.toString();
+        } else {
+            return false;
+        }
+
+        AccumulationExpression accExpr = stmt.expr;
+        accExpr.argument = ExpressionFieldPath::createPathFromString(
+            pExpCtx.get(), aggregate.outputField, pExpCtx->variablesParseState);
+        mergeStatements.emplace_back(stmt.fieldName, std::move(accExpr));
+        blockAggregates.push_back(std::move(aggregate));
+    }
+
+    auto mergeGroup = DocumentSourceGroup::create(pExpCtx,
+                                                  groupPtr->getIdExpression(),
+                                                  std::move(mergeStatements),
+                                                  groupPtr->getMaxMemoryUsageBytes());
+    mergeGroup->setDoingMerge(true);
+    *std::next(itr) = std::move(mergeGroup);
+    _blockAggregates = std::move(blockAggregates);
+    return true;
+}
+
 Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimizeAt(
     Pipeline::SourceContainer::iterator itr, Pipeline::SourceContainer* container) {
     invariant(*itr == this);
 
-    if (std::next(itr) == container->end()) {
+    // The block predicates are derived from the $match which directly follows this stage. Drop
+    // them until that is re-established below, in case the stages after this one have changed.
+    _bucketUnpacker.setBlockPredicates({});
+
+    // The $group following this stage merges its partial results, nothing else can be rewritten.
+    if (!_blockAggregates.empty() || std::next(itr) == container->end()) {
         return container->end();
     }
 
@@ -1028,6 +1349,22 @@ Pipeline::SourceContainer::iterator DocumentSourceInternalUnpackBucket::doOptimi
         }
     }
 
+    // Compute the accumulators of a following $group per bucket rather than per measurement.
+    if (internalQueryEnableTimeseriesBlockAggregates.load() &&
+        rewriteGroupAsBlockAggregates(itr, container)) {
+        return container->end();
+    }
+
+    // Let the unpacker reject measurements which fail simple comparisons of the following $match a
+    // whole column at a time, before they are materialized. The $match stays in the pipeline and is
+    // still applied to every measurement which does get unpacked.
+    if (internalQueryEnableTimeseriesBlockPredicates.load()) {
+        if (auto nextMatch = dynamic_cast<DocumentSourceMatch*>(std::next(itr)->get())) {
+            _bucketUnpacker.setBlockPredicates(extractBlockPredicates(
+                nextMatch->getMatchExpression(), _bucketUnpacker.bucketSpec()));
+        }
+    }
+
     return container->end();
 }
 
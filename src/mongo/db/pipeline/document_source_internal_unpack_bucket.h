@@ -30,6 +30,7 @@
 #pragma once
 
 #include <set>
+#include <string>
 #include <vector>
 
 #include "mongo/db/exec/bucket_unpacker.h"
@@ -45,6 +46,21 @@ public:
     static constexpr StringData kExclude = "exclude"_sd;
     static constexpr StringData kAssumeNoMixedSchemaData = "assumeNoMixedSchemaData"_sd;
     static constexpr StringData kBucketMaxSpanSeconds = "bucketMaxSpanSeconds"_sd;
+    static constexpr StringData kBlockAggregates = "blockAggregates"_sd;
+
+    /**
+     * An accumulator of the $group following this stage which is computed per bucket, see
+     * 'rewriteGroupAsBlockAggregates()'. Its partial result is output in 'outputField'.
+     */
+    struct BlockAggregate {
+        enum class Op { kMin, kMax, kSum, kAvg, kCount };
+
+        std::string outputField;
+        Op op;
+
+        // The measurement field the accumulator reads, empty for kCount.
+        std::string inputField;
+    };
 
     static boost::intrusive_ptr<DocumentSource> createFromBsonInternal(
         BSONElement elem, const boost::intrusive_ptr<ExpressionContext>& expCtx);
@@ -215,12 +231,37 @@ public:
     bool optimizeLastpoint(Pipeline::SourceContainer::iterator itr,
                            Pipeline::SourceContainer* container);
 
+    /**
+     * If every accumulator of the $group following this stage is a $min, $max, $sum or $avg of a
+     * measurement field or a $count, and its _id only depends on the metaField, makes this stage
+     * output the partial results of the accumulators for each bucket instead of its measurements,
+     * and replaces the $group by one which merges them. The partial results are computed over
+     * whole compressed columns where possible. Returns true if the pipeline was rewritten.
+     */
+    bool rewriteGroupAsBlockAggregates(Pipeline::SourceContainer::iterator itr,
+                                       Pipeline::SourceContainer* container);
+
+    const std::vector<BlockAggregate>& blockAggregates() const {
+        return _blockAggregates;
+    }
+
     GetModPathsReturn getModifiedPaths() const final override;
 
 private:
     GetNextResult doGetNext() final;
     bool haveComputedMetaField() const;
 
+    // Returns a document holding the metadata and the partial results of '_blockAggregates' for the
+    // bucket the unpacker was last reset to.
+    Document aggregateBucket();
+
+    // Computes the partial results of '_blockAggregates' over the decoded columns of a compressed
+    // bucket. Returns boost::none if a column can't be decoded as a block of numbers.
+    boost::optional<std::vector<Value>> aggregateBlocks() const;
+
+    // Computes the partial results of '_blockAggregates' by unpacking every measurement.
+    std::vector<Value> aggregateMeasurements();
+
     // If buckets contained a mixed type schema along some path, we have to push down special
     // predicates in order to ensure correctness.
     bool _assumeNoMixedSchemaData = false;
@@ -236,5 +277,9 @@ private:
     bool _triedBucketLevelFieldsPredicatesPushdown = false;
     bool _optimizedEndOfPipeline = false;
     bool _triedInternalizeProject = false;
+
+    // When set, each bucket is turned into a single document of partial results which the
+    // following $group merges, rather than unpacked into measurements.
+    std::vector<BlockAggregate> _blockAggregates;
 };
 }  // namespace mongo
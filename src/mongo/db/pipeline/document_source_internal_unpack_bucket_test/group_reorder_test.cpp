@@ -31,6 +31,7 @@
 
 #include "mongo/db/pipeline/aggregation_context_fixture.h"
 #include "mongo/db/query/util/make_data_structure.h"
+#include "mongo/idl/server_parameter_test_util.h"
 
 namespace mongo {
 namespace {
@@ -38,6 +39,8 @@ namespace {
 using InternalUnpackBucketGroupReorder = AggregationContextFixture;
 
 TEST_F(InternalUnpackBucketGroupReorder, OptimizeForCount) {
+    RAIIServerParameterControllerForTest controller("internalQueryEnableTimeseriesBlockAggregates",
+                                                    false);
     auto unpackSpecObj = fromjson(
         "{$_internalUnpackBucket: { include: ['a', 'b', 'c'], metaField: 'meta', timeField: 't', "
         "bucketMaxSpanSeconds: 3600}}");
@@ -95,6 +98,8 @@ TEST_F(InternalUnpackBucketGroupReorder, MinMaxGroupOnMetadata) {
 }
 
 TEST_F(InternalUnpackBucketGroupReorder, MinMaxGroupOnMetadataNegative) {
+    RAIIServerParameterControllerForTest controller("internalQueryEnableTimeseriesBlockAggregates",
+                                                    false);
     auto unpackSpecObj = fromjson(
         "{$_internalUnpackBucket: { include: ['a', 'b', 'c'], timeField: 't', metaField: 'meta', "
         "bucketMaxSpanSeconds: 3600}}");
@@ -126,5 +131,68 @@ TEST_F(InternalUnpackBucketGroupReorder, MinMaxGroupOnMetadataNegative1) {
     ASSERT_BSONOBJ_EQ(groupSpecObj, serialized[1]);
 }
 
+TEST_F(InternalUnpackBucketGroupReorder, BlockAggregatesForGroupOnMetadata) {
+    auto unpackSpecObj = fromjson(
+        "{$_internalUnpackBucket: { include: ['a', 'b', 'c'], timeField: 't', metaField: 'meta', "
+        "bucketMaxSpanSeconds: 3600}}");
+    auto groupSpecObj = fromjson(
+        "{$group: {_id: '$meta.a', mn: {$min: '$a'}, s: {$sum: '$b'}, avg: {$avg: '$c'}, "
+        "n: {$sum: 1}}}");
+
+    auto pipeline = Pipeline::parse(makeVector(unpackSpecObj, groupSpecObj), getExpCtx());
+    pipeline->optimizePipeline();
+
+    auto serialized = pipeline->serializeToBson();
+    ASSERT_EQ(2, serialized.size());
+
+    auto optimized = fromjson(
+        "{$_internalUnpackBucket: { include: ['a', 'b', 'c'], timeField: 't', metaField: 'meta', "
+        "bucketMaxSpanSeconds: 3600, blockAggregates: ["
+        "{field: '_blockAggregate0', op: '$min', input: 'a'}, "
+        "{field: '_blockAggregate1', op: '$sum', input: 'b'}, "
+        "{field: '_blockAggregate2', op: '$avg', input: 'c'}, "
+        "{field: '_blockAggregate3', op: '$count'}]}}");
+    ASSERT_BSONOBJ_EQ(optimized, serialized[0]);
+
+    auto mergeGroup = fromjson(
+        "{$group: {_id: '$meta.a', mn: {$min: '$_blockAggregate0'}, "
+        "s: {$sum: '$_blockAggregate1'}, avg: {$avg: '$_blockAggregate2'}, "
+        "n: {$sum: '$_blockAggregate3'}, $doingMerge: true}}");
+    ASSERT_BSONOBJ_EQ(mergeGroup, serialized[1]);
+
+    // Optimizing again leaves the pipeline as it is.
+    pipeline->optimizePipeline();
+    auto reoptimized = pipeline->serializeToBson();
+    ASSERT_EQ(2, reoptimized.size());
+    ASSERT_BSONOBJ_EQ(optimized, reoptimized[0]);
+    ASSERT_BSONOBJ_EQ(mergeGroup, reoptimized[1]);
+}
+
+TEST_F(InternalUnpackBucketGroupReorder, BlockAggregatesNegative) {
+    auto unpackSpecObj = fromjson(
+        "{$_internalUnpackBucket: { include: ['a', 'b', 'c'], timeField: 't', metaField: 'meta', "
+        "bucketMaxSpanSeconds: 3600}}");
+    for (auto&& groupSpecObj : {
+             // The _id depends on a measurement field.
+             fromjson("{$group: {_id: '$a', s: {$sum: '$b'}}}"),
+             // Unsupported accumulator.
+             fromjson("{$group: {_id: '$meta', f: {$first: '$b'}}}"),
+             // Dotted path.
+             fromjson("{$group: {_id: '$meta', s: {$sum: '$b.c'}}}"),
+             // Computed argument.
+             fromjson("{$group: {_id: '$meta', s: {$sum: {$add: ['$b', 1]}}}}"),
+             // Accumulating the time field.
+             fromjson("{$group: {_id: '$meta', s: {$max: '$t'}, n: {$sum: 1}}}"),
+         }) {
+        auto pipeline = Pipeline::parse(makeVector(unpackSpecObj, groupSpecObj), getExpCtx());
+        pipeline->optimizePipeline();
+
+        auto serialized = pipeline->serializeToBson();
+        ASSERT_EQ(2, serialized.size());
+        ASSERT_FALSE(serialized[0].firstElement().Obj().hasField("blockAggregates"));
+        ASSERT_FALSE(serialized[1].firstElement().Obj().hasField("$doingMerge"));
+    }
+}
+
 }  // namespace
 }  // namespace mongo
@@ -34,6 +34,7 @@
 #include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
 #include "mongo/db/pipeline/pipeline.h"
 #include "mongo/db/query/util/make_data_structure.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/bson_test_util.h"
 
 namespace mongo {
@@ -204,6 +205,8 @@ TEST_F(OptimizePipeline, MultipleMatchesPushedDownWithSort) {
 }
 
 TEST_F(OptimizePipeline, MetaMatchThenCountPushedDown) {
+    RAIIServerParameterControllerForTest controller("internalQueryEnableTimeseriesBlockAggregates",
+                                                    false);
     auto pipeline = Pipeline::parse(
         makeVector(fromjson("{$_internalUnpackBucket: { exclude: [], timeField: 'time', metaField: "
                             "'myMeta', bucketMaxSpanSeconds: 3600}}"),
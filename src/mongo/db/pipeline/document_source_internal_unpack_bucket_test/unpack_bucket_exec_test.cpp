@@ -31,6 +31,9 @@
 #include "mongo/db/pipeline/aggregation_context_fixture.h"
 #include "mongo/db/pipeline/document_source_internal_unpack_bucket.h"
 #include "mongo/db/pipeline/document_source_mock.h"
+#include "mongo/db/pipeline/pipeline.h"
+#include "mongo/db/query/util/make_data_structure.h"
+#include "mongo/db/timeseries/bucket_compression.h"
 #include "mongo/db/timeseries/timeseries_constants.h"
 
 namespace mongo {
@@ -925,5 +928,114 @@ TEST_F(InternalUnpackBucketExecTest, ParserRoundtripsComputedMetaProjFieldOverri
     unpackBucket->serializeToArray(array);
     ASSERT_BSONOBJ_EQ(array[0].getDocument().toBson(), bson);
 }
+
+TEST_F(InternalUnpackBucketExecTest, FollowingMatchSkipsMeasurementsOfCompressedBuckets) {
+    auto expCtx = getExpCtx();
+    auto pipeline = Pipeline::parse(
+        makeVector(fromjson("{$_internalUnpackBucket: {exclude: [], timeField: 'time', "
+                            "bucketMaxSpanSeconds: 3600}}"),
+                   fromjson("{$match: {a: {$gt: 4}}}")),
+        expCtx);
+    pipeline->optimizePipeline();
+
+    auto compress = [](const char* json) {
+        return Document{
+            *timeseries::compressBucket(fromjson(json), "time"_sd, {}, false).compressedBucket};
+    };
+    // The control fields of the first bucket let it past the bucket-level filter, but none of its
+    // measurements match. The second bucket has two measurements which do.
+    auto source = DocumentSourceMock::createForTest(
+        {compress("{control: {version: 1, min: {time: 1, a: 1}, max: {time: 2, a: 5}}, "
+                  "data: {time: {'0': 1, '1': 2}, a: {'0': 1, '1': 2}}}"),
+         compress("{control: {version: 1, min: {time: 3, a: 1}, max: {time: 6, a: 8}}, "
+                  "data: {time: {'0': 3, '1': 4, '2': 5, '3': 6}, "
+                  "a: {'0': 5, '1': 1, '2': 6, '3': 2}}}")},
+        expCtx);
+    pipeline->addInitialSource(source);
+
+    auto next = pipeline->getNext();
+    ASSERT_TRUE(next);
+    ASSERT_DOCUMENT_EQ(*next, Document(fromjson("{time: 3, a: 5}")));
+    next = pipeline->getNext();
+    ASSERT_TRUE(next);
+    ASSERT_DOCUMENT_EQ(*next, Document(fromjson("{time: 5, a: 6}")));
+    ASSERT_FALSE(pipeline->getNext());
+}
+
+TEST_F(InternalUnpackBucketExecTest, FollowingGroupIsComputedPerBucket) {
+    auto expCtx = getExpCtx();
+    auto pipeline = Pipeline::parse(
+        makeVector(fromjson("{$_internalUnpackBucket: {exclude: [], timeField: 'time', "
+                            "metaField: 'm', bucketMaxSpanSeconds: 3600}}"),
+                   fromjson("{$group: {_id: '$m', mn: {$min: '$a'}, mx: {$max: '$a'}, "
+                            "s: {$sum: '$a'}, avg: {$avg: '$a'}, n: {$sum: 1}}}"),
+                   fromjson("{$sort: {_id: 1}}")),
+        expCtx);
+    pipeline->optimizePipeline();
+    auto unpack = dynamic_cast<DocumentSourceInternalUnpackBucket*>(
+        pipeline->getSources().front().get());
+    ASSERT(unpack);
+    ASSERT_EQ(unpack->blockAggregates().size(), 5U);
+
+    auto compress = [](const char* json) {
+        return Document{
+            *timeseries::compressBucket(fromjson(json), "time"_sd, {}, false).compressedBucket};
+    };
+    // The first bucket is aggregated over its decoded columns. The second is not compressed and the
+    // third mixes types in a column, so both are unpacked into measurements instead.
+    auto source = DocumentSourceMock::createForTest(
+        {compress("{control: {version: 1, min: {time: 1, a: 1}, max: {time: 3, a: 5}}, m: 'x', "
+                  "data: {time: {'0': 1, '1': 2, '2': 3}, a: {'0': 1, '1': 5, '2': 2}}}"),
+         Document(fromjson("{control: {version: 1, min: {time: 4, a: 10}, max: {time: 5, a: 10}}, "
+                           "m: 'x', data: {time: {'0': 4, '1': 5}, a: {'0': 10}}}")),
+         compress("{control: {version: 1, min: {time: 6, a: 2.5}, max: {time: 7, a: 'str'}}, "
+                  "m: 'y', data: {time: {'0': 6, '1': 7}, a: {'0': 2.5, '1': 'str'}}}")},
+        expCtx);
+    pipeline->addInitialSource(source);
+
+    auto next = pipeline->getNext();
+    ASSERT_TRUE(next);
+    ASSERT_DOCUMENT_EQ(*next,
+                       Document(fromjson("{_id: 'x', mn: 1, mx: 10, s: 18, avg: 4.5, n: 5}")));
+    ASSERT_EQ((*next)["mn"].getType(), NumberInt);
+    ASSERT_EQ((*next)["s"].getType(), NumberInt);
+    next = pipeline->getNext();
+    ASSERT_TRUE(next);
+    ASSERT_DOCUMENT_EQ(
+        *next, Document(fromjson("{_id: 'y', mn: 2.5, mx: 'str', s: 2.5, avg: 2.5, n: 2}")));
+    ASSERT_FALSE(pipeline->getNext());
+}
+
+TEST_F(InternalUnpackBucketExecTest, ParserRoundtripsBlockAggregates) {
+    auto bson = fromjson(
+        "{$_internalUnpackBucket: {exclude: [], timeField: 'time', metaField: 'meta', "
+        "bucketMaxSpanSeconds: 3600, blockAggregates: [{field: 'p0', op: '$avg', input: 'a'}, "
+        "{field: 'p1', op: '$count'}]}}");
+    auto array = std::vector<Value>{};
+    DocumentSourceInternalUnpackBucket::createFromBsonInternal(bson.firstElement(), getExpCtx())
+        ->serializeToArray(array);
+    ASSERT_BSONOBJ_EQ(array[0].getDocument().toBson(), bson);
+}
+
+TEST_F(InternalUnpackBucketExecTest, ParserRejectsBadBlockAggregates) {
+    auto parse = [&](const char* blockAggregates) {
+        auto bson = fromjson(std::string{"{$_internalUnpackBucket: {exclude: [], timeField: "
+                                         "'time', bucketMaxSpanSeconds: 3600, blockAggregates: "} +
+                             blockAggregates + "}}");
+        DocumentSourceInternalUnpackBucket::createFromBsonInternal(bson.firstElement(),
+                                                                   getExpCtx());
+    };
+    ASSERT_THROWS_CODE(parse("{}"), AssertionException, 6610816);
+    ASSERT_THROWS_CODE(parse("[1]"), AssertionException, 6610817);
+    ASSERT_THROWS_CODE(parse("[{op: '$min', input: 'a'}]"), AssertionException, 6610811);
+    ASSERT_THROWS_CODE(
+        parse("[{field: 'p0', op: '$first', input: 'a'}]"), AssertionException, 6610812);
+    ASSERT_THROWS_CODE(
+        parse("[{field: 'p0', op: '$count', input: 'a'}]"), AssertionException, 6610813);
+    ASSERT_THROWS_CODE(parse("[{field: 'p0', op: '$sum'}]"), AssertionException, 6610814);
+    ASSERT_THROWS_CODE(
+        parse("[{field: 'p0', op: '$sum', input: 'a.b'}]"), AssertionException, 6610815);
+}
+
 }  // namespace
 }  // namespace mongo
@@ -33,6 +33,7 @@
 
 #include "mongo/db/pipeline/document_source_lookup.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "mongo/base/init.h"
@@ -40,6 +41,7 @@
 #include "mongo/db/exec/document_value/value.h"
 #include "mongo/db/jsobj.h"
 #include "mongo/db/matcher/expression_algo.h"
+#include "mongo/db/matcher/expression_parser.h"
 #include "mongo/db/pipeline/aggregation_request_helper.h"
 #include "mongo/db/pipeline/document_path_support.h"
 #include "mongo/db/pipeline/document_source_documents.h"
@@ -426,17 +428,23 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
         return unwindResult();
     }
 
+    // If we have not absorbed a $unwind, we cannot absorb a $match. If we have absorbed a $unwind,
+    // '_unwindSrc' would be non-null, and we would not have made it here.
+    invariant(!_matchSrc);
+
+    if (canBatchLocalFieldForeignFieldJoin()) {
+        return batchedResult();
+    }
+
     auto nextInput = pSource->getNext();
     if (!nextInput.isAdvanced()) {
         return nextInput;
     }
 
-    auto inputDoc = nextInput.releaseDocument();
-
-    // If we have not absorbed a $unwind, we cannot absorb a $match. If we have absorbed a $unwind,
-    // '_unwindSrc' would be non-null, and we would not have made it here.
-    invariant(!_matchSrc);
+    return lookUpSingleDocument(nextInput.releaseDocument());
+}
 
+Document DocumentSourceLookUp::lookUpSingleDocument(Document inputDoc) {
     if (hasLocalFieldForeignFieldJoin()) {
         auto matchStage =
             makeMatchStageFromInput(inputDoc, *_localField, _foreignField->fullPath(), BSONObj());
@@ -444,9 +452,35 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
         _resolvedPipeline[*_fieldMatchPipelineIdx] = matchStage;
     }
 
-    std::unique_ptr<Pipeline, PipelineDeleter> pipeline;
+    auto pipeline = buildPipelineCheckingShardedForeign(inputDoc);
+
+    std::vector<Value> results;
+    long long objsize = 0;
+    const auto maxBytes = internalLookupStageIntermediateDocumentMaxSizeBytes.load();
+
+    while (auto result = pipeline->getNext()) {
+        long long safeSum = 0;
+        bool hasOverflowed = overflow::add(objsize, result->getApproximateSize(), &safeSum);
+        uassert(4568,
+                str::stream() << "Total size of documents in " << _fromNs.coll()
+                              << " matching pipeline's $lookup stage exceeds " << maxBytes
+                              << " bytes",
+
+                !hasOverflowed && objsize <= maxBytes);
+        objsize = safeSum;
+        results.emplace_back(std::move(*result));
+    }
+
+    accumulatePipelinePlanSummaryStats(*pipeline, _stats.planSummaryStats);
+    MutableDocument output(std::move(inputDoc));
+    output.setNestedField(_as, Value(std::move(results)));
+    return output.freeze();
+}
+
+std::unique_ptr<Pipeline, PipelineDeleter>
+DocumentSourceLookUp::buildPipelineCheckingShardedForeign(const Document& inputDoc) {
     try {
-        pipeline = buildPipeline(inputDoc);
+        return buildPipeline(inputDoc);
     } catch (const ExceptionForCat<ErrorCategory::StaleShardVersionError>& ex) {
         // If lookup on a sharded collection is disallowed and the foreign collection is sharded,
         // throw a custom exception.
@@ -464,28 +498,208 @@ DocumentSource::GetNextResult DocumentSourceLookUp::doGetNext() {
         }
         throw;
     }
+}
 
-    std::vector<Value> results;
-    long long objsize = 0;
-    const auto maxBytes = internalLookupStageIntermediateDocumentMaxSizeBytes.load();
+bool DocumentSourceLookUp::canBatchLocalFieldForeignFieldJoin() const {
+    if (!hasLocalFieldForeignFieldJoin() || hasPipeline() || _unwindSrc ||
+        internalLookupLocalFieldJoinBatchSize.load() <= 1) {
+        return false;
+    }
 
-    while (auto result = pipeline->getNext()) {
-        long long safeSum = 0;
-        bool hasOverflowed = overflow::add(objsize, result->getApproximateSize(), &safeSum);
-        uassert(4568,
-                str::stream() << "Total size of documents in " << _fromNs.coll()
-                              << " matching pipeline's $lookup stage exceeds " << maxBytes
-                              << " bytes",
+    // The matches of each local document are found by looking up the values along the foreign
+    // path, which does not follow numeric path components the way the query language does (e.g.
+    // "a.0" also names the field "0" of the documents in the array "a").
+    for (size_t i = 0; i < _foreignField->getPathLength(); ++i) {
+        if (str::parseUnsignedBase10Integer(_foreignField->getFieldName(i))) {
+            return false;
+        }
+    }
+    return true;
+}
 
-                !hasOverflowed && objsize <= maxBytes);
-        objsize = safeSum;
-        results.emplace_back(std::move(*result));
+DocumentSource::GetNextResult DocumentSourceLookUp::batchedResult() {
+    if (_batchedResults.empty()) {
+        if (_pendingInputResult) {
+            auto pendingInputResult = std::move(*_pendingInputResult);
+            _pendingInputResult.reset();
+            return pendingInputResult;
+        }
+
+        const size_t batchSize = internalLookupLocalFieldJoinBatchSize.load();
+        std::vector<Document> localDocs;
+        while (localDocs.size() < batchSize) {
+            auto nextInput = pSource->getNext();
+            if (!nextInput.isAdvanced()) {
+                if (localDocs.empty()) {
+                    return nextInput;
+                }
+                // Return the documents we already have before propagating the pause or EOF.
+                _pendingInputResult = std::move(nextInput);
+                break;
+            }
+            localDocs.push_back(nextInput.releaseDocument());
+        }
+
+        if (localDocs.size() == 1) {
+            return lookUpSingleDocument(std::move(localDocs.front()));
+        }
+        lookUpBatch(std::move(localDocs));
     }
 
-    accumulatePipelinePlanSummaryStats(*pipeline, _stats.planSummaryStats);
-    MutableDocument output(std::move(inputDoc));
-    output.setNestedField(_as, Value(std::move(results)));
-    return output.freeze();
+    auto output = std::move(_batchedResults.front());
+    _batchedResults.pop_front();
+    return output;
+}
+
+void DocumentSourceLookUp::lookUpBatch(std::vector<Document> localDocs) {
+    const auto& foreignFieldName = _foreignField->fullPath();
+    const auto& valueComparator = _fromExpCtx->getValueComparator();
+
+    // Gather the distinct local values of the whole batch. As in makeMatchStageFromInput(), a
+    // missing local value is looked up as null.
+    auto seenValues = valueComparator.makeUnorderedValueSet();
+    BSONArrayBuilder localValues;
+    bool containsRegex = false;
+    auto addLocalValue = [&](const Value& value) {
+        if (seenValues.insert(value).second) {
+            localValues << value;
+            containsRegex = containsRegex || value.getType() == BSONType::RegEx;
+        }
+    };
+    for (auto&& localDoc : localDocs) {
+        bool hasValue = false;
+        document_path_support::visitAllValuesAtPath(
+            localDoc, *_localField, [&](const Value& value) {
+                addLocalValue(value);
+                hasValue = true;
+            });
+        if (!hasValue) {
+            addLocalValue(Value(BSONNULL));
+        }
+    }
+
+    // A single {$in: [...]} over all the values lets the query planner sort and deduplicate them
+    // into the bounds of one forward index scan, instead of seeking the index once per local
+    // document. If the values would not fit in a reasonably sized query, fall back to looking up
+    // the documents one by one.
+    if (localValues.len() > BSONObjMaxUserSize / 2) {
+        for (auto&& localDoc : localDocs) {
+            _batchedResults.push_back(lookUpSingleDocument(std::move(localDoc)));
+        }
+        return;
+    }
+    const auto localValueList = localValues.arr();
+    _resolvedPipeline[*_fieldMatchPipelineIdx] = BSON(
+        "$match" << (containsRegex
+                         ? buildEqualityOrQuery(foreignFieldName, localValueList)
+                         : BSON(foreignFieldName << BSON("$in" << localValueList))));
+
+    std::vector<Document> foreignDocs;
+    std::vector<BSONObj> foreignObjs;
+    {
+        auto pipeline = buildPipelineCheckingShardedForeign(localDocs.front());
+
+        long long objsize = 0;
+        const auto maxBytes = internalLookupStageIntermediateDocumentMaxSizeBytes.load();
+        while (auto result = pipeline->getNext()) {
+            long long safeSum = 0;
+            if (overflow::add(objsize, result->getApproximateSize(), &safeSum) ||
+                safeSum > maxBytes) {
+                // The matches of the whole batch do not fit in memory. Fall back to looking up the
+                // documents one by one, which enforces the limit on each of them separately.
+                accumulatePipelinePlanSummaryStats(*pipeline, _stats.planSummaryStats);
+                pipeline.reset();
+                for (auto&& localDoc : localDocs) {
+                    _batchedResults.push_back(lookUpSingleDocument(std::move(localDoc)));
+                }
+                return;
+            }
+            objsize = safeSum;
+            foreignObjs.push_back(result->toBson());
+            foreignDocs.push_back(std::move(*result));
+        }
+        accumulatePipelinePlanSummaryStats(*pipeline, _stats.planSummaryStats);
+    }
+
+    // Index the foreign documents by every value along the foreign path. This gives the matches of
+    // each scalar local value other than null, since an equality predicate on a path matches a
+    // document exactly when one of the values along the path is equal.
+    auto foreignDocsByValue = valueComparator.makeUnorderedValueMap<std::vector<size_t>>();
+    for (size_t i = 0; i < foreignDocs.size(); ++i) {
+        document_path_support::visitAllValuesAtPath(
+            foreignDocs[i], *_foreignField, [&](const Value& value) {
+                auto& docIndexes = foreignDocsByValue[value];
+                if (docIndexes.empty() || docIndexes.back() != i) {
+                    docIndexes.push_back(i);
+                }
+            });
+    }
+
+    // Null also matches missing foreign values, and an array also matches an equal foreign array as
+    // a whole, neither of which is in the index. The matches of each such value are found by
+    // running the predicate the unbatched join would have used against every foreign document,
+    // once per batch.
+    auto foreignDocsByOtherValue = valueComparator.makeUnorderedValueMap<std::vector<size_t>>();
+    auto matchOtherValue = [&](const Value& value) -> const std::vector<size_t>& {
+        auto [it, inserted] = foreignDocsByOtherValue.try_emplace(value);
+        if (inserted) {
+            auto matcher = uassertStatusOK(MatchExpressionParser::parse(
+                BSON(foreignFieldName << BSON("$eq" << value)), _fromExpCtx));
+            for (size_t i = 0; i < foreignObjs.size(); ++i) {
+                if (matcher->matchesBSON(foreignObjs[i])) {
+                    it->second.push_back(i);
+                }
+            }
+        }
+        return it->second;
+    };
+
+    const auto maxBytes = internalLookupStageIntermediateDocumentMaxSizeBytes.load();
+    for (auto&& localDoc : localDocs) {
+        std::vector<size_t> matches;
+        auto addMatches = [&](const std::vector<size_t>& docIndexes) {
+            matches.insert(matches.end(), docIndexes.begin(), docIndexes.end());
+        };
+        bool hasValue = false;
+        document_path_support::visitAllValuesAtPath(
+            localDoc, *_localField, [&](const Value& value) {
+                hasValue = true;
+                if (value.nullish() || value.isArray()) {
+                    addMatches(matchOtherValue(value));
+                } else if (auto it = foreignDocsByValue.find(value);
+                           it != foreignDocsByValue.end()) {
+                    addMatches(it->second);
+                }
+            });
+        if (!hasValue) {
+            // As in makeMatchStageFromInput(), a missing local value is looked up as null.
+            addMatches(matchOtherValue(Value(BSONNULL)));
+        }
+
+        // Return the matches in the order the foreign query produced them, each of them once.
+        std::sort(matches.begin(), matches.end());
+        matches.erase(std::unique(matches.begin(), matches.end()), matches.end());
+
+        std::vector<Value> results;
+        long long objsize = 0;
+        for (auto i : matches) {
+            long long safeSum = 0;
+            bool hasOverflowed =
+                overflow::add(objsize, foreignDocs[i].getApproximateSize(), &safeSum);
+            uassert(4568,
+                    str::stream() << "Total size of documents in " << _fromNs.coll()
+                                  << " matching pipeline's $lookup stage exceeds " << maxBytes
+                                  << " bytes",
+
+                    !hasOverflowed && objsize <= maxBytes);
+            objsize = safeSum;
+            results.emplace_back(foreignDocs[i]);
+        }
+
+        MutableDocument output(std::move(localDoc));
+        output.setNestedField(_as, Value(std::move(results)));
+        _batchedResults.push_back(output.freeze());
+    }
 }
 
 std::unique_ptr<Pipeline, PipelineDeleter> DocumentSourceLookUp::buildPipelineFromViewDefinition(
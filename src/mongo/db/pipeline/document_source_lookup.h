@@ -30,6 +30,7 @@
 #pragma once
 
 #include <boost/optional.hpp>
+#include <deque>
 
 #include "mongo/db/exec/document_value/value_comparator.h"
 #include "mongo/db/pipeline/document_source.h"
@@ -296,6 +297,40 @@ private:
 
     GetNextResult unwindResult();
 
+    /**
+     * Returns true if this $lookup can query the foreign collection on behalf of several local
+     * documents at once. This is only the case for the plain localField/foreignField syntax, where
+     * the foreign pipeline consists of nothing but the join $match.
+     */
+    bool canBatchLocalFieldForeignFieldJoin() const;
+
+    /**
+     * Produces the next result of a batched localField/foreignField join. Pulls up to
+     * 'internalLookupLocalFieldJoinBatchSize' documents from the source, looks all of them up with
+     * a single foreign query, and buffers the joined documents in '_batchedResults'.
+     */
+    GetNextResult batchedResult();
+
+    /**
+     * Runs one foreign query for all the documents in 'localDocs' and appends the joined documents
+     * to '_batchedResults', in order. The matches of each local document are selected from the
+     * combined result using the same predicate the unbatched join would have run.
+     */
+    void lookUpBatch(std::vector<Document> localDocs);
+
+    /**
+     * Runs the foreign pipeline for 'inputDoc' alone and returns it with the matches stored in the
+     * 'as' field.
+     */
+    Document lookUpSingleDocument(Document inputDoc);
+
+    /**
+     * Calls buildPipeline(), reporting a more specific error if the foreign collection turns out
+     * to be sharded when that is not allowed.
+     */
+    std::unique_ptr<Pipeline, PipelineDeleter> buildPipelineCheckingShardedForeign(
+        const Document& inputDoc);
+
     /**
      * Resolves let defined variables against 'localDoc' and stores the results in 'variables'.
      */
@@ -409,6 +444,13 @@ private:
     std::unique_ptr<Pipeline, PipelineDeleter> _pipeline;
     boost::optional<Document> _input;
     boost::optional<Document> _nextValue;
+
+    // The following members are used to hold onto state across getNext() calls when the
+    // localField/foreignField join is batched. '_batchedResults' holds the joined documents of
+    // the current batch, and '_pendingInputResult' holds the pause or EOF that ended the batch
+    // until all of them have been returned.
+    std::deque<Document> _batchedResults;
+    boost::optional<GetNextResult> _pendingInputResult;
 };
 
 }  // namespace mongo
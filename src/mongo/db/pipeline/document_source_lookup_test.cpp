@@ -50,6 +50,7 @@
 #include "mongo/db/repl/replication_coordinator_mock.h"
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/server_options.h"
+#include "mongo/idl/server_parameter_test_util.h"
 
 namespace mongo {
 namespace {
@@ -834,12 +835,18 @@ public:
 
         pipeline->addInitialSource(
             DocumentSourceMock::createForTest(_mockResults, pipeline->getContext()));
+        ++_numPipelinesAttached;
         return pipeline;
     }
 
+    int numPipelinesAttached() const {
+        return _numPipelinesAttached;
+    }
+
 private:
     deque<DocumentSource::GetNextResult> _mockResults;
     bool _removeLeadingQueryStages = false;
+    int _numPipelinesAttached = 0;
 };
 
 TEST_F(DocumentSourceLookUpTest, ShouldPropagatePauses) {
@@ -948,6 +955,151 @@ TEST_F(DocumentSourceLookUpTest, ShouldPropagatePausesWhileUnwinding) {
     lookup->dispose();
 }
 
+TEST_F(DocumentSourceLookUpTest, ShouldLookUpLocalFieldForeignFieldJoinInBatches) {
+    RAIIServerParameterControllerForTest batchSize("internalLookupLocalFieldJoinBatchSize", 3);
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+
+    // Mock out the foreign collection.
+    deque<DocumentSource::GetNextResult> mockForeignContents{
+        Document{{"_id", 0}, {"key", 1}},
+        Document{{"_id", 1}, {"key", {2, 5}}},
+        Document{{"_id", 2}, {"key", BSONNULL}},
+        Document{{"_id", 3}},
+        Document{{"_id", 4}, {"key", 1.0}}};
+    auto mongoProcessInterface =
+        std::make_shared<MockMongoInterface>(std::move(mockForeignContents));
+    expCtx->mongoProcessInterface = mongoProcessInterface;
+
+    // Set up the $lookup stage.
+    auto lookupSpec = Document{{"$lookup",
+                                Document{{"from", fromNs.coll()},
+                                         {"localField", "localKey"_sd},
+                                         {"foreignField", "key"_sd},
+                                         {"as", "foreignDocs"_sd}}}}
+                          .toBson();
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    // The first batch is cut short by the pause, the second one by the batch size.
+    auto mockLocalSource =
+        DocumentSourceMock::createForTest({Document{{"_id", 0}, {"localKey", 1}},
+                                           Document{{"_id", 1}, {"localKey", {1, 2}}},
+                                           DocumentSource::GetNextResult::makePauseExecution(),
+                                           Document{{"_id", 2}},
+                                           Document{{"_id", 3}, {"localKey", 3}},
+                                           Document{{"_id", 4}, {"localKey", 5}},
+                                           Document{{"_id", 5}, {"localKey", 2}}},
+                                          expCtx);
+    lookup->setSource(mockLocalSource.get());
+
+    Document foreignDocs[] = {Document{{"_id", 0}, {"key", 1}},
+                              Document{{"_id", 1}, {"key", {2, 5}}},
+                              Document{{"_id", 2}, {"key", BSONNULL}},
+                              Document{{"_id", 3}},
+                              Document{{"_id", 4}, {"key", 1.0}}};
+
+    auto next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(
+        next.releaseDocument(),
+        (Document{{"_id", 0}, {"localKey", 1}, {"foreignDocs", {foreignDocs[0], foreignDocs[4]}}}));
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(
+        next.releaseDocument(),
+        (Document{{"_id", 1},
+                  {"localKey", {1, 2}},
+                  {"foreignDocs", {foreignDocs[0], foreignDocs[1], foreignDocs[4]}}}));
+    ASSERT_EQ(mongoProcessInterface->numPipelinesAttached(), 1);
+
+    ASSERT_TRUE(lookup->getNext().isPaused());
+
+    // A missing local value matches null and missing foreign values.
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       (Document{{"_id", 2}, {"foreignDocs", {foreignDocs[2], foreignDocs[3]}}}));
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       (Document{{"_id", 3}, {"localKey", 3}, {"foreignDocs", vector<Value>{}}}));
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       (Document{{"_id", 4}, {"localKey", 5}, {"foreignDocs", {foreignDocs[1]}}}));
+    ASSERT_EQ(mongoProcessInterface->numPipelinesAttached(), 2);
+
+    next = lookup->getNext();
+    ASSERT_TRUE(next.isAdvanced());
+    ASSERT_DOCUMENT_EQ(next.releaseDocument(),
+                       (Document{{"_id", 5}, {"localKey", 2}, {"foreignDocs", {foreignDocs[1]}}}));
+    ASSERT_EQ(mongoProcessInterface->numPipelinesAttached(), 3);
+
+    ASSERT_TRUE(lookup->getNext().isEOF());
+    ASSERT_TRUE(lookup->getNext().isEOF());
+    lookup->dispose();
+}
+
+TEST_F(DocumentSourceLookUpTest, ShouldLookUpNullAndArrayLocalValuesInOneBatch) {
+    RAIIServerParameterControllerForTest batchSize("internalLookupLocalFieldJoinBatchSize", 10);
+    auto expCtx = getExpCtx();
+    NamespaceString fromNs("test", "foreign");
+    expCtx->setResolvedNamespaces(StringMap<ExpressionContext::ResolvedNamespace>{
+        {fromNs.coll().toString(), {fromNs, std::vector<BSONObj>()}}});
+
+    Document foreignDocs[] = {Document{{"_id", 0}, {"key", 1}},
+                              Document{{"_id", 1}, {"key", {2, 5}}},
+                              Document{{"_id", 2}, {"key", BSONNULL}},
+                              Document{{"_id", 3}}};
+    auto mongoProcessInterface = std::make_shared<MockMongoInterface>(
+        deque<DocumentSource::GetNextResult>(std::begin(foreignDocs), std::end(foreignDocs)));
+    expCtx->mongoProcessInterface = mongoProcessInterface;
+
+    auto lookupSpec = Document{{"$lookup",
+                                Document{{"from", fromNs.coll()},
+                                         {"localField", "localKey"_sd},
+                                         {"foreignField", "key"_sd},
+                                         {"as", "foreignDocs"_sd}}}}
+                          .toBson();
+    auto parsed = DocumentSourceLookUp::createFromBson(lookupSpec.firstElement(), expCtx);
+    auto lookup = static_cast<DocumentSourceLookUp*>(parsed.get());
+
+    // Null, missing and nested array local values are all joined in the same batch as the scalar
+    // ones, each against the matches a foreign query on that value would have returned.
+    auto nestedArray = vector<Value>{Value(vector<Value>{Value(2), Value(5)})};
+    auto mockLocalSource =
+        DocumentSourceMock::createForTest({Document{{"_id", 0}, {"localKey", BSONNULL}},
+                                           Document{{"_id", 1}, {"localKey", nestedArray}},
+                                           Document{{"_id", 2}},
+                                           Document{{"_id", 3}, {"localKey", {1, BSONNULL}}},
+                                           Document{{"_id", 4}, {"localKey", 5}}},
+                                          expCtx);
+    lookup->setSource(mockLocalSource.get());
+
+    Document expected[] = {
+        Document{{"_id", 0},
+                 {"localKey", BSONNULL},
+                 {"foreignDocs", {foreignDocs[2], foreignDocs[3]}}},
+        Document{{"_id", 1}, {"localKey", nestedArray}, {"foreignDocs", {foreignDocs[1]}}},
+        Document{{"_id", 2}, {"foreignDocs", {foreignDocs[2], foreignDocs[3]}}},
+        Document{{"_id", 3},
+                 {"localKey", {1, BSONNULL}},
+                 {"foreignDocs", {foreignDocs[0], foreignDocs[2], foreignDocs[3]}}},
+        Document{{"_id", 4}, {"localKey", 5}, {"foreignDocs", {foreignDocs[1]}}}};
+    for (auto&& doc : expected) {
+        auto next = lookup->getNext();
+        ASSERT_TRUE(next.isAdvanced());
+        ASSERT_DOCUMENT_EQ(next.releaseDocument(), doc);
+    }
+    ASSERT_EQ(mongoProcessInterface->numPipelinesAttached(), 1);
+
+    ASSERT_TRUE(lookup->getNext().isEOF());
+    lookup->dispose();
+}
+
 TEST_F(DocumentSourceLookUpTest, LookupReportsAsFieldIsModified) {
     auto expCtx = getExpCtx();
     NamespaceString fromNs("test", "foreign");
@@ -0,0 +1,227 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/db/query/ce/ce_histogram.h"
+
+#include "mongo/db/query/optimizer/cascades/ce_heuristic.h"
+
+namespace mongo::optimizer::cascades {
+
+using namespace properties;
+
+namespace {
+
+/**
+ * Converts a path of the form Get "a" Traverse Get "b" ... Id into the dotted field path "a.b".
+ * Statistics are gathered on the value at the end of the dotted path, so traversals in the middle
+ * of the path are assumed not to encounter arrays. Sets 'traverseLeaf' if the path ends with a
+ * traversal, i.e. elements of arrays at the end of the path are matched too.
+ */
+bool extractFieldPath(const ABT& path, std::string& fieldPath, bool& traverseLeaf) {
+    traverseLeaf = false;
+    const ABT* current = &path;
+    while (!current->is<PathIdentity>()) {
+        if (const auto* getPtr = current->cast<PathGet>()) {
+            if (!fieldPath.empty()) {
+                fieldPath += '.';
+            }
+            fieldPath += getPtr->name();
+            traverseLeaf = false;
+            current = &getPtr->getPath();
+        } else if (const auto* traversePtr = current->cast<PathTraverse>()) {
+            traverseLeaf = true;
+            current = &traversePtr->getPath();
+        } else {
+            // Other path elements, e.g. those produced for $elemMatch, are not supported.
+            return false;
+        }
+    }
+    return !fieldPath.empty();
+}
+
+boost::optional<ce::SBEValue> getConstantBound(const BoundRequirement& bound) {
+    if (const auto* constPtr = bound.getBound().cast<Constant>()) {
+        return constPtr->get();
+    }
+    return boost::none;
+}
+
+}  // namespace
+
+class CEHistogramTransport {
+public:
+    CEType transport(const ABT& n,
+                     const SargableNode& node,
+                     const Memo& memo,
+                     const LogicalProps& logicalProps,
+                     CEType childResult,
+                     CEType /*bindsResult*/,
+                     CEType /*refsResult*/) {
+        if (!hasProperty<IndexingAvailability>(logicalProps)) {
+            return _heuristicCE.deriveCE(memo, logicalProps, n.ref());
+        }
+
+        const auto& indexingAvailability = getPropertyConst<IndexingAvailability>(logicalProps);
+        auto statsIt = _stats.find(indexingAvailability.getScanDefName());
+        if (statsIt == _stats.cend() || !statsIt->second) {
+            return _heuristicCE.deriveCE(memo, logicalProps, n.ref());
+        }
+
+        // Assume independence between the requirements.
+        SelectivityType selectivity = 1.0;
+        for (const auto& [key, req] : node.getReqMap()) {
+            if (isIntervalReqFullyOpenDNF(req.getIntervals())) {
+                continue;
+            }
+
+            auto keySel = estimateKeySelectivity(
+                *statsIt->second, indexingAvailability.getScanProjection(), key, req);
+            if (!keySel) {
+                return _heuristicCE.deriveCE(memo, logicalProps, n.ref());
+            }
+            selectivity *= *keySel;
+        }
+
+        return childResult * selectivity;
+    }
+
+    template <typename T, typename... Ts>
+    CEType transport(const ABT& n,
+                     const T& /*node*/,
+                     const Memo& memo,
+                     const LogicalProps& logicalProps,
+                     Ts&&...) {
+        if (canBeLogicalNode<T>()) {
+            return _heuristicCE.deriveCE(memo, logicalProps, n.ref());
+        }
+        return 0.0;
+    }
+
+    static CEType derive(const Memo& memo,
+                         const ScanDefStatistics& stats,
+                         const LogicalProps& logicalProps,
+                         const ABT::reference_type logicalNodeRef) {
+        CEHistogramTransport instance(stats);
+        return algebra::transport<true>(logicalNodeRef, instance, memo, logicalProps);
+    }
+
+private:
+    CEHistogramTransport(const ScanDefStatistics& stats) : _heuristicCE(), _stats(stats) {}
+
+    /**
+     * Returns boost::none if the requirement cannot be estimated from the statistics.
+     */
+    boost::optional<SelectivityType> estimateKeySelectivity(
+        const ce::CollectionStatistics& stats,
+        const ProjectionName& scanProjection,
+        const PartialSchemaKey& key,
+        const PartialSchemaRequirement& req) {
+        if (key._projectionName != scanProjection) {
+            return boost::none;
+        }
+
+        std::string fieldPath;
+        bool traverseLeaf = false;
+        if (!extractFieldPath(key._path, fieldPath, traverseLeaf)) {
+            return boost::none;
+        }
+
+        const ce::PathStatistics* pathStats = stats.getPathStatistics(fieldPath);
+        if (!pathStats || pathStats->getDocumentCount() <= 0.0) {
+            return boost::none;
+        }
+
+        return estimateIntervals(*pathStats, traverseLeaf, req.getIntervals());
+    }
+
+    boost::optional<SelectivityType> estimateIntervals(const ce::PathStatistics& pathStats,
+                                                       const bool traverseLeaf,
+                                                       const IntervalReqExpr::Node& intervals) {
+        if (const auto* atomPtr = intervals.cast<IntervalReqExpr::Atom>()) {
+            const IntervalRequirement& interval = atomPtr->getExpr();
+            if (interval.isFullyOpen()) {
+                return 1.0;
+            }
+
+            const auto& lowBound = interval.getLowBound();
+            const auto& highBound = interval.getHighBound();
+            boost::optional<ce::SBEValue> low;
+            boost::optional<ce::SBEValue> high;
+            if (!lowBound.isInfinite() && !(low = getConstantBound(lowBound))) {
+                return boost::none;
+            }
+            if (!highBound.isInfinite() && !(high = getConstantBound(highBound))) {
+                return boost::none;
+            }
+
+            const double count = pathStats.estimateInterval(low,
+                                                            lowBound.isInclusive(),
+                                                            high,
+                                                            highBound.isInclusive(),
+                                                            traverseLeaf);
+            return count / pathStats.getDocumentCount();
+        } else if (const auto* conjPtr = intervals.cast<IntervalReqExpr::Conjunction>()) {
+            // Assume independence between the conjuncts.
+            SelectivityType result = 1.0;
+            for (const auto& child : conjPtr->nodes()) {
+                auto childSel = estimateIntervals(pathStats, traverseLeaf, child);
+                if (!childSel) {
+                    return boost::none;
+                }
+                result *= *childSel;
+            }
+            return result;
+        } else if (const auto* disjPtr = intervals.cast<IntervalReqExpr::Disjunction>()) {
+            // Assume the disjuncts (e.g. the values of an $in) do not overlap.
+            SelectivityType result = 0.0;
+            for (const auto& child : disjPtr->nodes()) {
+                auto childSel = estimateIntervals(pathStats, traverseLeaf, child);
+                if (!childSel) {
+                    return boost::none;
+                }
+                result += *childSel;
+            }
+            return std::min(result, 1.0);
+        }
+        MONGO_UNREACHABLE;
+    }
+
+    HeuristicCE _heuristicCE;
+
+    // We don't own this.
+    const ScanDefStatistics& _stats;
+};
+
+CEType HistogramCE::deriveCE(const Memo& memo,
+                             const LogicalProps& logicalProps,
+                             const ABT::reference_type logicalNodeRef) const {
+    return CEHistogramTransport::derive(memo, _stats, logicalProps, logicalNodeRef);
+}
+
+}  // namespace mongo::optimizer::cascades
@@ -0,0 +1,67 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "mongo/db/query/ce/stats_catalog.h"
+#include "mongo/db/query/optimizer/cascades/interfaces.h"
+
+namespace mongo::optimizer::cascades {
+
+/**
+ * Maps a scan definition name to the statistics of the collection it scans.
+ */
+using ScanDefStatistics = std::map<std::string, std::shared_ptr<const ce::CollectionStatistics>>;
+
+/**
+ * Estimation based on the histograms persisted by 'analyze'. SargableNodes over a collection with
+ * statistics for every constrained path are estimated from the histograms, assuming independence
+ * between paths. Everything else is estimated using heuristics.
+ *
+ * Only paths made of field accesses and array traversals are estimated from the histograms.
+ * Predicates whose path contains anything else, such as the lambdas and composite paths built for
+ * $elemMatch, fall back to heuristics for the whole SargableNode.
+ */
+class HistogramCE : public CEInterface {
+public:
+    HistogramCE(ScanDefStatistics stats) : _stats(std::move(stats)) {}
+
+    CEType deriveCE(const Memo& memo,
+                    const properties::LogicalProps& logicalProps,
+                    ABT::reference_type logicalNodeRef) const override final;
+
+private:
+    ScanDefStatistics _stats;
+};
+
+}  // namespace mongo::optimizer::cascades
@@ -0,0 +1,127 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/db/query/ce/ce_histogram.h"
+
+#include "mongo/db/query/optimizer/cascades/cost_derivation.h"
+#include "mongo/db/query/optimizer/explain.h"
+#include "mongo/db/query/optimizer/metadata.h"
+#include "mongo/db/query/optimizer/node.h"
+#include "mongo/db/query/optimizer/opt_phase_manager.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo::optimizer {
+namespace {
+
+using cascades::HistogramCE;
+using cascades::ScanDefStatistics;
+
+/**
+ * Statistics for a collection of 100 documents where 'selectivePath' equals 'selectiveValue' in a
+ * single document and 'unselectivePath' equals 'unselectiveValue' in 90 documents. Both paths
+ * equal 100 in all other documents.
+ */
+std::shared_ptr<const ce::CollectionStatistics> makeStats(StringData selectivePath,
+                                                          int selectiveValue,
+                                                          StringData unselectivePath,
+                                                          int unselectiveValue) {
+    std::vector<BSONObj> docs;
+    for (int i = 0; i < 100; ++i) {
+        docs.push_back(BSON(selectivePath << (i == 0 ? selectiveValue : 100) << unselectivePath
+                                          << (i < 90 ? unselectiveValue : 100)));
+    }
+
+    StringMap<ce::PathStatistics> paths;
+    paths.emplace(selectivePath.toString(),
+                  ce::PathStatistics::make(docs, selectivePath, 10 /* maxBuckets */));
+    paths.emplace(unselectivePath.toString(),
+                  ce::PathStatistics::make(docs, unselectivePath, 10 /* maxBuckets */));
+    return std::make_shared<const ce::CollectionStatistics>(std::move(paths));
+}
+
+/**
+ * Optimizes {a: 1, b: 2} over collection 'c1' with the given statistics and returns the explain of
+ * each filter of the plan, from the innermost (applied first) to the outermost.
+ */
+std::vector<std::string> optimizeFilters(std::shared_ptr<const ce::CollectionStatistics> stats) {
+    PrefixId prefixId;
+
+    // Apply the predicate on 'b' first in the input so that using the statistics to estimate the
+    // predicate on 'a' as the more selective one reorders the filters.
+    ABT result = make<ScanNode>("root", "c1");
+    for (auto&& [field, value] : std::vector<std::pair<std::string, int64_t>>{{"b", 2}, {"a", 1}}) {
+        result = make<FilterNode>(
+            make<EvalFilter>(make<PathGet>(field,
+                                           make<PathTraverse>(make<PathCompare>(
+                                               Operations::Eq, Constant::int64(value)))),
+                             make<Variable>("root")),
+            std::move(result));
+    }
+    ABT optimized =
+        make<RootNode>(ProjectionRequirement{ProjectionNameVector{"root"}}, std::move(result));
+
+    ScanDefStatistics scanDefStats;
+    scanDefStats.emplace("c1", std::move(stats));
+    OptPhaseManager phaseManager({OptPhaseManager::OptPhase::MemoSubstitutionPhase,
+                                  OptPhaseManager::OptPhase::MemoExplorationPhase,
+                                  OptPhaseManager::OptPhase::MemoImplementationPhase},
+                                 prefixId,
+                                 false /*requireRID*/,
+                                 {{{"c1", ScanDefinition{{}, {}}}}},
+                                 std::make_unique<HistogramCE>(std::move(scanDefStats)),
+                                 std::make_unique<DefaultCosting>(),
+                                 {true /*debugMode*/, 2 /*debugLevel*/,
+                                  DebugInfo::kIterationLimitForTests});
+    ASSERT_TRUE(phaseManager.optimize(optimized));
+
+    std::vector<std::string> filters;
+    const ABT* node = &optimized.cast<RootNode>()->getChild();
+    while (const auto* filterPtr = node->cast<FilterNode>()) {
+        filters.push_back(ExplainGenerator::explainV2(filterPtr->getFilter()));
+        node = &filterPtr->getChild();
+    }
+    std::reverse(filters.begin(), filters.end());
+    return filters;
+}
+
+TEST(HistogramCETest, MostSelectivePredicateIsAppliedFirst) {
+    auto filters = optimizeFilters(makeStats("a", 1, "b", 2));
+    ASSERT_EQ(2U, filters.size());
+    ASSERT_STRING_CONTAINS(filters[0], "Const [1]");
+    ASSERT_STRING_CONTAINS(filters[1], "Const [2]");
+
+    // With the statistics of the paths swapped, the predicate on 'b' is the selective one.
+    filters = optimizeFilters(makeStats("b", 2, "a", 1));
+    ASSERT_EQ(2U, filters.size());
+    ASSERT_STRING_CONTAINS(filters[0], "Const [2]");
+    ASSERT_STRING_CONTAINS(filters[1], "Const [1]");
+}
+
+}  // namespace
+}  // namespace mongo::optimizer
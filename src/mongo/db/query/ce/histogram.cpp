@@ -0,0 +1,375 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/db/query/ce/histogram.h"
+
+#include <algorithm>
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/bson/dotted_path_support.h"
+#include "mongo/db/exec/sbe/values/bson.h"
+
+namespace mongo::ce {
+namespace {
+
+namespace value = sbe::value;
+namespace dps = ::mongo::dotted_path_support;
+
+constexpr StringData kBoundsField = "bounds"_sd;
+constexpr StringData kBucketsField = "buckets"_sd;
+constexpr StringData kEqualFreqField = "equalFreq"_sd;
+constexpr StringData kRangeFreqField = "rangeFreq"_sd;
+constexpr StringData kCumulativeFreqField = "cumulativeFreq"_sd;
+constexpr StringData kNDVField = "ndv"_sd;
+
+constexpr StringData kDocumentsField = "documents"_sd;
+constexpr StringData kNullsField = "nulls"_sd;
+constexpr StringData kArraysField = "arrays"_sd;
+constexpr StringData kScalarHistogramField = "scalarHistogram"_sd;
+constexpr StringData kArrayHistogramField = "arrayHistogram"_sd;
+
+int32_t compareValues(const SBEValue& lhs, const SBEValue& rhs) {
+    const auto [tag, val] = value::compareValue(lhs.first, lhs.second, rhs.first, rhs.second);
+    uassert(6660500,
+            "Values in a histogram must be comparable",
+            tag == value::TypeTags::NumberInt32);
+    return value::bitcastTo<int32_t>(val);
+}
+
+int typeBracket(value::TypeTags tag) {
+    return canonicalizeBSONType(value::tagToType(tag));
+}
+
+double valueToDouble(const SBEValue& v) {
+    if (v.first == value::TypeTags::NumberDecimal) {
+        return value::numericCast<Decimal128>(v.first, v.second).toDouble();
+    }
+    return value::numericCast<double>(v.first, v.second);
+}
+
+void sortValues(std::vector<SBEValue>& values) {
+    std::sort(values.begin(), values.end(), [](const SBEValue& lhs, const SBEValue& rhs) {
+        return compareValues(lhs, rhs) < 0;
+    });
+}
+
+}  // namespace
+
+bool Bucket::operator==(const Bucket& other) const {
+    return _equalFreq == other._equalFreq && _rangeFreq == other._rangeFreq &&
+        _cumulativeFreq == other._cumulativeFreq && _ndv == other._ndv;
+}
+
+ScalarHistogram::ScalarHistogram(BSONObj bounds, std::vector<Bucket> buckets)
+    : _bounds(bounds.getOwned()), _buckets(std::move(buckets)) {
+    for (auto&& elem : _bounds) {
+        _boundElements.push_back(elem);
+    }
+    uassert(6660501,
+            "A histogram must have exactly one bound per bucket",
+            _boundElements.size() == _buckets.size());
+}
+
+ScalarHistogram ScalarHistogram::make(std::vector<SBEValue> values, const size_t maxBuckets) {
+    uassert(6660502, "A histogram must have at least one bucket", maxBuckets > 0);
+    sortValues(values);
+
+    const double target = std::max(1.0, static_cast<double>(values.size()) / maxBuckets);
+
+    BSONObjBuilder boundsBuilder;
+    std::vector<Bucket> buckets;
+    double rangeFreq = 0.0;
+    double ndv = 0.0;
+    double cumulativeFreq = 0.0;
+
+    for (size_t i = 0; i < values.size();) {
+        // Find the run of values equal to values[i].
+        size_t j = i + 1;
+        while (j < values.size() && compareValues(values[i], values[j]) == 0) {
+            ++j;
+        }
+        const double count = j - i;
+
+        // The first and last values of every type bracket are bucket bounds, so that values
+        // inside a bucket can always be interpolated between two bounds of their own type.
+        // Otherwise close the bucket once it is full.
+        const bool firstInBracket =
+            i == 0 || typeBracket(values[i - 1].first) != typeBracket(values[i].first);
+        const bool lastInBracket =
+            j == values.size() || typeBracket(values[i].first) != typeBracket(values[j].first);
+        if (firstInBracket || lastInBracket || rangeFreq + count >= target) {
+            cumulativeFreq += rangeFreq + count;
+            sbe::bson::appendValueToBsonObj(
+                boundsBuilder, std::to_string(buckets.size()), values[i].first, values[i].second);
+            buckets.push_back({count, rangeFreq, cumulativeFreq, ndv});
+            rangeFreq = 0.0;
+            ndv = 0.0;
+        } else {
+            rangeFreq += count;
+            ndv += 1.0;
+        }
+        i = j;
+    }
+
+    return {boundsBuilder.obj(), std::move(buckets)};
+}
+
+ScalarHistogram ScalarHistogram::parse(const BSONObj& obj) {
+    std::vector<Bucket> buckets;
+    for (auto&& elem : obj.getObjectField(kBucketsField)) {
+        const BSONObj bucket = elem.Obj();
+        buckets.push_back({bucket[kEqualFreqField].numberDouble(),
+                           bucket[kRangeFreqField].numberDouble(),
+                           bucket[kCumulativeFreqField].numberDouble(),
+                           bucket[kNDVField].numberDouble()});
+    }
+    return {obj.getObjectField(kBoundsField), std::move(buckets)};
+}
+
+BSONObj ScalarHistogram::serialize() const {
+    BSONObjBuilder bob;
+    bob.appendArray(kBoundsField, _bounds);
+    BSONArrayBuilder bucketsBuilder(bob.subarrayStart(kBucketsField));
+    for (const auto& bucket : _buckets) {
+        BSONObjBuilder bucketBuilder(bucketsBuilder.subobjStart());
+        bucketBuilder.append(kEqualFreqField, bucket._equalFreq);
+        bucketBuilder.append(kRangeFreqField, bucket._rangeFreq);
+        bucketBuilder.append(kCumulativeFreqField, bucket._cumulativeFreq);
+        bucketBuilder.append(kNDVField, bucket._ndv);
+    }
+    bucketsBuilder.doneFast();
+    return bob.obj();
+}
+
+bool ScalarHistogram::operator==(const ScalarHistogram& other) const {
+    return _buckets == other._buckets && _bounds.binaryEqual(other._bounds);
+}
+
+SBEValue ScalarHistogram::getBound(const size_t bucketIdx) const {
+    return sbe::bson::convertFrom<true /*View*/>(_boundElements.at(bucketIdx));
+}
+
+size_t ScalarHistogram::findBucket(value::TypeTags tag, value::Value val) const {
+    const SBEValue v{tag, val};
+    size_t lo = 0;
+    size_t hi = _buckets.size();
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (compareValues(getBound(mid), v) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+double ScalarHistogram::estimateEqual(value::TypeTags tag, value::Value val) const {
+    const size_t idx = findBucket(tag, val);
+    if (idx == _buckets.size()) {
+        return 0.0;
+    }
+
+    const Bucket& bucket = _buckets[idx];
+    const SBEValue bound = getBound(idx);
+    if (compareValues({tag, val}, bound) == 0) {
+        return bucket._equalFreq;
+    }
+    if (typeBracket(tag) != typeBracket(bound.first) || bucket._ndv == 0.0) {
+        return 0.0;
+    }
+
+    // Assume a uniform distribution of the distinct values inside the bucket.
+    return bucket._rangeFreq / bucket._ndv;
+}
+
+double ScalarHistogram::estimateLess(value::TypeTags tag,
+                                     value::Value val,
+                                     const bool inclusive) const {
+    const size_t idx = findBucket(tag, val);
+    if (idx == _buckets.size()) {
+        return getCardinality();
+    }
+
+    const Bucket& bucket = _buckets[idx];
+    const double prevCumulativeFreq = idx == 0 ? 0.0 : _buckets[idx - 1]._cumulativeFreq;
+    const SBEValue bound = getBound(idx);
+    if (compareValues({tag, val}, bound) == 0) {
+        return prevCumulativeFreq + bucket._rangeFreq + (inclusive ? bucket._equalFreq : 0.0);
+    }
+    if (typeBracket(tag) != typeBracket(bound.first)) {
+        // The value sorts before every value in this bucket.
+        return prevCumulativeFreq;
+    }
+
+    // The value falls strictly inside the bucket. Interpolate linearly between the bounds for
+    // numbers, otherwise assume it is in the middle of the bucket.
+    double fraction = 0.5;
+    if (idx > 0 && value::isNumber(tag) && value::isNumber(bound.first)) {
+        const SBEValue prevBound = getBound(idx - 1);
+        if (value::isNumber(prevBound.first)) {
+            const double low = valueToDouble(prevBound);
+            const double high = valueToDouble(bound);
+            if (high > low) {
+                fraction = std::clamp((valueToDouble({tag, val}) - low) / (high - low), 0.0, 1.0);
+            }
+        }
+    }
+
+    double result = prevCumulativeFreq + fraction * bucket._rangeFreq;
+    if (inclusive && bucket._ndv > 0.0) {
+        result += bucket._rangeFreq / bucket._ndv;
+    }
+    return std::min(result, prevCumulativeFreq + bucket._rangeFreq);
+}
+
+double ScalarHistogram::estimateTypeBracketStart(value::TypeTags tag) const {
+    const int bracket = typeBracket(tag);
+    double result = 0.0;
+    for (size_t idx = 0; idx < _buckets.size() && typeBracket(getBound(idx).first) < bracket;
+         ++idx) {
+        result = _buckets[idx]._cumulativeFreq;
+    }
+    return result;
+}
+
+double ScalarHistogram::estimateTypeBracketEnd(value::TypeTags tag) const {
+    const int bracket = typeBracket(tag);
+    double result = 0.0;
+    for (size_t idx = 0; idx < _buckets.size() && typeBracket(getBound(idx).first) <= bracket;
+         ++idx) {
+        result = _buckets[idx]._cumulativeFreq;
+    }
+    return result;
+}
+
+double ScalarHistogram::estimateInterval(const boost::optional<SBEValue>& low,
+                                         const bool lowInclusive,
+                                         const boost::optional<SBEValue>& high,
+                                         const bool highInclusive) const {
+    invariant(low || high);
+    if (empty()) {
+        return 0.0;
+    }
+
+    if (low && high && compareValues(*low, *high) == 0) {
+        return (lowInclusive && highInclusive) ? estimateEqual(low->first, low->second) : 0.0;
+    }
+
+    const double highFreq = high ? estimateLess(high->first, high->second, highInclusive)
+                                 : estimateTypeBracketEnd(low->first);
+    const double lowFreq = low ? estimateLess(low->first, low->second, !lowInclusive)
+                               : estimateTypeBracketStart(high->first);
+    return std::max(0.0, highFreq - lowFreq);
+}
+
+PathStatistics::PathStatistics(double documents,
+                               double nullCount,
+                               double arrayCount,
+                               ScalarHistogram scalar,
+                               ScalarHistogram arrayElements)
+    : _documents(documents),
+      _nullCount(nullCount),
+      _arrayCount(arrayCount),
+      _scalar(std::move(scalar)),
+      _arrayElements(std::move(arrayElements)) {}
+
+PathStatistics PathStatistics::make(const std::vector<BSONObj>& docs,
+                                    StringData path,
+                                    const size_t maxBuckets) {
+    double nullCount = 0.0;
+    double arrayCount = 0.0;
+    std::vector<SBEValue> scalarValues;
+    std::vector<SBEValue> arrayValues;
+
+    for (const auto& doc : docs) {
+        const BSONElement elem = dps::extractElementAtPath(doc, path);
+        if (elem.eoo() || elem.isNull()) {
+            ++nullCount;
+            scalarValues.emplace_back(value::TypeTags::Null, 0);
+        } else if (elem.type() == BSONType::Array) {
+            ++arrayCount;
+
+            // Every distinct element is counted once per array.
+            std::vector<SBEValue> elements;
+            for (auto&& arrayElem : elem.Obj()) {
+                elements.push_back(sbe::bson::convertFrom<true /*View*/>(arrayElem));
+            }
+            sortValues(elements);
+            auto end = std::unique(
+                elements.begin(), elements.end(), [](const SBEValue& lhs, const SBEValue& rhs) {
+                    return compareValues(lhs, rhs) == 0;
+                });
+            arrayValues.insert(arrayValues.end(), elements.begin(), end);
+        } else {
+            scalarValues.push_back(sbe::bson::convertFrom<true /*View*/>(elem));
+        }
+    }
+
+    return {static_cast<double>(docs.size()),
+            nullCount,
+            arrayCount,
+            ScalarHistogram::make(std::move(scalarValues), maxBuckets),
+            ScalarHistogram::make(std::move(arrayValues), maxBuckets)};
+}
+
+PathStatistics PathStatistics::parse(const BSONObj& obj) {
+    return {obj[kDocumentsField].numberDouble(),
+            obj[kNullsField].numberDouble(),
+            obj[kArraysField].numberDouble(),
+            ScalarHistogram::parse(obj.getObjectField(kScalarHistogramField)),
+            ScalarHistogram::parse(obj.getObjectField(kArrayHistogramField))};
+}
+
+BSONObj PathStatistics::serialize() const {
+    BSONObjBuilder bob;
+    bob.append(kDocumentsField, _documents);
+    bob.append(kNullsField, _nullCount);
+    bob.append(kArraysField, _arrayCount);
+    bob.append(kScalarHistogramField, _scalar.serialize());
+    bob.append(kArrayHistogramField, _arrayElements.serialize());
+    return bob.obj();
+}
+
+double PathStatistics::estimateInterval(const boost::optional<SBEValue>& low,
+                                        const bool lowInclusive,
+                                        const boost::optional<SBEValue>& high,
+                                        const bool highInclusive,
+                                        const bool traverseArrays) const {
+    double result = _scalar.estimateInterval(low, lowInclusive, high, highInclusive);
+    if (traverseArrays) {
+        // Each array contributes its distinct elements once, but an array with several matching
+        // elements still matches only one document.
+        result += std::min(_arrayCount,
+                           _arrayElements.estimateInterval(low, lowInclusive, high, highInclusive));
+    }
+    return std::min(result, _documents);
+}
+
+}  // namespace mongo::ce
@@ -0,0 +1,202 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+#include <vector>
+
+#include "mongo/bson/bsonobj.h"
+#include "mongo/db/exec/sbe/values/value.h"
+
+namespace mongo::ce {
+
+using SBEValue = std::pair<sbe::value::TypeTags, sbe::value::Value>;
+
+/**
+ * A histogram bucket. The bucket covers all values greater than the bound of the previous bucket
+ * and less than or equal to its own bound.
+ */
+struct Bucket {
+    bool operator==(const Bucket& other) const;
+
+    // Number of occurrences of the bucket's bound.
+    double _equalFreq;
+
+    // Number of occurrences of values strictly between the previous bound and this bound.
+    double _rangeFreq;
+
+    // Number of occurrences of all values up to and including this bound.
+    double _cumulativeFreq;
+
+    // Number of distinct values strictly between the previous bound and this bound.
+    double _ndv;
+};
+
+/**
+ * Equi-depth histogram over scalar values. Buckets never span more than one canonical BSON type,
+ * so every type bracket starts a new bucket and the boundary of a type bracket is always a bucket
+ * bound. This lets range predicates, which only match values of the type of their bound, be
+ * estimated without guessing how values are distributed across types.
+ */
+class ScalarHistogram {
+public:
+    ScalarHistogram() = default;
+    ScalarHistogram(BSONObj bounds, std::vector<Bucket> buckets);
+
+    /**
+     * Builds a histogram over 'values' with roughly 'maxBuckets' buckets, plus up to two extra
+     * buckets per type bracket for its minimum and maximum values. The values need not be sorted
+     * and are not owned by the histogram.
+     */
+    static ScalarHistogram make(std::vector<SBEValue> values, size_t maxBuckets);
+
+    static ScalarHistogram parse(const BSONObj& obj);
+    BSONObj serialize() const;
+
+    bool operator==(const ScalarHistogram& other) const;
+
+    bool empty() const {
+        return _buckets.empty();
+    }
+
+    double getCardinality() const {
+        return empty() ? 0.0 : _buckets.back()._cumulativeFreq;
+    }
+
+    const std::vector<Bucket>& getBuckets() const {
+        return _buckets;
+    }
+
+    SBEValue getBound(size_t bucketIdx) const;
+
+    /**
+     * Estimated number of values equal to the given value.
+     */
+    double estimateEqual(sbe::value::TypeTags tag, sbe::value::Value val) const;
+
+    /**
+     * Estimated number of values less than (or less than or equal to, if 'inclusive') the given
+     * value.
+     */
+    double estimateLess(sbe::value::TypeTags tag, sbe::value::Value val, bool inclusive) const;
+
+    /**
+     * Estimated number of values of canonical types sorting before (for the start) or not after
+     * (for the end) the canonical type of 'tag'.
+     */
+    double estimateTypeBracketStart(sbe::value::TypeTags tag) const;
+    double estimateTypeBracketEnd(sbe::value::TypeTags tag) const;
+
+    /**
+     * Estimated number of values in an interval. A missing bound is open-ended within the type
+     * bracket of the other bound, which matches the type-bracketing semantics of comparisons in
+     * the query language. At least one bound must be present.
+     */
+    double estimateInterval(const boost::optional<SBEValue>& low,
+                            bool lowInclusive,
+                            const boost::optional<SBEValue>& high,
+                            bool highInclusive) const;
+
+private:
+    // Returns the index of the first bucket whose bound is greater than or equal to the value, or
+    // the number of buckets if there is no such bucket.
+    size_t findBucket(sbe::value::TypeTags tag, sbe::value::Value val) const;
+
+    BSONObj _bounds;
+    std::vector<BSONElement> _boundElements;
+    std::vector<Bucket> _buckets;
+};
+
+/**
+ * Statistics for one path of a collection, as collected by the 'analyze' command.
+ *
+ * Documents where the path holds a scalar, is null or is missing contribute to the scalar
+ * histogram (missing values are recorded as null). Documents where the path holds an array
+ * contribute each of their distinct elements once to the array element histogram, so that
+ * predicates that traverse arrays can count each matching document at most once.
+ */
+class PathStatistics {
+public:
+    PathStatistics() = default;
+    PathStatistics(double documents,
+                   double nullCount,
+                   double arrayCount,
+                   ScalarHistogram scalar,
+                   ScalarHistogram arrayElements);
+
+    /**
+     * Builds statistics for 'path' over 'docs'. Arrays are only recognized at the end of the path.
+     */
+    static PathStatistics make(const std::vector<BSONObj>& docs,
+                               StringData path,
+                               size_t maxBuckets);
+
+    static PathStatistics parse(const BSONObj& obj);
+    BSONObj serialize() const;
+
+    double getDocumentCount() const {
+        return _documents;
+    }
+
+    double getNullCount() const {
+        return _nullCount;
+    }
+
+    double getArrayCount() const {
+        return _arrayCount;
+    }
+
+    const ScalarHistogram& getScalarHistogram() const {
+        return _scalar;
+    }
+
+    const ScalarHistogram& getArrayElementHistogram() const {
+        return _arrayElements;
+    }
+
+    /**
+     * Estimated number of documents with a value in the given interval. If 'traverseArrays' is
+     * set, documents holding an array with at least one element in the interval also match.
+     */
+    double estimateInterval(const boost::optional<SBEValue>& low,
+                            bool lowInclusive,
+                            const boost::optional<SBEValue>& high,
+                            bool highInclusive,
+                            bool traverseArrays) const;
+
+private:
+    double _documents = 0.0;
+    double _nullCount = 0.0;
+    double _arrayCount = 0.0;
+    ScalarHistogram _scalar;
+    ScalarHistogram _arrayElements;
+};
+
+}  // namespace mongo::ce
@@ -0,0 +1,186 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/db/query/ce/histogram.h"
+
+#include "mongo/bson/bsonobjbuilder.h"
+#include "mongo/db/exec/sbe/values/bson.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo::ce {
+namespace {
+
+namespace value = sbe::value;
+
+/**
+ * Returns views over the elements of 'values', which must outlive the result.
+ */
+std::vector<SBEValue> makeValues(const BSONObj& values) {
+    std::vector<SBEValue> result;
+    for (auto&& elem : values) {
+        result.push_back(sbe::bson::convertFrom<true /*View*/>(elem));
+    }
+    return result;
+}
+
+SBEValue makeInt(int32_t v) {
+    return {value::TypeTags::NumberInt32, value::bitcastFrom<int32_t>(v)};
+}
+
+boost::optional<SBEValue> makeOptInt(int32_t v) {
+    return makeInt(v);
+}
+
+TEST(HistogramTest, EmptyHistogram) {
+    const auto hist = ScalarHistogram::make({}, 10);
+    ASSERT_TRUE(hist.empty());
+    ASSERT_EQ(0.0, hist.getCardinality());
+    ASSERT_EQ(0.0, hist.estimateInterval(makeOptInt(1), true, makeOptInt(5), true));
+}
+
+TEST(HistogramTest, BucketsAreEquiDepth) {
+    BSONArrayBuilder bab;
+    for (int i = 0; i < 100; ++i) {
+        bab.append(i);
+    }
+    const BSONObj values = bab.arr();
+    const auto hist = ScalarHistogram::make(makeValues(values), 10);
+
+    // The minimum value gets a bucket of its own, every other bucket holds 10 values at most.
+    ASSERT_EQ(11U, hist.getBuckets().size());
+    ASSERT_EQ(100.0, hist.getCardinality());
+    ASSERT_EQ(0.0, hist.getBuckets().front()._rangeFreq);
+    for (const auto& bucket : hist.getBuckets()) {
+        ASSERT_EQ(1.0, bucket._equalFreq);
+        ASSERT_LTE(bucket._rangeFreq, 9.0);
+        ASSERT_EQ(bucket._rangeFreq, bucket._ndv);
+    }
+}
+
+TEST(HistogramTest, EqualityOnSkewedValues) {
+    BSONArrayBuilder bab;
+    for (int i = 0; i < 90; ++i) {
+        bab.append(7);
+    }
+    for (int i = 0; i < 10; ++i) {
+        bab.append(i * 100);
+    }
+    const BSONObj values = bab.arr();
+    const auto hist = ScalarHistogram::make(makeValues(values), 4);
+
+    // The frequent value closes a bucket of its own, so its count is exact.
+    const auto seven = makeInt(7);
+    ASSERT_EQ(90.0, hist.estimateEqual(seven.first, seven.second));
+
+    // A value which is not present in the histogram is estimated at most at the average
+    // frequency of the values in its bucket.
+    const auto missing = makeInt(50);
+    ASSERT_LTE(hist.estimateEqual(missing.first, missing.second), 1.0);
+}
+
+TEST(HistogramTest, RangeEstimates) {
+    BSONArrayBuilder bab;
+    for (int i = 0; i < 100; ++i) {
+        bab.append(i);
+    }
+    const BSONObj values = bab.arr();
+    const auto hist = ScalarHistogram::make(makeValues(values), 10);
+
+    // Bucket bounds are exact.
+    ASSERT_EQ(11.0, hist.estimateInterval(boost::none, true, makeOptInt(10), true));
+    ASSERT_EQ(10.0, hist.estimateInterval(boost::none, true, makeOptInt(10), false));
+    ASSERT_EQ(89.0, hist.estimateInterval(makeOptInt(10), false, boost::none, true));
+    ASSERT_EQ(1.0, hist.estimateInterval(makeOptInt(10), true, makeOptInt(10), true));
+
+    // Values inside buckets are interpolated.
+    ASSERT_APPROX_EQUAL(
+        50.0, hist.estimateInterval(makeOptInt(25), true, makeOptInt(74), true), 2.0);
+}
+
+TEST(HistogramTest, TypeBracketsDoNotShareBuckets) {
+    const BSONObj values = BSON_ARRAY(1 << 2 << 3 << "a"
+                                        << "b" << true << false);
+    const auto hist = ScalarHistogram::make(makeValues(values), 1);
+
+    // The minimum and maximum of every type bracket are bucket bounds.
+    ASSERT_EQ(6U, hist.getBuckets().size());
+    ASSERT_EQ(7.0, hist.getCardinality());
+
+    // Ranges on numbers only count numbers.
+    ASSERT_EQ(3.0, hist.estimateInterval(makeOptInt(0), true, boost::none, true));
+    ASSERT_EQ(3.0, hist.estimateInterval(boost::none, true, makeOptInt(100), true));
+
+    // Numbers of different types are compared by value.
+    const SBEValue half{value::TypeTags::NumberDouble, value::bitcastFrom<double>(1.5)};
+    ASSERT_APPROX_EQUAL(2.0, hist.estimateInterval(half, true, boost::none, true), 0.5);
+}
+
+TEST(HistogramTest, SerializationRoundTrip) {
+    const BSONObj values = BSON_ARRAY(1 << 2 << 2 << 3.5 << "a" << BSONNULL);
+    const auto hist = ScalarHistogram::make(makeValues(values), 2);
+    ASSERT_TRUE(hist == ScalarHistogram::parse(hist.serialize()));
+
+    const std::vector<BSONObj> docs{BSON("a" << 1), BSON("a" << BSON_ARRAY(1 << 2)), BSONObj()};
+    const auto stats = PathStatistics::make(docs, "a", 2);
+    const auto parsed = PathStatistics::parse(stats.serialize());
+    ASSERT_EQ(stats.getDocumentCount(), parsed.getDocumentCount());
+    ASSERT_EQ(stats.getNullCount(), parsed.getNullCount());
+    ASSERT_EQ(stats.getArrayCount(), parsed.getArrayCount());
+    ASSERT_TRUE(stats.getScalarHistogram() == parsed.getScalarHistogram());
+    ASSERT_TRUE(stats.getArrayElementHistogram() == parsed.getArrayElementHistogram());
+}
+
+TEST(PathStatisticsTest, NullsAndArrays) {
+    const std::vector<BSONObj> docs{BSON("a" << BSON("b" << 1)),
+                                    BSON("a" << BSON("b" << 5)),
+                                    BSON("a" << BSON("b" << BSONNULL)),
+                                    BSON("a" << 1),
+                                    BSON("a" << BSON("b" << BSON_ARRAY(5 << 5 << 6)))};
+    const auto stats = PathStatistics::make(docs, "a.b", 10);
+
+    ASSERT_EQ(5.0, stats.getDocumentCount());
+    ASSERT_EQ(2.0, stats.getNullCount());
+    ASSERT_EQ(1.0, stats.getArrayCount());
+
+    // Duplicate elements of an array are only counted once.
+    ASSERT_EQ(2.0, stats.getArrayElementHistogram().getCardinality());
+
+    // {a.b: 5} matches the scalar and, when traversing, the array.
+    ASSERT_EQ(1.0, stats.estimateInterval(makeOptInt(5), true, makeOptInt(5), true, false));
+    ASSERT_EQ(2.0, stats.estimateInterval(makeOptInt(5), true, makeOptInt(5), true, true));
+
+    // An array with several matching elements still matches a single document.
+    ASSERT_EQ(2.0, stats.estimateInterval(makeOptInt(5), true, makeOptInt(6), true, true));
+
+    const SBEValue null{value::TypeTags::Null, 0};
+    ASSERT_EQ(2.0, stats.estimateInterval(null, true, null, true, true));
+}
+
+}  // namespace
+}  // namespace mongo::ce
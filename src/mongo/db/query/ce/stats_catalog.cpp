@@ -0,0 +1,129 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/db/query/ce/stats_catalog.h"
+
+#include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/concurrency/d_concurrency.h"
+#include "mongo/db/operation_context.h"
+#include "mongo/db/service_context.h"
+
+namespace mongo::ce {
+namespace {
+
+const auto getStatsCatalog = ServiceContext::declareDecoration<StatsCatalog>();
+
+std::shared_ptr<const CollectionStatistics> loadStats(OperationContext* opCtx,
+                                                      const NamespaceString& nss,
+                                                      const UUID& uuid) {
+    const NamespaceString statsNss = nss.makeStatisticsNamespace();
+
+    // The statistics collection lives in the same database as 'nss', whose lock the caller holds.
+    boost::optional<Lock::CollectionLock> statsCollLock;
+    if (!opCtx->isLockFreeReadsOp()) {
+        statsCollLock.emplace(opCtx, statsNss, MODE_IS);
+    }
+    const auto statsColl =
+        CollectionCatalog::get(opCtx)->lookupCollectionByNamespace(opCtx, statsNss);
+    if (!statsColl) {
+        return nullptr;
+    }
+
+    StringMap<PathStatistics> paths;
+    auto cursor = statsColl->getCursor(opCtx);
+    while (auto record = cursor->next()) {
+        const BSONObj doc = record->data.toBson();
+        const BSONElement path = doc[StatsCatalog::kPathField];
+        uassert(6660510,
+                str::stream() << "Malformed statistics document in " << statsNss << ": " << doc,
+                path.type() == BSONType::String &&
+                    doc[StatsCatalog::kStatisticsField].type() == BSONType::Object);
+
+        // Skip statistics left behind by an earlier collection with the same name.
+        auto docUUID = UUID::parse(doc[StatsCatalog::kCollectionUUIDField]);
+        if (!docUUID.isOK() || docUUID.getValue() != uuid) {
+            continue;
+        }
+        paths.emplace(path.str(),
+                      PathStatistics::parse(doc[StatsCatalog::kStatisticsField].Obj().getOwned()));
+    }
+
+    if (paths.empty()) {
+        return nullptr;
+    }
+    return std::make_shared<const CollectionStatistics>(std::move(paths));
+}
+
+}  // namespace
+
+const PathStatistics* CollectionStatistics::getPathStatistics(StringData path) const {
+    auto it = _paths.find(path);
+    return it == _paths.end() ? nullptr : &it->second;
+}
+
+StatsCatalog& StatsCatalog::get(ServiceContext* serviceContext) {
+    return getStatsCatalog(serviceContext);
+}
+
+StatsCatalog& StatsCatalog::get(OperationContext* opCtx) {
+    return get(opCtx->getServiceContext());
+}
+
+std::shared_ptr<const CollectionStatistics> StatsCatalog::getStats(OperationContext* opCtx,
+                                                                   const NamespaceString& nss,
+                                                                   const UUID& uuid) {
+    uint64_t epoch;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        auto it = _cache.find(nss);
+        if (it != _cache.end() && it->second.uuid == uuid) {
+            return it->second.stats;
+        }
+        epoch = _epoch;
+    }
+
+    // Load outside the mutex since this reads from storage.
+    auto stats = loadStats(opCtx, nss, uuid);
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    if (epoch != _epoch) {
+        // An invalidation raced with the load, so the result may be stale. Do not cache it.
+        return stats;
+    }
+    _cache.insert_or_assign(nss, Entry{uuid, stats});
+    return stats;
+}
+
+void StatsCatalog::invalidate(const NamespaceString& nss) {
+    stdx::lock_guard<Latch> lk(_mutex);
+    _cache.erase(nss);
+    ++_epoch;
+}
+
+}  // namespace mongo::ce
@@ -0,0 +1,113 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+
+#include "mongo/db/namespace_string.h"
+#include "mongo/db/query/ce/histogram.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/util/string_map.h"
+#include "mongo/util/uuid.h"
+
+namespace mongo {
+
+class OperationContext;
+class ServiceContext;
+
+namespace ce {
+
+/**
+ * The statistics persisted by 'analyze' for a single collection, keyed by dotted field path.
+ */
+class CollectionStatistics {
+public:
+    explicit CollectionStatistics(StringMap<PathStatistics> paths) : _paths(std::move(paths)) {}
+
+    /**
+     * Returns nullptr when no statistics were gathered for 'path'.
+     */
+    const PathStatistics* getPathStatistics(StringData path) const;
+
+    bool empty() const {
+        return _paths.empty();
+    }
+
+private:
+    StringMap<PathStatistics> _paths;
+};
+
+/**
+ * In-memory cache of the statistics stored in the '<db>.system.statistics.<coll>' collections.
+ * Entries are loaded lazily the first time a collection's statistics are requested and are
+ * dropped by invalidate() whenever the persisted statistics change.
+ *
+ * Every statistics document records the UUID of the collection it was gathered on. Documents for
+ * another UUID are ignored, and a cached entry is reloaded when the UUID of the collection changes,
+ * so statistics never outlive a drop or a rename of the collection they describe.
+ */
+class StatsCatalog {
+public:
+    static constexpr StringData kPathField = "_id"_sd;
+    static constexpr StringData kCollectionUUIDField = "collectionUUID"_sd;
+    static constexpr StringData kStatisticsField = "statistics"_sd;
+
+    static StatsCatalog& get(ServiceContext* serviceContext);
+    static StatsCatalog& get(OperationContext* opCtx);
+
+    /**
+     * Returns the statistics for the collection 'nss' with UUID 'uuid', or nullptr if none have
+     * been gathered. The caller must hold at least a MODE_IS lock on 'nss', or be a lock-free read.
+     * The statistics are read from the storage snapshot of 'opCtx' without running a command.
+     */
+    std::shared_ptr<const CollectionStatistics> getStats(OperationContext* opCtx,
+                                                         const NamespaceString& nss,
+                                                         const UUID& uuid);
+
+    void invalidate(const NamespaceString& nss);
+
+private:
+    struct Entry {
+        UUID uuid;
+        // Null when the collection has no statistics.
+        std::shared_ptr<const CollectionStatistics> stats;
+    };
+
+    Mutex _mutex = MONGO_MAKE_LATCH("StatsCatalog::_mutex");
+
+    std::map<NamespaceString, Entry> _cache;
+
+    // Bumped by every invalidate() so that a load which raced with it is not cached.
+    uint64_t _epoch = 0;
+};
+
+}  // namespace ce
+}  // namespace mongo
@@ -0,0 +1,137 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/db/query/ce/stats_catalog.h"
+
+#include "mongo/db/catalog/catalog_test_fixture.h"
+#include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/db_raii.h"
+#include "mongo/db/repl/storage_interface.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo::ce {
+namespace {
+
+const NamespaceString kNss("test.coll");
+
+class StatsCatalogTest : public CatalogTestFixture {
+protected:
+    void createCollection(const NamespaceString& nss) {
+        ASSERT_OK(storageInterface()->createCollection(operationContext(), nss, {}));
+    }
+
+    UUID getUUID(const NamespaceString& nss) {
+        auto uuid = CollectionCatalog::get(operationContext())
+                        ->lookupUUIDByNSS(operationContext(), nss);
+        ASSERT(uuid);
+        return *uuid;
+    }
+
+    /**
+     * Persists statistics for 'path' over 'numDocs' documents the way 'analyze' does.
+     */
+    void insertStats(const NamespaceString& nss, const UUID& uuid, StringData path, int numDocs) {
+        std::vector<BSONObj> docs;
+        for (int i = 0; i < numDocs; ++i) {
+            docs.push_back(BSON(path << i));
+        }
+
+        BSONObjBuilder statsDoc;
+        statsDoc.append(StatsCatalog::kPathField, path);
+        uuid.appendToBuilder(&statsDoc, StatsCatalog::kCollectionUUIDField);
+        statsDoc.append(StatsCatalog::kStatisticsField,
+                        PathStatistics::make(docs, path, 10 /* maxBuckets */).serialize());
+
+        const auto statsNss = nss.makeStatisticsNamespace();
+        if (!CollectionCatalog::get(operationContext())
+                 ->lookupUUIDByNSS(operationContext(), statsNss)) {
+            createCollection(statsNss);
+        }
+        ASSERT_OK(storageInterface()->insertDocument(
+            operationContext(), statsNss, {statsDoc.obj(), Timestamp()}, 0 /* term */));
+    }
+
+    std::shared_ptr<const CollectionStatistics> getStats(const NamespaceString& nss) {
+        AutoGetCollectionForRead coll(operationContext(), nss);
+        ASSERT(coll);
+        return StatsCatalog::get(operationContext())
+            .getStats(operationContext(), nss, coll->uuid());
+    }
+};
+
+TEST_F(StatsCatalogTest, NoStatistics) {
+    createCollection(kNss);
+    ASSERT_FALSE(getStats(kNss));
+}
+
+TEST_F(StatsCatalogTest, LoadsPersistedStatistics) {
+    createCollection(kNss);
+    insertStats(kNss, getUUID(kNss), "a", 20);
+
+    auto stats = getStats(kNss);
+    ASSERT(stats);
+    ASSERT_FALSE(stats->getPathStatistics("b"));
+    const auto* pathStats = stats->getPathStatistics("a");
+    ASSERT(pathStats);
+    ASSERT_EQ(20.0, pathStats->getDocumentCount());
+}
+
+TEST_F(StatsCatalogTest, InvalidateReloadsStatistics) {
+    createCollection(kNss);
+    ASSERT_FALSE(getStats(kNss));
+
+    // The absence of statistics is cached until the entry is invalidated.
+    insertStats(kNss, getUUID(kNss), "a", 20);
+    ASSERT_FALSE(getStats(kNss));
+
+    StatsCatalog::get(operationContext()).invalidate(kNss);
+    ASSERT(getStats(kNss));
+}
+
+TEST_F(StatsCatalogTest, IgnoresStatisticsOfDroppedCollection) {
+    createCollection(kNss);
+    insertStats(kNss, getUUID(kNss), "a", 20);
+    ASSERT(getStats(kNss));
+
+    // Recreating the collection gives it a new UUID, so neither the cached entry nor the
+    // persisted statistics of the dropped collection apply to it.
+    ASSERT_OK(storageInterface()->dropCollection(operationContext(), kNss));
+    createCollection(kNss);
+    ASSERT_FALSE(getStats(kNss));
+
+    insertStats(kNss, getUUID(kNss), "b", 30);
+    StatsCatalog::get(operationContext()).invalidate(kNss);
+    auto stats = getStats(kNss);
+    ASSERT(stats);
+    ASSERT_FALSE(stats->getPathStatistics("a"));
+    ASSERT(stats->getPathStatistics("b"));
+}
+
+}  // namespace
+}  // namespace mongo::ce
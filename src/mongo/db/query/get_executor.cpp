@@ -88,6 +88,7 @@
 #include "mongo/db/query/query_settings_decoration.h"
 #include "mongo/db/query/sbe_cached_solution_planner.h"
 #include "mongo/db/query/sbe_multi_planner.h"
+#include "mongo/db/query/sbe_plan_cache_persistence.h"
 #include "mongo/db/query/sbe_sub_planner.h"
 #include "mongo/db/query/sbe_utils.h"
 #include "mongo/db/query/shard_filterer_factory_impl.h"
@@ -579,12 +580,23 @@ public:
         _recoveredPinnedCacheEntry = pinnedEntry;
     }
 
+    bool restoredFromPersistedPlanCache() const {
+        return _restoredFromPersistedPlanCache;
+    }
+
+    void setRestoredFromPersistedPlanCache(bool restored) {
+        _restoredFromPersistedPlanCache = restored;
+    }
+
 private:
     QuerySolutionVector _solutions;
     PlanStageVector _roots;
     boost::optional<size_t> _decisionWorks;
     bool _needSubplanning{false};
     bool _recoveredPinnedCacheEntry{false};
+    // True if the single solution was chosen from the SBE plan cache persisted by a previous run
+    // of the server, rather than by multi-planning.
+    bool _restoredFromPersistedPlanCache{false};
 };
 
 /**
@@ -1166,18 +1178,69 @@ protected:
     std::unique_ptr<SlotBasedPrepareExecutionResult> buildMultiPlan(
         std::vector<std::unique_ptr<QuerySolution>> solutions,
         const QueryPlannerParams& plannerParams) final {
-        auto result = makeResult();
-        for (size_t ix = 0; ix < solutions.size(); ++ix) {
-            if (solutions[ix]->cacheData.get()) {
-                solutions[ix]->cacheData->indexFilterApplied = plannerParams.indexFiltersApplied;
+        for (auto&& solution : solutions) {
+            if (solution->cacheData.get()) {
+                solution->cacheData->indexFilterApplied = plannerParams.indexFiltersApplied;
             }
+        }
 
+        if (auto result = buildPlanFromPersistedPlanCache(solutions)) {
+            return result;
+        }
+
+        auto result = makeResult();
+        for (size_t ix = 0; ix < solutions.size(); ++ix) {
             auto execTree = buildExecutableTree(*solutions[ix]);
             result->emplace(std::move(execTree), std::move(solutions[ix]));
         }
         return result;
     }
 
+    /**
+     * If the SBE plan cache persisted by the previous run of the server holds the winner of the
+     * multi-planning for this query shape, and that winner is among 'solutions', builds a plan
+     * stage tree for it alone. The plan is then run by the cached solution planner using the
+     * persisted decision reads, which replans if the plan no longer performs as well. Returns
+     * nullptr otherwise.
+     */
+    std::unique_ptr<SlotBasedPrepareExecutionResult> buildPlanFromPersistedPlanCache(
+        std::vector<std::unique_ptr<QuerySolution>>& solutions) {
+        if (!sbe::isPlanCachePersistenceEnabled() || !_cq->pipeline().empty() ||
+            !shouldCacheQuery(*_cq)) {
+            return nullptr;
+        }
+
+        auto persistedEntry = sbe::PersistedPlanCache::get(_opCtx->getServiceContext())
+                                  .take(plan_cache_key_factory::make<sbe::PlanCacheKey>(
+                                      *_cq, getMainCollection()));
+        if (!persistedEntry) {
+            return nullptr;
+        }
+
+        auto solutionIdx = sbe::findPersistedSolution(*persistedEntry, solutions);
+        if (!solutionIdx) {
+            LOGV2_DEBUG(6610702,
+                        2,
+                        "Persisted SBE plan cache entry does not match any candidate plan",
+                        "query"_attr = redact(_cq->toStringShort()),
+                        "planSummary"_attr = persistedEntry->getPlanSummary());
+            return nullptr;
+        }
+
+        auto result = makeResult();
+        auto execTree = buildExecutableTree(*solutions[*solutionIdx]);
+        result->emplace(std::move(execTree), std::move(solutions[*solutionIdx]));
+        result->setDecisionWorks(static_cast<size_t>(persistedEntry->getDecisionReads()));
+        result->setRestoredFromPersistedPlanCache(true);
+
+        LOGV2_DEBUG(6610703,
+                    2,
+                    "Using plan from the persisted SBE plan cache",
+                    "query"_attr = redact(_cq->toStringShort()),
+                    "planSummary"_attr = persistedEntry->getPlanSummary());
+        return result;
+    }
+
 private:
     const MultiCollection& _collections;
 };
@@ -1335,6 +1398,11 @@ StatusWith<std::unique_ptr<PlanExecutor, PlanExecutor::Deleter>> getSlotBasedExe
         // Do the runtime planning and pick the best candidate plan.
         auto candidates = planner->plan(std::move(solutions), std::move(roots));
 
+        if (planningResult->restoredFromPersistedPlanCache()) {
+            sbe::restorePlanCacheEntry(
+                opCtx, *mainColl, *cq, candidates, *planningResult->decisionWorks());
+        }
+
         return plan_executor_factory::make(opCtx,
                                            std::move(cq),
                                            std::move(candidates),
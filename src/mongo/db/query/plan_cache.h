@@ -434,6 +434,32 @@ public:
         partition->add(key, entry.release());
     }
 
+    /**
+     * Adds an active 'cachedPlan' whose number of 'works' was measured earlier, for example by a
+     * previous run of the server. Unlike set(), the new entry skips the inactive state because its
+     * works are already known. Does nothing if the cache already holds an entry for 'key'.
+     */
+    void restore(const KeyType& key,
+                 std::unique_ptr<CachedPlanType> cachedPlan,
+                 size_t works,
+                 Date_t now,
+                 DebugInfoType debugInfo) {
+        invariant(cachedPlan);
+        auto partition = _partitionedCache->lockOnePartition(key);
+        if (partition->get(key).isOK()) {
+            return;
+        }
+
+        auto entry = Entry::create(std::move(cachedPlan),
+                                   key.queryHash(),
+                                   key.planCacheKeyHash(),
+                                   now,
+                                   true /* isActive */,
+                                   works,
+                                   std::move(debugInfo));
+        partition->add(key, entry.release());
+    }
+
     /**
      * Set a cache entry back to the 'inactive' state. Rather than completely evicting an entry
      * when the associated plan starts to perform poorly, we deactivate it, so that plans which
@@ -570,6 +596,20 @@ public:
         return entries;
     }
 
+    /**
+     * Calls 'func' on every cache entry along with its key. Each partition stays locked while its
+     * entries are visited, so 'func' must not call back into the cache.
+     */
+    void forEachEntry(const std::function<void(const KeyType&, const Entry&)>& func) const {
+        for (size_t partitionId = 0; partitionId < _numPartitions; ++partitionId) {
+            auto lockedPartition = _partitionedCache->lockOnePartitionById(partitionId);
+
+            for (auto&& [key, entry] : *lockedPartition) {
+                func(key, *entry);
+            }
+        }
+    }
+
     /**
      * Returns the size of the cache.
      * Used for testing.
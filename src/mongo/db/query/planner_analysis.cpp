@@ -655,15 +655,12 @@ void QueryPlannerAnalysis::determineLookupStrategy(
         return boost::none;
     }();
 
-    // TODO SERVER-63449: make this setting configurable and tighten the HJ check to cover the
-    // number of records and the storage size of the collection.
-    static constexpr auto kMaxHashJoinCollectionSize = 100 * 1024 * 1024;
-
+    // The hash join spills to disk once it outgrows its memory limit, so it is picked regardless of
+    // the size of the foreign collection as long as the query may use disk.
     if (foreignIndex) {
         eqLookupNode->lookupStrategy = EqLookupNode::LookupStrategy::kIndexedLoopJoin;
         eqLookupNode->idxEntry = foreignIndex;
-    } else if (allowDiskUse &&
-               foreignCollItr->second.approximateCollectionSizeBytes < kMaxHashJoinCollectionSize) {
+    } else if (allowDiskUse) {
         eqLookupNode->lookupStrategy = EqLookupNode::LookupStrategy::kHashJoin;
     } else {
         eqLookupNode->lookupStrategy = EqLookupNode::LookupStrategy::kNestedLoopJoin;
@@ -127,8 +127,8 @@ public:
      * and marks the node accordingly. In particular:
      * - An indexed nested loop join is chosen if an index on the foreign collection can be used to
      * answer the join predicate.
-     * - A hash join is chosen if disk use is allowed and if the foreign collection is sufficiently
-     * small.
+     * - A hash join is chosen if disk use is allowed, since it can spill to disk however large the
+     * foreign collection is.
      * - A nested loop join is chosen in all other cases.
      */
     static void determineLookupStrategy(
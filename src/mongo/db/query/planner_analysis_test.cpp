@@ -281,4 +281,23 @@ TEST(QueryPlannerAnalysis, GeoSkipValidation) {
     ASSERT_EQ(expr->getCanSkipValidation(), true);
 }
 
+TEST(QueryPlannerAnalysis, LookupStrategyHashJoinIgnoresForeignCollectionSize) {
+    const auto foreignNss = NamespaceString("test.foreign");
+    std::map<NamespaceString, SecondaryCollectionInfo> collectionsInfo;
+    // A foreign collection much larger than the hash join's memory limit.
+    collectionsInfo[foreignNss].approximateCollectionSizeBytes = 1024LL * 1024 * 1024 * 1024;
+
+    EqLookupNode lookupNode(std::make_unique<CollectionScanNode>(),
+                            foreignNss.ns(),
+                            "localField",
+                            "foreignField",
+                            "as");
+
+    QueryPlannerAnalysis::determineLookupStrategy(&lookupNode, collectionsInfo, true);
+    ASSERT(lookupNode.lookupStrategy == EqLookupNode::LookupStrategy::kHashJoin);
+
+    QueryPlannerAnalysis::determineLookupStrategy(&lookupNode, collectionsInfo, false);
+    ASSERT(lookupNode.lookupStrategy == EqLookupNode::LookupStrategy::kNestedLoopJoin);
+}
+
 }  // namespace
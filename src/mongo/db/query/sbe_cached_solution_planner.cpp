@@ -32,11 +32,14 @@
 
 #include "mongo/db/query/sbe_cached_solution_planner.h"
 
+#include <limits>
+
 #include "mongo/db/exec/plan_cache_util.h"
 #include "mongo/db/exec/sbe/stages/plan_stats.h"
 #include "mongo/db/query/collection_query_info.h"
 #include "mongo/db/query/explain.h"
 #include "mongo/db/query/plan_cache_key_factory.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_planner.h"
 #include "mongo/db/query/sbe_multi_planner.h"
 #include "mongo/db/query/stage_builder_util.h"
@@ -100,8 +103,21 @@ CandidatePlans CachedSolutionPlanner::plan(
         return {makeVector(std::move(candidate)), 0};
     }
 
-    // If we're here, the trial period took more than 'maxReadsBeforeReplan' physical reads. This
-    // plan may not be efficient any longer, so we replan from scratch.
+    // If we're here, either the trial period took more than 'maxReadsBeforeReplan' physical reads,
+    // or a blocking stage received its input at a much lower rate than expected after the trial
+    // period. This plan may not be efficient any longer, so we replan from scratch.
+    if (_reoptimizationReason) {
+        LOGV2_DEBUG(6610800,
+                    1,
+                    "Evicting cache entry for a query and replanning it since its blocking stage "
+                    "received fewer documents than expected",
+                    "reason"_attr = *_reoptimizationReason,
+                    "decisionReads"_attr = _decisionReads,
+                    "query"_attr = redact(_cq.toStringShort()),
+                    "planSummary"_attr = explainer->getPlanSummary());
+        return replan(true, *_reoptimizationReason);
+    }
+
     auto visitor = PlanStatsNumReadsVisitor{};
     candidate.root->accumulate(kEmptyPlanNodeId, &visitor);
     const auto numReads = visitor.numReads;
@@ -142,20 +158,64 @@ plan_ranker::CandidatePlan CachedSolutionPlanner::collectExecutionStatsForCached
     // 'executeCandidateTrial()' and for plans with blocking stages is observed by the tracker
     // itself), it means that the cached plan isn't performing as well as it used to and we'll need
     // to replan, so we let the tracker terminate the trial. Otherwise, the plan is still good and
-    // we promote it from a candidate to "normal" by detaching the tracker and letting
-    // 'executeCandidateTrial()' reach 'maxNumResults'.
-    auto onMetricReached = [&candidate](TrialRunTracker::TrialRunMetric metric) {
+    // we promote it from a candidate to "normal" by letting 'executeCandidateTrial()' reach
+    // 'maxNumResults'.
+    //
+    // A blocking stage consumes all of its input before the plan returns its first result, so the
+    // trial only samples the beginning of that input. As long as the plan has not returned any
+    // results, we can still replan it without anyone noticing. So, after the trial has passed, we
+    // keep tracking reads and check at exponentially spaced checkpoints that the blocking stage
+    // still receives input at the rate expected from the plan cache entry. If the rate drops below
+    // what we expect by more than 'internalQueryCacheEvictionRatio', the data the plan was cached
+    // for is not representative of the data this query reads, and we terminate the plan to replan.
+    const size_t maxNumCheckpoints = _decisionReads > 0 && maxTrialPeriodNumReads > 0
+        ? internalQuerySBEMaxCachedPlanCheckpoints.load()
+        : 0;
+    size_t numCheckpoints = 0;
+    bool trialPassed = false;
+    std::unique_ptr<TrialRunTracker> tracker;
+    auto onMetricReached = [&](TrialRunTracker::TrialRunMetric metric) {
         switch (metric) {
-            case TrialRunTracker::kNumReads:
-                return true;  // terminate the trial run
+            case TrialRunTracker::kNumReads: {
+                if (!trialPassed) {
+                    return true;  // terminate the trial run
+                }
+
+                const auto numReads = tracker->getMetric<TrialRunTracker::kNumReads>();
+                const auto numResults = tracker->getMetric<TrialRunTracker::kNumResults>();
+                const double expectedNumResults = static_cast<double>(numReads) * maxNumResults /
+                    (_decisionReads * internalQueryCacheEvictionRatio);
+                if (numResults < expectedNumResults) {
+                    _reoptimizationReason = str::stream()
+                        << "cached plan was less efficient than expected: expected blocking stage "
+                           "to receive at least "
+                        << static_cast<size_t>(expectedNumResults) << " documents after "
+                        << numReads << " reads but it received " << numResults;
+                    return true;  // terminate the plan
+                }
+
+                if (++numCheckpoints == maxNumCheckpoints) {
+                    candidate.root->detachFromTrialRunTracker();
+                } else {
+                    tracker->setMaxMetric<TrialRunTracker::kNumReads>(2 * numReads);
+                }
+                return false;
+            }
             case TrialRunTracker::kNumResults:
-                candidate.root->detachFromTrialRunTracker();
+                trialPassed = true;
+                if (maxNumCheckpoints == 0) {
+                    candidate.root->detachFromTrialRunTracker();
+                } else {
+                    tracker->setMaxMetric<TrialRunTracker::kNumResults>(
+                        std::numeric_limits<size_t>::max());
+                    tracker->setMaxMetric<TrialRunTracker::kNumReads>(2 * maxTrialPeriodNumReads);
+                }
                 return false;  // upgrade the trial run into a normal one
             default:
                 MONGO_UNREACHABLE;
         }
     };
-    auto tracker = std::make_unique<TrialRunTracker>(
+    tracker = std::make_unique<TrialRunTracker>(
         std::move(onMetricReached), maxNumResults, maxTrialPeriodNumReads);
     candidate.root->attachToTrialRunTracker(tracker.get());
     executeCandidateTrial(&candidate, maxNumResults);
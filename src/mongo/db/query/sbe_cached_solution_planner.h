@@ -72,6 +72,10 @@ private:
      * reads during the trial meets the criteria for replanning, in which case it sets the
      * 'needsReplanning' flag of the resulting CandidatePlan to true.
      *
+     * If the plan has a blocking stage, it keeps checking the rate at which the blocking stage
+     * receives its input after the trial period has passed. If that rate falls too low, the plan is
+     * terminated as if it had exited early and '_reoptimizationReason' is set.
+     *
      * The execution plan for the resulting CandidatePlan remains open, but if the 'exitedEarly'
      * flag is set, the plan is in an invalid state and must be closed and reopened before it can be
      * executed.
@@ -98,5 +102,9 @@ private:
     // The number of physical reads taken to decide on a winning plan when the plan was first
     // cached.
     const size_t _decisionReads;
+
+    // Set if the cached plan passed its trial period but was terminated afterwards because its
+    // blocking stage received its input at a much lower rate than expected.
+    boost::optional<std::string> _reoptimizationReason;
 };
 }  // namespace mongo::sbe
@@ -0,0 +1,326 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kQuery
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/query/sbe_plan_cache_persistence.h"
+
+#include <boost/filesystem/operations.hpp>
+#include <fstream>
+
+#include "mongo/base/data_range_cursor.h"
+#include "mongo/base/data_type_validated.h"
+#include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/client.h"
+#include "mongo/db/exec/plan_cache_util.h"
+#include "mongo/db/query/plan_cache_key_factory.h"
+#include "mongo/db/query/query_feature_flags_gen.h"
+#include "mongo/db/query/query_knobs_gen.h"
+#include "mongo/db/storage/storage_options.h"
+#include "mongo/logv2/log.h"
+#include "mongo/rpc/object_check.h"
+#include "mongo/stdx/unordered_set.h"
+#include "mongo/util/errno_util.h"
+#include "mongo/util/scopeguard.h"
+
+namespace mongo::sbe {
+namespace {
+
+const auto persistedPlanCacheDecoration = ServiceContext::declareDecoration<PersistedPlanCache>();
+
+constexpr auto kFileName = "sbePlanCache.bson"_sd;
+
+std::string makeEntryKey(const UUID& collectionUuid,
+                         bool isShardedCollection,
+                         StringData planCacheKey) {
+    return str::stream() << collectionUuid.toString() << (isShardedCollection ? '1' : '0')
+                         << planCacheKey;
+}
+
+std::string makeEntryKey(const PersistedPlanCacheEntry& entry) {
+    auto planCacheKey = entry.getPlanCacheKey();
+    return makeEntryKey(entry.getCollectionUuid(),
+                        entry.getIsShardedCollection(),
+                        StringData(planCacheKey.data(), planCacheKey.length()));
+}
+}  // namespace
+
+bool isPlanCachePersistenceEnabled() {
+    return internalQuerySBEPlanCachePersistenceIntervalSecs > 0 && !storageGlobalParams.readOnly &&
+        feature_flags::gFeatureFlagSbePlanCache.isEnabledAndIgnoreFCV();
+}
+
+PersistedPlanCache& PersistedPlanCache::get(ServiceContext* serviceCtx) {
+    return persistedPlanCacheDecoration(serviceCtx);
+}
+
+boost::filesystem::path PersistedPlanCache::getFilePath() {
+    return boost::filesystem::path(storageGlobalParams.dbpath) / kFileName.toString();
+}
+
+StatusWith<size_t> PersistedPlanCache::writeSnapshot(OperationContext* opCtx,
+                                                     const PlanCache& cache,
+                                                     const boost::filesystem::path& path) const {
+    BufBuilder buffer;
+    size_t numEntries = 0;
+    auto appendEntry = [&](const PersistedPlanCacheEntry& entry) {
+        auto obj = entry.toBSON();
+        buffer.appendBuf(obj.objdata(), obj.objsize());
+        ++numEntries;
+    };
+
+    stdx::unordered_set<std::string> writtenKeys;
+    cache.forEachEntry([&](const PlanCacheKey& key, const PlanCacheEntry& entry) {
+        // Pinned entries come from queries with a single solution, which never multi-plan, so
+        // there is nothing to gain from persisting them.
+        if (!entry.isActive || entry.isPinned() || !entry.debugInfo) {
+            return;
+        }
+
+        const auto& keyString = key.toString();
+        appendEntry({key.getCollectionUuid(),
+                     key.isShardedCollection(),
+                     std::vector<std::uint8_t>(keyString.begin(), keyString.end()),
+                     entry.debugInfo->planSummary,
+                     entry.debugInfo->indexesUsed,
+                     static_cast<long long>(*entry.works)});
+        writtenKeys.insert(
+            makeEntryKey(key.getCollectionUuid(), key.isShardedCollection(), keyString));
+    });
+
+    {
+        auto catalog = CollectionCatalog::get(opCtx);
+        stdx::lock_guard lk(_mutex);
+        for (auto&& [entryKey, entry] : _entries) {
+            if (!writtenKeys.count(entryKey) &&
+                catalog->lookupNSSByUUID(opCtx, entry.getCollectionUuid())) {
+                appendEntry(entry);
+            }
+        }
+    }
+
+    auto tempPath = path;
+    tempPath += ".tmp";
+    {
+        std::ofstream ofs(tempPath.c_str(), std::ios_base::out | std::ios_base::binary);
+        if (!ofs) {
+            return Status(ErrorCodes::FileNotOpen,
+                          str::stream() << "Failed to open " << tempPath.string() << ": "
+                                        << errnoWithDescription());
+        }
+
+        ofs.write(buffer.buf(), buffer.len());
+        if (!ofs) {
+            return Status(ErrorCodes::OperationFailed,
+                          str::stream() << "Failed to write the SBE plan cache to "
+                                        << tempPath.string() << ": "
+                                        << errnoWithDescription());
+        }
+    }
+
+    // The file only serves to avoid multi-planning after a restart, so we do not fsync it. If the
+    // server crashes before the data reaches the disk, the damaged file is ignored on load.
+    boost::system::error_code ec;
+    boost::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        return Status(ErrorCodes::FileRenameFailed,
+                      str::stream() << "Failed to rename " << tempPath.string() << " to "
+                                    << path.string() << ": " << ec.message());
+    }
+
+    return numEntries;
+}
+
+Status PersistedPlanCache::load(const boost::filesystem::path& path) {
+    decltype(_entries) entries;
+    ON_BLOCK_EXIT([&] {
+        stdx::lock_guard lk(_mutex);
+        _entries = std::move(entries);
+    });
+
+    boost::system::error_code ec;
+    auto fileSize = boost::filesystem::file_size(path, ec);
+    if (ec) {
+        // A missing file is expected the first time persistence is enabled.
+        return boost::filesystem::exists(path)
+            ? Status(ErrorCodes::FileStreamFailed,
+                     str::stream() << "Unable to determine the size of " << path.string() << ": "
+                                   << ec.message())
+            : Status::OK();
+    }
+
+    std::vector<char> buffer(fileSize);
+    {
+        std::ifstream ifs(path.c_str(), std::ios_base::in | std::ios_base::binary);
+        if (!ifs) {
+            return Status(ErrorCodes::FileNotOpen,
+                          str::stream() << "Failed to open " << path.string());
+        }
+
+        ifs.read(buffer.data(), buffer.size());
+        if (!ifs) {
+            return Status(ErrorCodes::FileStreamFailed,
+                          str::stream() << "Unable to read the SBE plan cache from "
+                                        << path.string());
+        }
+    }
+
+    ConstDataRangeCursor cursor(buffer.data(), buffer.size());
+    while (!cursor.empty()) {
+        auto swObj = cursor.readAndAdvanceNoThrow<Validated<BSONObj>>();
+        if (!swObj.isOK()) {
+            entries.clear();
+            return swObj.getStatus().withContext(str::stream()
+                                                 << "Invalid SBE plan cache entry in "
+                                                 << path.string());
+        }
+
+        try {
+            auto entry = PersistedPlanCacheEntry::parse(
+                IDLParserErrorContext("PersistedPlanCacheEntry"), swObj.getValue().val);
+            auto entryKey = makeEntryKey(entry);
+            entries.emplace(std::move(entryKey), std::move(entry));
+        } catch (const DBException& ex) {
+            entries.clear();
+            return ex.toStatus().withContext(str::stream() << "Invalid SBE plan cache entry in "
+                                                           << path.string());
+        }
+    }
+
+    return Status::OK();
+}
+
+boost::optional<PersistedPlanCacheEntry> PersistedPlanCache::take(const PlanCacheKey& key) {
+    stdx::lock_guard lk(_mutex);
+    if (_entries.empty()) {
+        return boost::none;
+    }
+
+    auto it = _entries.find(
+        makeEntryKey(key.getCollectionUuid(), key.isShardedCollection(), key.toString()));
+    if (it == _entries.end()) {
+        return boost::none;
+    }
+
+    auto entry = std::move(it->second);
+    _entries.erase(it);
+    return entry;
+}
+
+size_t PersistedPlanCache::size() const {
+    stdx::lock_guard lk(_mutex);
+    return _entries.size();
+}
+
+boost::optional<size_t> findPersistedSolution(
+    const PersistedPlanCacheEntry& entry,
+    const std::vector<std::unique_ptr<QuerySolution>>& solutions) {
+    for (size_t i = 0; i < solutions.size(); ++i) {
+        auto debugInfo = plan_cache_util::buildDebugInfo(solutions[i].get());
+        if (debugInfo.planSummary == entry.getPlanSummary() &&
+            debugInfo.indexesUsed == entry.getIndexesUsed()) {
+            return i;
+        }
+    }
+    return boost::none;
+}
+
+void restorePlanCacheEntry(OperationContext* opCtx,
+                           const CollectionPtr& collection,
+                           const CanonicalQuery& cq,
+                           CandidatePlans& candidates,
+                           size_t decisionReads) {
+    auto&& winner = candidates.winner();
+    if (winner.data.replanReason || !winner.status.isOK()) {
+        return;
+    }
+
+    auto cachedPlan = std::make_unique<CachedSbePlan>(winner.root->clone(), winner.data);
+    plan_cache_util::resetRuntimeEnvironmentBeforeCaching(&cachedPlan->planStageData);
+
+    getPlanCache(opCtx).restore(plan_cache_key_factory::make<PlanCacheKey>(cq, collection),
+                                std::move(cachedPlan),
+                                decisionReads,
+                                opCtx->getServiceContext()->getPreciseClockSource()->now(),
+                                plan_cache_util::buildDebugInfo(winner.solution.get()));
+}
+
+PeriodicPlanCachePersister& PeriodicPlanCachePersister::get(ServiceContext* serviceContext) {
+    auto& jobContainer = _serviceDecoration(serviceContext);
+    jobContainer._init(serviceContext);
+    return jobContainer;
+}
+
+PeriodicJobAnchor& PeriodicPlanCachePersister::operator*() const noexcept {
+    stdx::lock_guard lk(_mutex);
+    return *_anchor;
+}
+
+PeriodicJobAnchor* PeriodicPlanCachePersister::operator->() const noexcept {
+    stdx::lock_guard lk(_mutex);
+    return _anchor.get();
+}
+
+void PeriodicPlanCachePersister::_init(ServiceContext* serviceContext) {
+    stdx::lock_guard lk(_mutex);
+    if (_anchor) {
+        return;
+    }
+
+    auto periodicRunner = serviceContext->getPeriodicRunner();
+    invariant(periodicRunner);
+
+    PeriodicRunner::PeriodicJob job(
+        "SBEPlanCachePersister",
+        [](Client* client) {
+            auto opCtx = client->makeOperationContext();
+            auto serviceCtx = client->getServiceContext();
+            auto swNumEntries = PersistedPlanCache::get(serviceCtx).writeSnapshot(
+                opCtx.get(), getPlanCache(serviceCtx), PersistedPlanCache::getFilePath());
+            if (!swNumEntries.isOK()) {
+                LOGV2_WARNING(6610700,
+                              "Failed to persist the SBE plan cache",
+                              "error"_attr = swNumEntries.getStatus());
+                return;
+            }
+
+            LOGV2_DEBUG(6610701,
+                        1,
+                        "Persisted the SBE plan cache",
+                        "numEntries"_attr = swNumEntries.getValue());
+        },
+        Seconds(internalQuerySBEPlanCachePersistenceIntervalSecs));
+
+    _anchor = std::make_shared<PeriodicJobAnchor>(periodicRunner->makeJob(std::move(job)));
+}
+
+}  // namespace mongo::sbe
@@ -0,0 +1,158 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#pragma once
+
+#include <boost/filesystem/path.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mongo/db/query/canonical_query.h"
+#include "mongo/db/query/query_solution.h"
+#include "mongo/db/query/sbe_plan_cache.h"
+#include "mongo/db/query/sbe_plan_cache_persistence_gen.h"
+#include "mongo/db/query/sbe_runtime_planner.h"
+#include "mongo/db/service_context.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/unordered_map.h"
+#include "mongo/util/hierarchical_acquisition.h"
+#include "mongo/util/periodic_runner.h"
+
+namespace mongo::sbe {
+
+/**
+ * Returns true if the SBE plan cache is enabled,
+ * internalQuerySlotBasedExecutionPlanCachePersistenceIntervalSecs asks for it to be persisted, and
+ * the server is allowed to write to its dbpath.
+ */
+bool isPlanCachePersistenceEnabled();
+
+/**
+ * Lets a freshly started server reuse the multi-planning decisions made by its previous run.
+ *
+ * An SBE execution tree cannot be written to disk as such. Instead, for every active entry of the
+ * SBE plan cache, we persist the plan cache key, the plan summary and the indexes of the solution
+ * which won multi-planning, and the number of reads it took to win. When the server starts, these
+ * entries are loaded back into memory. The first query of each persisted shape then looks for a
+ * candidate solution with the same summary and indexes. If there is one, that solution is run
+ * through the cached solution planner instead of multi-planning all the candidates. This also
+ * checks the persisted entry against the current index catalog and data: a missing index means no
+ * candidate matches, and a plan that does much more work than before is replanned.
+ */
+class PersistedPlanCache {
+public:
+    static PersistedPlanCache& get(ServiceContext* serviceCtx);
+
+    /**
+     * Returns the path of the file the SBE plan cache is persisted to.
+     */
+    static boost::filesystem::path getFilePath();
+
+    /**
+     * Writes every active, non-pinned entry of 'cache' to 'path', along with the persisted entries
+     * that have not been taken yet and whose collection still exists. Keeping the latter matters on
+     * a secondary, whose plan cache may stay cold until it is elected. The entries are written to
+     * a temporary file first, which is then renamed over 'path', so readers never see a partially
+     * written file. Returns the number of entries written.
+     */
+    StatusWith<size_t> writeSnapshot(OperationContext* opCtx,
+                                     const PlanCache& cache,
+                                     const boost::filesystem::path& path) const;
+
+    /**
+     * Replaces the entries held in memory with those read from 'path'. A missing file leaves no
+     * entries behind. Returns an error if the file cannot be read or parsed, in which case no
+     * entries are kept.
+     */
+    Status load(const boost::filesystem::path& path);
+
+    /**
+     * Removes and returns the entry persisted for 'key', if any. Each entry is handed out at most
+     * once: after that, the regular plan cache takes over for the query shape.
+     */
+    boost::optional<PersistedPlanCacheEntry> take(const PlanCacheKey& key);
+
+    /**
+     * Returns the number of persisted entries that have not been taken yet.
+     */
+    size_t size() const;
+
+private:
+    mutable Mutex _mutex = MONGO_MAKE_LATCH("PersistedPlanCache::_mutex");
+
+    // Entries keyed by the collection UUID, the sharded flag and the plan cache key string. The
+    // collection version is not part of the key since it is reset on every restart.
+    stdx::unordered_map<std::string, PersistedPlanCacheEntry> _entries;
+};
+
+/**
+ * Returns the position in 'solutions' of the solution described by 'entry', or boost::none if no
+ * solution matches, for instance because one of the indexes it used has been dropped.
+ */
+boost::optional<size_t> findPersistedSolution(
+    const PersistedPlanCacheEntry& entry,
+    const std::vector<std::unique_ptr<QuerySolution>>& solutions);
+
+/**
+ * Adds the winner of 'candidates' to the SBE plan cache as an active entry with 'decisionReads'
+ * works. Call this after the cached solution planner has run a solution found by
+ * findPersistedSolution(). If the planner had to replan, the multi-planner has already updated the
+ * cache and this does nothing.
+ */
+void restorePlanCacheEntry(OperationContext* opCtx,
+                           const CollectionPtr& collection,
+                           const CanonicalQuery& cq,
+                           CandidatePlans& candidates,
+                           size_t decisionReads);
+
+/**
+ * A periodic background job that writes the SBE plan cache to disk every
+ * internalQuerySlotBasedExecutionPlanCachePersistenceIntervalSecs seconds.
+ */
+class PeriodicPlanCachePersister final {
+public:
+    static PeriodicPlanCachePersister& get(ServiceContext* serviceContext);
+
+    PeriodicJobAnchor& operator*() const noexcept;
+    PeriodicJobAnchor* operator->() const noexcept;
+
+private:
+    void _init(ServiceContext* serviceContext);
+
+    inline static const auto _serviceDecoration =
+        ServiceContext::declareDecoration<PeriodicPlanCachePersister>();
+
+    mutable Mutex _mutex = MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(1),
+                                            "PeriodicPlanCachePersister::_mutex");
+    std::shared_ptr<PeriodicJobAnchor> _anchor;
+};
+
+}  // namespace mongo::sbe
@@ -0,0 +1,148 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+
+#include "mongo/platform/basic.h"
+
+#include <boost/filesystem/operations.hpp>
+#include <fstream>
+
+#include "mongo/db/query/sbe_plan_cache_persistence.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo::sbe {
+namespace {
+
+class SbePlanCachePersistenceTest : public ServiceContextTest {
+protected:
+    static PlanCacheKey makeKey(const UUID& collectionUuid, StringData shape) {
+        return PlanCacheKey(PlanCacheKeyInfo(shape.toString(), "<indexability>"),
+                            collectionUuid,
+                            1 /* collectionVersion */,
+                            false /* isShardedCollection */);
+    }
+
+    static PersistedPlanCacheEntry makeEntry(const PlanCacheKey& key,
+                                             std::string planSummary,
+                                             long long decisionReads) {
+        const auto& keyString = key.toString();
+        return {key.getCollectionUuid(),
+                key.isShardedCollection(),
+                std::vector<std::uint8_t>(keyString.begin(), keyString.end()),
+                std::move(planSummary),
+                {},
+                decisionReads};
+    }
+
+    void writeFile(const std::vector<PersistedPlanCacheEntry>& entries) {
+        std::ofstream ofs(_path.c_str(), std::ios_base::out | std::ios_base::binary);
+        for (auto&& entry : entries) {
+            auto obj = entry.toBSON();
+            ofs.write(obj.objdata(), obj.objsize());
+        }
+    }
+
+    unittest::TempDir _tempDir{"sbePlanCachePersistenceTest"};
+    boost::filesystem::path _path = boost::filesystem::path(_tempDir.path()) / "plan_cache.bson";
+    PersistedPlanCache _persistedPlanCache;
+};
+
+TEST_F(SbePlanCachePersistenceTest, MissingFileLoadsNoEntries) {
+    ASSERT_OK(_persistedPlanCache.load(_path));
+    ASSERT_EQ(_persistedPlanCache.size(), 0U);
+}
+
+TEST_F(SbePlanCachePersistenceTest, EachLoadedEntryIsTakenOnce) {
+    auto collectionUuid = UUID::gen();
+    auto firstKey = makeKey(collectionUuid, "first");
+    auto secondKey = makeKey(collectionUuid, "second");
+    writeFile({makeEntry(firstKey, "IXSCAN { a: 1 }", 10), makeEntry(secondKey, "COLLSCAN", 20)});
+
+    ASSERT_OK(_persistedPlanCache.load(_path));
+    ASSERT_EQ(_persistedPlanCache.size(), 2U);
+
+    auto entry = _persistedPlanCache.take(firstKey);
+    ASSERT(entry);
+    ASSERT_EQ(entry->getPlanSummary(), "IXSCAN { a: 1 }");
+    ASSERT_EQ(entry->getDecisionReads(), 10);
+    ASSERT_FALSE(_persistedPlanCache.take(firstKey));
+    ASSERT_EQ(_persistedPlanCache.size(), 1U);
+
+    // The same shape on another collection has no persisted entry.
+    ASSERT_FALSE(_persistedPlanCache.take(makeKey(UUID::gen(), "second")));
+    ASSERT(_persistedPlanCache.take(secondKey));
+}
+
+TEST_F(SbePlanCachePersistenceTest, CorruptFileLoadsNoEntries) {
+    auto key = makeKey(UUID::gen(), "shape");
+    writeFile({makeEntry(key, "COLLSCAN", 10)});
+    {
+        std::ofstream ofs(_path.c_str(), std::ios_base::app | std::ios_base::binary);
+        ofs << "garbage";
+    }
+
+    ASSERT_NOT_OK(_persistedPlanCache.load(_path));
+    ASSERT_EQ(_persistedPlanCache.size(), 0U);
+}
+
+TEST_F(SbePlanCachePersistenceTest, SnapshotDropsEntriesOfMissingCollections) {
+    writeFile({makeEntry(makeKey(UUID::gen(), "shape"), "COLLSCAN", 10)});
+    ASSERT_OK(_persistedPlanCache.load(_path));
+    ASSERT_EQ(_persistedPlanCache.size(), 1U);
+
+    // The collection of the loaded entry does not exist, so there is nothing left to persist.
+    auto opCtx = makeOperationContext();
+    PlanCache planCache(1024 * 1024, 1 /* numPartitions */);
+    auto swNumEntries = _persistedPlanCache.writeSnapshot(opCtx.get(), planCache, _path);
+    ASSERT_OK(swNumEntries.getStatus());
+    ASSERT_EQ(swNumEntries.getValue(), 0U);
+    ASSERT_EQ(boost::filesystem::file_size(_path), 0U);
+    ASSERT_FALSE(boost::filesystem::exists(_path.string() + ".tmp"));
+}
+
+TEST_F(SbePlanCachePersistenceTest, FindsSolutionWithPersistedSummary) {
+    std::vector<std::unique_ptr<QuerySolution>> solutions;
+    solutions.push_back(std::make_unique<QuerySolution>());
+    solutions.back()->setRoot(std::make_unique<EofNode>());
+    solutions.push_back(std::make_unique<QuerySolution>());
+    solutions.back()->setRoot(std::make_unique<CollectionScanNode>());
+
+    auto key = makeKey(UUID::gen(), "shape");
+    auto solutionIdx =
+        findPersistedSolution(makeEntry(key, solutions[1]->summaryString(), 10), solutions);
+    ASSERT(solutionIdx);
+    ASSERT_EQ(*solutionIdx, 1U);
+
+    ASSERT_FALSE(findPersistedSolution(makeEntry(key, "IXSCAN { a: 1 }", 10), solutions));
+}
+
+}  // namespace
+}  // namespace mongo::sbe
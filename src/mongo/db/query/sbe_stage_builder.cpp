@@ -2019,6 +2019,7 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
                                                         innerCondSlots,
                                                         innerProjectSlots,
                                                         collatorSlot,
+                                                        _cq.getExpCtx()->allowDiskUse,
                                                         root->nodeId());
 
     // If there are more than 2 children, iterate all remaining children and hash
@@ -2041,6 +2042,7 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
                                                        innerCondSlots,
                                                        innerProjectSlots,
                                                        collatorSlot,
+                                                       _cq.getExpCtx()->allowDiskUse,
                                                        root->nodeId());
     }
 
@@ -35,6 +35,7 @@
 
 #include <fmt/format.h>
 
+#include "mongo/db/exec/sbe/stages/hash_join.h"
 #include "mongo/db/exec/sbe/stages/loop_join.h"
 #include "mongo/db/query/sbe_stage_builder_coll_scan.h"
 #include "mongo/db/query/sbe_stage_builder_expression.h"
@@ -216,6 +217,128 @@ std::pair<SlotId /*matched docs*/, std::unique_ptr<sbe::PlanStage>> buildNljLook
 
     return {innerResultSlot, std::move(nlj)};
 }
+
+// Unwinds the key in 'keySlot' into its elements, or the key itself if it isn't an array. Empty
+// arrays produce Nothing.
+std::pair<SlotId /*elemSlot*/, EvalStage> unwindLookupKey(EvalStage inputStage,
+                                                          SlotId keySlot,
+                                                          const PlanNodeId nodeId,
+                                                          SlotIdGenerator& slotIdGenerator) {
+    inputStage.outSlots = makeSV(keySlot);
+    auto unwindStage = makeUnwind(std::move(inputStage), &slotIdGenerator, nodeId);
+    SlotId elemSlot = unwindStage.outSlots.front();
+    return {elemSlot, std::move(unwindStage)};
+}
+
+// Builds $lookup out of hash joins so that neither side needs to be kept in memory when
+// 'allowDiskUse' is set. Instead of probing the foreign side once per local record, the matches
+// are computed once per distinct local key:
+//  1. The foreign records are keyed by each element of their foreign key and joined with the
+//     elements of the distinct local keys.
+//  2. The matches are grouped by local key. The distinct local keys are unioned in without a
+//     match so that every local key gets a (possibly empty) array.
+//  3. The local records are joined with the resulting table on their local key.
+// The local records come out in input order unless the final join spills, and the matched
+// records come out in no particular order.
+std::pair<SlotId /*matched docs*/, std::unique_ptr<sbe::PlanStage>> buildHashJoinLookupStage(
+    StageBuilderState& state,
+    std::unique_ptr<sbe::PlanStage> localStage,
+    SlotId localRecordSlot,
+    StringData localFieldName,
+    std::unique_ptr<sbe::PlanStage> foreignStage,
+    SlotId foreignRecordSlot,
+    StringData foreignFieldName,
+    bool allowDiskUse,
+    const PlanNodeId nodeId,
+    SlotIdGenerator& slotIdGenerator) {
+    SlotId localKeySlot;
+    std::unique_ptr<sbe::PlanStage> localKeyStage;
+    std::tie(localKeySlot, localKeyStage) = buildLocalLookupBranch(
+        state, std::move(localStage), localRecordSlot, localFieldName, nodeId, slotIdGenerator);
+
+    // The distinct local keys are needed twice, so each use reads its own clone of the local
+    // branch. The clones define the same slots, which are hidden by the hash_agg stages.
+    auto makeDistinctLocalKeys = [&]() {
+        return makeHashAgg(EvalStage{localKeyStage->clone(), SlotVector{}},
+                           makeSV(localKeySlot),
+                           makeEM(),
+                           {} /*collatorSlot*/,
+                           allowDiskUse,
+                           nodeId);
+    };
+
+    // Probe side of the first join: an element of a distinct local key along with the key.
+    auto [localElemSlot, localElemStage] =
+        unwindLookupKey(makeDistinctLocalKeys(), localKeySlot, nodeId, slotIdGenerator);
+
+    // Build side of the first join: a foreign record for each element of its foreign key, with
+    // "undefined" compared as "null". Empty arrays don't match anything so they are dropped.
+    auto [foreignKeySlot, foreignKeyStage] = buildLookupKey(
+        std::move(foreignStage), foreignRecordSlot, foreignFieldName, nodeId, slotIdGenerator);
+    auto [foreignElemSlot, foreignElemStage] =
+        unwindLookupKey(EvalStage{std::move(foreignKeyStage), SlotVector{}},
+                        foreignKeySlot,
+                        nodeId,
+                        slotIdGenerator);
+    SlotId foreignJoinKeySlot = slotIdGenerator.generate();
+    foreignElemStage = makeProject(std::move(foreignElemStage),
+                                   nodeId,
+                                   foreignJoinKeySlot,
+                                   replaceUndefinedWithNullOrPassthrough(foreignElemSlot));
+    foreignElemStage = makeFilter<false /*IsConst*/, false /*IsEof*/>(
+        std::move(foreignElemStage),
+        makeFunction("exists"_sd, makeVariable(foreignJoinKeySlot)),
+        nodeId);
+
+    auto matchesStage = makeS<HashJoinStage>(std::move(foreignElemStage.stage),
+                                             std::move(localElemStage.stage),
+                                             makeSV(foreignJoinKeySlot) /*outerCond*/,
+                                             makeSV(foreignRecordSlot) /*outerProjects*/,
+                                             makeSV(localElemSlot) /*innerCond*/,
+                                             makeSV(localKeySlot) /*innerProjects*/,
+                                             boost::none /*collatorSlot*/,
+                                             allowDiskUse,
+                                             nodeId);
+
+    // Every distinct local key contributes a Nothing match, which 'addToSet' ignores, so that the
+    // keys without matches end up with an empty array.
+    SlotId noMatchSlot = slotIdGenerator.generate();
+    EvalStage noMatchStage = makeProject(
+        makeDistinctLocalKeys(), nodeId, noMatchSlot, makeConstant(TypeTags::Nothing, 0));
+
+    SlotId unionKeySlot = slotIdGenerator.generate();
+    SlotId unionForeignRecordSlot = slotIdGenerator.generate();
+    EvalStage unionStage =
+        makeUnion(makeVector(EvalStage{std::move(matchesStage), SlotVector{}},
+                             std::move(noMatchStage)),
+                  {makeSV(localKeySlot, foreignRecordSlot), makeSV(localKeySlot, noMatchSlot)},
+                  makeSV(unionKeySlot, unionForeignRecordSlot),
+                  nodeId);
+
+    // A foreign record which matches several elements of the same local key is joined once per
+    // element, so the matches are accumulated into a set.
+    SlotId matchedSlot = slotIdGenerator.generate();
+    EvalStage matchesByKeyStage = makeHashAgg(
+        std::move(unionStage),
+        makeSV(unionKeySlot),
+        makeEM(matchedSlot, makeFunction("addToSet"_sd, makeVariable(unionForeignRecordSlot))),
+        {} /*collatorSlot*/,
+        allowDiskUse,
+        nodeId);
+
+    std::unique_ptr<sbe::PlanStage> hj =
+        makeS<HashJoinStage>(std::move(matchesByKeyStage.stage),
+                             std::move(localKeyStage),
+                             makeSV(unionKeySlot) /*outerCond*/,
+                             makeSV(matchedSlot) /*outerProjects*/,
+                             makeSV(localKeySlot) /*innerCond*/,
+                             makeSV(localRecordSlot) /*innerProjects*/,
+                             boost::none /*collatorSlot*/,
+                             allowDiskUse,
+                             nodeId);
+
+    return {matchedSlot, std::move(hj)};
+}
 }  // namespace
 
 std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder::buildLookup(
@@ -224,8 +347,38 @@ std::pair<std::unique_ptr<sbe::PlanStage>, PlanStageSlots> SlotBasedStageBuilder
 
     switch (eqLookupNode->lookupStrategy) {
         case EqLookupNode::LookupStrategy::kHashJoin:
-            uasserted(5842602, "$lookup planning logic picked hash join");
-            break;
+            // TODO SERVER-63533: replace the check for number of children with proper access to the
+            // foreign collection. The check currently allows us to run unit tests.
+            if (eqLookupNode->children.size() == 2) {
+                const auto& localRoot = eqLookupNode->children[0];
+                auto [localStage, localOutputs] = build(localRoot, reqs);
+                sbe::value::SlotId localScanSlot = localOutputs.get(PlanStageSlots::kResult);
+
+                const auto& foreignRoot = eqLookupNode->children[1];
+                auto [foreignStage, foreignOutputs] = build(foreignRoot, reqs);
+                sbe::value::SlotId foreignScanSlot = foreignOutputs.get(PlanStageSlots::kResult);
+
+                auto [matchedSlot, hjStage] =
+                    buildHashJoinLookupStage(_state,
+                                             std::move(localStage),
+                                             localScanSlot,
+                                             eqLookupNode->joinFieldLocal,
+                                             std::move(foreignStage),
+                                             foreignScanSlot,
+                                             eqLookupNode->joinFieldForeign,
+                                             _cq.getExpCtx()->allowDiskUse,
+                                             eqLookupNode->nodeId(),
+                                             _slotIdGenerator);
+
+                PlanStageSlots outputs;
+                outputs.set(kResult, localScanSlot);  // TODO: create an object for $lookup result
+                outputs.set("local"_sd, localScanSlot);
+                outputs.set("matched"_sd, matchedSlot);
+                return {std::move(hjStage), std::move(outputs)};
+            } else {
+                uasserted(5842602, "$lookup planning logic picked hash join");
+                break;
+            }
         case EqLookupNode::LookupStrategy::kIndexedLoopJoin: {
             const auto& index = *eqLookupNode->idxEntry;
             uasserted(5842603,
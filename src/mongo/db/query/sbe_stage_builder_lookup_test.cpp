@@ -34,9 +34,11 @@
 #include "mongo/db/exec/sbe/sbe_plan_stage_test.h"
 #include "mongo/db/exec/sbe/stages/loop_join.h"
 #include "mongo/db/pipeline/document_source_lookup.h"
+#include "mongo/db/query/query_knobs_gen.h"
 #include "mongo/db/query/query_solution.h"
 #include "mongo/db/query/sbe_stage_builder_test_fixture.h"
 #include "mongo/util/assert_util.h"
+#include "mongo/util/scopeguard.h"
 
 #include "mongo/db/pipeline/expression_context.h"
 #include "mongo/db/pipeline/expression_context_for_test.h"
@@ -185,6 +187,113 @@ struct LookupStageBuilderTest : public SbeStageBuilderTestFixture {
                         debugPrint);
     }
 
+    static bool valuesEqual(TypeTags lhsTag, Value lhsVal, TypeTags rhsTag, Value rhsVal) {
+        auto [cmpTag, cmpVal] = compareValue(lhsTag, lhsVal, rhsTag, rhsVal);
+        return cmpTag == TypeTags::NumberInt32 && bitcastTo<int32_t>(cmpVal) == 0;
+    }
+
+    // Checks that the array in 'matchedTag'/'matchedVal' holds exactly the 'expected' documents, in
+    // any order.
+    static bool matchesEqual(TypeTags matchedTag,
+                             Value matchedVal,
+                             const std::vector<BSONObj>& expected) {
+        size_t numMatches = 0;
+        for (ArrayEnumerator it{matchedTag, matchedVal}; !it.atEnd(); it.advance()) {
+            numMatches++;
+        }
+        if (numMatches != expected.size()) {
+            return false;
+        }
+
+        for (const auto& doc : expected) {
+            bool found = false;
+            for (ArrayEnumerator it{matchedTag, matchedVal}; !found && !it.atEnd(); it.advance()) {
+                auto [tag, val] = it.getViewOfValue();
+                found = valuesEqual(
+                    tag, val, TypeTags::bsonObject, bitcastFrom<const char*>(doc.objdata()));
+            }
+            if (!found) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Execute the stage tree and check the results. Unlike the nested loop join, the hash join
+    // does not preserve the order of either the local records or their matches.
+    void CheckHashJoinResults(
+        PlanStage* hjStage,
+        SlotId localSlot,
+        SlotId matchedSlot,
+        const std::vector<std::pair<BSONObj, std::vector<BSONObj>>>& expected) {
+        auto ctx = makeCompileCtx();
+        prepareTree(ctx.get(), hjStage);
+        SlotAccessor* local = hjStage->getAccessor(*ctx, localSlot);
+        SlotAccessor* matched = hjStage->getAccessor(*ctx, matchedSlot);
+
+        std::vector<bool> seen(expected.size(), false);
+        size_t numResults = 0;
+        for (auto st = hjStage->getNext(); st == PlanState::ADVANCED;
+             st = hjStage->getNext(), numResults++) {
+            auto [localTag, localVal] = local->getViewOfValue();
+            auto [matchedTag, matchedVal] = matched->getViewOfValue();
+            ASSERT_TRUE(isArray(matchedTag));
+
+            bool found = false;
+            for (size_t i = 0; !found && i < expected.size(); i++) {
+                found = !seen[i] &&
+                    valuesEqual(localTag,
+                                localVal,
+                                TypeTags::bsonObject,
+                                bitcastFrom<const char*>(expected[i].first.objdata())) &&
+                    matchesEqual(matchedTag, matchedVal, expected[i].second);
+                seen[i] = seen[i] || found;
+            }
+            ASSERT_TRUE(found) << "unexpected result for local "
+                               << std::make_pair(localTag, localVal) << ": "
+                               << std::make_pair(matchedTag, matchedVal);
+        }
+        ASSERT_EQ(numResults, expected.size());
+        hjStage->close();
+    }
+
+    // Returns whether any hash join in the tree rooted at 'stats' spilled to disk.
+    static bool hashJoinUsedDisk(const PlanStageStats& stats) {
+        if (auto hjStats = dynamic_cast<const HashJoinStats*>(stats.specific.get());
+            hjStats && hjStats->usedDisk) {
+            return true;
+        }
+        return std::any_of(stats.children.begin(), stats.children.end(), [](const auto& child) {
+            return hashJoinUsedDisk(*child);
+        });
+    }
+
+    // Builds the lookup as a hash join with disk use allowed, checks its results, and returns
+    // whether it spilled.
+    bool runHashJoinTest(const std::vector<BSONObj>& ldocs,
+                         const std::vector<BSONObj>& fdocs,
+                         const std::string& lkey,
+                         const std::string& fkey,
+                         const std::vector<std::pair<BSONObj, std::vector<BSONObj>>>& expected) {
+        const char* foreignCollName = "fromColl";
+        std::stringstream lookupSpec;
+        lookupSpec << "{$lookup: {from: '" << foreignCollName << "', localField: '" << lkey
+                   << "', foreignField: '" << fkey << "', as: 'matched'}}";
+
+        auto solution = makeLookupSolution(lookupSpec.str(), foreignCollName, ldocs, fdocs);
+        static_cast<EqLookupNode*>(solution->root())->lookupStrategy =
+            EqLookupNode::LookupStrategy::kHashJoin;
+        auto [resultSlots, stage, data, _] = buildPlanStage(std::move(solution),
+                                                            false /*hasRecordId*/,
+                                                            nullptr /*shard filterer*/,
+                                                            nullptr /*collator*/,
+                                                            true /*allowDiskUse*/);
+
+        CheckHashJoinResults(
+            stage.get(), data.outputs.get("local"), data.outputs.get("matched"), expected);
+        return hashJoinUsedDisk(*stage->getStats(false /*includeDebugInfo*/));
+    }
+
     void debugPrintPlan(const PlanStage& stage, StringData header = "") {
         std::cout << std::endl << "*** " << header << " ***" << std::endl;
         std::cout << DebugPrinter{}.print(stage.debugPrint());
@@ -378,4 +487,130 @@ TEST_F(LookupStageBuilderTest, NestedLoopJoin_LocalKey_PathWithNumber) {
     // TODO SERVER-63690: either remove or enable this test.
     // runTest(ldocs, fdocs, "nested.0.lkey", "fkey", expected, true);
 }
+
+TEST_F(LookupStageBuilderTest, HashJoin_Basic) {
+    const std::vector<BSONObj> ldocs = {
+        fromjson("{id:0, lkey:1}"),
+        fromjson("{id:1, lkey:12}"),
+        fromjson("{id:2, lkey:3}"),
+        fromjson("{id:3, lkey:[1,4]}"),
+        fromjson("{id:4, lkey:1}"),
+    };
+
+    const std::vector<BSONObj> fdocs = {
+        fromjson("{id:0, fkey:1}"),
+        fromjson("{id:1, fkey:3}"),
+        fromjson("{id:2, fkey:[1,4,25]}"),
+        fromjson("{id:3, fkey:4}"),
+        fromjson("{id:4, fkey:[24,25,26]}"),
+        fromjson("{id:5, no_fkey:true}"),
+        fromjson("{id:6, fkey:null}"),
+        fromjson("{id:7, fkey:undefined}"),
+        fromjson("{id:8, fkey:[]}"),
+        fromjson("{id:9, fkey:[null]}"),
+    };
+
+    const std::vector<std::pair<BSONObj, std::vector<BSONObj>>> expected = {
+        {ldocs[0], {fdocs[0], fdocs[2]}},
+        {ldocs[1], {}},
+        {ldocs[2], {fdocs[1]}},
+        {ldocs[3], {fdocs[0], fdocs[2], fdocs[3]}},
+        {ldocs[4], {fdocs[0], fdocs[2]}},
+    };
+
+    ASSERT_FALSE(runHashJoinTest(ldocs, fdocs, "lkey", "fkey", expected));
+}
+
+TEST_F(LookupStageBuilderTest, HashJoin_LocalKey_NullAndMissing) {
+    const std::vector<BSONObj> ldocs = {fromjson("{id:0, lkey:null}"),
+                                        fromjson("{id:1, no_lkey:true}")};
+
+    const std::vector<BSONObj> fdocs = {fromjson("{id:0, fkey:1}"),
+                                        fromjson("{id:1, no_fkey:true}"),
+                                        fromjson("{id:2, fkey:null}"),
+                                        fromjson("{id:3, fkey:[null]}"),
+                                        fromjson("{id:4, fkey:undefined}"),
+                                        fromjson("{id:5, fkey:[undefined]}"),
+                                        fromjson("{id:6, fkey:[]}"),
+                                        fromjson("{id:7, fkey:[[]]}")};
+
+    std::vector<std::pair<BSONObj, std::vector<BSONObj>>> expected{
+        {ldocs[0], {fdocs[1], fdocs[2], fdocs[3], fdocs[4], fdocs[5]}},
+        {ldocs[1], {fdocs[1], fdocs[2], fdocs[3], fdocs[4], fdocs[5]}},
+    };
+
+    ASSERT_FALSE(runHashJoinTest(ldocs, fdocs, "lkey", "fkey", expected));
+}
+
+TEST_F(LookupStageBuilderTest, HashJoin_EmptyArrays) {
+    const std::vector<BSONObj> ldocs = {
+        fromjson("{id:0, lkey:[]}"),
+        fromjson("{id:1, lkey:[[]]}"),
+    };
+    const std::vector<BSONObj> fdocs = {
+        fromjson("{id:0, fkey:1}"),
+        fromjson("{id:1, no_fkey:true}"),
+        fromjson("{id:2, fkey:null}"),
+        fromjson("{id:3, fkey:[]}"),
+        fromjson("{id:4, fkey:[[]]}"),
+    };
+
+    // Matches the nested loop join, see NestedLoopJoin_EmptyArrays.
+    std::vector<std::pair<BSONObj, std::vector<BSONObj>>> expected = {
+        {ldocs[0], {}},
+        {ldocs[1], {fdocs[4]}},
+    };
+
+    ASSERT_FALSE(runHashJoinTest(ldocs, fdocs, "lkey", "fkey", expected));
+}
+
+TEST_F(LookupStageBuilderTest, HashJoin_Spill) {
+    const auto defaultMemoryLimit =
+        internalQuerySBEHashJoinApproxMemoryUseInBytesBeforeSpill.load();
+    internalQuerySBEHashJoinApproxMemoryUseInBytesBeforeSpill.store(256);
+    ON_BLOCK_EXIT([&] {
+        internalQuerySBEHashJoinApproxMemoryUseInBytesBeforeSpill.store(defaultMemoryLimit);
+    });
+
+    const int kNumKeys = 20;
+    std::vector<BSONObj> fdocs;
+    for (int i = 0; i < 3 * kNumKeys; i++) {
+        fdocs.push_back(BSON("id" << i << "fkey" << i % kNumKeys));
+    }
+    // A foreign record which matches every other key.
+    BSONArrayBuilder evenKeys;
+    for (int key = 0; key < kNumKeys; key += 2) {
+        evenKeys.append(key);
+    }
+    fdocs.push_back(BSON("id" << 3 * kNumKeys << "fkey" << evenKeys.arr()));
+
+    std::vector<BSONObj> ldocs;
+    std::vector<std::pair<BSONObj, std::vector<BSONObj>>> expected;
+    for (int i = 0; i < 2 * kNumKeys; i++) {
+        const int key = i % kNumKeys;
+        std::vector<BSONObj> matches = {
+            fdocs[key], fdocs[key + kNumKeys], fdocs[key + 2 * kNumKeys]};
+        if (key % 2 == 0) {
+            matches.push_back(fdocs.back());
+        }
+        ldocs.push_back(BSON("id" << i << "lkey" << key));
+        expected.emplace_back(ldocs.back(), std::move(matches));
+    }
+    // A local key outside of the foreign keys, and an array of keys which are both matched by the
+    // last foreign record.
+    ldocs.push_back(BSON("id" << 2 * kNumKeys << "lkey" << kNumKeys));
+    expected.emplace_back(ldocs.back(), std::vector<BSONObj>{});
+    ldocs.push_back(BSON("id" << 2 * kNumKeys + 1 << "lkey" << BSON_ARRAY(0 << 2)));
+    expected.emplace_back(
+        ldocs.back(),
+        std::vector<BSONObj>{fdocs[0],
+                             fdocs[kNumKeys],
+                             fdocs[2 * kNumKeys],
+                             fdocs[2],
+                             fdocs[2 + kNumKeys],
+                             fdocs[2 + 2 * kNumKeys],
+                             fdocs.back()});
+
+    ASSERT_TRUE(runHashJoinTest(ldocs, fdocs, "lkey", "fkey", expected));
+}
 }  // namespace mongo::sbe
@@ -52,10 +52,12 @@ SbeStageBuilderTestFixture::buildPlanStage(
     std::unique_ptr<QuerySolution> querySolution,
     bool hasRecordId,
     std::unique_ptr<ShardFiltererFactoryInterface> shardFiltererInterface,
-    std::unique_ptr<CollatorInterface> collator) {
+    std::unique_ptr<CollatorInterface> collator,
+    bool allowDiskUse) {
     auto findCommand = std::make_unique<FindCommandRequest>(_nss);
     const boost::intrusive_ptr<ExpressionContext> expCtx(
         new ExpressionContextForTest(opCtx(), _nss, std::move(collator)));
+    expCtx->allowDiskUse = allowDiskUse;
     auto statusWithCQ =
         CanonicalQuery::canonicalize(opCtx(), std::move(findCommand), false, expCtx);
     ASSERT_OK(statusWithCQ.getStatus());
@@ -70,7 +70,8 @@ public:
      * the 1st position. Otherwise, if hasRecordId is 'false', the SlotVector will contain a single
      * SlotId for the BSONObj representation of the document. A real or mock
      * ShardFiltererFactoryInterface must be provided so the sbe SlotBasedStageBuilder can build and
-     * utilize a ShardFilterer instance during translation of a ShardingFilterNode.
+     * utilize a ShardFilterer instance during translation of a ShardingFilterNode. 'allowDiskUse'
+     * is passed to the stage builder through the query's ExpressionContext.
      */
     std::tuple<sbe::value::SlotVector,
                std::unique_ptr<sbe::PlanStage>,
@@ -79,7 +80,8 @@ public:
     buildPlanStage(std::unique_ptr<QuerySolution> querySolution,
                    bool hasRecordId,
                    std::unique_ptr<ShardFiltererFactoryInterface> shardFiltererFactoryInterface,
-                   std::unique_ptr<CollatorInterface> collator = nullptr);
+                   std::unique_ptr<CollatorInterface> collator = nullptr,
+                   bool allowDiskUse = false);
 
 private:
     const NamespaceString _nss = NamespaceString{"testdb.sbe_stage_builder"};
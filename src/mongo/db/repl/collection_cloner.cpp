@@ -249,8 +249,26 @@ BaseCloner::AfterStageBehavior CollectionCloner::createCollectionStage() {
 }
 
 BaseCloner::AfterStageBehavior CollectionCloner::queryStage() {
-    runQuery();
-    waitForDatabaseWorkToComplete();
+    if (!_partitionsChosen) {
+        auto bounds = makePartitionBounds();
+        stdx::lock_guard<Latch> lk(_mutex);
+        if (!bounds.empty()) {
+            _partitions.emplace_back();
+            for (auto&& bound : bounds) {
+                _partitions.back().max = bound;
+                _partitions.emplace_back();
+                _partitions.back().min = bound;
+            }
+        }
+        _stats.partitions = _partitions.size();
+        _partitionsChosen = true;
+    }
+    if (_partitions.empty()) {
+        runQuery();
+        waitForDatabaseWorkToComplete();
+    } else {
+        runPartitionedQuery();
+    }
     // We want to free the _collLoader regardless of whether the commit succeeds.
     std::unique_ptr<CollectionBulkLoader> loader = std::move(_collLoader);
     uassertStatusOK(loader->commit());
@@ -346,17 +364,236 @@ void CollectionCloner::runQuery() {
         ReadConcernArgs::kLocal);
 }
 
-void CollectionCloner::handleNextBatch(DBClientCursorBatchIterator& iter) {
+std::vector<BSONObj> CollectionCloner::choosePartitionBounds(
+    const std::vector<BSONObj>& sortedSampleIds, size_t numPartitions) {
+    std::vector<BSONObj> bounds;
+    if (sortedSampleIds.empty()) {
+        return bounds;
+    }
+    for (size_t i = 1; i < numPartitions; ++i) {
+        const auto& bound = sortedSampleIds[i * sortedSampleIds.size() / numPartitions];
+        // Repeated samples would make empty ranges.
+        if (bounds.empty() || bounds.back().woCompare(bound) < 0) {
+            bounds.push_back(bound);
+        }
+    }
+    return bounds;
+}
+
+std::vector<BSONObj> CollectionCloner::makePartitionBounds() {
+    // Capped and clustered collections are cloned in natural order, and range bounds on the _id
+    // index only follow the simple BSON order without a collation.
+    if (!getCreateClientFn() || _collectionOptions.capped || _collectionOptions.clusteredIndex ||
+        !_collectionOptions.collation.isEmpty() || _idIndexSpec.isEmpty()) {
+        return {};
+    }
+    long long bytesToCopy;
     {
-        stdx::lock_guard<InitialSyncSharedData> lk(*getSharedData());
-        if (!getSharedData()->getStatus(lk).isOK()) {
-            static constexpr char message[] =
-                "Collection cloning cancelled due to initial sync failure";
-            LOGV2(21136, message, "error"_attr = getSharedData()->getStatus(lk));
-            uasserted(ErrorCodes::CallbackCanceled,
-                      str::stream() << message << ": " << getSharedData()->getStatus(lk));
+        stdx::lock_guard<Latch> lk(_mutex);
+        bytesToCopy = _stats.bytesToCopy;
+    }
+    const auto numPartitions =
+        std::min(static_cast<long long>(collectionClonerMaxPartitions.load()),
+                 bytesToCopy / collectionClonerMinPartitionSizeBytes.load());
+    if (numPartitions < 2) {
+        return {};
+    }
+
+    static constexpr long long kSampledIdsPerPartition = 16;
+    const long long sampleSize = numPartitions * kSampledIdsPerPartition;
+    std::vector<BSONObj> sortedSampleIds;
+    try {
+        BSONObj res;
+        getClient()->runCommand(
+            _sourceNss.db().toString(),
+            BSON("aggregate" << _sourceNss.coll() << "pipeline"
+                             << BSON_ARRAY(BSON("$sample" << BSON("size" << sampleSize))
+                                           << BSON("$project" << BSON("_id" << 1))
+                                           << BSON("$sort" << BSON("_id" << 1)))
+                             << "cursor" << BSON("batchSize" << sampleSize + 1)
+                             << ReadConcernArgs::kReadConcernFieldName << ReadConcernArgs::kLocal),
+            res,
+            QueryOption_SecondaryOk);
+        uassertStatusOK(getStatusFromCommandResult(res));
+        for (auto&& elem : res["cursor"]["firstBatch"].Obj()) {
+            sortedSampleIds.push_back(elem.Obj().getOwned());
         }
+    } catch (const DBException& e) {
+        LOGV2(6610806,
+              "Cloning collection through a single query because its _id values could not be "
+              "sampled",
+              logAttrs(_sourceNss),
+              "error"_attr = e.toStatus());
+        return {};
     }
+    auto bounds = choosePartitionBounds(sortedSampleIds, numPartitions);
+    LOGV2_DEBUG(6610807,
+                1,
+                "Cloning collection in _id ranges",
+                logAttrs(_sourceNss),
+                "partitions"_attr = bounds.size() + 1);
+    return bounds;
+}
+
+void CollectionCloner::runPartitionedQuery() {
+    size_t partitionsLeft = 0;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _partitionedQueryStatus = Status::OK();
+        for (const auto& partition : _partitions) {
+            partitionsLeft += partition.done ? 0 : 1;
+        }
+    }
+
+    // The first range query runs over the cloner's client, the others over additional connections.
+    std::vector<std::shared_ptr<DBClientConnection>> additionalClients;
+    while (additionalClients.size() + 1 < partitionsLeft) {
+        try {
+            additionalClients.push_back(makeAdditionalClient());
+        } catch (const DBException& e) {
+            LOGV2_WARNING(6610808,
+                          "Failed to open an additional connection for cloning collection ranges",
+                          logAttrs(_sourceNss),
+                          "error"_attr = e.toStatus());
+            break;
+        }
+    }
+
+    auto cloneRanges = [this](DBClientConnection* client) {
+        while (true) {
+            size_t partitionIndex = 0;
+            {
+                stdx::lock_guard<Latch> lk(_mutex);
+                while (partitionIndex < _partitions.size() && _partitions[partitionIndex].done) {
+                    ++partitionIndex;
+                }
+                if (!_partitionedQueryStatus.isOK() || partitionIndex == _partitions.size()) {
+                    return;
+                }
+                // Claim the range until its query finishes.
+                _partitions[partitionIndex].done = true;
+            }
+            try {
+                runPartitionQuery(client, partitionIndex);
+            } catch (const DBException& e) {
+                stdx::lock_guard<Latch> lk(_mutex);
+                _partitions[partitionIndex].done = false;
+                if (_partitionedQueryStatus.isOK()) {
+                    _partitionedQueryStatus = e.toStatus();
+                }
+                return;
+            }
+        }
+    };
+
+    {
+        auto workers =
+            makeWorkerPool("CollectionCloner-" + _sourceNss.ns(), additionalClients.size());
+        for (const auto& client : additionalClients) {
+            workers->schedule([&cloneRanges, client = client.get()](Status status) {
+                if (status.isOK()) {
+                    cloneRanges(client);
+                }
+            });
+        }
+        cloneRanges(getClient());
+        workers->shutdown();
+        workers->join();
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    uassertStatusOK(_partitionedQueryStatus);
+}
+
+void CollectionCloner::runPartitionQuery(DBClientConnection* client, size_t partitionIndex) {
+    Query query;
+    BSONObj resumeId;
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        const auto& partition = _partitions[partitionIndex];
+        resumeId = partition.lastId;
+        query.hint(BSON("_id" << 1));
+        if (!resumeId.isEmpty()) {
+            query.appendElements(BSON("$min" << resumeId));
+        } else if (!partition.min.isEmpty()) {
+            query.appendElements(BSON("$min" << partition.min));
+        }
+        if (!partition.max.isEmpty()) {
+            query.appendElements(BSON("$max" << partition.max));
+        }
+    }
+
+    client->query_DEPRECATED(
+        [&](DBClientCursorBatchIterator& iter) {
+            handleNextPartitionBatch(partitionIndex, &resumeId, iter);
+        },
+        _sourceDbAndUuid,
+        BSONObj{},
+        query,
+        nullptr /* fieldsToReturn */,
+        QueryOption_NoCursorTimeout | QueryOption_SecondaryOk |
+            (collectionClonerUsesExhaust ? QueryOption_Exhaust : 0),
+        _collectionClonerBatchSize,
+        ReadConcernArgs::kLocal);
+}
+
+void CollectionCloner::handleNextPartitionBatch(size_t partitionIndex,
+                                                BSONObj* resumeId,
+                                                DBClientCursorBatchIterator& iter) {
+    uassertInitialSyncNotFailed();
+
+    std::vector<BSONObj> docs;
+    while (iter.moreInCurrentBatch()) {
+        auto doc = iter.nextSafe();
+        if (!resumeId->isEmpty()) {
+            const bool isResumeDoc = resumeId->firstElement().woCompare(doc["_id"], false) == 0;
+            *resumeId = BSONObj();
+            if (isResumeDoc) {
+                continue;
+            }
+        }
+        docs.emplace_back(std::move(doc));
+    }
+
+    {
+        stdx::lock_guard<Latch> lk(_mutex);
+        // Stop early when the query of another range failed.
+        uassertStatusOK(_partitionedQueryStatus);
+        _stats.receivedBatches++;
+    }
+
+    if (!docs.empty()) {
+        // CollectionBulkLoader is not thread safe. The other ranges keep receiving their next
+        // batch and reporting their progress meanwhile.
+        stdx::lock_guard<Latch> loaderLock(_collLoaderMutex);
+        invariant(_collLoader);
+        uassertStatusOK(_collLoader->insertDocuments(docs.cbegin(), docs.cend()));
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    ++_stats.fetchedBatches;
+    if (docs.empty()) {
+        return;
+    }
+    _stats.documentsCopied += docs.size();
+    _stats.approxBytesCopied = ((long)_stats.documentsCopied) * _stats.avgObjSize;
+    _progressMeter.hit(int(docs.size()));
+    _partitions[partitionIndex].lastId = BSON("_id" << docs.back()["_id"]);
+}
+
+void CollectionCloner::uassertInitialSyncNotFailed() {
+    stdx::lock_guard<InitialSyncSharedData> lk(*getSharedData());
+    if (!getSharedData()->getStatus(lk).isOK()) {
+        static constexpr char message[] =
+            "Collection cloning cancelled due to initial sync failure";
+        LOGV2(21136, message, "error"_attr = getSharedData()->getStatus(lk));
+        uasserted(ErrorCodes::CallbackCanceled,
+                  str::stream() << message << ": " << getSharedData()->getStatus(lk));
+    }
+}
+
+void CollectionCloner::handleNextBatch(DBClientCursorBatchIterator& iter) {
+    uassertInitialSyncNotFailed();
 
     // If this is 'true', it means that something happened to our remote cursor for a reason other
     // than the collection being dropped, all while we were running a non-resumable (4.2) clone.
@@ -503,6 +740,9 @@ void CollectionCloner::Stats::append(BSONObjBuilder* builder) const {
         }
     }
     builder->appendNumber("receivedBatches", static_cast<long long>(receivedBatches));
+    if (partitions) {
+        builder->appendNumber("partitions", static_cast<long long>(partitions));
+    }
 }
 
 }  // namespace repl
@@ -63,6 +63,7 @@ public:
         long long bytesToCopy{0};
         long long avgObjSize{0};
         long long approxBytesCopied{0};
+        size_t partitions{0};
 
         std::string toString() const;
         BSONObj toBSON() const;
@@ -103,6 +104,14 @@ public:
         return *_sourceDbAndUuid.uuid();
     }
 
+    /**
+     * Returns the lower bounds of the _id ranges after the first one, when splitting a collection
+     * into at most 'numPartitions' ranges that each hold about as many of the sampled _id values.
+     * 'sortedSampleIds' holds documents of the form {_id: <value>} sorted by _id.
+     */
+    static std::vector<BSONObj> choosePartitionBounds(const std::vector<BSONObj>& sortedSampleIds,
+                                                      size_t numPartitions);
+
     /**
      * Set the cloner batch size.
      *
@@ -226,6 +235,49 @@ private:
      */
     void runQuery();
 
+    /**
+     * Throws if initial sync failed, to stop the remote query of the calling thread.
+     */
+    void uassertInitialSyncNotFailed();
+
+    /**
+     * Splits the collection into _id ranges to clone concurrently, based on a sample of the _id
+     * values on the source. Returns no ranges when the collection is small, when the collection
+     * must be cloned in natural order or when its _id values could not be sampled.
+     */
+    std::vector<BSONObj> makePartitionBounds();
+
+    /**
+     * Clones the ranges in '_partitions' that are not done yet, each through its own query over
+     * one of several connections to the source. Throws the first error of any range query.
+     */
+    void runPartitionedQuery();
+
+    /**
+     * Queries the source for the documents of the given range, resuming after the last document
+     * received from a previous attempt, and inserts them.
+     */
+    void runPartitionQuery(DBClientConnection* client, size_t partitionIndex);
+
+    /**
+     * Inserts a batch of documents of the given range. 'resumeId' is the _id of the last document
+     * received from a previous query on the range, which is skipped because range queries resume
+     * at that document inclusively.
+     */
+    void handleNextPartitionBatch(size_t partitionIndex,
+                                  BSONObj* resumeId,
+                                  DBClientCursorBatchIterator& iter);
+
+    // An _id range of the collection, cloned by its own query. Empty bounds are unbounded.
+    struct Partition {
+        BSONObj min;  // Inclusive.
+        BSONObj max;  // Exclusive.
+        // The _id of the last document received, of the form {_id: <value>}.
+        BSONObj lastId;
+        // Set while a query clones the range and once it finished. Reset when the query fails.
+        bool done = false;
+    };
+
     // All member variables are labeled with one of the following codes indicating the
     // synchronization rules for accessing them.
     //
@@ -273,6 +325,19 @@ private:
     // Signifies that there were changes to the collection on the sync source that resulted in
     // our remote cursor getting killed.
     bool _lostNonResumableCursor = false;  // (X)
+
+    // Whether the collection was checked for splitting into '_partitions'. This is decided once,
+    // so a retried query stage resumes the same kind of query.
+    bool _partitionsChosen = false;  // (X)
+
+    // The _id ranges the collection is cloned in, or empty when it is cloned by a single query.
+    std::vector<Partition> _partitions;  // (M)
+
+    // The first error of any range query of the current partitioned query attempt.
+    Status _partitionedQueryStatus = Status::OK();  // (M)
+
+    // Serializes the inserts of the range queries into '_collLoader', without holding '_mutex'.
+    Mutex _collLoaderMutex = MONGO_MAKE_LATCH("CollectionCloner::_collLoaderMutex");
 };
 
 }  // namespace repl
@@ -29,6 +29,7 @@
 
 #include "mongo/platform/basic.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "mongo/bson/bsonmisc.h"
@@ -39,6 +40,7 @@
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/dbtests/mock/mock_dbclient_connection.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/concurrency/thread_pool.h"
 
@@ -1006,6 +1008,142 @@ TEST_F(CollectionClonerTestResumable, ResumableQueryTwoResumes) {
     ASSERT_EQUALS(7u, stats.documentsCopied);
 }
 
+class CollectionClonerTestPartitioned : public CollectionClonerTest {
+protected:
+    void setUp() final {
+        CollectionClonerTest::setUp();
+        setInitialSyncId();
+
+        // Record the _id of every inserted document.
+        _storageInterface.createCollectionForBulkFn =
+            [this](const NamespaceString& nss,
+                   const CollectionOptions& options,
+                   const BSONObj idIndexSpec,
+                   const std::vector<BSONObj>& nonIdIndexSpecs)
+            -> StatusWith<std::unique_ptr<CollectionBulkLoaderMock>> {
+            auto localLoader = std::make_unique<CollectionBulkLoaderMock>(_collectionStats);
+            localLoader->insertDocsFn = [this](const std::vector<BSONObj>::const_iterator begin,
+                                               const std::vector<BSONObj>::const_iterator end) {
+                stdx::lock_guard<Latch> lk(_insertedIdsMutex);
+                for (auto it = begin; it != end; ++it) {
+                    _insertedIds.push_back((*it)["_id"].numberInt());
+                }
+                return Status::OK();
+            };
+            Status result = localLoader->init(nonIdIndexSpecs);
+            if (!result.isOK())
+                return result;
+
+            _loader = localLoader.get();
+            return std::move(localLoader);
+        };
+
+        setMockServerReplies(BSON("size" << 90),
+                             createCountResponse(9),
+                             createCursorResponse(_nss.ns(), BSON_ARRAY(_idIndexSpec)));
+        BSONArrayBuilder sampledIds;
+        for (int i = 1; i <= 9; ++i) {
+            _mockServer->insert(_nss.ns(), BSON("_id" << i));
+            sampledIds.append(BSON("_id" << i));
+        }
+        // Splits the collection into the _id ranges [MinKey, 4), [4, 7) and [7, MaxKey).
+        _mockServer->setCommandReply("aggregate",
+                                     createCursorResponse(_nss.ns(), sampledIds.arr()));
+    }
+
+    /**
+     * Makes a cloner that opens its additional connections to the mock server, or that fails to
+     * open any additional connection when 'canConnect' is false.
+     */
+    std::unique_ptr<CollectionCloner> makePartitionedCollectionCloner(bool canConnect) {
+        auto cloner = makeCollectionCloner();
+        cloner->setBatchSize_forTest(2);
+        cloner->setCreateClientFn([this, canConnect]() -> std::shared_ptr<DBClientConnection> {
+            uassert(ErrorCodes::HostUnreachable, "No additional connections", canConnect);
+            ++_clientsCreated;
+            return std::make_shared<MockDBClientConnection>(_mockServer.get(),
+                                                            true /* autoReconnect */);
+        });
+        return cloner;
+    }
+
+    std::vector<int> getSortedInsertedIds() {
+        stdx::lock_guard<Latch> lk(_insertedIdsMutex);
+        auto insertedIds = _insertedIds;
+        std::sort(insertedIds.begin(), insertedIds.end());
+        return insertedIds;
+    }
+
+    const std::vector<int> _expectedIds{1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    RAIIServerParameterControllerForTest _maxPartitions{"collectionClonerMaxPartitions", 3};
+    RAIIServerParameterControllerForTest _minPartitionSize{"collectionClonerMinPartitionSizeBytes",
+                                                           1};
+    int _clientsCreated = 0;
+
+    Mutex _insertedIdsMutex =
+        MONGO_MAKE_LATCH("CollectionClonerTestPartitioned::_insertedIdsMutex");
+    std::vector<int> _insertedIds;
+};
+
+TEST_F(CollectionClonerTestPartitioned, ClonesEachRangeOverItsOwnConnection) {
+    auto cloner = makePartitionedCollectionCloner(true /* canConnect */);
+    ASSERT_OK(cloner->run());
+
+    // The first range is cloned over the cloner's client, the others over additional connections.
+    ASSERT_EQUALS(2, _clientsCreated);
+
+    // The $min and $max bounds of the range queries cover every document exactly once.
+    ASSERT(_expectedIds == getSortedInsertedIds());
+    ASSERT_TRUE(_collectionStats->commitCalled);
+    auto stats = cloner->getStats();
+    ASSERT_EQUALS(3U, stats.partitions);
+    ASSERT_EQUALS(9U, stats.documentsCopied);
+}
+
+TEST_F(CollectionClonerTestPartitioned, FailedRangeQueryResumesAfterLastReceivedDocument) {
+    // Without additional connections, the cloner's client clones the ranges one after the other.
+    auto cloner = makePartitionedCollectionCloner(false /* canConnect */);
+
+    // The first range query fails transiently after receiving the documents with _id 1 and 2.
+    auto failNextBatch = globalFailPointRegistry().find("mockCursorThrowErrorOnGetMore");
+    failNextBatch->setMode(FailPoint::nTimes, 1, fromjson("{errorType: 'HostUnreachable'}"));
+    ASSERT_OK(cloner->run());
+
+    ASSERT_EQUALS(0, _clientsCreated);
+
+    // The retried query of the first range starts at _id 2, since $min is inclusive. The document
+    // with _id 2 is received twice but only inserted once, and the first range is not cloned from
+    // its start again.
+    ASSERT(_expectedIds == getSortedInsertedIds());
+    ASSERT_TRUE(_collectionStats->commitCalled);
+    auto stats = cloner->getStats();
+    ASSERT_EQUALS(3U, stats.partitions);
+    ASSERT_EQUALS(9U, stats.documentsCopied);
+}
+
+TEST(CollectionClonerPartitionBoundsTest, ChoosesEvenlySpacedSampledIds) {
+    std::vector<BSONObj> sampleIds;
+    for (int i = 0; i < 12; ++i) {
+        sampleIds.push_back(BSON("_id" << i));
+    }
+    auto bounds = CollectionCloner::choosePartitionBounds(sampleIds, 4);
+    ASSERT_EQUALS(3U, bounds.size());
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 3), bounds[0]);
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 6), bounds[1]);
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 9), bounds[2]);
+}
+
+TEST(CollectionClonerPartitionBoundsTest, SkipsRepeatedSampledIds) {
+    std::vector<BSONObj> sampleIds{
+        BSON("_id" << 1), BSON("_id" << 2), BSON("_id" << 2), BSON("_id" << 2)};
+    auto bounds = CollectionCloner::choosePartitionBounds(sampleIds, 4);
+    ASSERT_EQUALS(1U, bounds.size());
+    ASSERT_BSONOBJ_EQ(BSON("_id" << 2), bounds[0]);
+
+    ASSERT(CollectionCloner::choosePartitionBounds({}, 4).empty());
+}
+
 
 }  // namespace repl
 }  // namespace mongo
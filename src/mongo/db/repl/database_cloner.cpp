@@ -36,6 +36,7 @@
 #include "mongo/db/repl/database_cloner.h"
 #include "mongo/db/repl/database_cloner_common.h"
 #include "mongo/db/repl/database_cloner_gen.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/logv2/log.h"
 #include "mongo/util/assert_util.h"
 
@@ -127,20 +128,69 @@ void DatabaseCloner::postStage() {
             _stats.collectionStats.back().ns = coll.first.ns();
         }
     }
-    for (const auto& coll : _collections) {
-        auto& sourceNss = coll.first;
-        auto& collectionOptions = coll.second;
+
+    // Each additional worker clones collections over its own connection to the sync source,
+    // while this thread keeps using the database cloner's client.
+    const auto concurrency = getCreateClientFn()
+        ? std::min(_collections.size(),
+                   static_cast<size_t>(initialSyncMaxConcurrentCollectionClones.load()))
+        : size_t{1};
+    {
+        auto workers = makeWorkerPool("DatabaseCloner-" + _dbName, concurrency - 1);
+        for (size_t i = 1; i < concurrency; ++i) {
+            workers->schedule([this](Status status) {
+                if (!status.isOK()) {
+                    return;
+                }
+                std::shared_ptr<DBClientConnection> client;
+                try {
+                    client = makeAdditionalClient();
+                } catch (const DBException& e) {
+                    // The other workers, including the calling thread, still clone every
+                    // collection, so a missing connection only reduces the concurrency.
+                    LOGV2_WARNING(6610805,
+                                  "Failed to open an additional connection for collection cloning",
+                                  "db"_attr = _dbName,
+                                  "error"_attr = e.toStatus());
+                    return;
+                }
+                cloneCollections(client.get());
+            });
+        }
+        cloneCollections(getClient());
+        workers->shutdown();
+        workers->join();
+    }
+
+    stdx::lock_guard<Latch> lk(_mutex);
+    // Abort the database cloner if a collection clone failed.
+    if (_collectionCloneFailed)
+        return;
+    _stats.end = getSharedData()->getClock()->now();
+}
+
+void DatabaseCloner::cloneCollections(DBClientConnection* client) {
+    while (true) {
+        size_t collectionIndex;
+        std::unique_ptr<CollectionCloner> collectionCloner;
         {
             stdx::lock_guard<Latch> lk(_mutex);
-            _currentCollectionCloner = std::make_unique<CollectionCloner>(sourceNss,
-                                                                          collectionOptions,
-                                                                          getSharedData(),
-                                                                          getSource(),
-                                                                          getClient(),
-                                                                          getStorageInterface(),
-                                                                          getDBPool());
+            if (_collectionCloneFailed || _nextCollectionIndex == _collections.size())
+                return;
+            collectionIndex = _nextCollectionIndex++;
+            const auto& coll = _collections[collectionIndex];
+            collectionCloner = std::make_unique<CollectionCloner>(coll.first,
+                                                                  coll.second,
+                                                                  getSharedData(),
+                                                                  getSource(),
+                                                                  client,
+                                                                  getStorageInterface(),
+                                                                  getDBPool());
+            collectionCloner->setCreateClientFn(getCreateClientFn());
+            _currentCollectionCloners.emplace(collectionIndex, collectionCloner.get());
         }
-        auto collStatus = _currentCollectionCloner->run();
+        const auto& sourceNss = _collections[collectionIndex].first;
+        auto collStatus = collectionCloner->run();
         if (collStatus.isOK()) {
             LOGV2_DEBUG(21148,
                         1,
@@ -161,23 +211,22 @@ void DatabaseCloner::postStage() {
         }
         {
             stdx::lock_guard<Latch> lk(_mutex);
-            _stats.collectionStats[_stats.clonedCollections] = _currentCollectionCloner->getStats();
-            _currentCollectionCloner = nullptr;
-            // Abort the database cloner if the collection clone failed.
-            if (!collStatus.isOK())
+            _stats.collectionStats[collectionIndex] = collectionCloner->getStats();
+            _currentCollectionCloners.erase(collectionIndex);
+            if (!collStatus.isOK()) {
+                _collectionCloneFailed = true;
                 return;
+            }
             _stats.clonedCollections++;
         }
     }
-    stdx::lock_guard<Latch> lk(_mutex);
-    _stats.end = getSharedData()->getClock()->now();
 }
 
 DatabaseCloner::Stats DatabaseCloner::getStats() const {
     stdx::lock_guard<Latch> lk(_mutex);
     DatabaseCloner::Stats stats = _stats;
-    if (_currentCollectionCloner) {
-        stats.collectionStats[_stats.clonedCollections] = _currentCollectionCloner->getStats();
+    for (const auto& [collectionIndex, collectionCloner] : _currentCollectionCloners) {
+        stats.collectionStats[collectionIndex] = collectionCloner->getStats();
     }
     return stats;
 }
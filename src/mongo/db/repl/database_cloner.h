@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <map>
 #include <vector>
 
 #include "mongo/db/repl/base_cloner.h"
@@ -89,10 +90,18 @@ private:
 
     /**
      * The postStage creates and runs the individual CollectionCloners on each database found on
-     * the sync source, and sets the end time in _stats when done.
+     * the sync source, and sets the end time in _stats when done. Up to
+     * 'initialSyncMaxConcurrentCollectionClones' collections are cloned at the same time, each
+     * over its own connection to the sync source.
      */
     void postStage() final;
 
+    /**
+     * Clones collections from '_collections', one at a time and in order, over 'client' until
+     * none are left or a collection clone fails.
+     */
+    void cloneCollections(DBClientConnection* client);
+
     std::string describeForFuzzer(BaseClonerStage* stage) const final {
         return _dbName + " db: { " + stage->getName() + ": 1 } ";
     }
@@ -106,11 +115,17 @@ private:
     // (X)  Access only allowed from the main flow of control called from run() or constructor.
     // (MX) Write access with mutex from main flow of control, read access with mutex from other
     //      threads, read access allowed from main flow without mutex.
-    const std::string _dbName;                                                // (R)
-    ClonerStage<DatabaseCloner> _listCollectionsStage;                        // (R)
+    const std::string _dbName;                          // (R)
+    ClonerStage<DatabaseCloner> _listCollectionsStage;  // (R)
+    // Read-only once the collection cloners are started in postStage.
     std::vector<std::pair<NamespaceString, CollectionOptions>> _collections;  // (X)
-    std::unique_ptr<CollectionCloner> _currentCollectionCloner;               // (MX)
-    Stats _stats;                                                             // (MX)
+    // The collection cloners currently running, by their index in '_collections'.
+    std::map<size_t, CollectionCloner*> _currentCollectionCloners;  // (M)
+    // The index in '_collections' of the next collection to clone.
+    size_t _nextCollectionIndex = 0;  // (M)
+    // Set once a collection clone failed, to stop cloning the remaining collections.
+    bool _collectionCloneFailed = false;  // (M)
+    Stats _stats;                         // (MX)
 };
 
 }  // namespace repl
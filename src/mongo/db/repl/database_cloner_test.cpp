@@ -32,6 +32,7 @@
 #include "mongo/db/clientcursor.h"
 #include "mongo/db/repl/database_cloner.h"
 #include "mongo/db/repl/initial_sync_cloner_test_fixture.h"
+#include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/repl/storage_interface.h"
 #include "mongo/db/repl/storage_interface_mock.h"
 #include "mongo/db/service_context_test_fixture.h"
@@ -39,6 +40,7 @@
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/clock_source_mock.h"
 #include "mongo/util/concurrency/thread_pool.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace repl {
@@ -61,6 +63,7 @@ protected:
                    const BSONObj& idIndexSpec,
                    const std::vector<BSONObj>& secondaryIndexSpecs)
             -> StatusWith<std::unique_ptr<CollectionBulkLoaderMock>> {
+            stdx::lock_guard<Latch> lk(_collectionsMutex);
             const auto collInfo = &_collections[nss];
 
             auto localLoader = std::make_unique<CollectionBulkLoaderMock>(collInfo->stats);
@@ -105,6 +108,8 @@ protected:
         return cloner->_collections;
     }
 
+    // Collections may be cloned concurrently.
+    Mutex _collectionsMutex = MONGO_MAKE_LATCH("DatabaseClonerTest::_collectionsMutex");
     std::map<NamespaceString, CollectionCloneInfo> _collections;
 
     static std::string _dbName;
@@ -396,6 +401,59 @@ TEST_F(DatabaseClonerTest, CreateCollections) {
     ASSERT(stats.commitCalled);
 }
 
+TEST_F(DatabaseClonerTest, CreateCollectionsConcurrently) {
+    initialSyncMaxConcurrentCollectionClones.store(2);
+    ON_BLOCK_EXIT([] { initialSyncMaxConcurrentCollectionClones.store(1); });
+
+    auto uuid1 = UUID::gen();
+    auto uuid2 = UUID::gen();
+    const BSONObj idIndexSpec = BSON("v" << 1 << "key" << BSON("_id" << 1) << "name"
+                                         << "_id_");
+    const std::vector<BSONObj> sourceInfos = {BSON("name"
+                                                   << "a"
+                                                   << "type"
+                                                   << "collection"
+                                                   << "options" << BSONObj() << "info"
+                                                   << BSON("readOnly" << false << "uuid" << uuid1)),
+                                              BSON(
+                                                  "name"
+                                                  << "b"
+                                                  << "type"
+                                                  << "collection"
+                                                  << "options" << BSONObj() << "info"
+                                                  << BSON("readOnly" << false << "uuid" << uuid2))};
+    _mockServer->setCommandReply("listCollections",
+                                 createListCollectionsResponse({sourceInfos[0], sourceInfos[1]}));
+    _mockServer->setCommandReply("collStats", BSON("size" << 0));
+    _mockServer->setCommandReply("count", {createCountResponse(0), createCountResponse(0)});
+    _mockServer->setCommandReply("listIndexes",
+                                 {createCursorResponse(_dbName + ".a", BSON_ARRAY(idIndexSpec)),
+                                  createCursorResponse(_dbName + ".b", BSON_ARRAY(idIndexSpec))});
+    auto cloner = makeDatabaseCloner();
+    // The second collection is cloned over an additional connection.
+    int clientsCreated = 0;
+    cloner->setCreateClientFn([&] {
+        ++clientsCreated;
+        return std::unique_ptr<DBClientConnection>(
+            new MockDBClientConnection(_mockServer.get(), true /* autoReconnect */));
+    });
+    ASSERT_OK(cloner->run());
+    ASSERT_EQUALS(1, clientsCreated);
+
+    ASSERT_EQUALS(2U, _collections.size());
+    for (const auto& coll : {"a", "b"}) {
+        auto stats = *_collections[NamespaceString{_dbName, coll}].stats;
+        ASSERT_EQUALS(0, stats.insertCount);
+        ASSERT(stats.commitCalled);
+    }
+
+    auto stats = cloner->getStats();
+    ASSERT_EQUALS(2U, stats.clonedCollections);
+    ASSERT_EQUALS(2U, stats.collectionStats.size());
+    ASSERT_EQUALS(_dbName + ".a", stats.collectionStats[0].ns);
+    ASSERT_EQUALS(_dbName + ".b", stats.collectionStats[1].ns);
+}
+
 TEST_F(DatabaseClonerTest, DatabaseAndCollectionStats) {
     auto uuid1 = UUID::gen();
     auto uuid2 = UUID::gen();
@@ -32,6 +32,8 @@
 #include "mongo/platform/basic.h"
 
 #include "mongo/db/repl/initial_sync_base_cloner.h"
+
+#include "mongo/db/client.h"
 #include "mongo/db/repl/replication_consistency_markers_gen.h"
 #include "mongo/db/repl/replication_consistency_markers_impl.h"
 #include "mongo/logv2/log.h"
@@ -54,6 +56,31 @@ InitialSyncBaseCloner::InitialSyncBaseCloner(StringData clonerName,
                                              ThreadPool* dbPool)
     : BaseCloner(clonerName, sharedData, source, client, storageInterface, dbPool) {}
 
+std::shared_ptr<DBClientConnection> InitialSyncBaseCloner::makeAdditionalClient() {
+    if (!_createClientFn) {
+        return nullptr;
+    }
+    auto client = _createClientFn();
+    uassertStatusOK(client->connect(getSource(), StringData(), boost::none));
+    uassertStatusOK(replAuthenticate(client.get())
+                        .withContext(str::stream() << "Failed to authenticate to " << getSource()));
+    return client;
+}
+
+std::unique_ptr<ThreadPool> InitialSyncBaseCloner::makeWorkerPool(std::string poolName,
+                                                                  size_t maxThreads) {
+    ThreadPool::Options options;
+    options.poolName = std::move(poolName);
+    options.minThreads = 0;
+    options.maxThreads = std::max(maxThreads, size_t{1});
+    options.onCreateThread = [](const std::string& threadName) {
+        Client::initThread(threadName);
+    };
+    auto pool = std::make_unique<ThreadPool>(std::move(options));
+    pool->startup();
+    return pool;
+}
+
 void InitialSyncBaseCloner::clearRetryingState() {
     _retryableOp = boost::none;
 }
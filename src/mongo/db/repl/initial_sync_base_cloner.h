@@ -46,11 +46,39 @@ public:
                           ThreadPool* dbPool);
     virtual ~InitialSyncBaseCloner() = default;
 
+    using CreateClientFn = std::function<std::shared_ptr<DBClientConnection>()>;
+
+    /**
+     * Sets the function used to open additional connections to the sync source, so that a cloner
+     * can fetch data over several connections at once. Without it, a cloner only uses the client
+     * it was constructed with. The function is expected to keep track of the connections it
+     * creates, so that they can be shut down when initial sync is canceled.
+     */
+    void setCreateClientFn(CreateClientFn createClientFn) {
+        _createClientFn = std::move(createClientFn);
+    }
+
 protected:
     InitialSyncSharedData* getSharedData() const final {
         return checked_cast<InitialSyncSharedData*>(BaseCloner::getSharedData());
     }
 
+    const CreateClientFn& getCreateClientFn() const {
+        return _createClientFn;
+    }
+
+    /**
+     * Opens and authenticates an additional connection to the sync source. Returns nullptr if no
+     * CreateClientFn was set, and throws if the connection cannot be established.
+     */
+    std::shared_ptr<DBClientConnection> makeAdditionalClient();
+
+    /**
+     * Returns a started pool of up to 'maxThreads' threads, each with its own Client, for fetching
+     * data from the sync source concurrently. Destroying the pool waits for its tasks to finish.
+     */
+    static std::unique_ptr<ThreadPool> makeWorkerPool(std::string poolName, size_t maxThreads);
+
 private:
     /**
      * Make sure the initial sync ID on the sync source has not changed.  Throws an exception
@@ -102,6 +130,9 @@ private:
 
     // Operation that may currently be retrying.
     InitialSyncSharedData::RetryableOperation _retryableOp;
+
+    // Opens additional connections to the sync source. May be empty.
+    CreateClientFn _createClientFn;
 };
 
 }  // namespace repl
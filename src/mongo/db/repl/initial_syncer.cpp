@@ -350,6 +350,9 @@ void InitialSyncer::_cancelRemainingWork_inlock() {
     if (_client) {
         _client->shutdownAndDisallowReconnect();
     }
+    for (const auto& client : _additionalClonerClients) {
+        client->shutdownAndDisallowReconnect();
+    }
     _shutdownComponent_inlock(_applier);
     _shutdownComponent_inlock(_fCVFetcher);
     _shutdownComponent_inlock(_lastOplogEntryFetcher);
@@ -392,6 +395,30 @@ bool InitialSyncer::_isShuttingDown_inlock() const {
     return State::kShuttingDown == _state;
 }
 
+std::shared_ptr<DBClientConnection> InitialSyncer::_makeAdditionalClonerClient() {
+    stdx::lock_guard<Latch> lock(_mutex);
+    uassert(ErrorCodes::CallbackCanceled,
+            "Initial syncer is shutting down",
+            !_isShuttingDown_inlock());
+    {
+        stdx::lock_guard<InitialSyncSharedData> sharedDataLock(*_sharedData);
+        uassertStatusOK(_sharedData->getStatus(sharedDataLock));
+    }
+
+    // Drop the connections the cloners no longer use.
+    _additionalClonerClients.erase(
+        std::remove_if(_additionalClonerClients.begin(),
+                       _additionalClonerClients.end(),
+                       [](const auto& client) { return client.use_count() == 1; }),
+        _additionalClonerClients.end());
+
+    // The connection is registered before it connects, so that canceling the attempt keeps it
+    // from connecting at all.
+    std::shared_ptr<DBClientConnection> client = _createClientFn();
+    _additionalClonerClients.push_back(client);
+    return client;
+}
+
 std::string InitialSyncer::getDiagnosticString() const {
     LockGuard lk(_mutex);
     str::stream out;
@@ -1157,8 +1184,12 @@ void InitialSyncer::_fcvFetcherCallback(const StatusWith<Fetcher::QueryResponse>
                                                 _allowedOutageDuration,
                                                 getGlobalServiceContext()->getFastClockSource());
     _client = _createClientFn();
-    _initialSyncState = std::make_unique<InitialSyncState>(std::make_unique<AllDatabaseCloner>(
-        _sharedData.get(), _syncSource, _client.get(), _storage, _writerPool));
+    auto allDatabaseCloner = std::make_unique<AllDatabaseCloner>(
+        _sharedData.get(), _syncSource, _client.get(), _storage, _writerPool);
+    // The cloners open additional connections to fetch collections and collection ranges
+    // concurrently.
+    allDatabaseCloner->setCreateClientFn([this] { return _makeAdditionalClonerClient(); });
+    _initialSyncState = std::make_unique<InitialSyncState>(std::move(allDatabaseCloner));
 
     // Create oplog applier.
     auto consistencyMarkers = _replicationProcess->getConsistencyMarkers();
@@ -1359,6 +1390,7 @@ void InitialSyncer::_allDatabaseClonerCallback(
 
     stdx::lock_guard<Latch> lock(_mutex);
     _client.reset();
+    _additionalClonerClients.clear();
     auto status = _checkForShutdownAndConvertStatus_inlock(databaseClonerFinishStatus,
                                                            "error cloning databases");
     if (!status.isOK()) {
@@ -273,6 +273,13 @@ private:
     bool _isShuttingDown() const;
     bool _isShuttingDown_inlock() const;
 
+    /**
+     * Creates a connection to the sync source for the cloners to use in addition to '_client'.
+     * The connection is shut down along with '_client' when the attempt is canceled. Throws if the
+     * initial sync attempt is already canceled or failed.
+     */
+    std::shared_ptr<DBClientConnection> _makeAdditionalClonerClient();
+
     /**
      * Initial sync flowchart:
      *
@@ -693,6 +700,9 @@ private:
     // Used to create the DBClientConnection for the cloners
     CreateClientFn _createClientFn;
 
+    // Connections the cloners opened to the sync source in addition to '_client'.
+    std::vector<std::shared_ptr<DBClientConnection>> _additionalClonerClients;  // (M)
+
     // Used to create the OplogFetcher for the InitialSyncer.
     std::unique_ptr<OplogFetcherFactory> _createOplogFetcherFn;
 
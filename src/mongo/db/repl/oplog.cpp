@@ -1369,6 +1369,7 @@ Status applyOperation_inlock(OperationContext* opCtx,
                     // Do not use supplied timestamps if running through applyOps, as that would
                     // allow a user to dictate what timestamps appear in the oplog.
                     InsertStatement insertStmt(o);
+                    insertStmt.recordId = op.getReservedRecordId();
                     if (assignOperationTimestamp) {
                         invariant(op.getTerm());
                         insertStmt.oplogSlot = OpTime(op.getTimestamp(), op.getTerm().get());
@@ -458,6 +458,15 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
         // because the spawned threads refer to objects on the stack
         ON_BLOCK_EXIT([&] { _writerPool->waitForIdle(); });
 
+        // A batch made only of CRUD operations does not read its own oplog entries back while
+        // being applied, so its application may start while it is still being written to the
+        // oplog. The oplog truncate after point then stays set until both have finished.
+        const bool overlapOplogWrites = !getOptions().skipWritesToOplog &&
+            oplogApplicationOverlapsOplogWrites.load() &&
+            std::none_of(ops.begin(), ops.end(), [](const OplogEntry& op) {
+                return op.isCommand();
+            });
+
         // Write batch of ops into oplog.
         if (!getOptions().skipWritesToOplog) {
             _consistencyMarkers->setOplogTruncateAfterPoint(
@@ -478,12 +487,15 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
             _writerPool->getStats().options.maxThreads);
         fillWriterVectors(opCtx, &ops, &writerVectors, &derivedOps);
 
-        // Wait for writes to finish before applying ops.
-        _writerPool->waitForIdle();
+        // Wait for writes to finish before applying ops, unless application overlaps them.
+        if (!overlapOplogWrites) {
+            _writerPool->waitForIdle();
+        }
 
         // Use this fail point to hold the PBWM lock after we have written the oplog entries but
         // before we have applied them.
         if (MONGO_unlikely(pauseBatchApplicationAfterWritingOplogEntries.shouldFail())) {
+            _writerPool->waitForIdle();
             LOGV2(21231,
                   "pauseBatchApplicationAfterWritingOplogEntries fail point enabled. Blocking "
                   "until fail point is disabled");
@@ -495,7 +507,7 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
             _consistencyMarkers->getMinValid(opCtx) < ops.front().getOpTime();
 
         // Reset consistency markers in case the node fails while applying ops.
-        if (!getOptions().skipWritesToOplog) {
+        if (!getOptions().skipWritesToOplog && !overlapOplogWrites) {
             _consistencyMarkers->setOplogTruncateAfterPoint(opCtx, Timestamp());
         }
 
@@ -533,6 +545,13 @@ StatusWith<OpTime> OplogApplierImpl::_applyOplogBatch(OperationContext* opCtx,
 
             _writerPool->waitForIdle();
 
+            // The oplog writes have finished along with the application of the batch. A failure
+            // past this point leaves the oplog entries of the batch in place, as it does when the
+            // oplog writes are not overlapped.
+            if (overlapOplogWrites) {
+                _consistencyMarkers->setOplogTruncateAfterPoint(opCtx, Timestamp());
+            }
+
             // If any of the statuses is not ok, return error.
             for (auto it = statusVector.cbegin(); it != statusVector.cend(); ++it) {
                 const auto& status = *it;
@@ -617,7 +636,8 @@ void OplogApplierImpl::_deriveOpsAndFillWriterVectors(
     SessionUpdateTracker* sessionUpdateTracker) noexcept {
 
     LogicalSessionIdMap<std::vector<OplogEntry*>> partialTxnOps;
-    CachedCollectionProperties collPropertiesCache;
+    CachedCollectionProperties collPropertiesCache(getOptions().mode ==
+                                                   OplogApplication::Mode::kSecondary);
 
     // Used to serialize writes to the tenant migrations donor and recipient namespaces.
     boost::optional<uint32_t> tenantMigrationsWriterId;
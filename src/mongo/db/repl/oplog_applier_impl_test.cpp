@@ -612,6 +612,51 @@ TEST_F(OplogApplierImplTest,
                                                      createOplogCollectionOptions()));
 }
 
+TEST_F(OplogApplierImplTest, MultiApplyWritesOplogAndAppliesCrudBatchWithOverlappedOplogWrites) {
+    auto writerPool = makeReplWriterPool();
+    NoopOplogApplierObserver observer;
+    OplogApplierImpl oplogApplier(
+        nullptr,  // executor
+        nullptr,  // oplogBuffer
+        &observer,
+        ReplicationCoordinator::get(_opCtx.get()),
+        getConsistencyMarkers(),
+        getStorageInterface(),
+        repl::OplogApplier::Options(repl::OplogApplication::Mode::kSecondary),
+        writerPool.get());
+
+    // Use enough operations for the oplog writes to be spread across all writer threads.
+    const int numOps = 32 * writerPool->getStats().options.maxThreads;
+    int seconds = 1;
+    for (bool overlap : {false, true}) {
+        RAIIServerParameterControllerForTest controller{"oplogApplicationOverlapsOplogWrites",
+                                                        overlap};
+        NamespaceString nss("test." + _agent.getTestName() + (overlap ? "_overlap" : ""));
+        createCollection(_opCtx.get(), nss, {});
+
+        std::vector<OplogEntry> ops;
+        for (int i = 0; i < numOps; ++i) {
+            ops.push_back(makeInsertDocumentOplogEntry(
+                {Timestamp(Seconds(seconds), i + 1), 1LL}, nss, BSON("_id" << i)));
+        }
+        ++seconds;
+
+        const auto oplogCountBefore = unittest::assertGet(getStorageInterface()->getCollectionCount(
+            _opCtx.get(), NamespaceString::kRsOplogNamespace));
+        ASSERT_EQUALS(ops.back().getOpTime(),
+                      unittest::assertGet(oplogApplier.applyOplogBatch(_opCtx.get(), ops)));
+
+        ASSERT_EQUALS(static_cast<std::size_t>(numOps),
+                      unittest::assertGet(getStorageInterface()->getCollectionCount(_opCtx.get(),
+                                                                                    nss)));
+        ASSERT_EQUALS(oplogCountBefore + numOps,
+                      unittest::assertGet(getStorageInterface()->getCollectionCount(
+                          _opCtx.get(), NamespaceString::kRsOplogNamespace)));
+        ASSERT_EQUALS(Timestamp(),
+                      getConsistencyMarkers()->getOplogTruncateAfterPoint(_opCtx.get()));
+    }
+}
+
 TEST_F(OplogApplierImplTest,
        OplogApplicationThreadFuncUsesApplyOplogEntryOrGroupedInsertsToApplyOperation) {
     NamespaceString nss("local." + _agent.getSuiteName() + "_" + _agent.getTestName());
@@ -680,6 +725,108 @@ TEST_F(OplogApplierImplTest,
                   secondDerivedOp.getObject()["lastWriteOpTime"]["ts"].timestamp());
 }
 
+TEST_F(OplogApplierImplTest, MultiApplyReservesRecordIdsForCappedCollectionInsertsInOplogOrder) {
+    NamespaceString nss("test." + _agent.getTestName());
+    CollectionOptions options;
+    options.capped = true;
+    options.cappedSize = 64 * 1024;
+    createCollection(_opCtx.get(), nss, options);
+
+    std::vector<OplogEntry> ops;
+    for (int i = 0; i < 10; ++i) {
+        ops.push_back(
+            makeInsertDocumentOplogEntry({Timestamp(Seconds(1), i), 1LL}, nss, BSON("_id" << i)));
+    }
+
+    auto writerPool = makeReplWriterPool();
+    NoopOplogApplierObserver observer;
+    OplogApplierImpl oplogApplier(
+        nullptr,  // executor
+        nullptr,  // oplogBuffer
+        &observer,
+        ReplicationCoordinator::get(_opCtx.get()),
+        getConsistencyMarkers(),
+        getStorageInterface(),
+        repl::OplogApplier::Options(repl::OplogApplication::Mode::kSecondary),
+        writerPool.get());
+
+    {
+        auto opsToFill = ops;
+        std::vector<std::vector<const OplogEntry*>> writerVectors(
+            writerPool->getStats().options.maxThreads);
+        std::vector<std::vector<OplogEntry>> derivedOps;
+        oplogApplier.fillWriterVectors_forTest(
+            _opCtx.get(), &opsToFill, &writerVectors, &derivedOps);
+
+        // Every insert is for a capped collection and has a RecordId reserved in oplog order.
+        RecordId previous;
+        for (const auto& op : opsToFill) {
+            ASSERT_TRUE(op.isForCappedCollection());
+            ASSERT_FALSE(op.getReservedRecordId().isNull());
+            ASSERT_GT(op.getReservedRecordId(), previous);
+            previous = op.getReservedRecordId();
+        }
+    }
+
+    ASSERT_OK(oplogApplier.applyOplogBatch(_opCtx.get(), ops).getStatus());
+
+    // The natural order of the capped collection matches the oplog order.
+    AutoGetCollectionForRead coll(_opCtx.get(), nss);
+    auto cursor = coll->getCursor(_opCtx.get());
+    int expectedId = 0;
+    while (auto record = cursor->next()) {
+        ASSERT_EQ(expectedId, record->data.toBson()["_id"].numberInt());
+        ++expectedId;
+    }
+    ASSERT_EQ(10, expectedId);
+}
+
+TEST_F(OplogApplierImplTest, FillWriterVectorsOnlyReservesCappedRecordIdsOnSecondaries) {
+    NamespaceString nss("test." + _agent.getTestName());
+    CollectionOptions options;
+    options.capped = true;
+    options.cappedSize = 64 * 1024;
+    createCollection(_opCtx.get(), nss, options);
+
+    std::vector<OplogEntry> ops;
+    for (int i = 0; i < 10; ++i) {
+        ops.push_back(
+            makeInsertDocumentOplogEntry({Timestamp(Seconds(1), i), 1LL}, nss, BSON("_id" << i)));
+    }
+
+    auto writerPool = makeReplWriterPool();
+    NoopOplogApplierObserver observer;
+    OplogApplierImpl oplogApplier(
+        nullptr,  // executor
+        nullptr,  // oplogBuffer
+        &observer,
+        ReplicationCoordinator::get(_opCtx.get()),
+        getConsistencyMarkers(),
+        getStorageInterface(),
+        repl::OplogApplier::Options(repl::OplogApplication::Mode::kRecovering),
+        writerPool.get());
+
+    std::vector<std::vector<const OplogEntry*>> writerVectors(
+        writerPool->getStats().options.maxThreads);
+    std::vector<std::vector<OplogEntry>> derivedOps;
+    oplogApplier.fillWriterVectors_forTest(_opCtx.get(), &ops, &writerVectors, &derivedOps);
+
+    // Without reserved RecordIds, every insert into the capped collection goes to one writer.
+    size_t nonEmptyWriterVectors = 0;
+    for (const auto& writerVector : writerVectors) {
+        if (writerVector.empty()) {
+            continue;
+        }
+        ++nonEmptyWriterVectors;
+        ASSERT_EQ(ops.size(), writerVector.size());
+    }
+    ASSERT_EQ(1U, nonEmptyWriterVectors);
+    for (const auto& op : ops) {
+        ASSERT_TRUE(op.isForCappedCollection());
+        ASSERT_TRUE(op.getReservedRecordId().isNull());
+    }
+}
+
 class MultiOplogEntryOplogApplierImplTest : public OplogApplierImplTest {
 public:
     MultiOplogEntryOplogApplierImplTest()
@@ -40,6 +40,7 @@
 #include "mongo/db/repl/oplog_applier_utils.h"
 #include "mongo/db/repl/repl_server_parameters_gen.h"
 #include "mongo/db/stats/counters.h"
+#include "mongo/db/storage/record_store.h"
 #include "mongo/util/fail_point.h"
 
 #include "mongo/logv2/log.h"
@@ -48,6 +49,21 @@ MONGO_FAIL_POINT_DEFINE(hangAfterApplyingCollectionDropOplogEntry);
 
 namespace mongo {
 namespace repl {
+namespace {
+
+// The CRUD oplog entries assigned to a writer by namespace only, because their collection must
+// have all of its writes applied by a single writer.
+Counter64 serializedCrudOps;
+ServerStatusMetricField<Counter64> displaySerializedCrudOps("repl.apply.serializedCrudOps",
+                                                            &serializedCrudOps);
+
+// The inserts into capped collections applied with a RecordId reserved in oplog order.
+Counter64 cappedInsertsWithReservedRecordIds;
+ServerStatusMetricField<Counter64> displayCappedInsertsWithReservedRecordIds(
+    "repl.apply.cappedInsertsWithReservedRecordIds", &cappedInsertsWithReservedRecordIds);
+
+}  // namespace
+
 CachedCollectionProperties::CollectionProperties
 CachedCollectionProperties::getCollectionProperties(OperationContext* opCtx,
                                                     const StringMapHashedKey& ns) {
@@ -75,6 +91,11 @@ CachedCollectionProperties::getCollectionPropertiesImpl(OperationContext* opCtx,
     collProperties.isCapped = collection->isCapped();
     collProperties.isClustered = collection->isClustered();
     collProperties.collator = collection->getDefaultCollator();
+    if (_reserveCappedRecordIds && collProperties.isCapped && !collProperties.isClustered &&
+        oplogApplicationReservesCappedRecordIds &&
+        collection->getRecordStore()->reserveRecordIdsSupported()) {
+        collProperties.cappedRecordStore = collection->getRecordStore();
+    }
     return collProperties;
 }
 
@@ -90,19 +111,30 @@ void OplogApplierUtils::processCrudOp(OperationContext* opCtx,
     //
     // For capped collections, this is usually illegal, since capped collections must preserve
     // insertion order. One exception are clustered capped collections with a monotonically
-    // increasing cluster key, which guarantee preservation of the insertion order.
-    if (!collProperties.isCapped || collProperties.isClustered) {
+    // increasing cluster key, which guarantee preservation of the insertion order. The other are
+    // capped collections whose inserts get their RecordIds reserved here, in oplog order.
+    if (!collProperties.isCapped || collProperties.isClustered ||
+        collProperties.cappedRecordStore) {
         BSONElement id = op->getIdElement();
         BSONElementComparator elementHasher(BSONElementComparator::FieldNamesMode::kIgnore,
                                             collProperties.collator);
         const size_t idHash = elementHasher.hash(id);
         MurmurHash3_x86_32(&idHash, sizeof(idHash), *hash, hash);
+    } else {
+        serializedCrudOps.increment();
     }
 
     if (op->getOpType() == OpTypeEnum::kInsert && collProperties.isCapped) {
         // Mark capped collection ops before storing them to ensure we do not attempt to
         // bulk insert them.
         op->setIsForCappedCollection(true);
+
+        if (collProperties.cappedRecordStore) {
+            std::vector<RecordId> reserved;
+            collProperties.cappedRecordStore->reserveRecordIds(opCtx, &reserved, 1);
+            op->setReservedRecordId(std::move(reserved.front()));
+            cappedInsertsWithReservedRecordIds.increment();
+        }
     }
 }
 
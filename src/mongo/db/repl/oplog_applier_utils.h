@@ -34,6 +34,7 @@
 namespace mongo {
 class CollatorInterface;
 class OpCounters;
+class RecordStore;
 
 namespace repl {
 
@@ -43,10 +44,21 @@ namespace repl {
  */
 class CachedCollectionProperties {
 public:
+    /**
+     * Only secondary oplog application may set 'reserveCappedRecordIds'. It applies capped inserts
+     * at the RecordIds reserved for them and does not take the capped lock for those inserts,
+     * which other appliers rely on to keep the insertion order of capped collections.
+     */
+    explicit CachedCollectionProperties(bool reserveCappedRecordIds = false)
+        : _reserveCappedRecordIds(reserveCappedRecordIds) {}
+
     struct CollectionProperties {
         bool isCapped = false;
         bool isClustered = false;
         const CollatorInterface* collator = nullptr;
+        // Set for capped collections whose inserts are applied with RecordIds reserved from this
+        // record store, in oplog order, rather than by a single writer.
+        RecordStore* cappedRecordStore = nullptr;
     };
 
     CollectionProperties getCollectionProperties(OperationContext* opCtx,
@@ -56,6 +68,8 @@ private:
     CollectionProperties getCollectionPropertiesImpl(OperationContext* opCtx,
                                                      const NamespaceString& nss);
 
+    const bool _reserveCappedRecordIds;
+
     StringMap<CollectionProperties> _cache;
 };
 
@@ -75,7 +89,7 @@ public:
     static void stableSortByNamespace(std::vector<const OplogEntry*>* oplogEntryPointers);
 
     /**
-     * Updates a CRUD op's hash and isForCappedCollection field if necessary.
+     * Updates a CRUD op's hash, isForCappedCollection and reserved RecordId fields if necessary.
      */
     static void processCrudOp(OperationContext* opCtx,
                               OplogEntry* op,
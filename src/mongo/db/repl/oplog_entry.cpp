@@ -548,6 +548,10 @@ BSONObj OplogEntry::toBSONForLogging() const {
         builder.append("isForCappedCollection", _isForCappedCollection);
     }
 
+    if (!_reservedRecordId.isNull()) {
+        _reservedRecordId.serializeToken("reservedRecordId", &builder);
+    }
+
     if (_preImageOp) {
         auto op = _preImageOp->toBSON();
         if (estimatedTotalSize + op.objsize() > sizeTooBig) {
@@ -579,6 +583,14 @@ void OplogEntry::setIsForCappedCollection(bool isForCappedCollection) {
     _isForCappedCollection = isForCappedCollection;
 }
 
+const RecordId& OplogEntry::getReservedRecordId() const {
+    return _reservedRecordId;
+}
+
+void OplogEntry::setReservedRecordId(RecordId recordId) {
+    _reservedRecordId = std::move(recordId);
+}
+
 std::shared_ptr<DurableOplogEntry> OplogEntry::getPreImageOp() const {
     return _preImageOp;
 }
@@ -33,6 +33,7 @@
 #include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/db/catalog/collection_options.h"
 #include "mongo/db/logical_session_id.h"
+#include "mongo/db/record_id.h"
 #include "mongo/db/repl/apply_ops_gen.h"
 #include "mongo/db/repl/oplog_entry_gen.h"
 #include "mongo/db/repl/optime.h"
@@ -649,6 +650,14 @@ public:
     bool isForCappedCollection() const;
     void setIsForCappedCollection(bool isForCappedCollection);
 
+    /**
+     * The RecordId reserved for the document of an insert into a capped collection, so that the
+     * insert may be applied concurrently with other inserts into the collection and still keep
+     * the insertion order. A null RecordId when none was reserved.
+     */
+    const RecordId& getReservedRecordId() const;
+    void setReservedRecordId(RecordId recordId);
+
     std::shared_ptr<DurableOplogEntry> getPreImageOp() const;
     void setPreImageOp(std::shared_ptr<DurableOplogEntry> preImageOp);
     void setPreImageOp(const BSONObj& preImageOp);
@@ -771,6 +780,8 @@ private:
     boost::optional<Date_t> _applyOpsWallClockTime{boost::none};
 
     bool _isForCappedCollection = false;
+
+    RecordId _reservedRecordId;
 };
 
 std::ostream& operator<<(std::ostream& s, const DurableOplogEntry& o);
@@ -101,6 +101,7 @@
 #include "mongo/db/write_concern_options.h"
 #include "mongo/executor/connection_pool_stats.h"
 #include "mongo/executor/network_interface.h"
+#include "mongo/idl/basic_types.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/rpc/metadata/oplog_query_metadata.h"
@@ -213,22 +214,42 @@ constexpr StringData kQuiesceModeShutdownMessage =
 
 }  // namespace
 
+BSONObj ReplicationCoordinatorImpl::WaiterList::_makeWriteConcernKey(
+    const boost::optional<WriteConcernOptions>& wc) {
+    if (!wc) {
+        return BSONObj();
+    }
+    BSONObjBuilder builder;
+    serializeWriteConcernW(wc->w, "w", &builder);
+    builder.append("syncMode", static_cast<int>(wc->syncMode));
+    builder.append("checkCondition", static_cast<int>(wc->checkCondition));
+    return builder.obj();
+}
+
 void ReplicationCoordinatorImpl::WaiterList::add_inlock(const OpTime& opTime,
                                                         SharedWaiterHandle waiter) {
-    _waiters.emplace(opTime, std::move(waiter));
+    _waiters[_makeWriteConcernKey(waiter->writeConcern)].emplace(opTime, std::move(waiter));
 }
 
 SharedSemiFuture<void> ReplicationCoordinatorImpl::WaiterList::add_inlock(
     const OpTime& opTime, boost::optional<WriteConcernOptions> wc) {
     auto pf = makePromiseFuture<void>();
-    _waiters.emplace(opTime, std::make_shared<Waiter>(std::move(pf.promise), std::move(wc)));
+    add_inlock(opTime, std::make_shared<Waiter>(std::move(pf.promise), std::move(wc)));
     return std::move(pf.future);
 }
 
 bool ReplicationCoordinatorImpl::WaiterList::remove_inlock(SharedWaiterHandle waiter) {
-    for (auto iter = _waiters.begin(); iter != _waiters.end(); iter++) {
+    auto groupIt = _waiters.find(_makeWriteConcernKey(waiter->writeConcern));
+    if (groupIt == _waiters.end()) {
+        return false;
+    }
+    auto& group = groupIt->second;
+    for (auto iter = group.begin(); iter != group.end(); iter++) {
         if (iter->second == waiter) {
-            _waiters.erase(iter);
+            group.erase(iter);
+            if (group.empty()) {
+                _waiters.erase(groupIt);
+            }
             return true;
         }
     }
@@ -236,35 +257,50 @@ bool ReplicationCoordinatorImpl::WaiterList::remove_inlock(SharedWaiterHandle wa
 }
 
 template <typename Func>
-void ReplicationCoordinatorImpl::WaiterList::setValueIf_inlock(Func&& func,
-                                                               boost::optional<OpTime> opTime) {
-    for (auto it = _waiters.begin(); it != _waiters.end() && (!opTime || it->first <= *opTime);) {
-        const auto& waiter = it->second;
-        try {
-            if (func(it->first, waiter)) {
-                waiter->promise.emplaceValue();
-                it = _waiters.erase(it);
-            } else {
-                ++it;
+void ReplicationCoordinatorImpl::WaiterList::setValueIf_inlock(
+    Func&& func,
+    boost::optional<OpTime> opTime,
+    std::vector<SharedWaiterHandle>* readyWaiters) {
+    for (auto groupIt = _waiters.begin(); groupIt != _waiters.end();) {
+        auto& group = groupIt->second;
+        for (auto it = group.begin(); it != group.end() && (!opTime || it->first <= *opTime);) {
+            const auto& waiter = it->second;
+            try {
+                if (!func(it->first, waiter)) {
+                    // All remaining waiters in this group wait for the same write concern at a
+                    // later or equal opTime, so none of them can be ready either.
+                    break;
+                }
+                if (readyWaiters) {
+                    readyWaiters->push_back(waiter);
+                } else {
+                    waiter->promise.emplaceValue();
+                }
+                it = group.erase(it);
+            } catch (const DBException& e) {
+                waiter->promise.setError(e.toStatus());
+                it = group.erase(it);
             }
-        } catch (const DBException& e) {
-            waiter->promise.setError(e.toStatus());
-            it = _waiters.erase(it);
         }
+        groupIt = group.empty() ? _waiters.erase(groupIt) : std::next(groupIt);
     }
 }
 
 void ReplicationCoordinatorImpl::WaiterList::setValueAll_inlock() {
-    for (auto& [opTime, waiter] : _waiters) {
-        waiter->promise.emplaceValue();
+    for (auto& [key, group] : _waiters) {
+        for (auto& [opTime, waiter] : group) {
+            waiter->promise.emplaceValue();
+        }
     }
     _waiters.clear();
 }
 
 void ReplicationCoordinatorImpl::WaiterList::setErrorAll_inlock(Status status) {
     invariant(!status.isOK());
-    for (auto& [opTime, waiter] : _waiters) {
-        waiter->promise.setError(status);
+    for (auto& [key, group] : _waiters) {
+        for (auto& [opTime, waiter] : group) {
+            waiter->promise.setError(status);
+        }
     }
     _waiters.clear();
 }
@@ -4891,7 +4927,8 @@ ReplicationCoordinatorImpl::_setCurrentRSConfig(WithLock lk,
             // setValueIf_inlock will fulfill the waiter's promise with the error status.
             uassertStatusOK(_checkIfWriteConcernCanBeSatisfied_inlock(waiter->writeConcern.get()));
             // Return false meaning that the waiter is still satisfiable and thus can remain in the
-            // waiter list.
+            // waiter list. Satisfiability only depends on the write concern, so this also holds
+            // for the remaining waiters with the same write concern.
             return false;
         });
 
@@ -4937,21 +4974,35 @@ void ReplicationCoordinatorImpl::_wakeReadyWaiters(WithLock lk, boost::optional<
             invariant(waiter->writeConcern);
             return _doneWaitingForReplication_inlock(opTime, waiter->writeConcern.get());
         },
-        opTime);
+        opTime,
+        _readyWaitersToFulfill);
 }
 
 Status ReplicationCoordinatorImpl::processReplSetUpdatePosition(const UpdatePositionArgs& updates) {
+    // Write concern waiters satisfied by these updates are fulfilled once _mutex is released, so
+    // that the continuations of their futures do not run while holding it.
+    std::vector<SharedWaiterHandle> readyWaiters;
+    ON_BLOCK_EXIT([&] {
+        for (auto& waiter : readyWaiters) {
+            waiter->promise.emplaceValue();
+        }
+    });
+
     stdx::unique_lock<Latch> lock(_mutex);
     Status status = Status::OK();
     bool somethingChanged = false;
-    for (UpdatePositionArgs::UpdateIterator update = updates.updatesBegin();
-         update != updates.updatesEnd();
-         ++update) {
-        status = _setLastOptime(lock, *update);
-        if (!status.isOK()) {
-            break;
+    {
+        _readyWaitersToFulfill = &readyWaiters;
+        ON_BLOCK_EXIT([&] { _readyWaitersToFulfill = nullptr; });
+        for (UpdatePositionArgs::UpdateIterator update = updates.updatesBegin();
+             update != updates.updatesEnd();
+             ++update) {
+            status = _setLastOptime(lock, *update);
+            if (!status.isOK()) {
+                break;
+            }
+            somethingChanged = true;
         }
-        somethingChanged = true;
     }
 
     if (somethingChanged && !_getMemberState_inlock().primary()) {
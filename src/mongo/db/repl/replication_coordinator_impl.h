@@ -35,6 +35,7 @@
 #include <vector>
 
 #include "mongo/base/status.h"
+#include "mongo/bson/simple_bsonobj_comparator.h"
 #include "mongo/bson/timestamp.h"
 #include "mongo/db/concurrency/d_concurrency.h"
 #include "mongo/db/concurrency/replication_state_transition_lock_guard.h"
@@ -698,17 +699,30 @@ private:
         // Returns whether waiter is found and removed.
         bool remove_inlock(SharedWaiterHandle waiter);
         // Signals all waiters whose opTime is <= the given opTime (if any) that satisfy the
-        // condition in func.
+        // condition in func. For a given write concern, func must be monotonic in the waiter's
+        // opTime: once it returns false for a waiter, it would return false for every later waiter
+        // with the same write concern, so the scan of that write concern's waiters stops there.
+        // If 'readyWaiters' is provided, waiters that satisfy func are removed from the list and
+        // appended to it instead of being fulfilled, so that the caller can fulfill them after
+        // releasing the mutex. Waiters for which func throws are always fulfilled with the error.
         template <typename Func>
-        void setValueIf_inlock(Func&& func, boost::optional<OpTime> opTime = boost::none);
+        void setValueIf_inlock(Func&& func,
+                               boost::optional<OpTime> opTime = boost::none,
+                               std::vector<SharedWaiterHandle>* readyWaiters = nullptr);
         // Signals all waiters from the list and fulfills promises with OK status.
         void setValueAll_inlock();
         // Signals all waiters from the list and fulfills promises with Error status.
         void setErrorAll_inlock(Status status);
 
     private:
-        // Waiters sorted by OpTime.
-        std::multimap<OpTime, SharedWaiterHandle> _waiters;
+        using WaitersByOpTime = std::multimap<OpTime, SharedWaiterHandle>;
+
+        // Returns the key under which waiters with the given write concern are grouped.
+        static BSONObj _makeWriteConcernKey(const boost::optional<WriteConcernOptions>& wc);
+
+        // Waiters grouped by the parts of their write concern that determine when they are
+        // satisfied, and sorted by OpTime within each group.
+        std::map<BSONObj, WaitersByOpTime, SimpleBSONObjComparator::LessThan> _waiters;
     };
 
     enum class HeartbeatState { kScheduled = 0, kSent = 1 };
@@ -1600,6 +1614,11 @@ private:
     // Waiters in this list are checked and notified on self's lastApplied opTime updates.
     WaiterList _opTimeWaiterList;  // (M)
 
+    // When set, _wakeReadyWaiters() moves satisfied write concern waiters into this vector instead
+    // of fulfilling them, so that processReplSetUpdatePosition() and _handleHeartbeatResponse()
+    // can fulfill them after releasing _mutex.
+    std::vector<SharedWaiterHandle>* _readyWaitersToFulfill = nullptr;  // (M)
+
     // Maps a horizon name to the promise waited on by awaitable hello requests when the node
     // has an initialized replica set config and is an active member of the replica set.
     StringMap<std::shared_ptr<SharedPromiseOfHelloResponse>>
@@ -64,6 +64,7 @@
 #include "mongo/rpc/metadata/repl_set_metadata.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
 #include "mongo/util/str.h"
 #include "mongo/util/time_support.h"
 
@@ -181,6 +182,15 @@ void ReplicationCoordinatorImpl::handleHeartbeatResponse_forTest(BSONObj respons
 
 void ReplicationCoordinatorImpl::_handleHeartbeatResponse(
     const executor::TaskExecutor::RemoteCommandCallbackArgs& cbData, const std::string& setName) {
+    // Write concern waiters satisfied by this response are fulfilled once _mutex is released, so
+    // that the continuations of their futures do not run while holding it.
+    std::vector<SharedWaiterHandle> readyWaiters;
+    ON_BLOCK_EXIT([&] {
+        for (auto& waiter : readyWaiters) {
+            waiter->promise.emplaceValue();
+        }
+    });
+
     stdx::unique_lock<Latch> lk(_mutex);
 
     // remove handle from queued heartbeats
@@ -245,6 +255,8 @@ void ReplicationCoordinatorImpl::_handleHeartbeatResponse(
                  !_getMemberState_inlock().rollback())) {
                 // The node that sent the heartbeat is not guaranteed to be our sync source.
                 const bool fromSyncSource = false;
+                _readyWaitersToFulfill = &readyWaiters;
+                ON_BLOCK_EXIT([&] { _readyWaitersToFulfill = nullptr; });
                 _advanceCommitPoint(
                     lk, replMetadata.getValue().getLastOpCommitted(), fromSyncSource);
             }
@@ -310,6 +322,8 @@ void ReplicationCoordinatorImpl::_handleHeartbeatResponse(
     if (action.getAction() == HeartbeatResponseAction::NoAction && hbStatusResponse.isOK() &&
         hbStatusResponse.getValue().hasState() &&
         hbStatusResponse.getValue().getState() != MemberState::RS_PRIMARY) {
+        _readyWaitersToFulfill = &readyWaiters;
+        ON_BLOCK_EXIT([&] { _readyWaitersToFulfill = nullptr; });
         if (action.getAdvancedOpTimeOrUpdatedConfig()) {
             // If a member's opTime has moved forward or config is newer, try to update the
             // lastCommitted. Even if we've only updated the config, this is still safe.
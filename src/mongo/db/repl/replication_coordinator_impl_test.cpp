@@ -1158,6 +1158,77 @@ TEST_F(ReplCoordTest, NodeReturnsOkWhenAWriteConcernWithNoTimeoutHasBeenSatisfie
     awaiter.reset();
 }
 
+TEST_F(ReplCoordTest, UpdatePositionOnlyFulfillsWriteConcernWaitersThatAreSatisfied) {
+    assertStartSuccess(BSON("_id"
+                            << "mySet"
+                            << "version" << 2 << "members"
+                            << BSON_ARRAY(BSON("host"
+                                               << "node1:12345"
+                                               << "_id" << 0)
+                                          << BSON("host"
+                                                  << "node2:12345"
+                                                  << "_id" << 1)
+                                          << BSON("host"
+                                                  << "node3:12345"
+                                                  << "_id" << 2))),
+                       HostAndPort("node1", 12345));
+    ASSERT_OK(getReplCoord()->setFollowerMode(MemberState::RS_SECONDARY));
+    replCoordSetMyLastAppliedOpTime(OpTimeWithTermOne(100, 1), Date_t() + Seconds(100));
+    replCoordSetMyLastDurableOpTime(OpTimeWithTermOne(100, 1), Date_t() + Seconds(100));
+    simulateSuccessfulV1Election();
+
+    OpTime time1 = OpTimeWithTermOne(100, 2);
+    OpTime time2 = OpTimeWithTermOne(100, 3);
+    replCoordSetMyLastAppliedOpTime(time2, Date_t() + Seconds(100));
+    replCoordSetMyLastDurableOpTime(time2, Date_t() + Seconds(100));
+
+    auto updatePosition = [&](int memberId, const OpTime& opTime) {
+        UpdatePositionArgs args;
+        ASSERT_OK(args.initialize(BSON(
+            UpdatePositionArgs::kCommandFieldName
+            << 1 << UpdatePositionArgs::kUpdateArrayFieldName
+            << BSON_ARRAY(BSON(
+                   UpdatePositionArgs::kConfigVersionFieldName
+                   << getReplCoord()->getConfigVersion() << UpdatePositionArgs::kMemberIdFieldName
+                   << memberId << UpdatePositionArgs::kAppliedOpTimeFieldName << opTime.toBSON()
+                   << UpdatePositionArgs::kAppliedWallTimeFieldName
+                   << Date_t() + Seconds(opTime.getSecs())
+                   << UpdatePositionArgs::kDurableOpTimeFieldName << opTime.toBSON()
+                   << UpdatePositionArgs::kDurableWallTimeFieldName
+                   << Date_t() + Seconds(opTime.getSecs()))))));
+        ASSERT_OK(getReplCoord()->processReplSetUpdatePosition(args));
+    };
+
+    WriteConcernOptions w2;
+    w2.w = 2;
+    WriteConcernOptions w3;
+    w3.w = 3;
+    auto w2Time1 = getReplCoord()->awaitReplicationAsyncNoWTimeout(time1, w2);
+    auto w2Time2 = getReplCoord()->awaitReplicationAsyncNoWTimeout(time2, w2);
+    auto w3Time1 = getReplCoord()->awaitReplicationAsyncNoWTimeout(time1, w3);
+    ASSERT_FALSE(w2Time1.isReady());
+    ASSERT_FALSE(w2Time2.isReady());
+    ASSERT_FALSE(w3Time1.isReady());
+
+    // Only the w:2 waiter at time1 is satisfied once a single secondary reaches time1.
+    updatePosition(1, time1);
+    ASSERT_TRUE(w2Time1.isReady());
+    ASSERT_OK(w2Time1.getNoThrow());
+    ASSERT_FALSE(w2Time2.isReady());
+    ASSERT_FALSE(w3Time1.isReady());
+
+    // The w:2 waiter at time2 is satisfied once the same secondary reaches time2. The w:3 waiter
+    // at time1 still waits for the other secondary.
+    updatePosition(1, time2);
+    ASSERT_TRUE(w2Time2.isReady());
+    ASSERT_OK(w2Time2.getNoThrow());
+    ASSERT_FALSE(w3Time1.isReady());
+
+    updatePosition(2, time2);
+    ASSERT_TRUE(w3Time1.isReady());
+    ASSERT_OK(w3Time1.getNoThrow());
+}
+
 
 TEST_F(ReplCoordTest, NodeCalculatesDefaultWriteConcernOnStartupExistingLocalConfigMajority) {
     assertStartSuccess(BSON("_id"
@@ -33,8 +33,10 @@
 
 #include <algorithm>
 #include <boost/optional/optional_io.hpp>
+#include <set>
 #include <vector>
 
+#include "mongo/db/catalog_raii.h"
 #include "mongo/db/logical_session_id_helpers.h"
 #include "mongo/db/op_observer_noop.h"
 #include "mongo/db/op_observer_registry.h"
@@ -52,6 +54,7 @@
 #include "mongo/db/service_context_test_fixture.h"
 #include "mongo/executor/thread_pool_task_executor_test_fixture.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/log_test.h"
 
 namespace mongo {
@@ -500,6 +503,60 @@ TEST_F(TenantOplogApplierTest, ApplyInsert_Success) {
     applier->join();
 }
 
+TEST_F(TenantOplogApplierTest, ApplyInsertsToCappedCollection_Serialized) {
+    NamespaceString nss(dbName, "capped");
+    CollectionOptions options;
+    options.uuid = UUID::gen();
+    options.capped = true;
+    options.cappedSize = 64 * 1024;
+    createCollection(_opCtx.get(), nss, options);
+
+    // Only secondary oplog application reserves RecordIds for capped inserts. The tenant applier
+    // must keep applying every insert into a capped collection on the same writer thread.
+    std::vector<OplogEntry> entries;
+    for (int i = 1; i <= 10; ++i) {
+        entries.push_back(makeInsertOplogEntry(i, nss, options.uuid));
+    }
+
+    auto mutex = MONGO_MAKE_LATCH("ApplyInsertsToCappedCollection_Serialized::mutex");
+    std::set<stdx::thread::id> writerThreads;
+    std::vector<BSONObj> insertedDocs;
+    _opObserver->onInsertsFn =
+        [&](OperationContext* opCtx, const NamespaceString& nss, const std::vector<BSONObj>& docs) {
+            stdx::lock_guard lk(mutex);
+            writerThreads.insert(stdx::this_thread::get_id());
+            for (const auto& doc : docs) {
+                insertedDocs.push_back(doc.getOwned());
+            }
+        };
+    pushOps(entries);
+    auto writerPool = makeTenantMigrationWriterPool(4);
+
+    auto applier = std::make_shared<TenantOplogApplier>(
+        _migrationUuid, _tenantId, OpTime(), &_oplogBuffer, _executor, writerPool.get());
+    ASSERT_OK(applier->startup());
+    auto opAppliedFuture = applier->getNotificationForOpTime(entries.back().getOpTime());
+    ASSERT_OK(opAppliedFuture.getNoThrow().getStatus());
+    applier->shutdown();
+    applier->join();
+
+    ASSERT_EQ(1U, writerThreads.size());
+    ASSERT_EQ(entries.size(), insertedDocs.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        ASSERT_BSONOBJ_EQ(entries[i].getObject(), insertedDocs[i]);
+    }
+
+    // The natural order of the capped collection matches the oplog order.
+    AutoGetCollectionForRead coll(_opCtx.get(), nss);
+    auto cursor = coll->getCursor(_opCtx.get());
+    for (const auto& entry : entries) {
+        auto record = cursor->next();
+        ASSERT_TRUE(record);
+        ASSERT_BSONOBJ_EQ(entry.getObject(), record->data.toBson());
+    }
+    ASSERT_FALSE(cursor->next());
+}
+
 TEST_F(TenantOplogApplierTest, ApplyInserts_Grouped) {
     // TODO(SERVER-50256): remove nss_workaround, which is used to work around a bug where
     // the first operation assigned to a worker cannot be grouped.
@@ -107,6 +107,7 @@
 #include "mongo/transport/hello_metrics.h"
 #include "mongo/transport/service_executor.h"
 #include "mongo/transport/session.h"
+#include "mongo/util/concurrency/admission_priority.h"
 #include "mongo/util/duration.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/future_util.h"
@@ -1371,6 +1372,17 @@ void ExecCommandDatabase::_initiateCommand() {
         } else if (fieldName == "comment") {
             stdx::lock_guard<Client> lk(*client);
             opCtx->setComment(element.wrap());
+        } else if (fieldName == "$admissionPriority") {
+            // Only internal callers may move an operation ahead of others in the ticket queue.
+            uassert(ErrorCodes::Unauthorized,
+                    "Client is not properly authorized to specify $admissionPriority",
+                    authzSession->isAuthorizedForActionsOnResource(
+                        ResourcePattern::forClusterResource(), ActionType::internal));
+            uassert(ErrorCodes::TypeMismatch,
+                    "$admissionPriority must be a string",
+                    element.type() == String);
+            opCtx->lockState()->setAdmissionPriority(
+                uassertStatusOK(parseAdmissionPriority(element.valueStringData())));
         } else if (fieldName == query_request_helper::queryOptionMaxTimeMS) {
             uasserted(ErrorCodes::InvalidOptions,
                       "no such command option $maxTimeMs; use maxTimeMS instead");
@@ -49,6 +49,8 @@
 #include "mongo/db/sorter/sorter.h"
 
 #include <boost/filesystem/operations.hpp>
+#include <exception>
+#include <functional>
 #include <snappy.h>
 #include <vector>
 
@@ -61,6 +63,7 @@
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/overflow_arithmetic.h"
 #include "mongo/s/is_mongos.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/assert_util.h"
 #include "mongo/util/destructor_guard.h"
 #include "mongo/util/str.h"
@@ -116,6 +119,10 @@ EncryptionHooks* getEncryptionHooksIfEnabled() {
 
 constexpr std::size_t kSortedFileBufferSize = 64 * 1024;
 
+// Below this many elements per thread, sorting in parallel costs more in thread startup than it
+// saves in comparisons.
+constexpr std::size_t kMinElementsPerSortThread = 16 * 1024;
+
 }  // namespace
 
 namespace sorter {
@@ -151,6 +158,85 @@ void dassertCompIsSane(const Comparator& comp, const Data& lhs, const Data& rhs)
 #endif
 }
 
+inline void runConcurrently(const std::vector<std::function<void()>>& tasks) {
+    if (tasks.empty()) {
+        return;
+    }
+
+    std::vector<std::exception_ptr> errors(tasks.size());
+    auto runTask = [&](size_t i) {
+        try {
+            tasks[i]();
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+
+    std::vector<stdx::thread> threads;
+    threads.reserve(tasks.size() - 1);
+    for (size_t i = 1; i < tasks.size(); ++i) {
+        threads.emplace_back(runTask, i);
+    }
+    runTask(0);
+    for (auto&& thread : threads) {
+        thread.join();
+    }
+
+    for (auto&& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+/**
+ * Stable-sorts [begin, end) using up to 'numThreads' threads. The range is cut into 'numThreads'
+ * contiguous runs which are sorted concurrently, and adjacent runs are then merged pairwise, also
+ * concurrently, until a single run remains. Since both std::stable_sort and std::inplace_merge are
+ * stable and runs are always merged left-to-right, the result is identical to a single call to
+ * std::stable_sort.
+ */
+template <typename RandomIt, typename Less>
+void parallelStableSort(RandomIt begin, RandomIt end, size_t numThreads, const Less& less) {
+    const auto size = end - begin;
+    if (numThreads <= 1 || size < 2) {
+        std::stable_sort(begin, end, less);
+        return;
+    }
+
+    // Run i covers [bounds[i], bounds[i + 1]).
+    std::vector<RandomIt> bounds;
+    bounds.reserve(numThreads + 1);
+    for (size_t i = 0; i <= numThreads; ++i) {
+        bounds.push_back(begin + size * static_cast<decltype(size)>(i) /
+                             static_cast<decltype(size)>(numThreads));
+    }
+
+    std::vector<std::function<void()>> tasks;
+    for (size_t i = 0; i + 1 < bounds.size(); ++i) {
+        tasks.push_back([&, i] { std::stable_sort(bounds[i], bounds[i + 1], less); });
+    }
+    runConcurrently(tasks);
+
+    while (bounds.size() > 2) {
+        tasks.clear();
+        std::vector<RandomIt> mergedBounds;
+        for (size_t i = 0; i < bounds.size(); i += 2) {
+            mergedBounds.push_back(bounds[i]);
+            if (i + 2 < bounds.size()) {
+                tasks.push_back([&, i] {
+                    std::inplace_merge(bounds[i], bounds[i + 1], bounds[i + 2], less);
+                });
+            }
+        }
+        if (mergedBounds.back() != end) {
+            mergedBounds.push_back(end);
+        }
+        runConcurrently(tasks);
+        bounds = std::move(mergedBounds);
+    }
+}
+
 /**
  * Returns results from sorted in-memory storage.
  */
@@ -379,6 +465,12 @@ private:
  * Merge-sorts results from 0 or more FileIterators, all of which should be iterating over sorted
  * ranges within the same file. This class is given the data source file name upon construction and
  * is responsible for deleting the data source file upon destruction.
+ *
+ * The merge is driven by a tournament tree of losers: every internal node remembers the stream that
+ * lost the match played there, and the overall winner is kept at the root. Producing the next
+ * element only replays the matches on the path from the winner's leaf to the root, which costs
+ * exactly ceil(log2(k)) comparisons per element, compared to roughly twice that for the sift-down
+ * of a binary heap.
  */
 template <typename Key, typename Value, typename Comparator>
 class MergeIterator : public SortIteratorInterface<Key, Value> {
@@ -392,37 +484,34 @@ public:
         : _opts(opts),
           _remaining(opts.limit ? opts.limit : std::numeric_limits<unsigned long long>::max()),
           _first(true),
-          _greater(comp) {
+          _comp(comp) {
         for (size_t i = 0; i < iters.size(); i++) {
             iters[i]->openSource();
             if (iters[i]->more()) {
-                _heap.push_back(std::make_shared<Stream>(i, iters[i]->next(), iters[i]));
+                _streams.push_back(std::make_unique<Stream>(i, iters[i]->next(), iters[i]));
             } else {
                 iters[i]->closeSource();
             }
         }
 
-        if (_heap.empty()) {
+        if (_streams.empty()) {
             _remaining = 0;
             return;
         }
 
-        std::make_heap(_heap.begin(), _heap.end(), _greater);
-        std::pop_heap(_heap.begin(), _heap.end(), _greater);
-        _current = _heap.back();
-        _heap.pop_back();
+        _numLiveStreams = _streams.size();
+        _buildTree();
     }
 
     ~MergeIterator() {
-        _current.reset();
-        _heap.clear();
+        _streams.clear();
     }
 
     void openSource() {}
     void closeSource() {}
 
     bool more() {
-        if (_remaining > 0 && (_first || !_heap.empty() || _current->more()))
+        if (_remaining > 0 && (_first || _numLiveStreams > 1 || _winner()->more()))
             return true;
 
         _remaining = 0;
@@ -436,21 +525,19 @@ public:
 
         if (_first) {
             _first = false;
-            return _current->current();
+            return _winner()->current();
         }
 
-        if (!_current->advance()) {
-            verify(!_heap.empty());
-            std::pop_heap(_heap.begin(), _heap.end(), _greater);
-            _current = _heap.back();
-            _heap.pop_back();
-        } else if (!_heap.empty() && _greater(_current, _heap.front())) {
-            std::pop_heap(_heap.begin(), _heap.end(), _greater);
-            std::swap(_current, _heap.back());
-            std::push_heap(_heap.begin(), _heap.end(), _greater);
+        const size_t winner = _tree[0];
+        if (!_streams[winner]->advance()) {
+            // Destroying the stream closes its source. An exhausted stream loses every match.
+            _streams[winner].reset();
+            --_numLiveStreams;
+            verify(_numLiveStreams > 0);
         }
+        _replay(winner);
 
-        return _current->current();
+        return _winner()->current();
     }
 
 
@@ -492,32 +579,78 @@ private:
         std::shared_ptr<Input> _rest;
     };
 
-    class STLComparator {  // uses greater rather than less-than to maintain a MinHeap
-    public:
-        explicit STLComparator(const Comparator& comp) : _comp(comp) {}
+    Stream* _winner() const {
+        return _streams[_tree[0]].get();
+    }
 
-        template <typename Ptr>
-        bool operator()(const Ptr& lhs, const Ptr& rhs) const {
-            // first compare data
-            dassertCompIsSane(_comp, lhs->current(), rhs->current());
-            int ret = _comp(lhs->current(), rhs->current());
-            if (ret)
-                return ret > 0;
+    /**
+     * Returns true if the stream at index 'lhs' must be returned before the stream at index 'rhs'.
+     * Exhausted streams sort after everything else, and ties are broken by file number so that the
+     * merge is stable.
+     */
+    bool _beats(size_t lhs, size_t rhs) const {
+        const auto& left = _streams[lhs];
+        const auto& right = _streams[rhs];
+        if (!left || !right)
+            return left && !right;
+
+        dassertCompIsSane(_comp, left->current(), right->current());
+        int ret = _comp(left->current(), right->current());
+        if (ret)
+            return ret < 0;
+
+        return left->fileNum < right->fileNum;
+    }
+
+    /**
+     * Plays the initial tournament. With k streams, the leaf for stream i is node k + i and the
+     * internal nodes are 1 through k - 1, so the children of node n are 2n and 2n + 1. Node 0
+     * holds the overall winner.
+     */
+    void _buildTree() {
+        const size_t k = _streams.size();
+        _tree.assign(k, 0);
 
-            // then compare fileNums to ensure stability
-            return lhs->fileNum > rhs->fileNum;
+        std::vector<size_t> winners(2 * k);
+        for (size_t i = 0; i < k; ++i) {
+            winners[k + i] = i;
         }
+        for (size_t node = k - 1; node >= 1; --node) {
+            size_t left = winners[2 * node];
+            size_t right = winners[2 * node + 1];
+            if (_beats(left, right)) {
+                winners[node] = left;
+                _tree[node] = right;
+            } else {
+                winners[node] = right;
+                _tree[node] = left;
+            }
+        }
+        _tree[0] = k > 1 ? winners[1] : 0;
+    }
 
-    private:
-        const Comparator _comp;
-    };
+    /**
+     * Replays the matches on the path from the leaf of stream 'stream' to the root, after the head
+     * of that stream has changed.
+     */
+    void _replay(size_t stream) {
+        const size_t k = _streams.size();
+        size_t winner = stream;
+        for (size_t node = (k + stream) / 2; node >= 1; node /= 2) {
+            if (_beats(_tree[node], winner)) {
+                std::swap(_tree[node], winner);
+            }
+        }
+        _tree[0] = winner;
+    }
 
     SortOptions _opts;
     unsigned long long _remaining;
     bool _first;
-    std::shared_ptr<Stream> _current;
-    std::vector<std::shared_ptr<Stream>> _heap;  // MinHeap
-    STLComparator _greater;                      // named so calls make sense
+    const Comparator _comp;
+    std::vector<std::unique_ptr<Stream>> _streams;  // Null once exhausted.
+    std::vector<size_t> _tree;                      // Losers at [1, k), the winner at 0.
+    size_t _numLiveStreams = 0;
 };
 
 template <typename Key, typename Value, typename Comparator>
@@ -733,7 +866,9 @@ private:
 
     void sort() {
         STLComparator less(this->_comp);
-        std::stable_sort(_data.begin(), _data.end(), less);
+        auto numThreads =
+            std::min(this->_opts.numSortThreads, _data.size() / kMinElementsPerSortThread);
+        parallelStableSort(_data.begin(), _data.end(), numThreads, less);
         this->_numSorted += _data.size();
     }
 
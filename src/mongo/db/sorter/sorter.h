@@ -31,9 +31,11 @@
 
 #include <third_party/murmurhash3/MurmurHash3.h>
 
+#include <algorithm>
 #include <boost/filesystem/path.hpp>
 #include <deque>
 #include <fstream>
+#include <functional>
 #include <memory>
 #include <queue>
 #include <string>
@@ -93,6 +95,17 @@
 
 namespace mongo {
 
+namespace sorter {
+/**
+ * Runs each of 'tasks' on its own thread, using the calling thread for the first one, and waits
+ * for all of them to finish. If any task throws, the first exception is rethrown once every thread
+ * has been joined.
+ *
+ * Defined in sorter.cpp, so it may only be used by translation units that include it.
+ */
+inline void runConcurrently(const std::vector<std::function<void()>>& tasks);
+}  // namespace sorter
+
 /**
  * Runtime options that control the Sorter's behavior
  */
@@ -121,11 +134,17 @@ struct SortOptions {
     // instead of copying.
     bool moveSortedDataIntoIterator;
 
+    // The maximum number of threads a sorter without a limit may use to sort its in-memory data
+    // before spilling it or returning it. The comparator must be safe to call concurrently when
+    // this is greater than 1.
+    size_t numSortThreads;
+
     SortOptions()
         : limit(0),
           maxMemoryUsageBytes(64 * 1024 * 1024),
           extSortAllowed(false),
-          moveSortedDataIntoIterator(false) {}
+          moveSortedDataIntoIterator(false),
+          numSortThreads(1) {}
 
     // Fluent API to support expressions like SortOptions().Limit(1000).ExtSortAllowed(true)
 
@@ -158,6 +177,11 @@ struct SortOptions {
         moveSortedDataIntoIterator = newMoveSortedDataIntoIterator;
         return *this;
     }
+
+    SortOptions& NumSortThreads(size_t newNumSortThreads) {
+        numSortThreads = std::max(newNumSortThreads, static_cast<size_t>(1));
+        return *this;
+    }
 };
 
 /**
@@ -32,8 +32,10 @@
 #include "mongo/platform/basic.h"
 
 #include <boost/filesystem.hpp>
+#include <deque>
 #include <fstream>
 #include <memory>
+#include <numeric>
 
 #include "mongo/base/data_type_endian.h"
 #include "mongo/base/static_assert.h"
@@ -349,6 +351,26 @@ public:
             ASSERT_ITERATORS_EQUIVALENT(mergeIterators(iterators, DESC),
                                         std::make_shared<IntIterator>(30, 0, -1));
         }
+        {  // test a number of sources that is not a power of two, with unequal lengths
+            std::shared_ptr<IWIterator> iterators[] = {
+                std::make_shared<IntIterator>(0, 70, 7),  // 0, 7, ... 63
+                std::make_shared<IntIterator>(1, 70, 7),  // 1, 8, ... 64
+                std::make_shared<IntIterator>(2, 70, 7),  // 2, 9, ... 65
+                std::make_shared<IntIterator>(3, 70, 7),  // 3, 10, ... 66
+                std::make_shared<IntIterator>(4, 70, 7),  // 4, 11, ... 67
+                std::make_shared<IntIterator>(5, 70, 7),  // 5, 12, ... 68
+                std::make_shared<IntIterator>(6, 70, 7),  // 6, 13, ... 69
+                std::make_shared<IntIterator>(70, 80)};   // 70, 71, ... 79
+
+            ASSERT_ITERATORS_EQUIVALENT(mergeIterators(iterators, ASC),
+                                        std::make_shared<IntIterator>(0, 80, 1));
+        }
+        {  // test a single source
+            std::shared_ptr<IWIterator> iterators[] = {std::make_shared<IntIterator>(0, 10)};
+
+            ASSERT_ITERATORS_EQUIVALENT(mergeIterators(iterators, ASC),
+                                        std::make_shared<IntIterator>(0, 10));
+        }
         {  // test Limit
             std::shared_ptr<IWIterator> iterators[] = {
                 std::make_shared<IntIterator>(1, 20, 2),   // 1, 3, ... 19
@@ -659,6 +681,31 @@ public:
 };
 
 
+/**
+ * Sorts enough data in memory for the sorter to split the sort across several threads.
+ */
+template <bool Random = true>
+class LotsOfDataParallelSort : public LotsOfDataLittleMemory<Random> {
+    typedef LotsOfDataLittleMemory<Random> Parent;
+    SortOptions adjustSortOptions(SortOptions opts) override {
+        // Make sure the data fits in memory and is large enough to be sorted by several threads.
+        MONGO_STATIC_ASSERT(MEM_LIMIT > (Parent::NUM_ITEMS * sizeof(IWPair)));
+        MONGO_STATIC_ASSERT(Parent::NUM_ITEMS > NUM_THREADS * kMinElementsPerSortThread);
+
+        return opts.MaxMemoryUsageBytes(MEM_LIMIT).NumSortThreads(NUM_THREADS);
+    }
+    size_t correctNumRanges() const override {
+        return 0;
+    }
+    size_t correctNumSpills() const override {
+        return 0;
+    }
+    enum {
+        MEM_LIMIT = 64 * 1024 * 1024,
+        NUM_THREADS = 4,
+    };
+};
+
 template <long long Limit, bool Random = true>
 class LotsOfDataWithLimit : public LotsOfDataLittleMemory<Random> {
     typedef LotsOfDataLittleMemory<Random> Parent;
@@ -705,6 +752,8 @@ public:
         add<SorterTests::Dupes>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/false>>();
         add<SorterTests::LotsOfDataLittleMemory</*random=*/true>>();
+        add<SorterTests::LotsOfDataParallelSort</*random=*/false>>();
+        add<SorterTests::LotsOfDataParallelSort</*random=*/true>>();
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/false>>();     // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<1, /*random=*/true>>();      // limit=1 is special case
         add<SorterTests::LotsOfDataWithLimit<100, /*random=*/false>>();   // fits in mem
@@ -732,6 +781,46 @@ public:
 
 mongo::unittest::OldStyleSuiteInitializer<SorterSuite> extSortTests;
 
+TEST(SorterParallelStableSortTest, MatchesStableSort) {
+    using Entry = std::pair<int, int>;
+    auto less = [](const Entry& lhs, const Entry& rhs) {
+        return lhs.first < rhs.first;
+    };
+
+    PseudoRandom random(int64_t(time(nullptr)));
+    for (size_t numThreads : {1, 2, 3, 4, 7, 8}) {
+        // Many duplicate keys, with the value recording the insertion order, so that any loss of
+        // stability shows up as a difference from std::stable_sort.
+        std::deque<Entry> data;
+        for (int i = 0; i < 10 * 1000; ++i) {
+            data.emplace_back(random.nextInt32(100), i);
+        }
+
+        auto expected = data;
+        std::stable_sort(expected.begin(), expected.end(), less);
+
+        parallelStableSort(data.begin(), data.end(), numThreads, less);
+        ASSERT(data == expected);
+    }
+}
+
+TEST(SorterParallelStableSortTest, MoreThreadsThanElements) {
+    std::vector<int> data{3, 1, 2};
+    parallelStableSort(data.begin(), data.end(), 8, std::less<int>());
+    ASSERT(data == std::vector<int>({1, 2, 3}));
+}
+
+TEST(SorterParallelStableSortTest, PropagatesComparatorException) {
+    std::vector<int> data(1000);
+    std::iota(data.begin(), data.end(), 0);
+    auto throwingLess = [](int lhs, int rhs) -> bool {
+        uasserted(ErrorCodes::InternalError, "comparison failed");
+    };
+    ASSERT_THROWS_CODE(parallelStableSort(data.begin(), data.end(), 4, throwingLess),
+                       DBException,
+                       ErrorCodes::InternalError);
+}
+
 /**
  * This suite includes test cases for resumable index builds where the Sorter is reconstructed from
  * state persisted to disk during a previous clean shutdown.
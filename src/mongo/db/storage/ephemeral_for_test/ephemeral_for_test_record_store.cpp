@@ -339,6 +339,17 @@ void RecordStore::_initHighestIdIfNeeded(OperationContext* opCtx) {
     _highestRecordId.store(nextId);
 };
 
+void RecordStore::reserveRecordIds(OperationContext* opCtx,
+                                   std::vector<RecordId>* out,
+                                   size_t nRecords) {
+    invariant(reserveRecordIdsSupported());
+    _initHighestIdIfNeeded(opCtx);
+    int64_t nextId = _highestRecordId.fetchAndAdd(nRecords);
+    for (size_t i = 0; i < nRecords; i++) {
+        out->push_back(RecordId(nextId++));
+    }
+}
+
 int64_t RecordStore::_nextRecordId(OperationContext* opCtx) {
     _initHighestIdIfNeeded(opCtx);
     return _highestRecordId.fetchAndAdd(1);
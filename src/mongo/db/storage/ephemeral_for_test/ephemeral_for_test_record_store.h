@@ -75,6 +75,14 @@ public:
                                  std::vector<Record>* inOutRecords,
                                  const std::vector<Timestamp>& timestamps);
 
+    virtual bool reserveRecordIdsSupported() const {
+        return _keyFormat == KeyFormat::Long && !_isOplog;
+    }
+
+    virtual void reserveRecordIds(OperationContext* opCtx,
+                                  std::vector<RecordId>* out,
+                                  size_t nRecords);
+
     virtual Status updateRecord(OperationContext* opCtx,
                                 const RecordId& oldLocation,
                                 const char* data,
@@ -38,6 +38,7 @@
 #include "mongo/bson/timestamp.h"
 #include "mongo/db/catalog/collection_options.h"
 #include "mongo/db/catalog/import_options.h"
+#include "mongo/db/storage/column_store.h"
 #include "mongo/db/storage/durable_catalog.h"
 #include "mongo/db/storage/record_store.h"
 #include "mongo/db/storage/sorted_data_interface.h"
@@ -135,6 +136,25 @@ public:
 
     virtual Status dropSortedDataInterface(OperationContext* opCtx, StringData ident) = 0;
 
+    /**
+     * Column stores are optional. Engines that do not implement them reject creation so that a
+     * columnar index can never be built on top of them.
+     */
+    virtual Status createColumnStore(OperationContext* opCtx,
+                                     const CollectionOptions& collOptions,
+                                     StringData ident,
+                                     const IndexDescriptor* desc) {
+        return {ErrorCodes::NotImplemented,
+                "This storage engine does not support columnar indexes"};
+    }
+
+    virtual std::unique_ptr<ColumnStore> getColumnStore(OperationContext* opCtx,
+                                                        const CollectionOptions& collOptions,
+                                                        StringData ident,
+                                                        const IndexDescriptor* desc) {
+        MONGO_UNREACHABLE;
+    }
+
     virtual int64_t getIdentSize(OperationContext* opCtx, StringData ident) = 0;
 
     /**
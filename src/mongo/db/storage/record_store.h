@@ -353,6 +353,29 @@ public:
                                  std::vector<Record>* inOutRecords,
                                  const std::vector<Timestamp>& timestamps) = 0;
 
+    /**
+     * Does this RecordStore support reserving RecordIds ahead of inserting the records?
+     *
+     * If you return true, you must provide an implementation of reserveRecordIds().
+     */
+    virtual bool reserveRecordIdsSupported() const {
+        return false;
+    }
+
+    /**
+     * Reserves 'nRecords' RecordIds, in increasing order, for records that will be inserted later
+     * by passing them to insertRecords(). A reserved RecordId is never generated for another
+     * record, so records inserted concurrently with their reserved RecordIds keep the order in
+     * which the RecordIds were reserved.
+     *
+     * Only called if reserveRecordIdsSupported() returns true.
+     */
+    virtual void reserveRecordIds(OperationContext* opCtx,
+                                  std::vector<RecordId>* out,
+                                  size_t nRecords) {
+        MONGO_UNREACHABLE;
+    }
+
     /**
      * A thin wrapper around insertRecords() to simplify handling of single document inserts.
      */
@@ -107,5 +107,64 @@ TEST(RecordStoreTestHarness, InsertMultipleRecords) {
     }
 }
 
+// Reserve RecordIds, insert records with them in reverse order, and verify that a cursor returns
+// the records in the order in which their RecordIds were reserved.
+TEST(RecordStoreTestHarness, InsertRecordsWithReservedRecordIds) {
+    const auto harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newRecordStore());
+    if (!rs->reserveRecordIdsSupported()) {
+        return;
+    }
+
+    const int nToInsert = 10;
+    std::vector<RecordId> reserved;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        rs->reserveRecordIds(opCtx.get(), &reserved, nToInsert);
+    }
+    ASSERT_EQUALS(static_cast<size_t>(nToInsert), reserved.size());
+    for (int i = 1; i < nToInsert; i++) {
+        ASSERT_LT(reserved[i - 1], reserved[i]);
+    }
+
+    for (int i = nToInsert - 1; i >= 0; i--) {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        string data = str::stream() << "record " << i;
+
+        WriteUnitOfWork uow(opCtx.get());
+        StatusWith<RecordId> res =
+            rs->insertRecord(opCtx.get(), reserved[i], data.c_str(), data.size() + 1, Timestamp());
+        ASSERT_OK(res.getStatus());
+        ASSERT_EQUALS(reserved[i], res.getValue());
+        uow.commit();
+    }
+
+    // A RecordId generated by the record store follows the reserved ones.
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        string data = "unreserved";
+
+        WriteUnitOfWork uow(opCtx.get());
+        StatusWith<RecordId> res =
+            rs->insertRecord(opCtx.get(), data.c_str(), data.size() + 1, Timestamp());
+        ASSERT_OK(res.getStatus());
+        ASSERT_LT(reserved.back(), res.getValue());
+        uow.commit();
+    }
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        auto cursor = rs->getCursor(opCtx.get());
+        for (int i = 0; i < nToInsert; i++) {
+            auto record = cursor->next();
+            ASSERT(record);
+            ASSERT_EQUALS(reserved[i], record->id);
+            ASSERT_EQUALS(string(str::stream() << "record " << i), record->data.data());
+        }
+        ASSERT(cursor->next());
+        ASSERT_FALSE(cursor->next());
+    }
+}
+
 }  // namespace
 }  // namespace mongo
@@ -0,0 +1,669 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kStorage
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_column_store.h"
+
+#include "mongo/base/data_view.h"
+#include "mongo/db/catalog/validate_results.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/repl/repl_settings.h"
+#include "mongo/db/service_context.h"
+#include "mongo/db/stats/resource_consumption_metrics.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_cursor.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_cursor_helpers.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_index.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_prepare_conflict.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_record_store.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/logv2/log.h"
+#include "mongo/util/str.h"
+
+namespace mongo {
+namespace {
+
+// Bumped whenever the on-disk key or cell format changes.
+const int kColumnStoreFormatVersion = 1;
+
+// Byte that separates the path from the RecordId in a key. Paths never contain a 0 byte, so every
+// key for a given path sorts before the keys of any other path that has it as a prefix.
+const char kPathTerminator = '\0';
+
+// Flipping the sign bit of a RecordId makes its big-endian representation sort byte-wise in the
+// same order as the signed value.
+const uint64_t kRecordIdSignBit = 1ull << 63;
+
+}  // namespace
+
+// static
+StatusWith<std::string> WiredTigerColumnStore::generateCreateString(
+    const std::string& engineName,
+    const std::string& sysIndexConfig,
+    const std::string& collIndexConfig,
+    const NamespaceString& collectionNamespace,
+    const IndexDescriptor& desc) {
+    str::stream ss;
+
+    // Separate out a prefix and suffix in the default string. User configuration will override
+    // values in the prefix, but not values in the suffix. Cells are stored under keys sharing long
+    // path prefixes, so prefix compression is always enabled.
+    ss << "type=file,internal_page_max=16k,leaf_page_max=16k,";
+    ss << "checksum=on,";
+    ss << "prefix_compression=true,";
+
+    ss << WiredTigerCustomizationHooks::get(getGlobalServiceContext())
+              ->getTableCreateConfig(collectionNamespace.ns());
+    ss << sysIndexConfig << ",";
+    ss << collIndexConfig << ",";
+
+    // Column stores accept the same 'storageEngine' options as regular indexes.
+    BSONElement storageEngineElement = desc.infoObj()["storageEngine"];
+    if (storageEngineElement.isABSONObj()) {
+        BSONObj storageEngine = storageEngineElement.Obj();
+        StatusWith<std::string> parseStatus =
+            WiredTigerIndex::parseIndexOptions(storageEngine.getObjectField(engineName));
+        if (!parseStatus.isOK()) {
+            return parseStatus;
+        }
+        if (!parseStatus.getValue().empty()) {
+            ss << "," << parseStatus.getValue();
+        }
+    }
+
+    // WARNING: No user-specified config can appear below this line. These options are required
+    // for correct behavior of the server.
+    ss << ",key_format=u";
+    ss << ",value_format=u";
+
+    ss << ",app_metadata=(formatVersion=" << kColumnStoreFormatVersion << "),";
+
+    bool replicatedWrites = getGlobalReplSettings().usingReplSets() ||
+        repl::ReplSettings::shouldRecoverFromOplogAsStandalone();
+    if (WiredTigerUtil::useTableLogging(collectionNamespace, replicatedWrites)) {
+        ss << "log=(enabled=true)";
+    } else {
+        ss << "log=(enabled=false)";
+    }
+
+    LOGV2_DEBUG(6610100, 3, "column store create string", "str"_attr = ss.ss.str());
+    return StatusWith<std::string>(ss);
+}
+
+// static
+Status WiredTigerColumnStore::create(OperationContext* opCtx,
+                                     const std::string& uri,
+                                     const std::string& config) {
+    // Don't use the session from the recovery unit: create should not be used in a transaction
+    WiredTigerSession session(WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->conn());
+    WT_SESSION* s = session.getSession();
+    LOGV2_DEBUG(6610101, 1, "create column store", "uri"_attr = uri, "config"_attr = config);
+    return wtRCToStatus(s->create(s, uri.c_str(), config.c_str()), s);
+}
+
+// static
+std::string& WiredTigerColumnStore::makeKey(std::string& buffer,
+                                            PathView path,
+                                            const RecordId& rid) {
+    buffer.clear();
+    buffer.reserve(path.size() + 1 + sizeof(uint64_t));
+    buffer.append(path.rawData(), path.size());
+    buffer.push_back(kPathTerminator);
+    if (rid.isNull()) {
+        return buffer;
+    }
+
+    tassert(6610102, "Column stores only support RecordIds in the long format", rid.isLong());
+    char ridBytes[sizeof(uint64_t)];
+    DataView(ridBytes).write<BigEndian<uint64_t>>(static_cast<uint64_t>(rid.getLong()) ^
+                                                  kRecordIdSignBit);
+    buffer.append(ridBytes, sizeof(ridBytes));
+    return buffer;
+}
+
+// static
+std::pair<PathView, RecordId> WiredTigerColumnStore::decodeKey(StringData key) {
+    const auto terminator = key.find(kPathTerminator);
+    invariant(terminator != std::string::npos);
+    const auto ridBytes = key.substr(terminator + 1);
+    invariant(ridBytes.size() == sizeof(uint64_t));
+    const auto repr = ConstDataView(ridBytes.rawData()).read<BigEndian<uint64_t>>();
+    return {key.substr(0, terminator), RecordId(static_cast<int64_t>(repr ^ kRecordIdSignBit))};
+}
+
+WiredTigerColumnStore::WiredTigerColumnStore(OperationContext* ctx,
+                                             const std::string& uri,
+                                             StringData ident,
+                                             const IndexDescriptor* desc,
+                                             bool isReadOnly)
+    : ColumnStore(ident),
+      _uri(uri),
+      _tableId(WiredTigerSession::genTableId()),
+      _desc(desc),
+      _indexName(desc->indexName()) {
+    auto version = WiredTigerUtil::checkApplicationMetadataFormatVersion(
+        ctx, uri, kColumnStoreFormatVersion, kColumnStoreFormatVersion);
+    if (!version.isOK()) {
+        auto status = version.getStatus();
+        LOGV2_FATAL_NOTRACE(6610103,
+                            "Column store has unsupported format version",
+                            "uri"_attr = uri,
+                            "index"_attr = _indexName,
+                            "error"_attr = status);
+    }
+
+    if (!isReadOnly) {
+        // Keep table logging in line with the replication settings, as WiredTigerIndex does.
+        bool replicatedWrites = getGlobalReplSettings().usingReplSets() ||
+            repl::ReplSettings::shouldRecoverFromOplogAsStandalone();
+        bool useTableLogging = !replicatedWrites ||
+            WiredTigerUtil::useTableLogging(desc->getEntry()->getNSSFromCatalog(ctx),
+                                            replicatedWrites);
+        uassertStatusOK(WiredTigerUtil::setTableLogging(ctx, uri, useTableLogging));
+    }
+}
+
+class WiredTigerColumnStore::WriteCursor final : public ColumnStore::WriteCursor {
+public:
+    WriteCursor(WiredTigerColumnStore& cs, OperationContext* opCtx)
+        : _opCtx(opCtx),
+          _indexName(cs.indexName()),
+          _curwrap(cs.uri(), cs.tableId(), true, opCtx) {}
+
+    void insert(PathView, RecordId, CellView) override;
+    void remove(PathView, RecordId) override;
+    void update(PathView, RecordId, CellView) override;
+
+    WT_CURSOR* c() {
+        return _curwrap.get();
+    }
+
+private:
+    OperationContext* const _opCtx;
+    const std::string _indexName;
+    WiredTigerCursor _curwrap;
+    std::string _buffer;
+};
+
+std::unique_ptr<ColumnStore::WriteCursor> WiredTigerColumnStore::newWriteCursor(
+    OperationContext* opCtx) {
+    return std::make_unique<WriteCursor>(*this, opCtx);
+}
+
+void WiredTigerColumnStore::insert(OperationContext* opCtx,
+                                   PathView path,
+                                   RecordId rid,
+                                   CellView cell) {
+    WriteCursor(*this, opCtx).insert(path, rid, cell);
+}
+
+void WiredTigerColumnStore::WriteCursor::insert(PathView path, RecordId rid, CellView cell) {
+    dassert(_opCtx->lockState()->isWriteLocked());
+
+    WiredTigerItem keyItem(makeKey(_buffer, path, rid));
+    c()->set_key(c(), keyItem.Get());
+    WiredTigerItem valueItem(cell.rawData(), cell.size());
+    c()->set_value(c(), valueItem.Get());
+
+    // The cursor is opened with overwrite enabled, so inserting an existing cell replaces it.
+    int ret = WT_OP_CHECK(wiredTigerCursorInsert(_opCtx, c()));
+    invariantWTOK(ret, c()->session);
+
+    auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
+    metricsCollector.incrementOneIdxEntryWritten(keyItem.size);
+}
+
+void WiredTigerColumnStore::remove(OperationContext* opCtx, PathView path, RecordId rid) {
+    WriteCursor(*this, opCtx).remove(path, rid);
+}
+
+void WiredTigerColumnStore::WriteCursor::remove(PathView path, RecordId rid) {
+    dassert(_opCtx->lockState()->isWriteLocked());
+
+    WiredTigerItem keyItem(makeKey(_buffer, path, rid));
+    c()->set_key(c(), keyItem.Get());
+    int ret = WT_OP_CHECK(wiredTigerCursorRemove(_opCtx, c()));
+    if (ret == WT_NOTFOUND) {
+        return;
+    }
+    invariantWTOK(ret, c()->session);
+
+    auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
+    metricsCollector.incrementOneIdxEntryWritten(keyItem.size);
+}
+
+void WiredTigerColumnStore::update(OperationContext* opCtx,
+                                   PathView path,
+                                   RecordId rid,
+                                   CellView cell) {
+    WriteCursor(*this, opCtx).update(path, rid, cell);
+}
+
+void WiredTigerColumnStore::WriteCursor::update(PathView path, RecordId rid, CellView cell) {
+    dassert(_opCtx->lockState()->isWriteLocked());
+
+    WiredTigerItem keyItem(makeKey(_buffer, path, rid));
+    c()->set_key(c(), keyItem.Get());
+
+    // An update of a cell that is not present is a logic error in the caller, so it must not be
+    // silently turned into an insert. The cursor is opened with overwrite enabled, which would make
+    // WiredTiger insert the missing cell, so position on the cell first.
+    int ret = wiredTigerPrepareConflictRetry(_opCtx, [&] { return c()->search(c()); });
+    invariant(ret != WT_NOTFOUND,
+              str::stream() << "Column store update of a missing cell, index: " << _indexName
+                            << ", path: " << path << ", RecordId: " << rid);
+    invariantWTOK(ret, c()->session);
+
+    WiredTigerItem valueItem(cell.rawData(), cell.size());
+    c()->set_value(c(), valueItem.Get());
+    ret = WT_OP_CHECK(wiredTigerCursorUpdate(_opCtx, c()));
+    invariantWTOK(ret, c()->session);
+
+    auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
+    metricsCollector.incrementOneIdxEntryWritten(keyItem.size);
+}
+
+class WiredTigerColumnStore::Cursor final : public ColumnStore::Cursor {
+public:
+    Cursor(OperationContext* opCtx, const WiredTigerColumnStore& cs) : _opCtx(opCtx), _cs(cs) {
+        _cursor.emplace(_cs.uri(), _cs.tableId(), false, _opCtx);
+    }
+
+    boost::optional<FullCellView> next() override {
+        if (_eof) {
+            return {};
+        }
+        if (!_lastMoveSkippedKey) {
+            advanceWTCursor();
+        }
+        _lastMoveSkippedKey = false;
+        return curr();
+    }
+
+    boost::optional<FullCellView> seekAtOrPast(PathView path, RecordId rid) override {
+        makeKey(_buffer, path, rid);
+        seekWTCursor();
+        return curr();
+    }
+
+    boost::optional<FullCellView> seekExact(PathView path, RecordId rid) override {
+        makeKey(_buffer, path, rid);
+        seekWTCursor(/*exactOnly*/ true);
+        return curr();
+    }
+
+    void save() override {
+        if (!_eof && _cursor) {
+            // Remember the current key so that restore() can reposition to it. The key memory is
+            // owned by WiredTiger and is invalidated by the reset() below.
+            WT_ITEM key;
+            getKey(c(), &key);
+            _buffer.assign(static_cast<const char*>(key.data), key.size);
+        }
+
+        try {
+            if (_cursor)
+                _cursor->reset();
+        } catch (const WriteConflictException&) {
+            // Ignore since this is only called when we are about to kill our transaction
+            // anyway.
+        }
+    }
+
+    void saveUnpositioned() override {
+        save();
+        _eof = true;
+    }
+
+    void restore() override {
+        if (!_cursor) {
+            _cursor.emplace(_cs.uri(), _cs.tableId(), false, _opCtx);
+        }
+
+        // Ensure an active session exists, so any restored cursors will bind to it
+        invariant(WiredTigerRecoveryUnit::get(_opCtx)->getSession() == _cursor->getSession());
+
+        if (!_eof) {
+            // If the saved cell was removed while we were yielded, we are now positioned on the
+            // cell after it and the next call to next() must return it rather than skip it.
+            _lastMoveSkippedKey = !seekWTCursor();
+        }
+    }
+
+    void detachFromOperationContext() override {
+        _opCtx = nullptr;
+        _cursor = boost::none;
+    }
+
+    void reattachToOperationContext(OperationContext* opCtx) override {
+        _opCtx = opCtx;
+        // _cursor recreated in restore() to avoid risk of WT_ROLLBACK issues.
+    }
+
+private:
+    WT_CURSOR* c() {
+        return _cursor->get();
+    }
+
+    void getKey(WT_CURSOR* cursor, WT_ITEM* key) {
+        invariantWTOK(cursor->get_key(cursor, key), cursor->session);
+
+        auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
+        metricsCollector.incrementOneIdxEntryRead(key->size);
+    }
+
+    void advanceWTCursor() {
+        // Ensure an active transaction is open.
+        WiredTigerRecoveryUnit::get(_opCtx)->getSession();
+
+        WT_CURSOR* cursor = c();
+        int ret = wiredTigerPrepareConflictRetry(_opCtx, [&] { return cursor->next(cursor); });
+        if (ret == WT_NOTFOUND) {
+            _eof = true;
+            return;
+        }
+        invariantWTOK(ret, cursor->session);
+        _eof = false;
+    }
+
+    // Seeks to the key in '_buffer'. Returns true on exact match. Unless 'exactOnly' is set, leaves
+    // the cursor on the first key after '_buffer' when there is no exact match.
+    bool seekWTCursor(bool exactOnly = false) {
+        // Ensure an active transaction is open.
+        WiredTigerRecoveryUnit::get(_opCtx)->getSession();
+
+        WT_CURSOR* cursor = c();
+        WiredTigerItem searchKey(_buffer);
+        cursor->set_key(cursor, searchKey.Get());
+
+        _lastMoveSkippedKey = false;
+        if (exactOnly) {
+            int ret =
+                wiredTigerPrepareConflictRetry(_opCtx, [&] { return cursor->search(cursor); });
+            if (ret == WT_NOTFOUND) {
+                _eof = true;
+                return false;
+            }
+            invariantWTOK(ret, cursor->session);
+            _eof = false;
+            return true;
+        }
+
+        int cmp;
+        int ret = wiredTigerPrepareConflictRetry(
+            _opCtx, [&] { return cursor->search_near(cursor, &cmp); });
+        if (ret == WT_NOTFOUND) {
+            _eof = true;
+            return false;
+        }
+        invariantWTOK(ret, cursor->session);
+        _eof = false;
+
+        if (cmp < 0) {
+            // Landed before the search key, so step forward onto the first key after it.
+            advanceWTCursor();
+        }
+        return cmp == 0;
+    }
+
+    boost::optional<FullCellView> curr() {
+        if (_eof) {
+            return {};
+        }
+
+        WT_ITEM key;
+        WT_ITEM value;
+        getKey(c(), &key);
+        invariantWTOK(c()->get_value(c(), &value), c()->session);
+
+        auto [path, rid] = decodeKey(StringData(static_cast<const char*>(key.data), key.size));
+        return FullCellView{path, rid, CellView(static_cast<const char*>(value.data), value.size)};
+    }
+
+    OperationContext* _opCtx;
+    const WiredTigerColumnStore& _cs;
+    boost::optional<WiredTigerCursor> _cursor;
+    std::string _buffer;
+    bool _eof = false;
+    bool _lastMoveSkippedKey = false;
+};
+
+std::unique_ptr<ColumnStore::Cursor> WiredTigerColumnStore::newCursor(
+    OperationContext* opCtx) const {
+    return std::make_unique<Cursor>(opCtx, *this);
+}
+
+/**
+ * Bulk loads cells into an empty column store. Cells must be added in increasing (path, RecordId)
+ * order.
+ */
+class WiredTigerColumnStore::BulkBuilder final : public ColumnStore::BulkBuilder {
+public:
+    BulkBuilder(WiredTigerColumnStore& cs, OperationContext* opCtx)
+        : _opCtx(opCtx),
+          _session(WiredTigerRecoveryUnit::get(_opCtx)->getSessionCache()->getSession()),
+          _cursor(openBulkCursor(cs)) {}
+
+    ~BulkBuilder() {
+        _cursor->close(_cursor);
+    }
+
+    void addCell(PathView path, RecordId rid, CellView cell) override {
+        makeKey(_buffer, path, rid);
+
+        // Can't use WiredTigerCursor since we aren't using the cache.
+        WiredTigerItem keyItem(_buffer);
+        _cursor->set_key(_cursor, keyItem.Get());
+
+        WiredTigerItem valueItem(cell.rawData(), cell.size());
+        _cursor->set_value(_cursor, valueItem.Get());
+
+        invariantWTOK(wiredTigerCursorInsert(_opCtx, _cursor), _cursor->session);
+
+        auto& metricsCollector = ResourceConsumption::MetricsCollector::get(_opCtx);
+        metricsCollector.incrementOneIdxEntryWritten(keyItem.size);
+    }
+
+private:
+    WT_CURSOR* openBulkCursor(WiredTigerColumnStore& cs) {
+        // Open cursors can cause bulk open_cursor to fail with EBUSY.
+        WiredTigerSession* outerSession = WiredTigerRecoveryUnit::get(_opCtx)->getSession();
+        outerSession->closeAllCursors(cs.uri());
+
+        // Not using cursor cache since we need to set "bulk".
+        WT_CURSOR* cursor;
+        // Use a different session to ensure we don't hijack an existing transaction.
+        // Configure the bulk cursor open to fail quickly if it would wait on a checkpoint
+        // completing - since checkpoints can take a long time, and waiting can result in
+        // an unexpected pause in building an index.
+        WT_SESSION* session = _session->getSession();
+        int err = session->open_cursor(
+            session, cs.uri().c_str(), nullptr, "bulk,checkpoint_wait=false", &cursor);
+        if (!err)
+            return cursor;
+
+        LOGV2_WARNING(6610104,
+                      "Failed to create WiredTiger bulk cursor, falling back to non-bulk",
+                      "error"_attr = wiredtiger_strerror(err),
+                      "index"_attr = cs.uri());
+
+        invariantWTOK(session->open_cursor(session, cs.uri().c_str(), nullptr, nullptr, &cursor),
+                      session);
+        return cursor;
+    }
+
+    OperationContext* const _opCtx;
+    UniqueWiredTigerSession const _session;
+    WT_CURSOR* const _cursor;
+    std::string _buffer;
+};
+
+std::unique_ptr<ColumnStore::BulkBuilder> WiredTigerColumnStore::makeBulkBuilder(
+    OperationContext* opCtx) {
+    return std::make_unique<BulkBuilder>(*this, opCtx);
+}
+
+Status WiredTigerColumnStore::compact(OperationContext* opCtx) {
+    dassert(opCtx->lockState()->isWriteLocked());
+    WiredTigerSessionCache* cache = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache();
+    if (!cache->isEphemeral()) {
+        WT_SESSION* s = WiredTigerRecoveryUnit::get(opCtx)->getSession()->getSession();
+        opCtx->recoveryUnit()->abandonSnapshot();
+        int ret = s->compact(s, uri().c_str(), "timeout=0");
+        if (ret == EBUSY) {
+            return Status(ErrorCodes::Interrupted,
+                          str::stream() << "Compaction interrupted on " << uri().c_str()
+                                        << " due to cache eviction pressure");
+        }
+        invariantWTOK(ret, s);
+    }
+    return Status::OK();
+}
+
+void WiredTigerColumnStore::fullValidate(OperationContext* opCtx,
+                                         int64_t* numKeysOut,
+                                         IndexValidateResults* fullResults) const {
+    dassert(opCtx->lockState()->isReadLocked());
+    if (fullResults && !WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->isEphemeral()) {
+        int err = WiredTigerUtil::verifyTable(opCtx, _uri, &(fullResults->errors));
+        if (err == EBUSY) {
+            std::string msg = str::stream()
+                << "Could not complete validation of " << _uri << ". "
+                << "This is a transient issue as the collection was actively "
+                   "in use by other operations.";
+
+            LOGV2_WARNING(6610105,
+                          "Could not complete validation. This is a transient issue as "
+                          "the collection was actively in use by other operations",
+                          "uri"_attr = _uri);
+            fullResults->warnings.push_back(msg);
+        } else if (err) {
+            std::string msg = str::stream()
+                << "verify() returned " << wiredtiger_strerror(err) << ". "
+                << "This indicates structural damage. "
+                << "Not examining individual column store entries.";
+            LOGV2_ERROR(6610106,
+                        "verify() returned an error. This indicates structural damage. Not "
+                        "examining individual column store entries.",
+                        "error"_attr = wiredtiger_strerror(err));
+            fullResults->errors.push_back(msg);
+            fullResults->valid = false;
+            return;
+        }
+    }
+
+    // Every key must decode to a path and a valid RecordId and keys must be strictly increasing.
+    // The latter is guaranteed by WiredTiger, so only the former is checked here.
+    auto cursor = newCursor(opCtx);
+    int64_t count = 0;
+    while (auto cell = cursor->next()) {
+        if (fullResults && !cell->rid.isValid()) {
+            fullResults->errors.push_back(str::stream()
+                                          << "Invalid RecordId " << cell->rid.toString()
+                                          << " for path " << cell->path << " in column store "
+                                          << _indexName);
+            fullResults->valid = false;
+        }
+        count++;
+    }
+    if (numKeysOut) {
+        *numKeysOut = count;
+    }
+}
+
+bool WiredTigerColumnStore::appendCustomStats(OperationContext* opCtx,
+                                              BSONObjBuilder* output,
+                                              double scale) const {
+    dassert(opCtx->lockState()->isReadLocked());
+    {
+        BSONObjBuilder metadata(output->subobjStart("metadata"));
+        Status status = WiredTigerUtil::getApplicationMetadata(opCtx, uri(), &metadata);
+        if (!status.isOK()) {
+            metadata.append("error", "unable to retrieve metadata");
+            metadata.append("code", static_cast<int>(status.code()));
+            metadata.append("reason", status.reason());
+        }
+    }
+    std::string type, sourceURI;
+    WiredTigerUtil::fetchTypeAndSourceURI(opCtx, _uri, &type, &sourceURI);
+    StatusWith<std::string> metadataResult = WiredTigerUtil::getMetadataCreate(opCtx, sourceURI);
+    StringData creationStringName("creationString");
+    if (!metadataResult.isOK()) {
+        BSONObjBuilder creationString(output->subobjStart(creationStringName));
+        creationString.append("error", "unable to retrieve creation config");
+        creationString.append("code", static_cast<int>(metadataResult.getStatus().code()));
+        creationString.append("reason", metadataResult.getStatus().reason());
+    } else {
+        output->append(creationStringName, metadataResult.getValue());
+        output->append("type", type);
+    }
+
+    WiredTigerSession* session = WiredTigerRecoveryUnit::get(opCtx)->getSession();
+    WT_SESSION* s = session->getSession();
+    Status status =
+        WiredTigerUtil::exportTableToBSON(s, "statistics:" + uri(), "statistics=(fast)", output);
+    if (!status.isOK()) {
+        output->append("error", "unable to retrieve statistics");
+        output->append("code", static_cast<int>(status.code()));
+        output->append("reason", status.reason());
+    }
+    return true;
+}
+
+long long WiredTigerColumnStore::getSpaceUsedBytes(OperationContext* opCtx) const {
+    dassert(opCtx->lockState()->isReadLocked());
+    WiredTigerSession* session = WiredTigerRecoveryUnit::get(opCtx)->getSession();
+    return static_cast<long long>(WiredTigerUtil::getIdentSize(session->getSession(), _uri));
+}
+
+long long WiredTigerColumnStore::getFreeStorageBytes(OperationContext* opCtx) const {
+    dassert(opCtx->lockState()->isReadLocked());
+    WiredTigerSession* session = WiredTigerRecoveryUnit::get(opCtx)->getSessionNoTxn();
+    return static_cast<long long>(WiredTigerUtil::getIdentReuseSize(session->getSession(), _uri));
+}
+
+bool WiredTigerColumnStore::isEmpty(OperationContext* opCtx) {
+    WiredTigerCursor curwrap(_uri, _tableId, false, opCtx);
+    WT_CURSOR* c = curwrap.get();
+    if (!c)
+        return true;
+    int ret = wiredTigerPrepareConflictRetry(opCtx, [&] { return c->next(c); });
+    if (ret == WT_NOTFOUND)
+        return true;
+    invariantWTOK(ret, c->session);
+    return false;
+}
+
+}  // namespace mongo
@@ -0,0 +1,135 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <wiredtiger.h>
+
+#include "mongo/base/status_with.h"
+#include "mongo/db/storage/column_store.h"
+
+namespace mongo {
+
+class IndexDescriptor;
+class NamespaceString;
+
+/**
+ * A ColumnStore backed by a single WiredTiger table. Every cell is stored under a key made of the
+ * path, a 0 byte, and the RecordId encoded so that byte-wise comparison of keys orders them first
+ * by path and then by RecordId. This keeps all cells for a path contiguous so that a scan over a
+ * handful of paths only reads the pages holding those paths.
+ *
+ * Only the storage layer is implemented: column stores are reachable through
+ * KVEngine::createColumnStore() and KVEngine::getColumnStore(), but there is no columnstore index
+ * type, access method or OpObserver wiring that would maintain one for a collection.
+ */
+class WiredTigerColumnStore final : public ColumnStore {
+public:
+    /**
+     * Creates a configuration string suitable for 'config' parameter in WT_SESSION::create().
+     * Uses the same user-provided index options as WiredTigerIndex::generateCreateString().
+     */
+    static StatusWith<std::string> generateCreateString(const std::string& engineName,
+                                                        const std::string& sysIndexConfig,
+                                                        const std::string& collIndexConfig,
+                                                        const NamespaceString& collectionNamespace,
+                                                        const IndexDescriptor& desc);
+
+    /**
+     * Creates a WiredTiger table suitable for implementing a column store.
+     * 'config' should be created with generateCreateString().
+     */
+    static Status create(OperationContext* opCtx,
+                         const std::string& uri,
+                         const std::string& config);
+
+    /**
+     * Builds the WiredTiger key for the cell at ('path', 'rid') into 'buffer' and returns it. A
+     * null 'rid' produces the smallest possible key for 'path', suitable for seeking.
+     */
+    static std::string& makeKey(std::string& buffer, PathView path, const RecordId& rid);
+
+    /**
+     * Inverse of makeKey().
+     */
+    static std::pair<PathView, RecordId> decodeKey(StringData key);
+
+    WiredTigerColumnStore(OperationContext* ctx,
+                          const std::string& uri,
+                          StringData ident,
+                          const IndexDescriptor* desc,
+                          bool isReadOnly = false);
+
+    std::unique_ptr<ColumnStore::WriteCursor> newWriteCursor(OperationContext*) override;
+    void insert(OperationContext*, PathView, RecordId, CellView) override;
+    void remove(OperationContext*, PathView, RecordId) override;
+    void update(OperationContext*, PathView, RecordId, CellView) override;
+    std::unique_ptr<ColumnStore::Cursor> newCursor(OperationContext*) const override;
+    using ColumnStore::newCursor;
+
+    std::unique_ptr<ColumnStore::BulkBuilder> makeBulkBuilder(OperationContext* opCtx) override;
+
+    Status compact(OperationContext* opCtx) override;
+    void fullValidate(OperationContext* opCtx,
+                      int64_t* numKeysOut,
+                      IndexValidateResults* fullResults) const override;
+
+    bool appendCustomStats(OperationContext* opCtx,
+                           BSONObjBuilder* output,
+                           double scale) const override;
+
+    long long getSpaceUsedBytes(OperationContext* opCtx) const override;
+    long long getFreeStorageBytes(OperationContext* opCtx) const override;
+
+    bool isEmpty(OperationContext* opCtx) override;
+
+    const std::string& uri() const {
+        return _uri;
+    }
+
+    uint64_t tableId() const {
+        return _tableId;
+    }
+
+    std::string indexName() const {
+        return _indexName;
+    }
+
+private:
+    class WriteCursor;
+    class Cursor;
+    class BulkBuilder;
+
+    const std::string _uri;
+    const uint64_t _tableId;
+    const IndexDescriptor* const _desc;
+    const std::string _indexName;
+};
+
+}  // namespace mongo
@@ -0,0 +1,258 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/operation_context_noop.h"
+#include "mongo/db/service_context_test_fixture.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_column_store.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_oplog_manager.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/db/storage/write_unit_of_work.h"
+#include "mongo/unittest/temp_dir.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/system_clock_source.h"
+
+namespace mongo {
+namespace {
+
+class WiredTigerColumnStoreTest : public ServiceContextTest {
+public:
+    WiredTigerColumnStoreTest() : _dbpath("wt_test") {
+        const char* config = "create,cache_size=1G,";
+        int ret = wiredtiger_open(_dbpath.path().c_str(), nullptr, config, &_conn);
+        invariantWTOK(ret, nullptr);
+
+        _fastClockSource = std::make_unique<SystemClockSource>();
+        _sessionCache = std::make_unique<WiredTigerSessionCache>(_conn, _fastClockSource.get());
+
+        WiredTigerUtil::notifyStartupComplete();
+
+        BSONObj spec = BSON("key" << BSON("$**"
+                                          << "columnstore")
+                                  << "name"
+                                  << "csi"
+                                  << "v" << static_cast<int>(IndexDescriptor::kLatestIndexVersion));
+        _desc = std::make_unique<IndexDescriptor>("", spec);
+
+        auto opCtx = newOperationContext();
+        auto result = WiredTigerColumnStore::generateCreateString(
+            kWiredTigerEngineName, "", "", NamespaceString("test.wt"), *_desc);
+        ASSERT_OK(result.getStatus());
+        ASSERT_OK(WiredTigerColumnStore::create(opCtx.get(), _uri, result.getValue()));
+        _cs = std::make_unique<WiredTigerColumnStore>(
+            opCtx.get(), _uri, "" /* ident */, _desc.get());
+    }
+
+    ~WiredTigerColumnStoreTest() {
+        _cs.reset();
+        _sessionCache.reset();
+        _conn->close(_conn, nullptr);
+
+        WiredTigerUtil::resetTableLoggingInfo();
+    }
+
+    std::unique_ptr<OperationContext> newOperationContext() {
+        return std::make_unique<OperationContextNoop>(
+            new WiredTigerRecoveryUnit(_sessionCache.get(), &_oplogManager));
+    }
+
+protected:
+    const std::string _uri = "table:test.wt.csi";
+    unittest::TempDir _dbpath;
+    WT_CONNECTION* _conn = nullptr;
+    std::unique_ptr<ClockSource> _fastClockSource;
+    std::unique_ptr<WiredTigerSessionCache> _sessionCache;
+    WiredTigerOplogManager _oplogManager;
+    std::unique_ptr<IndexDescriptor> _desc;
+    std::unique_ptr<WiredTigerColumnStore> _cs;
+};
+
+TEST(WiredTigerColumnStoreKeyTest, KeysOrderByPathThenRecordId) {
+    std::string lhs, rhs;
+
+    // A path sorts before any path it is a prefix of, regardless of the RecordId.
+    ASSERT_LT(WiredTigerColumnStore::makeKey(lhs, "a", RecordId(100)),
+              WiredTigerColumnStore::makeKey(rhs, "a.b", RecordId(1)));
+    ASSERT_LT(WiredTigerColumnStore::makeKey(lhs, "a", RecordId(100)),
+              WiredTigerColumnStore::makeKey(rhs, "a\x01", RecordId()));
+
+    // Within a path, keys follow signed RecordId order.
+    ASSERT_LT(WiredTigerColumnStore::makeKey(lhs, "a", RecordId(-5)),
+              WiredTigerColumnStore::makeKey(rhs, "a", RecordId(3)));
+    ASSERT_LT(WiredTigerColumnStore::makeKey(lhs, "a", RecordId(3)),
+              WiredTigerColumnStore::makeKey(rhs, "a", RecordId(256)));
+
+    // The null RecordId produces the smallest key for its path.
+    ASSERT_LT(WiredTigerColumnStore::makeKey(lhs, "a", RecordId()),
+              WiredTigerColumnStore::makeKey(rhs, "a", RecordId::minLong()));
+}
+
+TEST(WiredTigerColumnStoreKeyTest, DecodeRoundTrips) {
+    std::string buffer;
+    for (auto rid : {RecordId(1), RecordId(-7), RecordId::minLong(), RecordId::maxLong()}) {
+        auto [path, decoded] = WiredTigerColumnStore::decodeKey(
+            WiredTigerColumnStore::makeKey(buffer, "x.y.z", rid));
+        ASSERT_EQ(path, "x.y.z");
+        ASSERT_EQ(decoded, rid);
+    }
+}
+
+TEST_F(WiredTigerColumnStoreTest, InsertAndScanSinglePath) {
+    auto opCtx = newOperationContext();
+    ASSERT_TRUE(_cs->isEmpty(opCtx.get()));
+    {
+        WriteUnitOfWork wuow(opCtx.get());
+        _cs->insert(opCtx.get(), "a", RecordId(1), "one");
+        _cs->insert(opCtx.get(), "a", RecordId(2), "two");
+        _cs->insert(opCtx.get(), "a.b", RecordId(1), "nested");
+        _cs->insert(opCtx.get(), "b", RecordId(1), "other");
+        wuow.commit();
+    }
+    ASSERT_FALSE(_cs->isEmpty(opCtx.get()));
+
+    auto cursor = _cs->newCursor(opCtx.get(), "a");
+    auto cell = cursor->seekAtOrPast(RecordId());
+    ASSERT(cell);
+    ASSERT_EQ(cell->rid, RecordId(1));
+    ASSERT_EQ(cell->value, "one");
+    cell = cursor->next();
+    ASSERT(cell);
+    ASSERT_EQ(cell->rid, RecordId(2));
+    ASSERT_EQ(cell->value, "two");
+    ASSERT_FALSE(cursor->next());
+
+    cell = cursor->seekExact(RecordId(2));
+    ASSERT(cell);
+    ASSERT_EQ(cell->value, "two");
+    ASSERT_FALSE(cursor->seekExact(RecordId(3)));
+
+    ASSERT_TRUE(_cs->haveAnyWithPath(opCtx.get(), "a.b"));
+    ASSERT_FALSE(_cs->haveAnyWithPath(opCtx.get(), "c"));
+
+    auto paths = _cs->uniquePaths(opCtx.get());
+    ASSERT_EQ(paths.size(), 3U);
+    ASSERT_EQ(paths[0], "a");
+    ASSERT_EQ(paths[1], "a.b");
+    ASSERT_EQ(paths[2], "b");
+
+    int64_t numKeys = 0;
+    IndexValidateResults results;
+    _cs->fullValidate(opCtx.get(), &numKeys, &results);
+    ASSERT_EQ(numKeys, 4);
+    ASSERT_TRUE(results.valid);
+}
+
+TEST_F(WiredTigerColumnStoreTest, UpdateAndRemove) {
+    auto opCtx = newOperationContext();
+    {
+        WriteUnitOfWork wuow(opCtx.get());
+        auto writeCursor = _cs->newWriteCursor(opCtx.get());
+        writeCursor->insert("a", RecordId(1), "one");
+        writeCursor->insert("a", RecordId(2), "two");
+        writeCursor->update("a", RecordId(1), "uno");
+        writeCursor->remove("a", RecordId(2));
+        // Removing a missing cell is a no-op.
+        writeCursor->remove("a", RecordId(3));
+        wuow.commit();
+    }
+
+    auto cursor = _cs->newCursor(opCtx.get(), "a");
+    auto cell = cursor->seekAtOrPast(RecordId());
+    ASSERT(cell);
+    ASSERT_EQ(cell->rid, RecordId(1));
+    ASSERT_EQ(cell->value, "uno");
+    ASSERT_FALSE(cursor->next());
+}
+
+DEATH_TEST_F(WiredTigerColumnStoreTest,
+             UpdateOfMissingCellIsFatal,
+             "Column store update of a missing cell") {
+    auto opCtx = newOperationContext();
+    WriteUnitOfWork wuow(opCtx.get());
+    _cs->update(opCtx.get(), "a", RecordId(1), "one");
+}
+
+TEST_F(WiredTigerColumnStoreTest, RestoreAfterCurrentCellRemoved) {
+    auto opCtx = newOperationContext();
+    {
+        WriteUnitOfWork wuow(opCtx.get());
+        for (int i = 1; i <= 3; ++i) {
+            _cs->insert(opCtx.get(), "a", RecordId(i), "");
+        }
+        wuow.commit();
+    }
+
+    auto cursor = _cs->newCursor(opCtx.get(), "a");
+    ASSERT_EQ(cursor->seekAtOrPast(RecordId())->rid, RecordId(1));
+    cursor->save();
+    {
+        WriteUnitOfWork wuow(opCtx.get());
+        _cs->remove(opCtx.get(), "a", RecordId(1));
+        wuow.commit();
+    }
+    cursor->restore();
+
+    // The cell following the removed one must not be skipped.
+    auto cell = cursor->next();
+    ASSERT(cell);
+    ASSERT_EQ(cell->rid, RecordId(2));
+    cell = cursor->next();
+    ASSERT(cell);
+    ASSERT_EQ(cell->rid, RecordId(3));
+    ASSERT_FALSE(cursor->next());
+}
+
+TEST_F(WiredTigerColumnStoreTest, BulkBuild) {
+    auto opCtx = newOperationContext();
+    {
+        WriteUnitOfWork wuow(opCtx.get());
+        auto builder = _cs->makeBulkBuilder(opCtx.get());
+        builder->addCell("a", RecordId(1), "1");
+        builder->addCell("a", RecordId(2), "2");
+        builder->addCell(ColumnStore::kRowIdPath, RecordId(1), "");
+        builder->addCell(ColumnStore::kRowIdPath, RecordId(2), "");
+        builder.reset();
+        wuow.commit();
+    }
+
+    ASSERT_EQ(_cs->numEntries(opCtx.get()), 4);
+
+    auto cursor = _cs->newCursor(opCtx.get(), ColumnStore::kRowIdPath);
+    ASSERT_EQ(cursor->seekAtOrPast(RecordId())->rid, RecordId(1));
+    ASSERT_EQ(cursor->next()->rid, RecordId(2));
+    ASSERT_FALSE(cursor->next());
+}
+
+}  // namespace
+}  // namespace mongo
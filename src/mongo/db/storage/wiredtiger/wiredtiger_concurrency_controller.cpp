@@ -0,0 +1,88 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_concurrency_controller.h"
+
+#include <algorithm>
+
+namespace mongo {
+
+int WiredTigerConcurrencyController::adjust(int currentTickets,
+                                            const Sample& sample,
+                                            const Settings& settings) {
+    const int maxTickets = std::max(settings.minTickets, settings.maxTickets);
+    auto clamp = [&](int tickets) {
+        return std::clamp(tickets, settings.minTickets, maxTickets);
+    };
+
+    if (_isCacheUnderPressure(sample, settings)) {
+        // Throughput measured while eviction catches up is no baseline for probing.
+        _direction = Direction::kIncrease;
+        _lastThroughput = boost::none;
+        return clamp(static_cast<int>(currentTickets * kDecreaseFactor));
+    }
+
+    if (sample.queued == 0 || sample.elapsed <= Milliseconds(0)) {
+        // Tickets are not what limits throughput right now, so changing their number would not
+        // tell us anything.
+        _direction = Direction::kIncrease;
+        _lastThroughput = boost::none;
+        return clamp(currentTickets);
+    }
+
+    const double throughput =
+        sample.opsCompleted * 1000.0 / durationCount<Milliseconds>(sample.elapsed);
+    if (_lastThroughput) {
+        if (throughput < *_lastThroughput * (1 - kThroughputTolerance)) {
+            // The last step hurt throughput, so undo it.
+            _direction = _direction == Direction::kIncrease ? Direction::kDecrease
+                                                            : Direction::kIncrease;
+        } else if (throughput <= *_lastThroughput * (1 + kThroughputTolerance)) {
+            // The last step did not change throughput. More concurrency at the same throughput
+            // only means longer latency, so favor fewer tickets.
+            _direction = Direction::kDecrease;
+        }
+    }
+    _lastThroughput = throughput;
+
+    const int step = std::max(1, currentTickets / 16);
+    return clamp(_direction == Direction::kIncrease ? currentTickets + step
+                                                    : currentTickets - step);
+}
+
+bool WiredTigerConcurrencyController::_isCacheUnderPressure(const Sample& sample,
+                                                            const Settings& settings) {
+    return sample.cacheDirtyRatio > settings.cacheDirtyTrigger ||
+        sample.cacheFillRatio > settings.cacheFillTrigger ||
+        sample.appEvictionRatio > settings.appEvictionTrigger;
+}
+
+}  // namespace mongo
@@ -0,0 +1,105 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <boost/optional.hpp>
+
+#include "mongo/util/duration.h"
+
+namespace mongo {
+
+/**
+ * Decides how many tickets the storage engine should hand out, in the manner of TCP congestion
+ * control.
+ *
+ * While operations are queued for tickets, the controller probes for the concurrency level that
+ * maximizes the throughput of completed operations. It keeps stepping the number of tickets in one
+ * direction for as long as throughput improves. When growing the pool stops paying off, it steps
+ * back down, since extra concurrency at the same throughput only adds latency; when shrinking the
+ * pool starts costing throughput, it steps back up again.
+ *
+ * When the cache shows signs of eviction falling behind, the number of tickets is cut
+ * multiplicatively so that eviction can catch up before throughput collapses, and probing resumes
+ * from the reduced level.
+ *
+ * This class is not thread-safe.
+ */
+class WiredTigerConcurrencyController {
+public:
+    /**
+     * Statistics gathered over one sampling interval.
+     */
+    struct Sample {
+        // The number of operations which released their ticket during the interval.
+        long long opsCompleted = 0;
+        Milliseconds elapsed{0};
+        // The number of operations queued for a ticket at the end of the interval.
+        int queued = 0;
+        // The fractions of the cache which are in use and dirty.
+        double cacheFillRatio = 0;
+        double cacheDirtyRatio = 0;
+        // The fraction of the time spent holding tickets which application threads spent evicting
+        // pages instead of doing their own work.
+        double appEvictionRatio = 0;
+    };
+
+    struct Settings {
+        int minTickets = 5;
+        int maxTickets = 512;
+        double cacheDirtyTrigger = 0.15;
+        double cacheFillTrigger = 0.95;
+        double appEvictionTrigger = 0.1;
+    };
+
+    // The factor by which the number of tickets is cut when the cache is under pressure.
+    static constexpr double kDecreaseFactor = 0.75;
+
+    // Relative changes in throughput smaller than this are attributed to noise.
+    static constexpr double kThroughputTolerance = 0.05;
+
+    /**
+     * Returns the number of tickets to hand out until the next sample, given the current number of
+     * tickets and the statistics of the interval since the previous call.
+     */
+    int adjust(int currentTickets, const Sample& sample, const Settings& settings);
+
+private:
+    enum class Direction { kIncrease, kDecrease };
+
+    static bool _isCacheUnderPressure(const Sample& sample, const Settings& settings);
+
+    Direction _direction = Direction::kIncrease;
+
+    // The throughput in operations per second of the previous interval, if it can serve as a
+    // baseline for judging the last step.
+    boost::optional<double> _lastThroughput;
+};
+
+}  // namespace mongo
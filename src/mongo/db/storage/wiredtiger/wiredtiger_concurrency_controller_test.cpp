@@ -0,0 +1,125 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include "mongo/db/storage/wiredtiger/wiredtiger_concurrency_controller.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+using Sample = WiredTigerConcurrencyController::Sample;
+
+WiredTigerConcurrencyController::Settings settings() {
+    WiredTigerConcurrencyController::Settings settings;
+    settings.minTickets = 5;
+    settings.maxTickets = 512;
+    return settings;
+}
+
+Sample throughputSample(long long opsPerSecond, int queued = 10) {
+    Sample sample;
+    sample.opsCompleted = opsPerSecond;
+    sample.elapsed = Seconds(1);
+    sample.queued = queued;
+    return sample;
+}
+
+TEST(WiredTigerConcurrencyControllerTest, GrowsWhileThroughputImproves) {
+    WiredTigerConcurrencyController controller;
+    int tickets = 128;
+    long long throughput = 1000;
+    for (int i = 0; i < 5; ++i) {
+        const int newTickets = controller.adjust(tickets, throughputSample(throughput), settings());
+        ASSERT_GT(newTickets, tickets);
+        tickets = newTickets;
+        throughput += 200;
+    }
+}
+
+TEST(WiredTigerConcurrencyControllerTest, BacksOffWhenThroughputDrops) {
+    WiredTigerConcurrencyController controller;
+    int tickets = controller.adjust(128, throughputSample(1000), settings());
+    ASSERT_GT(tickets, 128);
+
+    // Growing the pool made things worse, so it shrinks again.
+    const int newTickets = controller.adjust(tickets, throughputSample(800), settings());
+    ASSERT_LT(newTickets, tickets);
+}
+
+TEST(WiredTigerConcurrencyControllerTest, ShrinksWhenMoreTicketsDoNotHelp) {
+    WiredTigerConcurrencyController controller;
+    int tickets = controller.adjust(128, throughputSample(1000), settings());
+    ASSERT_GT(tickets, 128);
+
+    // Throughput is flat, so the extra tickets only add latency.
+    const int newTickets = controller.adjust(tickets, throughputSample(1010), settings());
+    ASSERT_LT(newTickets, tickets);
+}
+
+TEST(WiredTigerConcurrencyControllerTest, HoldsWhenNothingIsQueued) {
+    WiredTigerConcurrencyController controller;
+    ASSERT_EQ(controller.adjust(128, throughputSample(1000, 0), settings()), 128);
+    ASSERT_EQ(controller.adjust(128, throughputSample(10, 0), settings()), 128);
+}
+
+TEST(WiredTigerConcurrencyControllerTest, CutsTicketsUnderCachePressure) {
+    WiredTigerConcurrencyController controller;
+
+    auto dirty = throughputSample(1000);
+    dirty.cacheDirtyRatio = 0.3;
+    ASSERT_EQ(controller.adjust(128, dirty, settings()), 96);
+
+    auto full = throughputSample(1000);
+    full.cacheFillRatio = 0.99;
+    ASSERT_EQ(controller.adjust(96, full, settings()), 72);
+
+    auto appEviction = throughputSample(1000);
+    appEviction.appEvictionRatio = 0.5;
+    ASSERT_EQ(controller.adjust(72, appEviction, settings()), 54);
+
+    // Probing resumes upwards once the cache is healthy again.
+    ASSERT_GT(controller.adjust(54, throughputSample(1000), settings()), 54);
+}
+
+TEST(WiredTigerConcurrencyControllerTest, StaysWithinBounds) {
+    WiredTigerConcurrencyController controller;
+
+    auto dirty = throughputSample(1000);
+    dirty.cacheDirtyRatio = 0.3;
+    ASSERT_EQ(controller.adjust(6, dirty, settings()), 5);
+    ASSERT_EQ(controller.adjust(5, dirty, settings()), 5);
+
+    ASSERT_EQ(controller.adjust(512, throughputSample(1000), settings()), 512);
+    ASSERT_EQ(controller.adjust(600, throughputSample(2000), settings()), 512);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -78,7 +78,9 @@
 #include "mongo/db/storage/storage_options.h"
 #include "mongo/db/storage/storage_parameters_gen.h"
 #include "mongo/db/storage/storage_repair_observer.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_column_store.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_cursor.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_concurrency_controller.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_customization_hooks.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_extensions.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_global_options.h"
@@ -328,6 +330,146 @@ Status OpenReadTransactionParam::setFromString(const std::string& str) {
     return _data->resize(num);
 }
 
+/**
+ * Periodically resizes the read and write ticket pools based on the throughput of completed
+ * operations and on the health of the WiredTiger cache. See WiredTigerConcurrencyController.
+ */
+class WiredTigerKVEngine::WiredTigerConcurrencyAdjuster : public BackgroundJob {
+public:
+    explicit WiredTigerConcurrencyAdjuster(WT_CONNECTION* conn)
+        : BackgroundJob(false /* deleteSelf */), _conn(conn) {}
+
+    virtual string name() const {
+        return "WTConcurrencyAdjuster";
+    }
+
+    virtual void run() {
+        ThreadClient tc(name(), getGlobalServiceContext());
+        LOGV2_DEBUG(6610801, 1, "starting {name} thread", "name"_attr = name());
+
+        WiredTigerSession session(_conn);
+        _readPool.lastTotalReleased = openReadTransaction.totalReleased();
+        _writePool.lastTotalReleased = openWriteTransaction.totalReleased();
+        _lastAppEvictionTime =
+            _getStatistic(session.getSession(), WT_STAT_CONN_APPLICATION_EVICT_TIME);
+        auto lastSampleTime = Date_t::now();
+
+        while (!_shuttingDown.load()) {
+            {
+                stdx::unique_lock<Latch> lock(_mutex);
+                MONGO_IDLE_THREAD_BLOCK;
+                _condvar.wait_for(
+                    lock,
+                    Milliseconds(gWiredTigerAdaptiveConcurrencyIntervalMillis.load())
+                        .toSystemDuration(),
+                    [&] { return _shuttingDown.load(); });
+            }
+            if (_shuttingDown.load()) {
+                break;
+            }
+
+            const auto now = Date_t::now();
+            _adjust(session.getSession(), now - lastSampleTime);
+            lastSampleTime = now;
+        }
+        LOGV2_DEBUG(6610802, 1, "stopping {name} thread", "name"_attr = name());
+    }
+
+    void shutdown() {
+        _shuttingDown.store(true);
+        {
+            stdx::unique_lock<Latch> lock(_mutex);
+            _condvar.notify_one();
+        }
+        wait();
+    }
+
+private:
+    struct TicketPool {
+        TicketPool(StringData name, TicketHolder* holder) : name(name), holder(holder) {}
+
+        const StringData name;
+        TicketHolder* const holder;
+        WiredTigerConcurrencyController controller;
+        long long lastTotalReleased = 0;
+    };
+
+    /**
+     * Returns the current value of a connection statistic, or 0 if it is not being collected.
+     */
+    static long long _getStatistic(WT_SESSION* session, int key) {
+        auto swValue = WiredTigerUtil::getStatisticsValue(session, "statistics:", "", key);
+        return swValue.isOK() ? swValue.getValue() : 0;
+    }
+
+    void _adjust(WT_SESSION* session, Milliseconds elapsed) {
+        WiredTigerConcurrencyController::Sample sample;
+        sample.elapsed = elapsed;
+
+        const double cacheMaxBytes = _getStatistic(session, WT_STAT_CONN_CACHE_BYTES_MAX);
+        if (cacheMaxBytes > 0) {
+            sample.cacheFillRatio =
+                _getStatistic(session, WT_STAT_CONN_CACHE_BYTES_INUSE) / cacheMaxBytes;
+            sample.cacheDirtyRatio =
+                _getStatistic(session, WT_STAT_CONN_CACHE_BYTES_DIRTY) / cacheMaxBytes;
+        }
+
+        // Attribute application eviction to all the tickets in use, as the read and write pools
+        // compete for the same cache.
+        const auto appEvictionTime = _getStatistic(session, WT_STAT_CONN_APPLICATION_EVICT_TIME);
+        const double ticketMicros = durationCount<Microseconds>(elapsed) *
+            std::max(openReadTransaction.used() + openWriteTransaction.used(), 1);
+        if (ticketMicros > 0) {
+            sample.appEvictionRatio = (appEvictionTime - _lastAppEvictionTime) / ticketMicros;
+        }
+        _lastAppEvictionTime = appEvictionTime;
+
+        WiredTigerConcurrencyController::Settings settings;
+        settings.minTickets = gWiredTigerAdaptiveConcurrencyMinTickets.load();
+        settings.maxTickets = gWiredTigerAdaptiveConcurrencyMaxTickets.load();
+        settings.cacheDirtyTrigger = gWiredTigerAdaptiveConcurrencyCacheDirtyTrigger.load();
+        settings.cacheFillTrigger = gWiredTigerAdaptiveConcurrencyCacheFillTrigger.load();
+        settings.appEvictionTrigger = gWiredTigerAdaptiveConcurrencyAppEvictionTrigger.load();
+
+        for (auto pool : {&_readPool, &_writePool}) {
+            const auto totalReleased = pool->holder->totalReleased();
+            sample.opsCompleted = totalReleased - pool->lastTotalReleased;
+            sample.queued = pool->holder->queued();
+            pool->lastTotalReleased = totalReleased;
+
+            const int currentTickets = pool->holder->outof();
+            const int newTickets = pool->controller.adjust(currentTickets, sample, settings);
+            if (newTickets == currentTickets) {
+                continue;
+            }
+
+            LOGV2_DEBUG(6610803,
+                        2,
+                        "Adjusting the number of tickets",
+                        "pool"_attr = pool->name,
+                        "from"_attr = currentTickets,
+                        "to"_attr = newTickets,
+                        "opsCompleted"_attr = sample.opsCompleted,
+                        "queued"_attr = sample.queued,
+                        "cacheFillRatio"_attr = sample.cacheFillRatio,
+                        "cacheDirtyRatio"_attr = sample.cacheDirtyRatio,
+                        "appEvictionRatio"_attr = sample.appEvictionRatio);
+            invariant(pool->holder->resize(newTickets));
+        }
+    }
+
+    WT_CONNECTION* const _conn;
+    AtomicWord<bool> _shuttingDown{false};
+
+    Mutex _mutex = MONGO_MAKE_LATCH("WiredTigerConcurrencyAdjuster::_mutex");  // protects _condvar
+    stdx::condition_variable _condvar;
+
+    // Only accessed by the adjuster thread.
+    TicketPool _readPool{"read"_sd, &openReadTransaction};
+    TicketPool _writePool{"write"_sd, &openWriteTransaction};
+    long long _lastAppEvictionTime = 0;
+};
+
 StringData WiredTigerKVEngine::kTableUriPrefix = "table:"_sd;
 
 WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
@@ -613,6 +755,11 @@ WiredTigerKVEngine::WiredTigerKVEngine(const std::string& canonicalName,
 
     Locker::setGlobalThrottling(&openReadTransaction, &openWriteTransaction);
 
+    if (gWiredTigerAdaptiveConcurrencyEnabled) {
+        _concurrencyAdjuster = std::make_unique<WiredTigerConcurrencyAdjuster>(_conn);
+        _concurrencyAdjuster->go();
+    }
+
     _runTimeConfigParam.reset(new WiredTigerEngineRuntimeConfigParameter(
         "wiredTigerEngineRuntimeConfig", ServerParameterType::kRuntimeOnly));
     _runTimeConfigParam->_data.second = this;
@@ -640,6 +787,11 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("out", openWriteTransaction.used());
         bbb.append("available", openWriteTransaction.available());
         bbb.append("totalTickets", openWriteTransaction.outof());
+        bbb.append("queued", openWriteTransaction.queued());
+        {
+            BSONObjBuilder priorities(bbb.subobjStart("priorities"));
+            openWriteTransaction.appendStats(priorities);
+        }
         bbb.done();
     }
     {
@@ -647,6 +799,11 @@ void WiredTigerKVEngine::appendGlobalStats(BSONObjBuilder& b) {
         bbb.append("out", openReadTransaction.used());
         bbb.append("available", openReadTransaction.available());
         bbb.append("totalTickets", openReadTransaction.outof());
+        bbb.append("queued", openReadTransaction.queued());
+        {
+            BSONObjBuilder priorities(bbb.subobjStart("priorities"));
+            openReadTransaction.appendStats(priorities);
+        }
         bbb.done();
     }
     bb.done();
@@ -756,6 +913,9 @@ void WiredTigerKVEngine::cleanShutdown() {
 
     // these must be the last things we do before _conn->close();
     haltOplogManager(/*oplogRecordStore=*/nullptr, /*shuttingDown=*/true);
+    if (_concurrencyAdjuster) {
+        _concurrencyAdjuster->shutdown();
+    }
     if (_sessionSweeper) {
         LOGV2(22318, "Shutting down session sweeper thread");
         _sessionSweeper->shutdown();
@@ -1687,6 +1847,52 @@ std::unique_ptr<SortedDataInterface> WiredTigerKVEngine::getSortedDataInterface(
         opCtx, _uri(ident), ident, keyFormat, desc, _readOnly);
 }
 
+Status WiredTigerKVEngine::createColumnStore(OperationContext* opCtx,
+                                             const CollectionOptions& collOptions,
+                                             StringData ident,
+                                             const IndexDescriptor* desc) {
+    _ensureIdentPath(ident);
+
+    std::string collIndexOptions;
+
+    if (auto storageEngineOptions = collOptions.indexOptionDefaults.getStorageEngine()) {
+        collIndexOptions =
+            dps::extractElementAtPath(*storageEngineOptions, _canonicalName + ".configString")
+                .str();
+    }
+    // Some unittests use a OperationContextNoop that can't support such lookups.
+    auto ns = collOptions.uuid
+        ? *CollectionCatalog::get(opCtx)->lookupNSSByUUID(opCtx, *collOptions.uuid)
+        : NamespaceString();
+
+    StatusWith<std::string> result = WiredTigerColumnStore::generateCreateString(
+        _canonicalName, _indexOptions, collIndexOptions, ns, *desc);
+    if (!result.isOK()) {
+        return result.getStatus();
+    }
+
+    std::string config = result.getValue();
+
+    LOGV2_DEBUG(6610107,
+                2,
+                "WiredTigerKVEngine::createColumnStore",
+                "collection_uuid"_attr = collOptions.uuid,
+                "ident"_attr = ident,
+                "config"_attr = config);
+    return WiredTigerColumnStore::create(opCtx, _uri(ident), config);
+}
+
+std::unique_ptr<ColumnStore> WiredTigerKVEngine::getColumnStore(
+    OperationContext* opCtx,
+    const CollectionOptions& collOptions,
+    StringData ident,
+    const IndexDescriptor* desc) {
+    uassert(ErrorCodes::InvalidOptions,
+            "Columnar indexes are not supported on clustered collections",
+            !collOptions.clusteredIndex);
+    return std::make_unique<WiredTigerColumnStore>(opCtx, _uri(ident), ident, desc, _readOnly);
+}
+
 std::unique_ptr<RecordStore> WiredTigerKVEngine::makeTemporaryRecordStore(OperationContext* opCtx,
                                                                           StringData ident,
                                                                           KeyFormat keyFormat) {
@@ -2585,22 +2791,22 @@ bool WiredTigerKVEngine::supportsOplogStones() const {
 void WiredTigerKVEngine::startOplogManager(OperationContext* opCtx,
                                            WiredTigerRecordStore* oplogRecordStore) {
     stdx::lock_guard<Latch> lock(_oplogManagerMutex);
-    // Halt visibility thread if running on previous record store
+    // Stop tracking visibility of the previous record store, if any.
     if (_oplogRecordStore) {
-        _oplogManager->haltVisibilityThread();
+        _oplogManager->halt();
     }
 
-    _oplogManager->startVisibilityThread(opCtx, oplogRecordStore);
+    _oplogManager->start(opCtx, oplogRecordStore);
     _oplogRecordStore = oplogRecordStore;
 }
 
 void WiredTigerKVEngine::haltOplogManager(WiredTigerRecordStore* oplogRecordStore,
                                           bool shuttingDown) {
     stdx::unique_lock<Latch> lock(_oplogManagerMutex);
-    // Halt the visibility thread if we're in shutdown or the request matches the current record
+    // Stop tracking oplog visibility if we're in shutdown or the request matches the current record
     // store.
     if (shuttingDown || _oplogRecordStore == oplogRecordStore) {
-        _oplogManager->haltVisibilityThread();
+        _oplogManager->halt();
         _oplogRecordStore = nullptr;
     }
 }
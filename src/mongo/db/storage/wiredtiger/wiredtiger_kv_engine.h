@@ -157,6 +157,16 @@ public:
         StringData ident,
         const IndexDescriptor* desc) override;
 
+    Status createColumnStore(OperationContext* opCtx,
+                             const CollectionOptions& collOptions,
+                             StringData ident,
+                             const IndexDescriptor* desc) override;
+
+    std::unique_ptr<ColumnStore> getColumnStore(OperationContext* opCtx,
+                                                const CollectionOptions& collOptions,
+                                                StringData ident,
+                                                const IndexDescriptor* desc) override;
+
     Status importRecordStore(OperationContext* opCtx,
                              StringData ident,
                              const BSONObj& storageMetadata,
@@ -282,19 +292,19 @@ public:
     void syncSizeInfo(bool sync) const;
 
     /*
-     * The oplog manager is always accessible, but this method will start the background thread to
-     * control oplog entry visibility for reads.
+     * The oplog manager is always accessible, but this method will start it controlling oplog
+     * entry visibility for reads.
      *
-     * On mongod, the background thread will be started when the oplog record store is created, and
-     * stopped when the oplog record store is destroyed. For unit tests, the background thread may
-     * be started and stopped multiple times as tests create and destroy the oplog record store.
+     * On mongod, the oplog manager will be started when the oplog record store is created, and
+     * stopped when the oplog record store is destroyed. For unit tests, the oplog manager may be
+     * started and stopped multiple times as tests create and destroy the oplog record store.
      */
     void startOplogManager(OperationContext* opCtx, WiredTigerRecordStore* oplogRecordStore);
     void haltOplogManager(WiredTigerRecordStore* oplogRecordStore, bool shuttingDown);
 
     /*
      * Always returns a non-nil pointer. However, the WiredTigerOplogManager may not have been
-     * initialized and its background refreshing thread may not be running.
+     * initialized and may not be running.
      *
      * A caller that wants to get the oplog read timestamp, or call
      * `waitForAllEarlierOplogWritesToBeVisible`, is advised to first see if the oplog manager is
@@ -375,6 +385,7 @@ public:
 
 private:
     class WiredTigerSessionSweeper;
+    class WiredTigerConcurrencyAdjuster;
 
     struct IdentToDrop {
         std::string uri;
@@ -468,6 +479,7 @@ private:
     const bool _keepDataHistory = true;
 
     std::unique_ptr<WiredTigerSessionSweeper> _sessionSweeper;
+    std::unique_ptr<WiredTigerConcurrencyAdjuster> _concurrencyAdjuster;
 
     std::string _rsOptions;
     std::string _indexOptions;
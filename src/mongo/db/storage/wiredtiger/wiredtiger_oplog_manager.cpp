@@ -39,20 +39,21 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/platform/mutex.h"
-#include "mongo/util/concurrency/idle_thread_block.h"
-#include "mongo/util/scopeguard.h"
+#include "mongo/util/concurrency/thread_name.h"
+#include "mongo/util/time_support.h"
 
 namespace mongo {
 
 MONGO_FAIL_POINT_DEFINE(WTPauseOplogVisibilityUpdateLoop);
 
-// Arbitrary. Using the storageGlobalParams.journalCommitIntervalMs default, which used to
-// dynamically control the visibility thread's delay back when the visibility thread also flushed
-// the journal.
+// How often operations waiting for oplog visibility query the all_durable timestamp themselves, in
+// case the visibility updates of the commits they wait for were left to another thread which found
+// nothing new, and how often the replayer of the updates suppressed by
+// WTPauseOplogVisibilityUpdateLoop checks whether the fail point has been released.
 const int kDelayMillis = 100;
 
-void WiredTigerOplogManager::startVisibilityThread(OperationContext* opCtx,
-                                                   WiredTigerRecordStore* oplogRecordStore) {
+void WiredTigerOplogManager::start(OperationContext* opCtx,
+                                   WiredTigerRecordStore* oplogRecordStore) {
     invariant(!_isRunning);
     // Prime the oplog read timestamp.
     std::unique_ptr<SeekableRecordCursor> reverseOplogCursor =
@@ -74,19 +75,14 @@ void WiredTigerOplogManager::startVisibilityThread(OperationContext* opCtx,
         setOplogReadTimestamp(Timestamp(StorageEngine::kMinimumTimestamp));
     }
 
-    // Need to obtain the mutex before starting the thread, as otherwise it may race ahead
-    // see _shuttingDown as true and quit prematurely.
     stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
-    _oplogVisibilityThread = stdx::thread(&WiredTigerOplogManager::_updateOplogVisibilityLoop,
-                                          this,
-                                          WiredTigerRecoveryUnit::get(opCtx)->getSessionCache(),
-                                          oplogRecordStore);
-
+    _kvEngine = WiredTigerRecoveryUnit::get(opCtx)->getSessionCache()->getKVEngine();
+    _oplogRecordStore = oplogRecordStore;
     _isRunning = true;
     _shuttingDown = false;
 }
 
-void WiredTigerOplogManager::haltVisibilityThread() {
+void WiredTigerOplogManager::halt() {
     {
         stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
         if (!_isRunning) {
@@ -95,8 +91,8 @@ void WiredTigerOplogManager::haltVisibilityThread() {
             // second call will be a no-op. Calling this on clean shutdown is necessary because the
             // oplog manager makes calls into WiredTiger to retrieve the all durable timestamp. Lock
             // Free Reads introduced shared collections which can offset when their respective
-            // destructors run. This created a scenario where the oplog manager visibility loop can
-            // be executed after the storage engine has shutdown.
+            // destructors run. This created a scenario where the oplog manager could update
+            // visibility after the storage engine has shutdown.
             return;
         }
 
@@ -104,18 +100,129 @@ void WiredTigerOplogManager::haltVisibilityThread() {
         _isRunning = false;
     }
 
-    if (_oplogVisibilityThread.joinable()) {
-        _oplogVisibilityThreadCV.notify_one();
-        _oplogVisibilityThread.join();
+    stdx::thread replayer;
+    {
+        stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
+        replayer = std::move(_suppressedUpdatesReplayer);
     }
+    if (replayer.joinable()) {
+        replayer.join();
+    }
+
+    // Wait out any visibility update which started before we stopped, as it may still use the
+    // storage engine and the oplog record store. Later ones see that we are no longer running.
+    stdx::lock_guard<Latch> updateLk(_oplogVisibilityUpdateMutex);
+    LOGV2(22372, "Stopped tracking oplog visibility.");
+
+    stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
+    _kvEngine = nullptr;
+    _oplogRecordStore = nullptr;
 }
 
 void WiredTigerOplogManager::triggerOplogVisibilityUpdate() {
+    _visibilityUpdatePending.store(true);
+
+    if (MONGO_unlikely(WTPauseOplogVisibilityUpdateLoop.shouldFail())) {
+        _replaySuppressedUpdatesWhenUnpaused();
+        return;
+    }
+
+    _processPendingVisibilityUpdates();
+}
+
+void WiredTigerOplogManager::_processPendingVisibilityUpdates() {
+    while (_visibilityUpdatePending.load()) {
+        // Whoever holds the mutex checks for pending updates again after releasing it, so we can
+        // leave ours to them instead of waiting.
+        stdx::unique_lock<Latch> updateLk(_oplogVisibilityUpdateMutex, stdx::try_to_lock);
+        if (!updateLk.owns_lock()) {
+            return;
+        }
+
+        // Clearing the flag before querying WiredTiger makes the query cover every commit which
+        // set it.
+        while (_visibilityUpdatePending.swap(false)) {
+            if (!_updateOplogVisibility(updateLk)) {
+                return;
+            }
+        }
+    }
+}
+
+bool WiredTigerOplogManager::_updateOplogVisibility(WithLock) {
+    WiredTigerKVEngine* kvEngine;
+    WiredTigerRecordStore* oplogRecordStore;
+    {
+        stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
+        if (!_isRunning || _shuttingDown) {
+            return false;
+        }
+        kvEngine = _kvEngine;
+        oplogRecordStore = _oplogRecordStore;
+    }
+
+    // Fetch the all_durable timestamp from the storage engine, which is guaranteed not to have
+    // any holes behind it in-memory.
+    const uint64_t newTimestamp = kvEngine->getAllDurableTimestamp().asULL();
+
+    // The newTimestamp may actually go backward during secondary batch application,
+    // where we commit data file changes separately from oplog changes, so ignore
+    // a non-incrementing timestamp.
+    if (newTimestamp <= _oplogReadTimestamp.load()) {
+        LOGV2_DEBUG(22373,
+                    2,
+                    "No new oplog entries became visible.",
+                    "aNoHolesOplogTimestamp"_attr = Timestamp(newTimestamp));
+        return true;
+    }
+
+    {
+        stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
+        // Publish the new timestamp value. Avoid going backward.
+        auto currentVisibleTimestamp = getOplogReadTimestamp();
+        if (newTimestamp > currentVisibleTimestamp) {
+            _setOplogReadTimestamp(lk, newTimestamp);
+        }
+    }
+
+    // Wake up any awaitData cursors and tell them more data might be visible now.
+    //
+    // We normally notify waiters on capped collection inserts/updates, but oplog entries will
+    // not become visible immediately upon insert, so we notify waiters here as well, when new
+    // oplog entries actually become visible to cursors.
+    oplogRecordStore->notifyCappedWaitersIfNeeded();
+    return true;
+}
+
+void WiredTigerOplogManager::_replaySuppressedUpdatesWhenUnpaused() {
     stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
-    if (!_triggerOplogVisibilityUpdate) {
-        _triggerOplogVisibilityUpdate = true;
-        _oplogVisibilityThreadCV.notify_one();
+    if (!_isRunning || _shuttingDown || _replayingSuppressedUpdates) {
+        return;
     }
+
+    // A previous replayer is done once it has reset the flag, so this does not wait on it.
+    if (_suppressedUpdatesReplayer.joinable()) {
+        _suppressedUpdatesReplayer.join();
+    }
+
+    _replayingSuppressedUpdates = true;
+    _suppressedUpdatesReplayer = stdx::thread([this] {
+        setThreadName("OplogVisibilityReplayer");
+        while (MONGO_unlikely(WTPauseOplogVisibilityUpdateLoop.shouldFail())) {
+            {
+                stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
+                if (_shuttingDown) {
+                    _replayingSuppressedUpdates = false;
+                    return;
+                }
+            }
+            sleepmillis(kDelayMillis);
+        }
+
+        _processPendingVisibilityUpdates();
+        stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
+        _replayingSuppressedUpdates = false;
+    });
 }
 
 void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
@@ -142,19 +249,7 @@ void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
     // Close transaction before we wait.
     opCtx->recoveryUnit()->abandonSnapshot();
 
-    stdx::unique_lock<Latch> lk(_oplogVisibilityStateMutex);
-
-    // Prevent any scheduled oplog visibility updates from being delayed for batching and blocking
-    // this wait excessively.
-    ++_opsWaitingForOplogVisibilityUpdate;
-    invariant(_opsWaitingForOplogVisibilityUpdate > 0);
-    ScopeGuard exitGuard([&] { --_opsWaitingForOplogVisibilityUpdate; });
-
-    // Out of order writes to the oplog always call triggerOplogVisibilityUpdate() on commit to
-    // prompt the OplogVisibilityThread to run and update the oplog visibility. We simply need to
-    // wait until all of the writes behind and including 'waitingFor' commit so there are no oplog
-    // holes.
-    opCtx->waitForConditionOrInterrupt(_oplogEntriesBecameVisibleCV, lk, [&] {
+    auto isVisible = [&] {
         auto newLatestVisibleTimestamp = getOplogReadTimestamp();
         if (newLatestVisibleTimestamp < currentLatestVisibleTimestamp) {
             LOGV2_DEBUG(22370,
@@ -179,89 +274,20 @@ void WiredTigerOplogManager::waitForAllEarlierOplogWritesToBeVisible(
                             Timestamp(currentLatestVisibleTimestamp));
         }
         return newLatestVisible >= waitingFor;
-    });
-}
-
-void WiredTigerOplogManager::_updateOplogVisibilityLoop(WiredTigerSessionCache* sessionCache,
-                                                        WiredTigerRecordStore* oplogRecordStore) {
-    Client::initThread("OplogVisibilityThread");
+    };
 
-    // This thread updates the oplog read timestamp, the timestamp used to read from the oplog with
-    // forward cursors. The timestamp is used to hide oplog entries that might be committed but have
-    // uncommitted entries behind them. This prevents cursors from seeing 'holes' in the oplog and
-    // consequently missing data that was not there yet when scanning went passed up to a later
-    // timestamp.
+    // Out of order writes to the oplog always call triggerOplogVisibilityUpdate() on commit, and
+    // the update following the commit which fills the last hole behind 'waitingFor' wakes us up.
+    // Whatever committed before we started waiting may not have been accounted for yet, so request
+    // an update ourselves.
     while (true) {
-        stdx::unique_lock<Latch> lk(_oplogVisibilityStateMutex);
-        {
-            MONGO_IDLE_THREAD_BLOCK;
-            _oplogVisibilityThreadCV.wait(
-                lk, [&] { return _shuttingDown || _triggerOplogVisibilityUpdate; });
-
-            // If we are not shutting down and nobody is actively waiting for the oplog to become
-            // visible, delay a bit to batch more requests into one update and reduce system load.
-            auto now = Date_t::now();
-            auto deadline = now + Milliseconds(kDelayMillis);
-
-            auto wakeUpEarlyForWaitersPredicate = [&] {
-                return _shuttingDown || _opsWaitingForOplogVisibilityUpdate ||
-                    oplogRecordStore->haveCappedWaiters();
-            };
-
-            // Check once a millisecond, up to the delay deadline, whether the delay should be
-            // preempted because of waiting callers or shutdown.
-            while (now < deadline &&
-                   !_oplogVisibilityThreadCV.wait_until(
-                       lk, now.toSystemTimePoint(), wakeUpEarlyForWaitersPredicate)) {
-                now += Milliseconds(1);
-            }
-        }
-
-        while (!_shuttingDown && MONGO_unlikely(WTPauseOplogVisibilityUpdateLoop.shouldFail())) {
-            lk.unlock();
-            sleepmillis(10);
-            lk.lock();
-        }
+        triggerOplogVisibilityUpdate();
 
-        if (_shuttingDown) {
-            LOGV2(22372, "Oplog visibility thread shutting down.");
+        stdx::unique_lock<Latch> lk(_oplogVisibilityStateMutex);
+        if (opCtx->waitForConditionOrInterruptFor(
+                _oplogEntriesBecameVisibleCV, lk, Milliseconds(kDelayMillis), isVisible)) {
             return;
         }
-
-        invariant(_triggerOplogVisibilityUpdate);
-        _triggerOplogVisibilityUpdate = false;
-
-        lk.unlock();
-
-        // Fetch the all_durable timestamp from the storage engine, which is guaranteed not to have
-        // any holes behind it in-memory.
-        const uint64_t newTimestamp = sessionCache->getKVEngine()->getAllDurableTimestamp().asULL();
-
-        // The newTimestamp may actually go backward during secondary batch application,
-        // where we commit data file changes separately from oplog changes, so ignore
-        // a non-incrementing timestamp.
-        if (newTimestamp <= _oplogReadTimestamp.load()) {
-            LOGV2_DEBUG(22373,
-                        2,
-                        "No new oplog entries became visible.",
-                        "aNoHolesOplogTimestamp"_attr = Timestamp(newTimestamp));
-            continue;
-        }
-
-        lk.lock();
-        // Publish the new timestamp value. Avoid going backward.
-        auto currentVisibleTimestamp = getOplogReadTimestamp();
-        if (newTimestamp > currentVisibleTimestamp) {
-            _setOplogReadTimestamp(lk, newTimestamp);
-        }
-        lk.unlock();
-
-        // Wake up any awaitData cursors and tell them more data might be visible now.
-        //
-        // We normally notify waiters on capped collection inserts/updates, but oplog entries will
-        // not become visible immediately upon insert, so we notify waiters here as well, when new
-        // oplog entries actually become visible to cursors.
-        oplogRecordStore->notifyCappedWaitersIfNeeded();
     }
 }
 
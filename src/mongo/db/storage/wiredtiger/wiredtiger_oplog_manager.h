@@ -37,14 +37,16 @@
 
 namespace mongo {
 
+class WiredTigerKVEngine;
 class WiredTigerRecordStore;
-class WiredTigerSessionCache;
 
 /**
  * Manages oplog visibility.
  *
- * On demand, queries WiredTiger's all_durable timestamp value and updates the oplog read timestamp.
- * This is done asynchronously on a thread that startVisibilityThread() will set up.
+ * Queries WiredTiger's all_durable timestamp value and updates the oplog read timestamp inline,
+ * on the threads of out-of-order oplog writes as they commit, without a hop through a background
+ * thread. Only one committer queries WiredTiger at a time. The others leave their update to it and
+ * return immediately, and it queries again on their behalf before it returns.
  *
  * The WT all_durable timestamp is the in-memory timestamp behind which there are no oplog holes
  * in-memory. Note, all_durable is the timestamp that has no holes in-memory, which may NOT be
@@ -64,10 +66,16 @@ public:
     ~WiredTigerOplogManager() {}
 
     /*
-     * Initializes the oplog read timestamp and start the update visibility thread.
+     * Initializes the oplog read timestamp and starts tracking oplog visibility for
+     * 'oplogRecordStore'.
      */
-    void startVisibilityThread(OperationContext* opCtx, WiredTigerRecordStore* oplogRecordStore);
-    void haltVisibilityThread();
+    void start(OperationContext* opCtx, WiredTigerRecordStore* oplogRecordStore);
+
+    /**
+     * Stops tracking oplog visibility. Waits for visibility updates which are in progress on other
+     * threads, so that the oplog record store is no longer accessed once this returns.
+     */
+    void halt();
 
     bool isRunning() {
         stdx::lock_guard<Latch> lk(_oplogVisibilityStateMutex);
@@ -75,7 +83,13 @@ public:
     }
 
     /**
-     * Signals the oplog visibility thread to update the oplog read timestamp.
+     * Advances the oplog read timestamp to WiredTiger's current all_durable timestamp. Called after
+     * each out-of-order oplog write commits, so that the oplog becomes visible up to the latest
+     * write as soon as the last oplog hole is filled.
+     *
+     * Never blocks: if another caller is already querying WiredTiger, the update is left to that
+     * caller, which queries again once it is done. While WTPauseOplogVisibilityUpdateLoop is
+     * active, updates are suppressed and replayed once it is released.
      */
     void triggerOplogVisibilityUpdate();
 
@@ -99,21 +113,27 @@ public:
     void setOplogReadTimestamp(Timestamp ts);
 
 private:
+    void _setOplogReadTimestamp(WithLock, uint64_t newTimestamp);
+
     /**
-     * Runs the oplog visibility updates when signaled by triggerOplogVisibilityUpdate() until
-     * _shuttingDown is set to true.
+     * Runs the pending visibility updates unless another thread is already running them.
      */
-    void _updateOplogVisibilityLoop(WiredTigerSessionCache* sessionCache,
-                                    WiredTigerRecordStore* oplogRecordStore);
-
-    void _setOplogReadTimestamp(WithLock, uint64_t newTimestamp);
+    void _processPendingVisibilityUpdates();
 
-    AtomicWord<unsigned long long> _oplogReadTimestamp{0};
+    /**
+     * Queries the all_durable timestamp and advances the oplog read timestamp to it. Must be called
+     * with _oplogVisibilityUpdateMutex held. Returns false if the oplog manager is not running.
+     */
+    bool _updateOplogVisibility(WithLock);
 
-    stdx::thread _oplogVisibilityThread;
+    /**
+     * Starts a thread which waits for WTPauseOplogVisibilityUpdateLoop to be released and then runs
+     * the updates which were suppressed while it was active, unless such a thread is already
+     * waiting.
+     */
+    void _replaySuppressedUpdatesWhenUnpaused();
 
-    // Signaled to trigger the oplog visibility thread to run.
-    mutable stdx::condition_variable _oplogVisibilityThreadCV;
+    AtomicWord<unsigned long long> _oplogReadTimestamp{0};
 
     // Signaled when oplog visibility has been updated.
     mutable stdx::condition_variable _oplogEntriesBecameVisibleCV;
@@ -125,12 +145,22 @@ private:
     bool _isRunning = false;
     bool _shuttingDown = false;
 
-    // Triggers an oplog visibility update -- can be delayed if no callers are waiting for an
-    // update, per the _opsWaitingForOplogVisibility counter.
-    bool _triggerOplogVisibilityUpdate = false;
+    WiredTigerKVEngine* _kvEngine = nullptr;
+    WiredTigerRecordStore* _oplogRecordStore = nullptr;
+
+    // Set while the replayer of suppressed updates is waiting for WTPauseOplogVisibilityUpdateLoop
+    // to be released.
+    bool _replayingSuppressedUpdates = false;
+    stdx::thread _suppressedUpdatesReplayer;
+
+    // Held by the thread querying the all_durable timestamp. Other callers of
+    // triggerOplogVisibilityUpdate() only try to acquire it, so that commits never queue up behind
+    // each other's queries. Acquired before _oplogVisibilityStateMutex.
+    Mutex _oplogVisibilityUpdateMutex =
+        MONGO_MAKE_LATCH("WiredTigerOplogManager::_oplogVisibilityUpdateMutex");
 
-    // Incremented when a caller is waiting for more of the oplog to become visible, to avoid update
-    // delays for batching.
-    int64_t _opsWaitingForOplogVisibilityUpdate = 0;
+    // Set when a visibility update is requested, and cleared right before the all_durable query
+    // which covers the request.
+    AtomicWord<bool> _visibilityUpdatePending{false};
 };
 }  // namespace mongo
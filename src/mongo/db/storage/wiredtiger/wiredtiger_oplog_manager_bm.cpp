@@ -0,0 +1,105 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <benchmark/benchmark.h>
+
+#include "mongo/base/checked_cast.h"
+#include "mongo/db/storage/record_store.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_kv_engine.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_oplog_manager.h"
+#include "mongo/db/storage/wiredtiger/wiredtiger_record_store_test_harness.h"
+#include "mongo/platform/atomic_word.h"
+#include "mongo/unittest/unittest.h"
+
+namespace mongo {
+namespace {
+
+const int kMaxThreads = 16;
+
+// Shared by the threads of a benchmark run. Set up and torn down by the first thread, outside of
+// the timed loop, which all threads enter and leave together.
+std::unique_ptr<WiredTigerHarnessHelper> harnessHelper;
+std::unique_ptr<RecordStore> oplog;
+AtomicWord<unsigned> nextOplogInc{1};
+
+void setUpOplog(benchmark::State& state) {
+    if (state.thread_index == 0) {
+        harnessHelper = std::make_unique<WiredTigerHarnessHelper>();
+        oplog = harnessHelper->newOplogRecordStore();
+    }
+}
+
+void tearDownOplog(benchmark::State& state) {
+    if (state.thread_index == 0) {
+        oplog.reset();
+        harnessHelper.reset();
+    }
+}
+
+WiredTigerOplogManager* getOplogManager() {
+    return checked_cast<WiredTigerKVEngine*>(harnessHelper->getEngine())->getOplogManager();
+}
+
+// The cost of the visibility update which follows every out-of-order oplog commit, with that many
+// committing threads.
+void BM_TriggerOplogVisibilityUpdate(benchmark::State& state) {
+    setUpOplog(state);
+    for (auto _ : state) {
+        getOplogManager()->triggerOplogVisibilityUpdate();
+    }
+    tearDownOplog(state);
+}
+
+// Out-of-order oplog inserts committed by that many threads, including the visibility updates
+// they trigger.
+void BM_CommitOplogInsert(benchmark::State& state) {
+    setUpOplog(state);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto client = harnessHelper->serviceContext()->makeClient("committer");
+        auto opCtx = harnessHelper->newOperationContext(client.get());
+        const Timestamp ts(1, nextOplogInc.fetchAndAdd(1));
+        const BSONObj obj = BSON("ts" << ts);
+        state.ResumeTiming();
+
+        WriteUnitOfWork wuow(opCtx.get());
+        ASSERT_OK(oplog->oplogDiskLocRegister(opCtx.get(), ts, false));
+        ASSERT_OK(oplog->insertRecord(opCtx.get(), obj.objdata(), obj.objsize(), ts).getStatus());
+        wuow.commit();
+    }
+    tearDownOplog(state);
+}
+
+BENCHMARK(BM_TriggerOplogVisibilityUpdate)->ThreadRange(1, kMaxThreads);
+BENCHMARK(BM_CommitOplogInsert)->ThreadRange(1, kMaxThreads);
+
+}  // namespace
+}  // namespace mongo
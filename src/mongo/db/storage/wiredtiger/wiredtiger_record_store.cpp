@@ -1008,8 +1008,8 @@ void WiredTigerRecordStore::checkSize(OperationContext* opCtx) {
                            "ident"_attr = getIdent());
         sizeRecoveryState(getGlobalServiceContext())
             .markCollectionAsAlwaysNeedsSizeAdjustment(getIdent());
-        _sizeInfo->dataSize.store(0);
-        _sizeInfo->numRecords.store(0);
+        _sizeInfo->setDataSize(0);
+        _sizeInfo->setNumRecords(0);
     }
 
     if (_sizeStorer)
@@ -1056,11 +1056,12 @@ bool WiredTigerRecordStore::inShutdown() const {
 }
 
 long long WiredTigerRecordStore::dataSize(OperationContext* opCtx) const {
-    return _sizeInfo->dataSize.load();
+    auto dataSize = _sizeInfo->dataSize();
+    return dataSize > 0 ? dataSize : 0;
 }
 
 long long WiredTigerRecordStore::numRecords(OperationContext* opCtx) const {
-    auto numRecords = _sizeInfo->numRecords.load();
+    auto numRecords = _sizeInfo->numRecords();
     return numRecords > 0 ? numRecords : 0;
 }
 
@@ -1233,8 +1234,31 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayT
             WiredTigerCursor cwrap(_uri, _tableId, true, opCtx);
             WT_CURSOR* cursor = cwrap.get();
 
+            // Previously truncated ranges leave deleted records at the start of the table until
+            // WiredTiger reclaims their pages. Walking over them from the start of the table on
+            // every truncation is costly on a busy oplog, so position the cursors at the previous
+            // truncation point instead, if there is one. Overlapping stones that end before it are
+            // still truncated from the start of the table.
+            boost::optional<CursorKey> truncateFromKey;
+            if (!_oplogStones->firstRecord.isNull() &&
+                _oplogStones->firstRecord < stone->lastRecord) {
+                truncateFromKey = makeCursorKey(_oplogStones->firstRecord, _keyFormat);
+            }
+
             // The first record in the oplog should be within the truncate range.
-            int ret = wiredTigerPrepareConflictRetry(opCtx, [&] { return cursor->next(cursor); });
+            int ret;
+            if (truncateFromKey) {
+                setKey(cursor, &*truncateFromKey);
+                int cmp;
+                ret = wiredTigerPrepareConflictRetry(
+                    opCtx, [&] { return cursor->search_near(cursor, &cmp); });
+                if (ret == 0 && cmp <= 0) {
+                    ret = wiredTigerPrepareConflictRetry(opCtx,
+                                                         [&] { return cursor->next(cursor); });
+                }
+            } else {
+                ret = wiredTigerPrepareConflictRetry(opCtx, [&] { return cursor->next(cursor); });
+            }
             invariantWTOK(ret, cursor->session);
             RecordId firstRecord = getKey(cursor);
             if (firstRecord < _oplogStones->firstRecord || firstRecord > stone->lastRecord) {
@@ -1287,7 +1311,17 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayT
             // current stone's lastRecord.
             invariantWTOK(cursor->reset(cursor), cursor->session);
             setKey(cursor, &truncateUpToKey);
-            invariantWTOK(session->truncate(session, nullptr, nullptr, cursor, nullptr), session);
+
+            // WiredTiger starts the truncation at the first record after the start cursor's key,
+            // if that key no longer exists.
+            boost::optional<WiredTigerCursor> startWrap;
+            WT_CURSOR* start = nullptr;
+            if (truncateFromKey) {
+                startWrap.emplace(_uri, _tableId, true, opCtx);
+                start = startWrap->get();
+                setKey(start, &*truncateFromKey);
+            }
+            invariantWTOK(session->truncate(session, nullptr, start, cursor, nullptr), session);
             _changeNumRecords(opCtx, -stone->records);
             _increaseDataSize(opCtx, -stone->bytes);
 
@@ -1312,8 +1346,8 @@ void WiredTigerRecordStore::reclaimOplog(OperationContext* opCtx, Timestamp mayT
     LOGV2(22402,
           "WiredTiger record store oplog truncation finished",
           "pinnedOplogTimestamp"_attr = mayTruncateUpTo,
-          "numRecords"_attr = _sizeInfo->numRecords.load(),
-          "dataSize"_attr = _sizeInfo->dataSize.load(),
+          "numRecords"_attr = _sizeInfo->numRecords(),
+          "dataSize"_attr = _sizeInfo->dataSize(),
           "duration"_attr = Milliseconds(elapsedMillis));
 }
 
@@ -1894,8 +1928,8 @@ void WiredTigerRecordStore::updateStatsAfterRepair(OperationContext* opCtx,
     sizeRecoveryState(getGlobalServiceContext())
         .markCollectionAsAlwaysNeedsSizeAdjustment(getIdent());
 
-    _sizeInfo->numRecords.store(std::max(numRecords, 0ll));
-    _sizeInfo->dataSize.store(std::max(dataSize, 0ll));
+    _sizeInfo->setNumRecords(std::max(numRecords, 0ll));
+    _sizeInfo->setDataSize(std::max(dataSize, 0ll));
 
     // If we have a WiredTigerSizeStorer, but our size info is not currently cached, add it.
     if (_sizeStorer)
@@ -1966,6 +2000,17 @@ void WiredTigerRecordStore::_initNextIdIfNeeded(OperationContext* opCtx) {
     _nextIdNum.store(nextId);
 }
 
+void WiredTigerRecordStore::reserveRecordIds(OperationContext* opCtx,
+                                             std::vector<RecordId>* out,
+                                             size_t nRecords) {
+    invariant(reserveRecordIdsSupported());
+    _initNextIdIfNeeded(opCtx);
+    int64_t nextId = _nextIdNum.fetchAndAdd(nRecords);
+    for (size_t i = 0; i < nRecords; i++) {
+        out->push_back(RecordId(nextId++));
+    }
+}
+
 RecordId WiredTigerRecordStore::_nextId(OperationContext* opCtx) {
     // Clustered record stores do not generate unique ObjectId's for RecordId's as the expectation
     // is for the caller to set the RecordId using the server generated ObjectId.
@@ -1989,9 +2034,9 @@ void WiredTigerRecordStore::_changeNumRecords(OperationContext* opCtx, int64_t d
     opCtx->recoveryUnit()->onRollback([this, diff]() {
         LOGV2_DEBUG(
             22404, 3, "WiredTigerRecordStore: rolling back NumRecordsChange", "diff"_attr = -diff);
-        _sizeInfo->numRecords.addAndFetch(-diff);
+        _sizeInfo->addNumRecords(-diff);
     });
-    _sizeInfo->numRecords.addAndFetch(diff);
+    _sizeInfo->addNumRecords(diff);
 }
 
 void WiredTigerRecordStore::_increaseDataSize(OperationContext* opCtx, int64_t amount) {
@@ -2007,15 +2052,14 @@ void WiredTigerRecordStore::_increaseDataSize(OperationContext* opCtx, int64_t a
         opCtx->recoveryUnit()->onRollback(
             [this, amount]() { _increaseDataSize(nullptr, -amount); });
 
-    if (_sizeInfo->dataSize.fetchAndAdd(amount) < 0)
-        _sizeInfo->dataSize.store(std::max(amount, int64_t(0)));
+    _sizeInfo->addDataSize(amount);
 
     if (_sizeStorer)
         _sizeStorer->store(_uri, _sizeInfo);
 }
 
 void WiredTigerRecordStore::setNumRecords(long long numRecords) {
-    _sizeInfo->numRecords.store(std::max(numRecords, 0ll));
+    _sizeInfo->setNumRecords(std::max(numRecords, 0ll));
 
     if (!_sizeStorer) {
         return;
@@ -2028,7 +2072,7 @@ void WiredTigerRecordStore::setNumRecords(long long numRecords) {
 }
 
 void WiredTigerRecordStore::setDataSize(long long dataSize) {
-    _sizeInfo->dataSize.store(std::max(dataSize, 0ll));
+    _sizeInfo->setDataSize(std::max(dataSize, 0ll));
 
     if (!_sizeStorer) {
         return;
@@ -154,6 +154,14 @@ public:
                                  std::vector<Record>* records,
                                  const std::vector<Timestamp>& timestamps);
 
+    virtual bool reserveRecordIdsSupported() const {
+        return _keyFormat == KeyFormat::Long && !_isOplog;
+    }
+
+    virtual void reserveRecordIds(OperationContext* opCtx,
+                                  std::vector<RecordId>* out,
+                                  size_t nRecords);
+
     virtual Status updateRecord(OperationContext* opCtx,
                                 const RecordId& recordId,
                                 const char* data,
@@ -471,7 +479,7 @@ protected:
 extern FailPoint WTWriteConflictException;
 extern FailPoint WTWriteConflictExceptionForReads;
 
-// Prevents oplog writes from becoming visible asynchronously. Once activated, new writes will not
+// Prevents oplog writes from becoming visible as they commit. Once activated, new writes will not
 // be seen by regular readers until deactivated. It is unspecified whether writes that commit before
 // activation will become visible while active.
 extern FailPoint WTPauseOplogVisibilityUpdateLoop;
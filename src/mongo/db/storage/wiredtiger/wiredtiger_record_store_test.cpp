@@ -311,6 +311,66 @@ TEST(WiredTigerRecordStoreTest, OplogDurableVisibilityOutOfOrder) {
     ASSERT(!wtrs->isOpHidden_forTest(id2));
 }
 
+// Test that the commit filling the last oplog hole makes all the entries behind it visible by the
+// time it returns, without anybody waiting for visibility.
+TEST(WiredTigerRecordStoreTest, OplogVisibilityAdvancesWhenHoleIsFilled) {
+    unique_ptr<RecordStoreHarnessHelper> harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newOplogRecordStore());
+
+    auto wtrs = checked_cast<WiredTigerRecordStore*>(rs.get());
+
+    ServiceContext::UniqueOperationContext longLivedOp(harnessHelper->newOperationContext());
+    WriteUnitOfWork uow(longLivedOp.get());
+    RecordId id1 = _oplogOrderInsertOplog(longLivedOp.get(), rs, 1);
+
+    RecordId id2;
+    {
+        auto innerClient = harnessHelper->serviceContext()->makeClient("inner");
+        ServiceContext::UniqueOperationContext opCtx(
+            harnessHelper->newOperationContext(innerClient.get()));
+        WriteUnitOfWork uow(opCtx.get());
+        id2 = _oplogOrderInsertOplog(opCtx.get(), rs, 2);
+        uow.commit();
+    }
+
+    // The uncommitted first entry is a hole which hides the second one.
+    ASSERT(wtrs->isOpHidden_forTest(id1));
+    ASSERT(wtrs->isOpHidden_forTest(id2));
+
+    uow.commit();
+
+    ASSERT(!wtrs->isOpHidden_forTest(id1));
+    ASSERT(!wtrs->isOpHidden_forTest(id2));
+}
+
+// Test that the visibility updates suppressed while WTPauseOplogVisibilityUpdateLoop is active are
+// replayed once it is released, without anybody waiting for visibility or committing again.
+TEST(WiredTigerRecordStoreTest, OplogVisibilityUpdatesReplayedWhenUnpaused) {
+    ON_BLOCK_EXIT([] { WTPauseOplogVisibilityUpdateLoop.setMode(FailPoint::off); });
+    WTPauseOplogVisibilityUpdateLoop.setMode(FailPoint::alwaysOn);
+
+    unique_ptr<RecordStoreHarnessHelper> harnessHelper(newRecordStoreHarnessHelper());
+    unique_ptr<RecordStore> rs(harnessHelper->newOplogRecordStore());
+
+    auto wtrs = checked_cast<WiredTigerRecordStore*>(rs.get());
+
+    RecordId id;
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+        WriteUnitOfWork uow(opCtx.get());
+        id = _oplogOrderInsertOplog(opCtx.get(), rs, 1);
+        uow.commit();
+    }
+    ASSERT(wtrs->isOpHidden_forTest(id));
+
+    WTPauseOplogVisibilityUpdateLoop.setMode(FailPoint::off);
+
+    for (int i = 0; wtrs->isOpHidden_forTest(id); ++i) {
+        ASSERT_LT(i, 1000) << "oplog entry still hidden after the fail point was released";
+        sleepmillis(10);
+    }
+}
+
 TEST(WiredTigerRecordStoreTest, AppendCustomStatsMetadata) {
     std::unique_ptr<RecordStoreHarnessHelper> harnessHelper = newRecordStoreHarnessHelper();
     unique_ptr<RecordStore> rs(harnessHelper->newRecordStore("a.b"));
@@ -836,6 +896,45 @@ TEST(WiredTigerRecordStoreTest, OplogStones_ReclaimStones) {
     }
 }
 
+// Verify that consecutive reclaims, which start truncating at the previous truncation point,
+// remove exactly the records of the truncated stones.
+TEST(WiredTigerRecordStoreTest, OplogStones_ReclaimStonesFromPreviousTruncationPoint) {
+    std::unique_ptr<RecordStoreHarnessHelper> harnessHelper = newRecordStoreHarnessHelper();
+    std::unique_ptr<RecordStore> rs(harnessHelper->newOplogRecordStore());
+
+    WiredTigerRecordStore* wtrs = static_cast<WiredTigerRecordStore*>(rs.get());
+    WiredTigerRecordStore::OplogStones* oplogStones = wtrs->oplogStones();
+
+    ASSERT_OK(wtrs->updateOplogSize(250));
+
+    oplogStones->setMinBytesPerStone(100);
+
+    {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+
+        for (int i = 1; i <= 5; i++) {
+            ASSERT_EQ(insertBSONWithSize(opCtx.get(), rs.get(), Timestamp(1, i), 100),
+                      RecordId(1, i));
+        }
+        ASSERT_EQ(5U, oplogStones->numStones());
+    }
+
+    // Truncate one stone at a time.
+    for (int i = 1; i <= 3; i++) {
+        ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+
+        wtrs->reclaimOplog(opCtx.get(), Timestamp(1, i + 1));
+
+        ASSERT_EQ(5 - i, rs->numRecords(opCtx.get()));
+        ASSERT_EQ(5U - i, oplogStones->numStones());
+
+        RecordData data;
+        for (int j = 1; j <= 5; j++) {
+            ASSERT_EQ(j > i, rs->findRecord(opCtx.get(), RecordId(1, j), &data));
+        }
+    }
+}
+
 // Verify that an oplog stone isn't created if it would cause the logical representation of the
 // records to not be in increasing order.
 TEST(WiredTigerRecordStoreTest, OplogStones_AscendingOrder) {
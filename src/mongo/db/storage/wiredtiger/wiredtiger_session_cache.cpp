@@ -33,8 +33,14 @@
 
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 
+#include <algorithm>
+#include <functional>
 #include <memory>
 
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
 #include "mongo/base/error_codes.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/global_settings.h"
@@ -45,6 +51,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
 #include "mongo/stdx/thread.h"
+#include "mongo/util/processinfo.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
@@ -207,6 +214,8 @@ WiredTigerSessionCache::WiredTigerSessionCache(WiredTigerKVEngine* engine)
       _conn(engine->getConnection()),
       _clockSource(_engine->getClockSource()),
       _shuttingDown(0),
+      _numPartitions(std::max(ProcessInfo::getNumCores(), 1U)),
+      _partitions(std::make_unique<SessionCachePartition[]>(_numPartitions)),
       _prepareCommitOrAbortCounter(0) {}
 
 WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource* cs)
@@ -214,6 +223,8 @@ WiredTigerSessionCache::WiredTigerSessionCache(WT_CONNECTION* conn, ClockSource*
       _conn(conn),
       _clockSource(cs),
       _shuttingDown(0),
+      _numPartitions(std::max(ProcessInfo::getNumCores(), 1U)),
+      _partitions(std::make_unique<SessionCachePartition[]>(_numPartitions)),
       _prepareCommitOrAbortCounter(0) {}
 
 WiredTigerSessionCache::~WiredTigerSessionCache() {
@@ -382,9 +393,12 @@ void WiredTigerSessionCache::notifyPreparedUnitOfWorkHasCommittedOrAborted() {
 
 
 void WiredTigerSessionCache::closeAllCursors(const std::string& uri) {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeAllCursors(uri);
+    for (size_t i = 0; i < _numPartitions; ++i) {
+        auto& partition = _partitions[i];
+        stdx::lock_guard<Latch> lock(partition.lock);
+        for (auto session : partition.sessions) {
+            session->closeAllCursors(uri);
+        }
     }
 }
 
@@ -392,15 +406,21 @@ void WiredTigerSessionCache::closeCursorsForQueuedDrops() {
     // Increment the cursor epoch so that all cursors from this epoch are closed.
     _cursorEpoch.fetchAndAdd(1);
 
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    for (SessionCache::iterator i = _sessions.begin(); i != _sessions.end(); i++) {
-        (*i)->closeCursorsForQueuedDrops(_engine);
+    for (size_t i = 0; i < _numPartitions; ++i) {
+        auto& partition = _partitions[i];
+        stdx::lock_guard<Latch> lock(partition.lock);
+        for (auto session : partition.sessions) {
+            session->closeCursorsForQueuedDrops(_engine);
+        }
     }
 }
 
 size_t WiredTigerSessionCache::getIdleSessionsCount() {
-    stdx::lock_guard<Latch> lock(_cacheLock);
-    return _sessions.size();
+    size_t count = 0;
+    for (size_t i = 0; i < _numPartitions; ++i) {
+        count += _partitions[i].numSessions.load();
+    }
+    return count;
 }
 
 void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
@@ -412,19 +432,21 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
     auto cutoffTime = _clockSource->now() - Milliseconds(idleTimeMillis);
     SessionCache sessionsToClose;
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
+    for (size_t i = 0; i < _numPartitions; ++i) {
+        auto& partition = _partitions[i];
+        stdx::lock_guard<Latch> lock(partition.lock);
         // Discard all sessions that became idle before the cutoff time
-        for (auto it = _sessions.begin(); it != _sessions.end();) {
+        for (auto it = partition.sessions.begin(); it != partition.sessions.end();) {
             auto session = *it;
             invariant(session->getIdleExpireTime() != Date_t::min());
             if (session->getIdleExpireTime() < cutoffTime) {
-                it = _sessions.erase(it);
+                it = partition.sessions.erase(it);
                 sessionsToClose.push_back(session);
             } else {
                 ++it;
             }
         }
+        partition.numSessions.store(partition.sessions.size());
     }
 
     // Closing expired idle sessions is expensive, so do it outside of the cache mutex. This helps
@@ -435,17 +457,24 @@ void WiredTigerSessionCache::closeExpiredIdleSessions(int64_t idleTimeMillis) {
 }
 
 void WiredTigerSessionCache::closeAll() {
-    // Increment the epoch as we are now closing all sessions with this epoch.
-    SessionCache swap;
-
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        _epoch.fetchAndAdd(1);
-        _sessions.swap(swap);
-    }
+    // Increment the epoch as we are now closing all sessions with this epoch. Sessions which are
+    // in use are closed when they are released, since releaseSession() rechecks the epoch under
+    // the lock of the partition it returns a session to, and we empty each partition after the
+    // epoch has been bumped.
+    _epoch.fetchAndAdd(1);
+
+    for (size_t i = 0; i < _numPartitions; ++i) {
+        auto& partition = _partitions[i];
+        SessionCache swap;
+        {
+            stdx::lock_guard<Latch> lock(partition.lock);
+            partition.sessions.swap(swap);
+            partition.numSessions.store(0);
+        }
 
-    for (SessionCache::iterator i = swap.begin(); i != swap.end(); i++) {
-        delete (*i);
+        for (auto session : swap) {
+            delete session;
+        }
     }
 }
 
@@ -458,13 +487,22 @@ UniqueWiredTigerSession WiredTigerSessionCache::getSession() {
     // operations should be allowed to start.
     invariant(!(_shuttingDown.loadRelaxed() & kShuttingDownMask));
 
-    {
-        stdx::lock_guard<Latch> lock(_cacheLock);
-        if (!_sessions.empty()) {
+    // Start with the partition of the current CPU, and only look at the other ones if it has no
+    // session to offer.
+    const size_t home = _getCurrentPartitionIndex();
+    for (size_t i = 0; i < _numPartitions; ++i) {
+        auto& partition = _partitions[(home + i) % _numPartitions];
+        if (partition.numSessions.load() == 0) {
+            continue;
+        }
+
+        stdx::lock_guard<Latch> lock(partition.lock);
+        if (!partition.sessions.empty()) {
             // Get the most recently used session so that if we discard sessions, we're
             // discarding older ones
-            WiredTigerSession* cachedSession = _sessions.back();
-            _sessions.pop_back();
+            WiredTigerSession* cachedSession = partition.sessions.back();
+            partition.sessions.pop_back();
+            partition.numSessions.store(partition.sessions.size());
             // Reset the idle time
             cachedSession->setIdleExpireTime(Date_t::min());
             return UniqueWiredTigerSession(cachedSession);
@@ -526,10 +564,12 @@ void WiredTigerSessionCache::releaseSession(WiredTigerSession* session) {
     session->setIdleExpireTime(_clockSource->now());
 
     if (session->_getEpoch() == currentEpoch) {  // check outside of lock to reduce contention
-        stdx::lock_guard<Latch> lock(_cacheLock);
+        auto& partition = _partitions[_getCurrentPartitionIndex()];
+        stdx::lock_guard<Latch> lock(partition.lock);
         if (session->_getEpoch() == _epoch.load()) {  // recheck inside the lock for correctness
             returnedToCache = true;
-            _sessions.push_back(session);
+            partition.sessions.push_back(session);
+            partition.numSessions.store(partition.sessions.size());
         }
     } else
         invariant(session->_getEpoch() < currentEpoch);
@@ -552,6 +592,16 @@ void WiredTigerSessionCache::setJournalListener(JournalListener* jl) {
     _journalListener = jl;
 }
 
+size_t WiredTigerSessionCache::_getCurrentPartitionIndex() const {
+#if defined(__linux__)
+    const int cpu = sched_getcpu();
+    if (cpu >= 0) {
+        return static_cast<size_t>(cpu) % _numPartitions;
+    }
+#endif
+    return std::hash<stdx::thread::id>()(stdx::this_thread::get_id()) % _numPartitions;
+}
+
 bool WiredTigerSessionCache::isEngineCachingCursors() {
     return gWiredTigerCursorCacheSize.load() <= 0;
 }
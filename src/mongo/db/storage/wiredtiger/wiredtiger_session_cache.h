@@ -30,7 +30,9 @@
 #pragma once
 
 #include <list>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <wiredtiger.h>
 
@@ -38,6 +40,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_snapshot_manager.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/new.h"
 #include "mongo/util/concurrency/spin_lock.h"
 
 namespace mongo {
@@ -209,6 +212,13 @@ private:
 /**
  *  This cache implements a shared pool of WiredTiger sessions with the goal to amortize the
  *  cost of session creation and destruction over multiple uses.
+ *
+ *  The pool is split into one partition per CPU, each with its own mutex, so that threads running
+ *  on different CPUs do not contend on the same lock and cache line. Sessions are taken from and
+ *  returned to the partition of the CPU the calling thread runs on, which also tends to hand a
+ *  thread a session whose cached cursors are still warm in that CPU's caches. Invalidating all
+ *  sessions or cursors bumps an epoch, which makes releasing threads discard the affected sessions,
+ *  rather than requiring a lock that covers the whole cache.
  */
 class WiredTigerSessionCache {
 public:
@@ -379,9 +389,20 @@ private:
     AtomicWord<unsigned> _shuttingDown;
     static const uint32_t kShuttingDownMask = 1 << 31;
 
-    Mutex _cacheLock = MONGO_MAKE_LATCH("WiredTigerSessionCache::_cacheLock");
     typedef std::vector<WiredTigerSession*> SessionCache;
-    SessionCache _sessions;
+
+    // This alignment is a best effort approach to ensure that each partition falls on a separate
+    // cache line in order to avoid false sharing.
+    struct alignas(stdx::hardware_destructive_interference_size) SessionCachePartition {
+        Mutex lock = MONGO_MAKE_LATCH("WiredTigerSessionCache::SessionCachePartition::lock");
+        SessionCache sessions;
+        // The size of 'sessions', which may be read without holding 'lock' in order to skip
+        // empty partitions.
+        AtomicWord<size_t> numSessions{0};
+    };
+
+    const size_t _numPartitions;
+    std::unique_ptr<SessionCachePartition[]> _partitions;
 
     // Bumped when all open sessions need to be closed
     AtomicWord<unsigned long long> _epoch;  // atomic so we can check it outside of the lock
@@ -418,6 +439,12 @@ private:
      * session and releasing it, the session is directly released. This method is thread safe.
      */
     void releaseSession(WiredTigerSession* session);
+
+    /**
+     * Returns the index of the partition which belongs to the CPU the calling thread is running
+     * on.
+     */
+    size_t _getCurrentPartitionIndex() const;
 };
 
 /**
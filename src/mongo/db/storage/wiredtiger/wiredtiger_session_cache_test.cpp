@@ -31,11 +31,13 @@
 
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "mongo/base/string_data.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_cursor.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/temp_dir.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/system_clock_source.h"
@@ -114,4 +116,58 @@ TEST(WiredTigerSessionCacheTest, CheckSessionCacheCleanup) {
     ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
 }
 
+TEST(WiredTigerSessionCacheTest, CloseAllDiscardsSessionsInUseOnRelease) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+
+    UniqueWiredTigerSession inUse = sessionCache->getSession();
+    sessionCache->getSession().reset();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 1U);
+
+    sessionCache->closeAll();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+
+    // The session predates closeAll, so it is closed rather than cached.
+    inUse.reset();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+
+    sessionCache->getSession().reset();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 1U);
+}
+
+TEST(WiredTigerSessionCacheTest, SessionsAreSharedAcrossThreads) {
+    WiredTigerSessionCacheHarnessHelper harnessHelper("");
+    WiredTigerSessionCache* sessionCache = harnessHelper.getSessionCache();
+
+    const size_t kNumThreads = 8;
+    std::vector<stdx::thread> threads;
+    for (size_t i = 0; i < kNumThreads; ++i) {
+        threads.emplace_back([sessionCache] {
+            for (int j = 0; j < 1000; ++j) {
+                sessionCache->getSession().reset();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Every thread held at most one session at a time, and sessions found in any partition are
+    // reused before a new one is created.
+    const auto idleSessions = sessionCache->getIdleSessionsCount();
+    ASSERT_GTE(idleSessions, 1U);
+    ASSERT_LTE(idleSessions, kNumThreads);
+
+    // Sessions released on other threads, and hence possibly to other partitions, are handed out
+    // on this one.
+    std::vector<UniqueWiredTigerSession> sessions;
+    for (size_t i = 0; i < idleSessions; ++i) {
+        sessions.push_back(sessionCache->getSession());
+    }
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), 0U);
+
+    sessions.clear();
+    ASSERT_EQUALS(sessionCache->getIdleSessionsCount(), idleSessions);
+}
+
 }  // namespace mongo
@@ -33,6 +33,10 @@
 
 #include <wiredtiger.h>
 
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
 #include "mongo/bson/bsonobj.h"
 #include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/service_context.h"
@@ -43,10 +47,97 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
 #include "mongo/logv2/log.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/util/scopeguard.h"
 
 namespace mongo {
 
+long long WiredTigerSizeStorer::SizeInfo::numRecords() const {
+    long long total = _numRecords.load();
+    if (auto stripes = _stripes.load()) {
+        for (const auto& stripe : *stripes) {
+            total += stripe.numRecords.load();
+        }
+    }
+    return total;
+}
+
+long long WiredTigerSizeStorer::SizeInfo::dataSize() const {
+    long long total = _dataSize.load();
+    if (auto stripes = _stripes.load()) {
+        for (const auto& stripe : *stripes) {
+            total += stripe.dataSize.load();
+        }
+    }
+    return total;
+}
+
+void WiredTigerSizeStorer::SizeInfo::addNumRecords(long long diff) {
+    if (auto stripe = _getCurrentStripe()) {
+        stripe->numRecords.fetchAndAdd(diff);
+    } else {
+        _numRecords.fetchAndAdd(diff);
+    }
+}
+
+void WiredTigerSizeStorer::SizeInfo::addDataSize(long long diff) {
+    if (auto stripe = _getCurrentStripe()) {
+        stripe->dataSize.fetchAndAdd(diff);
+    } else {
+        _dataSize.fetchAndAdd(diff);
+    }
+
+    // Only a decrease can make the size negative, so increases need not fold the stripes.
+    if (diff < 0) {
+        _clampDataSize();
+    }
+}
+
+void WiredTigerSizeStorer::SizeInfo::setNumRecords(long long value) {
+    addNumRecords(value - numRecords());
+}
+
+void WiredTigerSizeStorer::SizeInfo::setDataSize(long long value) {
+    addDataSize(value - dataSize());
+}
+
+void WiredTigerSizeStorer::SizeInfo::_clampDataSize() {
+    while (true) {
+        // Loading the base value before folding makes the compare-and-swap fail if another thread
+        // has clamped the size in between, so that it is not corrected twice.
+        auto base = _dataSize.load();
+        const auto total = dataSize();
+        if (total >= 0 || _dataSize.compareAndSwap(&base, base - total)) {
+            return;
+        }
+    }
+}
+
+WiredTigerSizeStorer::SizeInfo::Stripe* WiredTigerSizeStorer::SizeInfo::_getCurrentStripe() {
+    size_t index = std::hash<stdx::thread::id>()(stdx::this_thread::get_id()) % kNumStripes;
+#if defined(__linux__)
+    const int cpu = sched_getcpu();
+    if (cpu >= 0) {
+        index = static_cast<size_t>(cpu) % kNumStripes;
+    }
+#endif
+
+    auto stripes = _stripes.load();
+    if (!stripes) {
+        int firstUpdateStripe = -1;
+        if (_firstUpdateStripe.compareAndSwap(&firstUpdateStripe, static_cast<int>(index)) ||
+            firstUpdateStripe == static_cast<int>(index)) {
+            return nullptr;
+        }
+
+        auto newStripes = std::make_unique<Stripes>();
+        if (_stripes.compareAndSwap(&stripes, newStripes.get())) {
+            stripes = newStripes.release();
+        }
+    }
+    return &(*stripes)[index];
+}
+
 WiredTigerSizeStorer::WiredTigerSizeStorer(WT_CONNECTION* conn,
                                            const std::string& storageUri,
                                            bool readOnly)
@@ -85,8 +176,8 @@ void WiredTigerSizeStorer::store(StringData uri, std::shared_ptr<SizeInfo> sizeI
                 2,
                 "WiredTigerSizeStorer::store",
                 "uri"_attr = uri,
-                "numRecords"_attr = sizeInfo->numRecords.load(),
-                "dataSize"_attr = sizeInfo->dataSize.load(),
+                "numRecords"_attr = sizeInfo->numRecords(),
+                "dataSize"_attr = sizeInfo->dataSize(),
                 "entryUseCount"_attr = entry.use_count());
 }
 
@@ -122,21 +213,34 @@ std::shared_ptr<WiredTigerSizeStorer::SizeInfo> WiredTigerSizeStorer::load(Opera
 }
 
 void WiredTigerSizeStorer::flush(bool syncToDisk) {
+    uint64_t request;
+    {
+        stdx::lock_guard<Latch> bufferLock(_bufferMutex);
+        request = ++_flushesRequested;
+    }
+
+    // We serialize flushing to disk to avoid running into write conflicts from having multiple
+    // threads try to flush at the same time. Callers queued behind a flush in progress are
+    // usually covered by the next one to run, and don't need a transaction of their own.
+    stdx::lock_guard<Latch> flushLock(_flushMutex);
+    if (request <= (syncToDisk ? _lastSyncedRequest : _lastFlushedRequest))
+        return;  // A concurrent flush already wrote our changes.
+
     Buffer buffer;
+    uint64_t coveredRequest;
     {
         stdx::lock_guard<Latch> bufferLock(_bufferMutex);
         _buffer.swap(buffer);
+        coveredRequest = _flushesRequested;
     }
 
-    if (buffer.empty())
+    if (buffer.empty()) {
+        _lastFlushedRequest = coveredRequest;
         return;  // Nothing to do.
+    }
 
     Timer t;
 
-    // We serialize flushing to disk to avoid running into write conflicts from having multiple
-    // threads try to flush at the same time.
-    stdx::lock_guard<Latch> flushLock(_flushMutex);
-
     // When the session is destructed, it closes any cursors that remain open.
     WiredTigerSession session(_conn);
     WT_CURSOR* cursor = session.getNewCursor(_storageUri, "overwrite=true");
@@ -167,8 +271,8 @@ void WiredTigerSizeStorer::flush(bool syncToDisk) {
             // still be written back. So, the required order is to clear the dirty flag first.
             SizeInfo& sizeInfo = *it->second;
             sizeInfo._dirty.store(false);
-            BSONObj data = BSON("numRecords" << sizeInfo.numRecords.load() << "dataSize"
-                                             << sizeInfo.dataSize.load());
+            BSONObj data = BSON("numRecords" << sizeInfo.numRecords() << "dataSize"
+                                             << sizeInfo.dataSize());
 
             auto& uri = it->first;
             LOGV2_DEBUG(22425,
@@ -196,6 +300,11 @@ void WiredTigerSizeStorer::flush(bool syncToDisk) {
         buffer.clear();
     }
 
+    _lastFlushedRequest = coveredRequest;
+    if (syncToDisk) {
+        _lastSyncedRequest = coveredRequest;
+    }
+
     LOGV2_DEBUG(22426,
                 2,
                 "WiredTigerSizeStorer::flush completed",
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include <array>
 #include <string>
 
 #include <wiredtiger.h>
@@ -37,6 +38,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_session_cache.h"
 #include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
+#include "mongo/stdx/new.h"
 #include "mongo/util/string_map.h"
 
 namespace mongo {
@@ -60,19 +62,72 @@ public:
      * ownership. The SizeInfo may still be updated after it is stored in the SizeStorer.
      * The 'dirty' field is used by the size storer to cheaply merge duplicate stores of the same
      * SizeInfo.
+     *
+     * Once a collection is written to from more than one CPU, updates are accumulated in cache line
+     * aligned stripes selected by the CPU of the calling thread, so that concurrent writers to the
+     * same collection do not contend on one cache line. Reads fold all stripes together, which
+     * makes them more expensive than updates. The stripes are only allocated then, so that the many
+     * collections which are rarely written to do not pay for them.
      */
     struct SizeInfo {
         SizeInfo() = default;
-        SizeInfo(long long records, long long size) : numRecords(records), dataSize(size) {}
+        SizeInfo(long long records, long long size) : _numRecords(records), _dataSize(size) {}
 
         ~SizeInfo() {
             invariant(!_dirty.load());
+            delete _stripes.load();
+        }
+
+        long long numRecords() const;
+        long long dataSize() const;
+
+        void addNumRecords(long long diff);
+
+        /**
+         * A data size which becomes negative is reset to zero, as it can only be the result of
+         * earlier inaccurate updates.
+         */
+        void addDataSize(long long diff);
+
+        /**
+         * Adjusts the folded value to 'value'. Concurrent updates are preserved.
+         */
+        void setNumRecords(long long value);
+        void setDataSize(long long value);
+
+        bool isStriped_forTest() const {
+            return _stripes.load();
         }
-        AtomicWord<long long> numRecords;
-        AtomicWord<long long> dataSize;
 
     private:
         friend WiredTigerSizeStorer;
+
+        static constexpr size_t kNumStripes = 8;
+
+        struct alignas(stdx::hardware_destructive_interference_size) Stripe {
+            AtomicWord<long long> numRecords;
+            AtomicWord<long long> dataSize;
+        };
+        using Stripes = std::array<Stripe, kNumStripes>;
+
+        /**
+         * Returns the stripe of the current CPU, or nullptr if the collection has only been written
+         * to from the current CPU so far and updates should go to the base values.
+         */
+        Stripe* _getCurrentStripe();
+
+        void _clampDataSize();
+
+        // The values the SizeInfo was created or loaded with, plus the updates made before the
+        // stripes were allocated.
+        AtomicWord<long long> _numRecords;
+        AtomicWord<long long> _dataSize;
+
+        // The stripe index of the CPU which first updated the SizeInfo, or -1 if it was never
+        // updated. The stripes are allocated once the SizeInfo is updated from another stripe.
+        AtomicWord<int> _firstUpdateStripe{-1};
+        AtomicWord<Stripes*> _stripes{nullptr};
+
         AtomicWord<bool> _dirty;
     };
 
@@ -88,7 +143,9 @@ public:
     std::shared_ptr<SizeInfo> load(OperationContext* opCtx, StringData uri) const;
 
     /**
-     * Writes all changes to the underlying table.
+     * Writes all changes to the underlying table. Concurrent callers are group committed: a flush
+     * that started after this call was made, and synced to disk if 'syncToDisk' is set, also
+     * satisfies it.
      */
     void flush(bool syncToDisk);
 
@@ -101,6 +158,15 @@ private:
     // Serializes flushes to disk.
     Mutex _flushMutex = MONGO_MAKE_LATCH("WiredTigerSessionStorer::_flushMutex");
 
+    // Number of flushes requested, guarded by _bufferMutex. Each flush covers all requests made
+    // before it swapped out the buffer.
+    uint64_t _flushesRequested = 0;
+
+    // The last request covered by a completed flush, and by a completed flush that synced to
+    // disk. Guarded by _flushMutex.
+    uint64_t _lastFlushedRequest = 0;
+    uint64_t _lastSyncedRequest = 0;
+
     using Buffer = StringMap<std::shared_ptr<SizeInfo>>;
 
     mutable Mutex _bufferMutex =
@@ -33,6 +33,7 @@
 #include <sstream>
 #include <string>
 #include <time.h>
+#include <vector>
 
 #include "mongo/base/checked_cast.h"
 #include "mongo/base/init.h"
@@ -46,6 +47,7 @@
 #include "mongo/db/storage/wiredtiger/wiredtiger_recovery_unit.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_size_storer.h"
 #include "mongo/db/storage/wiredtiger/wiredtiger_util.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/fail_point.h"
 #include "mongo/util/scopeguard.h"
@@ -100,7 +102,7 @@ TEST(WiredTigerRecordStoreTest, SizeStorer1) {
     {
         ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
         auto& info = *ss.load(opCtx.get(), uri);
-        ASSERT_EQUALS(N, info.numRecords.load());
+        ASSERT_EQUALS(N, info.numRecords());
     }
 
     {
@@ -148,7 +150,7 @@ TEST(WiredTigerRecordStoreTest, SizeStorer1) {
         const bool enableWtLogging = false;
         WiredTigerSizeStorer ss2(harnessHelper->conn(), indexUri, enableWtLogging);
         auto info = ss2.load(opCtx.get(), uri);
-        ASSERT_EQUALS(N, info->numRecords.load());
+        ASSERT_EQUALS(N, info->numRecords());
     }
 
     rs.reset(nullptr);  // this has to be deleted before ss
@@ -178,11 +180,11 @@ private:
 
 protected:
     long long getNumRecords(OperationContext* opCtx) const {
-        return sizeStorer->load(opCtx, uri)->numRecords.load();
+        return sizeStorer->load(opCtx, uri)->numRecords();
     }
 
     long long getDataSize(OperationContext* opCtx) const {
-        return sizeStorer->load(opCtx, uri)->dataSize.load();
+        return sizeStorer->load(opCtx, uri)->dataSize();
     }
 
     std::unique_ptr<WiredTigerHarnessHelper> harnessHelper;
@@ -201,5 +203,78 @@ TEST_F(SizeStorerUpdateTest, Basic) {
     ASSERT_EQUALS(getDataSize(opCtx.get()), val);
 }
 
+TEST(WiredTigerSizeStorerTest, SizeInfoFoldsConcurrentUpdates) {
+    WiredTigerSizeStorer::SizeInfo sizeInfo(10, 100);
+
+    const int kNumThreads = 8;
+    const int kNumUpdates = 1000;
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < kNumThreads; i++) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < kNumUpdates; j++) {
+                sizeInfo.addNumRecords(1);
+                sizeInfo.addDataSize(2);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQUALS(10 + kNumThreads * kNumUpdates, sizeInfo.numRecords());
+    ASSERT_EQUALS(100 + 2 * kNumThreads * kNumUpdates, sizeInfo.dataSize());
+
+    sizeInfo.setNumRecords(5);
+    sizeInfo.setDataSize(50);
+    ASSERT_EQUALS(5, sizeInfo.numRecords());
+    ASSERT_EQUALS(50, sizeInfo.dataSize());
+}
+
+TEST(WiredTigerSizeStorerTest, SizeInfoResetsNegativeDataSize) {
+    WiredTigerSizeStorer::SizeInfo sizeInfo(1, 10);
+
+    sizeInfo.addDataSize(-15);
+    ASSERT_EQUALS(0, sizeInfo.dataSize());
+
+    // Later updates start over from zero rather than from the negative size.
+    sizeInfo.addDataSize(7);
+    ASSERT_EQUALS(7, sizeInfo.dataSize());
+}
+
+TEST(WiredTigerSizeStorerTest, SizeInfoIsNotStripedUntilUpdatedFromAnotherCPU) {
+    WiredTigerSizeStorer::SizeInfo sizeInfo(1, 10);
+    sizeInfo.setDataSize(20);
+    ASSERT_FALSE(sizeInfo.isStriped_forTest());
+    ASSERT_EQUALS(1, sizeInfo.numRecords());
+    ASSERT_EQUALS(20, sizeInfo.dataSize());
+}
+
+// Concurrent flushes may be group committed, but every store must still be written.
+TEST_F(SizeStorerUpdateTest, ConcurrentFlushesWriteAllStores) {
+    const int kNumThreads = 8;
+    std::vector<stdx::thread> threads;
+    for (int i = 0; i < kNumThreads; i++) {
+        threads.emplace_back([&, i] {
+            sizeStorer->store("table:concurrentFlush" + std::to_string(i),
+                              std::make_shared<WiredTigerSizeStorer::SizeInfo>(i, 2 * i));
+            sizeStorer->flush(true);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ServiceContext::UniqueOperationContext opCtx(harnessHelper->newOperationContext());
+    const bool enableWtLogging = false;
+    WiredTigerSizeStorer sizeStorer2(harnessHelper->conn(),
+                                     WiredTigerKVEngine::kTableUriPrefix + "sizeStorer",
+                                     enableWtLogging);
+    for (int i = 0; i < kNumThreads; i++) {
+        auto info = sizeStorer2.load(opCtx.get(), "table:concurrentFlush" + std::to_string(i));
+        ASSERT_EQUALS(i, info->numRecords());
+        ASSERT_EQUALS(2 * i, info->dataSize());
+    }
+}
+
 }  // namespace
 }  // namespace mongo
@@ -38,11 +38,13 @@
 #include "mongo/db/commands/server_status.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/db/timeseries/timeseries_constants.h"
 #include "mongo/db/timeseries/timeseries_options.h"
 #include "mongo/db/views/view_catalog.h"
 #include "mongo/platform/compiler.h"
 #include "mongo/stdx/thread.h"
 #include "mongo/util/fail_point.h"
+#include "mongo/util/scopeguard.h"
 
 namespace mongo {
 namespace {
@@ -205,6 +207,8 @@ struct BucketCatalog::ExecutionStats {
     AtomicWord<long long> numBucketsClosedDueToTimeForward;
     AtomicWord<long long> numBucketsClosedDueToTimeBackward;
     AtomicWord<long long> numBucketsClosedDueToMemoryThreshold;
+    AtomicWord<long long> numBucketReopeningHits;
+    AtomicWord<long long> numBucketReopeningMisses;
     AtomicWord<long long> numCommits;
     AtomicWord<long long> numWaits;
     AtomicWord<long long> numMeasurementsCommitted;
@@ -415,6 +419,7 @@ struct BucketCatalog::CreationInfo {
     ExecutionStats* stats;
     ClosedBuckets* closedBuckets;
     bool openedDuetoMetadata = true;
+    boost::optional<BucketToReopen>* bucketToReopen = nullptr;
 };
 
 BucketCatalog::WriteBatch::WriteBatch(const BucketHandle& bucket,
@@ -566,7 +571,8 @@ StatusWith<BucketCatalog::InsertResult> BucketCatalog::insert(
     const StringData::ComparatorInterface* comparator,
     const TimeseriesOptions& options,
     const BSONObj& doc,
-    CombineWithInsertsFromOtherClients combine) {
+    CombineWithInsertsFromOtherClients combine,
+    const BucketFinder& bucketFinder) {
 
     auto timeElem = doc[options.getTimeField()];
     if (!timeElem || BSONType::Date != timeElem.type()) {
@@ -594,7 +600,34 @@ StatusWith<BucketCatalog::InsertResult> BucketCatalog::insert(
     CreationInfo info{key, stripeNumber, time, options, stats.get(), &closedBuckets};
 
     auto& stripe = _stripes[stripeNumber];
-    stdx::lock_guard stripeLock{stripe.mutex};
+    stdx::unique_lock stripeLock{stripe.mutex};
+
+    // Reading the archived bucket requires storage access, so the stripe is unlocked meanwhile. By
+    // the time it is locked again, another writer may have opened a bucket for this metadata, in
+    // which case the archived bucket is only reopened if that one cannot take the measurement.
+    boost::optional<BucketToReopen> bucketToReopen;
+    bool reopeningInProgress = false;
+    ScopeGuard finishReopening([&] {
+        if (reopeningInProgress) {
+            _finishBucketReopening();
+        }
+    });
+    if (bucketFinder && gTimeseriesEnableBucketReopening.load() &&
+        _shouldLookForBucketToReopen(stripe, stripeLock, key, time, options)) {
+        auto era = _startBucketReopening();
+        reopeningInProgress = true;
+        stripeLock.unlock();
+        bucketToReopen = BucketToReopen{
+            bucketFinder(opCtx, _makeBucketToReopenFilter(key, time, options)).getOwned(), era};
+        stripeLock.lock();
+
+        if (bucketToReopen->bucketDoc.isEmpty()) {
+            _numBucketReopeningMisses.fetchAndAddRelaxed(1);
+            stats->numBucketReopeningMisses.fetchAndAddRelaxed(1);
+        } else {
+            info.bucketToReopen = &bucketToReopen;
+        }
+    }
 
     Bucket* bucket = _useOrCreateBucket(&stripe, stripeLock, info);
     invariant(bucket);
@@ -789,6 +822,7 @@ void BucketCatalog::abort(std::shared_ptr<WriteBatch> batch,
 }
 
 void BucketCatalog::clear(const OID& oid) {
+    _markClearedForReopening(oid);
     auto result = _setBucketState(oid, BucketState::kCleared);
     if (result && *result == BucketState::kPreparedAndCleared) {
         hangTimeseriesDirectModificationBeforeWriteConflict.pauseWhileSet();
@@ -797,6 +831,7 @@ void BucketCatalog::clear(const OID& oid) {
 }
 
 void BucketCatalog::clear(const std::function<bool(const NamespaceString&)>& shouldClear) {
+    _advanceEra();
     for (auto& stripe : _stripes) {
         stdx::lock_guard stripeLock{stripe.mutex};
         for (auto it = stripe.allBuckets.begin(); it != stripe.allBuckets.end();) {
@@ -841,6 +876,8 @@ void BucketCatalog::appendExecutionStats(const NamespaceString& ns, BSONObjBuild
                           stats->numBucketsClosedDueToTimeBackward.load());
     builder->appendNumber("numBucketsClosedDueToMemoryThreshold",
                           stats->numBucketsClosedDueToMemoryThreshold.load());
+    builder->appendNumber("numBucketReopeningHits", stats->numBucketReopeningHits.load());
+    builder->appendNumber("numBucketReopeningMisses", stats->numBucketReopeningMisses.load());
     auto commits = stats->numCommits.load();
     builder->appendNumber("numCommits", commits);
     builder->appendNumber("numWaits", stats->numWaits.load());
@@ -1085,6 +1122,21 @@ BucketCatalog::Bucket* BucketCatalog::_allocateBucket(Stripe* stripe,
                                                       const CreationInfo& info) {
     _expireIdleBuckets(stripe, stripeLock, info.stats, info.closedBuckets);
 
+    if (info.bucketToReopen && *info.bucketToReopen) {
+        // The archived bucket is considered at most once, so that it is not reopened again if it
+        // has to be rolled over right away.
+        auto bucketToReopen = std::move(**info.bucketToReopen);
+        info.bucketToReopen->reset();
+
+        if (Bucket* bucket = _reopenBucket(stripe, stripeLock, info, bucketToReopen)) {
+            _numBucketReopeningHits.fetchAndAddRelaxed(1);
+            info.stats->numBucketReopeningHits.fetchAndAddRelaxed(1);
+            return bucket;
+        }
+        _numBucketReopeningMisses.fetchAndAddRelaxed(1);
+        info.stats->numBucketReopeningMisses.fetchAndAddRelaxed(1);
+    }
+
     auto [bucketId, roundedTime] = generateBucketId(info.time, info.options);
 
     auto [it, inserted] =
@@ -1108,6 +1160,140 @@ BucketCatalog::Bucket* BucketCatalog::_allocateBucket(Stripe* stripe,
     return bucket;
 }
 
+bool BucketCatalog::_shouldLookForBucketToReopen(const Stripe& stripe,
+                                                 WithLock,
+                                                 const BucketKey& key,
+                                                 const Date_t& time,
+                                                 const TimeseriesOptions& options) const {
+    auto it = stripe.openBuckets.find(key);
+    if (it == stripe.openBuckets.end()) {
+        return true;
+    }
+
+    auto bucketTime = it->second->getTime();
+    return time < bucketTime || time - bucketTime >= Seconds(*options.getBucketMaxSpanSeconds());
+}
+
+BSONObj BucketCatalog::_makeBucketToReopenFilter(const BucketKey& key,
+                                                 const Date_t& time,
+                                                 const TimeseriesOptions& options) {
+    using namespace timeseries;
+
+    // A bucket's control.min time is its rounded creation time, so it can hold 'time' if that lies
+    // within 'bucketMaxSpanSeconds' after it. Compressed buckets cannot be appended to.
+    BSONObjBuilder builder;
+    builder.append(str::stream() << kBucketControlFieldName << "."
+                                 << kBucketControlVersionFieldName,
+                   kTimeseriesControlDefaultVersion);
+    if (auto metadata = key.metadata.toBSON().firstElement()) {
+        builder.appendAs(metadata, kBucketMetaFieldName);
+    } else {
+        builder.append(kBucketMetaFieldName, BSON("$exists" << false));
+    }
+    builder.append(str::stream() << kControlMinFieldNamePrefix << options.getTimeField(),
+                   BSON("$lte" << time << "$gt"
+                               << time - Seconds(*options.getBucketMaxSpanSeconds())));
+    return builder.obj();
+}
+
+BucketCatalog::Bucket* BucketCatalog::_reopenBucket(Stripe* stripe,
+                                                    WithLock stripeLock,
+                                                    const CreationInfo& info,
+                                                    const BucketToReopen& bucketToReopen) {
+    using namespace timeseries;
+
+    const auto& bucketDoc = bucketToReopen.bucketDoc;
+    auto idElem = bucketDoc[kBucketIdFieldName];
+    auto controlElem = bucketDoc[kBucketControlFieldName];
+    auto dataElem = bucketDoc[kBucketDataFieldName];
+    if (idElem.type() != BSONType::jstOID || controlElem.type() != BSONType::Object ||
+        dataElem.type() != BSONType::Object ||
+        controlElem.Obj()[kBucketControlVersionFieldName].numberInt() !=
+            kTimeseriesControlDefaultVersion) {
+        return nullptr;
+    }
+
+    auto bucketId = idElem.OID();
+    if (stripe->allBuckets.find(bucketId) != stripe->allBuckets.end()) {
+        // The bucket was already reopened by someone else, and is either full or no longer able to
+        // take this measurement.
+        return nullptr;
+    }
+
+    const auto& options = info.options;
+    auto timeField = options.getTimeField();
+    auto controlMin = controlElem.Obj()[kBucketControlMinFieldName];
+    auto controlMax = controlElem.Obj()[kBucketControlMaxFieldName];
+    auto timeColumn = dataElem.Obj()[timeField];
+    if (controlMin.type() != BSONType::Object || controlMax.type() != BSONType::Object ||
+        timeColumn.type() != BSONType::Object ||
+        controlMax.Obj()[timeField].type() != BSONType::Date) {
+        return nullptr;
+    }
+
+    // The filter matched the metadata using the collation of the collection; only reopen buckets
+    // whose metadata is binary equal, like the catalog does for open buckets.
+    if (!(BucketMetadata{bucketDoc[kBucketMetaFieldName], info.key.metadata.getComparator()} ==
+          info.key.metadata)) {
+        return nullptr;
+    }
+
+    auto bucketTime = bucketId.asDateT();
+    auto numMeasurements = static_cast<uint32_t>(timeColumn.Obj().nFields());
+    if (info.time < bucketTime ||
+        info.time - bucketTime >= Seconds(*options.getBucketMaxSpanSeconds()) ||
+        numMeasurements == 0 ||
+        numMeasurements >= static_cast<std::uint64_t>(gTimeseriesBucketMaxCount) ||
+        bucketDoc.objsize() >= gTimeseriesBucketMaxSize) {
+        return nullptr;
+    }
+
+    auto bucket = std::make_unique<Bucket>(bucketId, info.stripe);
+    bucket->_ns = info.key.ns;
+    bucket->_metadata = info.key.metadata;
+    bucket->_timeField = timeField.toString();
+    bucket->_latestTime = controlMax.Obj()[timeField].Date();
+    bucket->_size = bucketDoc.objsize();
+    bucket->_numMeasurements = numMeasurements;
+    bucket->_numCommittedMeasurements = numMeasurements;
+    for (auto&& column : dataElem.Obj()) {
+        bucket->_fieldNames.emplace(column.fieldNameStringData());
+    }
+
+    // The control.min and control.max documents bound every measurement in the bucket, so they are
+    // enough to rebuild both the min/max and the schema. Reading the full min and max clears their
+    // pending updates, so that the next commit only sends what it changes.
+    auto metaField = bucket->_metadata.getMetaField();
+    auto comparator = bucket->_metadata.getComparator();
+    bucket->_minmax.update(controlMin.Obj(), metaField, comparator);
+    bucket->_minmax.update(controlMax.Obj(), metaField, comparator);
+    bucket->_memoryUsage += bucket->_minmax.min().objsize();
+    bucket->_memoryUsage += bucket->_minmax.max().objsize();
+    if (bucket->_schema.update(controlMin.Obj(), metaField, comparator) ==
+            timeseries::Schema::UpdateStatus::Failed ||
+        bucket->_schema.update(controlMax.Obj(), metaField, comparator) ==
+            timeseries::Schema::UpdateStatus::Failed) {
+        return nullptr;
+    }
+
+    // See insert() for how the memory usage of a new bucket is approximated.
+    bucket->_memoryUsage += (info.key.ns.size() * 2) + bucketDoc.objsize() + sizeof(Bucket) +
+        sizeof(std::unique_ptr<Bucket>) + (sizeof(Bucket*) * 2);
+
+    // Registering the bucket state fails if the bucket was cleared since the document was read, as
+    // that might have been a direct write to or the compression of this bucket.
+    if (!_initializeBucketStateIfNotCleared(bucketId, bucketToReopen.era)) {
+        return nullptr;
+    }
+
+    Bucket* reopened = bucket.get();
+    stripe->allBuckets.emplace(bucketId, std::move(bucket));
+    stripe->openBuckets[info.key] = reopened;
+    _memoryUsage.fetchAndAdd(reopened->_memoryUsage);
+
+    return reopened;
+}
+
 BucketCatalog::Bucket* BucketCatalog::_rollover(Stripe* stripe,
                                                 WithLock stripeLock,
                                                 Bucket* bucket,
@@ -1160,6 +1346,41 @@ void BucketCatalog::_initializeBucketState(const OID& id) {
     _bucketStates.emplace(id, BucketState::kNormal);
 }
 
+bool BucketCatalog::_initializeBucketStateIfNotCleared(const OID& id, uint64_t era) {
+    stdx::lock_guard catalogLock{_mutex};
+    if (_era != era || _bucketsClearedWhileReopening.count(id)) {
+        return false;
+    }
+    _bucketStates.emplace(id, BucketState::kNormal);
+    return true;
+}
+
+uint64_t BucketCatalog::_startBucketReopening() {
+    stdx::lock_guard catalogLock{_mutex};
+    ++_numBucketReopeningsInProgress;
+    return _era;
+}
+
+void BucketCatalog::_finishBucketReopening() {
+    stdx::lock_guard catalogLock{_mutex};
+    invariant(_numBucketReopeningsInProgress > 0);
+    if (--_numBucketReopeningsInProgress == 0) {
+        _bucketsClearedWhileReopening.clear();
+    }
+}
+
+void BucketCatalog::_advanceEra() {
+    stdx::lock_guard catalogLock{_mutex};
+    ++_era;
+}
+
+void BucketCatalog::_markClearedForReopening(const OID& id) {
+    stdx::lock_guard catalogLock{_mutex};
+    if (_numBucketReopeningsInProgress > 0) {
+        _bucketsClearedWhileReopening.insert(id);
+    }
+}
+
 void BucketCatalog::_eraseBucketState(const OID& id) {
     stdx::lock_guard catalogLock{_mutex};
     _bucketStates.erase(id);
@@ -1259,6 +1480,10 @@ public:
         builder.appendNumber("numIdleBuckets", static_cast<long long>(counts.idle));
         builder.appendNumber("memoryUsage",
                              static_cast<long long>(bucketCatalog._memoryUsage.load()));
+        builder.appendNumber("numBucketReopeningHits",
+                             bucketCatalog._numBucketReopeningHits.load());
+        builder.appendNumber("numBucketReopeningMisses",
+                             bucketCatalog._numBucketReopeningMisses.load());
         return builder.obj();
     }
 } bucketCatalogServerStatus;
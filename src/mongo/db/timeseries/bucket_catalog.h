@@ -31,6 +31,7 @@
 
 #include <boost/container/small_vector.hpp>
 #include <boost/container/static_vector.hpp>
+#include <functional>
 #include <queue>
 
 #include "mongo/bson/unordered_fields_bsonobj_comparator.h"
@@ -187,6 +188,13 @@ public:
         ClosedBuckets closedBuckets;
     };
 
+    /**
+     * Looks up a single document in the buckets collection matching 'filter', returning an empty
+     * document if there is none. Used by insert() to find an archived bucket which can be reopened.
+     * Called without any BucketCatalog lock held.
+     */
+    using BucketFinder = std::function<BSONObj(OperationContext*, const BSONObj& filter)>;
+
     static BucketCatalog& get(ServiceContext* svcCtx);
     static BucketCatalog& get(OperationContext* opCtx);
 
@@ -210,13 +218,19 @@ public:
      * were closed in order to make space to insert the document. Any caller who receives the same
      * batch may commit or abort the batch after claiming commit rights. See WriteBatch for more
      * details.
+     *
+     * If the document cannot go into the open bucket for its metadata because there is none, or
+     * because its time falls outside of that bucket's time range, and 'bucketFinder' is provided,
+     * the catalog looks for an uncompressed bucket on disk covering the document's time and reopens
+     * it instead of allocating a new bucket.
      */
     StatusWith<InsertResult> insert(OperationContext* opCtx,
                                     const NamespaceString& ns,
                                     const StringData::ComparatorInterface* comparator,
                                     const TimeseriesOptions& options,
                                     const BSONObj& doc,
-                                    CombineWithInsertsFromOtherClients combine);
+                                    CombineWithInsertsFromOtherClients combine,
+                                    const BucketFinder& bucketFinder = {});
 
     /**
      * Prepares a batch for commit, transitioning it to an inactive state. Caller must already have
@@ -340,6 +354,16 @@ private:
         std::size_t operator()(const BucketKey& key) const;
     };
 
+    /**
+     * An archived bucket document read from disk, along with the value of '_era' before it was
+     * read. The bucket may only be reopened if neither it nor its namespace was cleared in the
+     * meantime.
+     */
+    struct BucketToReopen {
+        BSONObj bucketDoc;
+        uint64_t era;
+    };
+
     /**
      * Struct to hold a portion of the buckets managed by the catalog.
      *
@@ -449,10 +473,40 @@ private:
                             ClosedBuckets* closedBuckets);
 
     /**
-     * Allocates a new bucket and adds it to the catalog.
+     * Allocates a new bucket and adds it to the catalog. Reopens the archived bucket in
+     * 'info.bucketToReopen' instead, if it is set and suitable, and resets it either way.
      */
     Bucket* _allocateBucket(Stripe* stripe, WithLock stripeLock, const CreationInfo& info);
 
+    /**
+     * Returns whether inserting a measurement with the given time would need a bucket other than
+     * the open bucket for 'key', such that it is worth looking for an archived bucket to reopen.
+     */
+    bool _shouldLookForBucketToReopen(const Stripe& stripe,
+                                      WithLock stripeLock,
+                                      const BucketKey& key,
+                                      const Date_t& time,
+                                      const TimeseriesOptions& options) const;
+
+    /**
+     * Returns the filter which finds an archived, uncompressed bucket for 'key' which can hold a
+     * measurement with the given time.
+     */
+    static BSONObj _makeBucketToReopenFilter(const BucketKey& key,
+                                             const Date_t& time,
+                                             const TimeseriesOptions& options);
+
+    /**
+     * Rebuilds the in-memory state of the archived bucket and adds it to the catalog as the open
+     * bucket for 'info.key'. Returns nullptr if the bucket is not suitable for the measurement
+     * being inserted, is already tracked by the catalog, or if any bucket was cleared since it was
+     * read.
+     */
+    Bucket* _reopenBucket(Stripe* stripe,
+                          WithLock stripeLock,
+                          const CreationInfo& info,
+                          const BucketToReopen& bucketToReopen);
+
     /**
      * Close the existing, full bucket and open a new one for the same metadata.
      *
@@ -476,6 +530,33 @@ private:
      */
     void _initializeBucketState(const OID& id);
 
+    /**
+     * Initializes state for the given bucket to kNormal, unless '_era' no longer matches 'era' or
+     * the bucket was cleared since the reopening started. Returns whether the state was
+     * initialized.
+     */
+    bool _initializeBucketStateIfNotCleared(const OID& id, uint64_t era);
+
+    /**
+     * Registers an archived bucket lookup which is about to read from disk and returns the current
+     * value of '_era'. Every call must be paired with a call to _finishBucketReopening() once the
+     * bucket read is either reopened or given up on.
+     */
+    uint64_t _startBucketReopening();
+    void _finishBucketReopening();
+
+    /**
+     * Advances '_era'. Must be called whenever all buckets of a namespace are cleared, so that
+     * archived buckets which were read from disk before the clear are not reopened afterwards.
+     */
+    void _advanceEra();
+
+    /**
+     * Records that the bucket 'id' was cleared if any archived bucket lookup is in progress, so
+     * that the lookup does not reopen a copy of the bucket read before the clear.
+     */
+    void _markClearedForReopening(const OID& id);
+
     /**
      * Remove state for the given bucket from the catalog.
      */
@@ -500,6 +581,14 @@ private:
     // Bucket state for synchronization with direct writes, protected by '_mutex'
     stdx::unordered_map<OID, BucketState, OID::Hasher> _bucketStates;
 
+    // Incremented whenever the buckets of a namespace are cleared. Protected by '_mutex'.
+    uint64_t _era = 0;
+
+    // The number of archived bucket lookups in progress, and the buckets cleared by id, including
+    // buckets the catalog does not track, since the oldest of them started. Protected by '_mutex'.
+    uint64_t _numBucketReopeningsInProgress = 0;
+    stdx::unordered_set<OID, OID::Hasher> _bucketsClearedWhileReopening;
+
     // Per-namespace execution stats. This map is protected by '_mutex'. Once you complete your
     // lookup, you can keep the shared_ptr to an individual namespace's stats object and release the
     // lock. The object itself is thread-safe (using atomics).
@@ -508,6 +597,11 @@ private:
     // Approximate memory usage of the bucket catalog.
     AtomicWord<uint64_t> _memoryUsage;
 
+    // Number of archived buckets which were looked up on disk and reopened, and number of lookups
+    // which did not produce a bucket that could be reopened, across all namespaces.
+    AtomicWord<long long> _numBucketReopeningHits;
+    AtomicWord<long long> _numBucketReopeningMisses;
+
     class ServerStatus;
 };
 }  // namespace mongo
@@ -33,7 +33,9 @@
 #include "mongo/db/catalog_raii.h"
 #include "mongo/db/concurrency/write_conflict_exception.h"
 #include "mongo/db/timeseries/bucket_catalog.h"
+#include "mongo/db/timeseries/timeseries_options.h"
 #include "mongo/db/views/view_catalog.h"
+#include "mongo/idl/server_parameter_test_util.h"
 #include "mongo/stdx/future.h"
 #include "mongo/unittest/bson_test_util.h"
 #include "mongo/unittest/death_test.h"
@@ -75,6 +77,14 @@ protected:
 
     long long _getNumWaits(const NamespaceString& ns);
     long long _getNumSchemaChanges(const NamespaceString& ns);
+    long long _getExecutionStat(const NamespaceString& ns, StringData stat);
+
+    // Returns a bucket document for '_ns1' holding the measurements in 'data', which must all have
+    // the same metadata value 'meta'. The data is never compressed, regardless of 'version'.
+    BSONObj _makeArchivedBucket(const OID& bucketId,
+                                StringData meta,
+                                const std::vector<BSONObj>& data,
+                                int version = 1) const;
 
     // Check that each group of objects has compatible schema with itself, but that inserting the
     // first object in new group closes the existing bucket and opens a new one
@@ -190,6 +200,36 @@ long long BucketCatalogTest::_getNumSchemaChanges(const NamespaceString& ns) {
     return builder.obj().getIntField("numBucketsClosedDueToSchemaChange");
 }
 
+long long BucketCatalogTest::_getExecutionStat(const NamespaceString& ns, StringData stat) {
+    BSONObjBuilder builder;
+    _bucketCatalog->appendExecutionStats(ns, &builder);
+    return builder.obj().getIntField(stat);
+}
+
+BSONObj BucketCatalogTest::_makeArchivedBucket(const OID& bucketId,
+                                               StringData meta,
+                                               const std::vector<BSONObj>& data,
+                                               int version) const {
+    timeseries::MinMax minmax;
+    minmax.update(BSON(_timeField << bucketId.asDateT()), boost::none, nullptr);
+    std::map<std::string, BSONObjBuilder> columns;
+    for (size_t i = 0; i < data.size(); ++i) {
+        minmax.update(data[i], boost::none, nullptr);
+        for (auto&& elem : data[i]) {
+            columns[elem.fieldName()].appendAs(elem, std::to_string(i));
+        }
+    }
+
+    BSONObjBuilder dataBuilder;
+    for (auto&& [fieldName, column] : columns) {
+        dataBuilder.append(fieldName, column.obj());
+    }
+    return BSON("_id" << bucketId << "control"
+                      << BSON("version" << version << "min" << minmax.min() << "max"
+                                        << minmax.max())
+                      << "meta" << meta << "data" << dataBuilder.obj());
+}
+
 void BucketCatalogTest::_testMeasurementSchema(
     const std::initializer_list<std::initializer_list<BSONObj>>& groups) {
     // Make sure we start and end with a clean slate.
@@ -981,5 +1021,194 @@ TEST_F(BucketCatalogTest, SchemaChanges) {
     _testMeasurementSchema({{docs[18], docs[19]}, {docs[20], docs[21]}});
 }
 
+TEST_F(BucketCatalogTest, ReopenArchivedBucket) {
+    auto options = _getTimeseriesOptions(_ns1);
+    auto now = Date_t::now();
+    OID bucketId = OID::gen();
+    bucketId.setTimestamp(durationCount<Seconds>(
+        timeseries::roundTimestampToGranularity(now, options.getGranularity())
+            .toDurationSinceEpoch()));
+    auto bucketDoc = _makeArchivedBucket(
+        bucketId, "A", {BSON(_timeField << now << "a" << 1), BSON(_timeField << now << "a" << 3)});
+
+    BSONObj filter;
+    auto findBucket = [&](OperationContext*, const BSONObj& query) {
+        filter = query.getOwned();
+        return bucketDoc;
+    };
+    auto result =
+        _bucketCatalog->insert(_opCtx,
+                               _ns1,
+                               _getCollator(_ns1),
+                               options,
+                               BSON(_timeField << now << _metaField << "A" << "a" << 2),
+                               BucketCatalog::CombineWithInsertsFromOtherClients::kAllow,
+                               findBucket);
+    ASSERT_OK(result.getStatus());
+    auto batch = result.getValue().batch;
+
+    // The lookup is restricted to uncompressed buckets for the same metadata.
+    ASSERT_EQ(filter["control.version"].numberInt(), 1);
+    ASSERT_EQ(filter["meta"].str(), "A");
+    ASSERT_EQ(batch->bucket().id, bucketId);
+    ASSERT_EQ(_getExecutionStat(_ns1, "numBucketReopeningHits"), 1);
+    ASSERT_EQ(_getExecutionStat(_ns1, "numBucketsOpenedDueToMetadata"), 0);
+
+    // The new measurement is appended after the archived ones, and is within the existing min and
+    // max, so no control fields need to be updated.
+    ASSERT(batch->claimCommitRights());
+    ASSERT(_bucketCatalog->prepareCommit(batch));
+    ASSERT_EQ(batch->numPreviouslyCommittedMeasurements(), 2);
+    ASSERT(batch->newFieldNamesToBeInserted().empty());
+    ASSERT_BSONOBJ_EQ(batch->min(), BSONObj());
+    ASSERT_BSONOBJ_EQ(batch->max(), BSONObj());
+    _bucketCatalog->finish(batch, {});
+}
+
+TEST_F(BucketCatalogTest, DoNotReopenUnsuitableBuckets) {
+    auto options = _getTimeseriesOptions(_ns1);
+    auto now = Date_t::now();
+    OID bucketId = OID::gen();
+    bucketId.setTimestamp(durationCount<Seconds>(
+        timeseries::roundTimestampToGranularity(now, options.getGranularity())
+            .toDurationSinceEpoch()));
+
+    auto insertWithArchivedBucket = [&](StringData meta, const BSONObj& bucketDoc) {
+        auto result = _bucketCatalog->insert(
+            _opCtx,
+            _ns1,
+            _getCollator(_ns1),
+            options,
+            BSON(_timeField << now << _metaField << meta),
+            BucketCatalog::CombineWithInsertsFromOtherClients::kAllow,
+            [&](OperationContext*, const BSONObj&) { return bucketDoc; });
+        ASSERT_OK(result.getStatus());
+        return result.getValue().batch->bucket().id;
+    };
+
+    // No archived bucket was found.
+    ASSERT_NE(insertWithArchivedBucket("A", BSONObj()), bucketId);
+    ASSERT_EQ(_getExecutionStat(_ns1, "numBucketReopeningMisses"), 1);
+
+    // The archived bucket is compressed.
+    ASSERT_NE(insertWithArchivedBucket(
+                  "B", _makeArchivedBucket(bucketId, "B", {BSON(_timeField << now)}, 2)),
+              bucketId);
+    ASSERT_EQ(_getExecutionStat(_ns1, "numBucketReopeningMisses"), 2);
+
+    // The archived bucket holds different metadata.
+    ASSERT_NE(insertWithArchivedBucket(
+                  "C", _makeArchivedBucket(bucketId, "D", {BSON(_timeField << now)})),
+              bucketId);
+    ASSERT_EQ(_getExecutionStat(_ns1, "numBucketReopeningMisses"), 3);
+
+    ASSERT_EQ(_getExecutionStat(_ns1, "numBucketReopeningHits"), 0);
+    ASSERT_EQ(_getExecutionStat(_ns1, "numBucketsOpenedDueToMetadata"), 3);
+}
+
+TEST_F(BucketCatalogTest, DoNotReopenBucketIfClearedWhileReading) {
+    auto options = _getTimeseriesOptions(_ns1);
+    auto now = Date_t::now();
+    OID bucketId = OID::gen();
+    bucketId.setTimestamp(durationCount<Seconds>(
+        timeseries::roundTimestampToGranularity(now, options.getGranularity())
+            .toDurationSinceEpoch()));
+    auto bucketDoc = _makeArchivedBucket(bucketId, "A", {BSON(_timeField << now)});
+
+    // A direct write to the archived bucket between reading it and reopening it, which clears it,
+    // must prevent it from being reopened.
+    auto result = _bucketCatalog->insert(
+        _opCtx,
+        _ns1,
+        _getCollator(_ns1),
+        options,
+        BSON(_timeField << now << _metaField << "A"),
+        BucketCatalog::CombineWithInsertsFromOtherClients::kAllow,
+        [&](OperationContext*, const BSONObj&) {
+            _bucketCatalog->clear(bucketId);
+            return bucketDoc;
+        });
+    ASSERT_OK(result.getStatus());
+    ASSERT_NE(result.getValue().batch->bucket().id, bucketId);
+    ASSERT_EQ(_getExecutionStat(_ns1, "numBucketReopeningMisses"), 1);
+}
+
+TEST_F(BucketCatalogTest, ReopenBucketIfOtherBucketClearedWhileReading) {
+    auto options = _getTimeseriesOptions(_ns1);
+    auto now = Date_t::now();
+    OID bucketId = OID::gen();
+    bucketId.setTimestamp(durationCount<Seconds>(
+        timeseries::roundTimestampToGranularity(now, options.getGranularity())
+            .toDurationSinceEpoch()));
+    auto bucketDoc = _makeArchivedBucket(bucketId, "A", {BSON(_timeField << now)});
+
+    // Direct writes to other buckets do not affect the reopening.
+    auto result = _bucketCatalog->insert(
+        _opCtx,
+        _ns1,
+        _getCollator(_ns1),
+        options,
+        BSON(_timeField << now << _metaField << "A"),
+        BucketCatalog::CombineWithInsertsFromOtherClients::kAllow,
+        [&](OperationContext*, const BSONObj&) {
+            _bucketCatalog->clear(OID::gen());
+            return bucketDoc;
+        });
+    ASSERT_OK(result.getStatus());
+    ASSERT_EQ(result.getValue().batch->bucket().id, bucketId);
+    ASSERT_EQ(_getExecutionStat(_ns1, "numBucketReopeningHits"), 1);
+}
+
+TEST_F(BucketCatalogTest, DoNotLookForArchivedBucketIfReopeningDisabled) {
+    RAIIServerParameterControllerForTest reopening{"timeseriesEnableBucketReopening", false};
+    auto options = _getTimeseriesOptions(_ns1);
+    bool lookedUp = false;
+    auto result = _bucketCatalog->insert(
+        _opCtx,
+        _ns1,
+        _getCollator(_ns1),
+        options,
+        BSON(_timeField << Date_t::now()),
+        BucketCatalog::CombineWithInsertsFromOtherClients::kAllow,
+        [&](OperationContext*, const BSONObj&) {
+            lookedUp = true;
+            return BSONObj();
+        });
+    ASSERT_OK(result.getStatus());
+    ASSERT_FALSE(lookedUp);
+}
+
+TEST_F(BucketCatalogTest, LookForArchivedBucketOnlyIfOpenBucketCannotTakeMeasurement) {
+    auto options = _getTimeseriesOptions(_ns1);
+    int numLookups = 0;
+    auto findBucket = [&](OperationContext*, const BSONObj&) {
+        ++numLookups;
+        return BSONObj();
+    };
+    auto insert = [&](Date_t time) {
+        auto result =
+            _bucketCatalog->insert(_opCtx,
+                                   _ns1,
+                                   _getCollator(_ns1),
+                                   options,
+                                   BSON(_timeField << time),
+                                   BucketCatalog::CombineWithInsertsFromOtherClients::kAllow,
+                                   findBucket);
+        ASSERT_OK(result.getStatus());
+    };
+
+    auto now = Date_t::now();
+    insert(now);
+    ASSERT_EQ(numLookups, 1);
+
+    // The open bucket covers this measurement.
+    insert(now);
+    ASSERT_EQ(numLookups, 1);
+
+    // A late measurement needs a different bucket.
+    insert(now - Seconds(*options.getBucketMaxSpanSeconds()) * 2);
+    ASSERT_EQ(numLookups, 2);
+}
+
 }  // namespace
 }  // namespace mongo
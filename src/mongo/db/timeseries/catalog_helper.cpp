@@ -31,7 +31,12 @@
 
 #include "mongo/db/timeseries/catalog_helper.h"
 
+#include "mongo/db/catalog/collection.h"
 #include "mongo/db/catalog/collection_catalog.h"
+#include "mongo/db/catalog/index_catalog.h"
+#include "mongo/db/index/index_descriptor.h"
+#include "mongo/db/query/collation/collator_interface.h"
+#include "mongo/db/timeseries/timeseries_index_schema_conversion_functions.h"
 
 namespace mongo {
 
@@ -49,5 +54,27 @@ boost::optional<TimeseriesOptions> getTimeseriesOptions(OperationContext* opCtx,
     return bucketsColl->getTimeseriesOptions();
 }
 
+boost::optional<BSONObj> getIndexForBucketReopening(OperationContext* opCtx,
+                                                    const Collection& bucketsColl) {
+    const auto& options = bucketsColl.getTimeseriesOptions();
+    if (!options) {
+        return boost::none;
+    }
+
+    // The lookup compares the metadata with the collection's default collation, so the index must
+    // use the same collation to be able to serve it.
+    auto it = bucketsColl.getIndexCatalog()->getIndexIterator(opCtx,
+                                                              /*includeUnfinishedIndexes=*/false);
+    while (it->more()) {
+        const auto* entry = it->next();
+        if (CollatorInterface::collatorsMatch(entry->getCollator(),
+                                              bucketsColl.getDefaultCollator()) &&
+            isBucketsIndexSuitableForReopening(*options, entry->descriptor()->infoObj())) {
+            return entry->descriptor()->keyPattern().getOwned();
+        }
+    }
+    return boost::none;
+}
+
 }  // namespace timeseries
 }  // namespace mongo
@@ -33,6 +33,7 @@
 
 namespace mongo {
 
+class Collection;
 class NamespaceString;
 class OperationContext;
 
@@ -49,5 +50,13 @@ boost::optional<TimeseriesOptions> getTimeseriesOptions(OperationContext* opCtx,
                                                         const NamespaceString& nss,
                                                         bool convertToBucketsNamespace);
 
+/**
+ * Returns the key pattern of a ready index on the buckets collection 'bucketsColl' which can serve
+ * the lookup of an archived bucket to reopen, or boost::none if there is no such index. Without
+ * one, the lookup would have to scan the whole buckets collection.
+ */
+boost::optional<BSONObj> getIndexForBucketReopening(OperationContext* opCtx,
+                                                    const Collection& bucketsColl);
+
 }  // namespace timeseries
 }  // namespace mongo
@@ -31,6 +31,7 @@
 
 #include "mongo/db/timeseries/timeseries_index_schema_conversion_functions.h"
 
+#include "mongo/db/index/index_descriptor.h"
 #include "mongo/db/index_names.h"
 #include "mongo/db/matcher/expression_algo.h"
 #include "mongo/db/matcher/expression_parser.h"
@@ -402,6 +403,34 @@ bool isBucketsIndexSpecCompatibleForDowngrade(const TimeseriesOptions& timeserie
                /*timeseriesMetricIndexesFeatureFlagEnabled=*/false) != boost::none;
 }
 
+bool isBucketsIndexSuitableForReopening(const TimeseriesOptions& timeseriesOptions,
+                                        const BSONObj& bucketsIndex) {
+    if (!bucketsIndex.hasField(kKeyFieldName) ||
+        bucketsIndex.hasField(kPartialFilterExpressionFieldName) ||
+        bucketsIndex[IndexDescriptor::kSparseFieldName].trueValue() ||
+        bucketsIndex[IndexDescriptor::kHiddenFieldName].trueValue()) {
+        return false;
+    }
+
+    // Only ascending and descending key parts can be used for the equality on the metadata and the
+    // range on the time.
+    BSONObjIterator it(bucketsIndex.getField(kKeyFieldName).Obj());
+    auto nextKeyPartIs = [&](StringData fieldName) {
+        if (!it.more()) {
+            return false;
+        }
+        auto elem = it.next();
+        return elem.fieldNameStringData() == fieldName && elem.isNumber();
+    };
+
+    if (timeseriesOptions.getMetaField() && !nextKeyPartIs(kBucketMetaFieldName)) {
+        return false;
+    }
+    const std::string controlMinTimeField = str::stream()
+        << kControlMinFieldNamePrefix << timeseriesOptions.getTimeField();
+    return nextKeyPartIs(controlMinTimeField);
+}
+
 bool doesBucketsIndexIncludeMeasurement(OperationContext* opCtx,
                                         const NamespaceString& bucketNs,
                                         const TimeseriesOptions& timeseriesOptions,
@@ -76,6 +76,15 @@ std::list<BSONObj> createTimeseriesIndexesFromBucketsIndexes(
 bool isBucketsIndexSpecCompatibleForDowngrade(const TimeseriesOptions& timeseriesOptions,
                                               const BSONObj& bucketsIndex);
 
+/**
+ * Returns true if the buckets collection index 'bucketsIndex' can serve the lookup of an archived
+ * bucket to reopen, which matches the metadata exactly and the time against control.min of the
+ * time field. That is, the index key starts with the 'meta' field, if the collection has a
+ * metaField, followed by control.min of the time field, and the index covers every bucket.
+ */
+bool isBucketsIndexSuitableForReopening(const TimeseriesOptions& timeseriesOptions,
+                                        const BSONObj& bucketsIndex);
+
 /**
  * Returns true if 'bucketsIndex' uses a measurement field, excluding the time field. Checks both
  * the index key and the partialFilterExpression, if present.
@@ -399,5 +399,43 @@ TEST(TimeseriesIndexSchemaConversionTest, 2dsphereMeasurementIndexSpecConversion
     testBothWaysIndexSpecConversion(timeseriesOptions, timeseriesIndexSpec, bucketsIndexSpec);
 }
 
+TEST(TimeseriesIndexSchemaConversionTest, IndexSuitableForReopeningWithMetaField) {
+    TimeseriesOptions timeseriesOptions = makeTimeseriesOptions();
+    auto isSuitable = [&](const BSONObj& bucketsIndex) {
+        return timeseries::isBucketsIndexSuitableForReopening(timeseriesOptions, bucketsIndex);
+    };
+
+    // The index created for {mm: 1, tm: 1} on the time-series collection.
+    BSONObj key = BSON(timeseries::kBucketMetaFieldName << 1 << kControlMinTimeFieldName << 1
+                                                        << kControlMaxTimeFieldName << 1);
+    ASSERT_TRUE(isSuitable(BSON("key" << key)));
+    ASSERT_TRUE(isSuitable(BSON("key" << BSON(timeseries::kBucketMetaFieldName
+                                              << -1 << kControlMinTimeFieldName << -1))));
+
+    // The index must cover every bucket.
+    ASSERT_FALSE(isSuitable(BSON("key" << key << "sparse" << true)));
+    ASSERT_FALSE(isSuitable(BSON("key" << key << "hidden" << true)));
+    ASSERT_FALSE(isSuitable(
+        BSON("key" << key << "partialFilterExpression" << BSON("meta" << BSON("$gt" << 0)))));
+
+    // The key must start with the metadata followed by control.min of the time field.
+    ASSERT_FALSE(isSuitable(BSON("key" << BSON(timeseries::kBucketMetaFieldName << 1))));
+    ASSERT_FALSE(isSuitable(BSON("key" << BSON(kControlMinTimeFieldName << 1))));
+    ASSERT_FALSE(isSuitable(BSON("key" << BSON(timeseries::kBucketMetaFieldName
+                                               << 1 << kControlMaxTimeFieldName << -1))));
+    ASSERT_FALSE(isSuitable(BSON("key" << BSON("meta.a" << 1 << kControlMinTimeFieldName << 1))));
+    ASSERT_FALSE(isSuitable(BSON("key" << BSON(timeseries::kBucketMetaFieldName
+                                               << "hashed" << kControlMinTimeFieldName << 1))));
+}
+
+TEST(TimeseriesIndexSchemaConversionTest, IndexSuitableForReopeningWithoutMetaField) {
+    TimeseriesOptions timeseriesOptions(kTimeseriesTimeFieldName);
+    ASSERT_TRUE(timeseries::isBucketsIndexSuitableForReopening(
+        timeseriesOptions,
+        BSON("key" << BSON(kControlMinTimeFieldName << 1 << kControlMaxTimeFieldName << 1))));
+    ASSERT_FALSE(timeseries::isBucketsIndexSuitableForReopening(
+        timeseriesOptions, BSON("key" << BSON("_id" << 1))));
+}
+
 }  // namespace
 }  // namespace mongo
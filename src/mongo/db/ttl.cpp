@@ -181,6 +181,9 @@ private:
         const ServiceContext::UniqueOperationContext opCtxPtr = cc().makeOperationContext();
         OperationContext* opCtx = opCtxPtr.get();
 
+        // TTL deletes are background work and should yield tickets to user operations under load.
+        opCtx->lockState()->setAdmissionPriority(AdmissionPriority::kLow);
+
         // If part of replSet but not in a readable state (e.g. during initial sync), skip.
         if (repl::ReplicationCoordinator::get(opCtx)->getReplicationMode() ==
                 repl::ReplicationCoordinator::modeReplSet &&
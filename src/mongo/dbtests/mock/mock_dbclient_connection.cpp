@@ -108,6 +108,25 @@ int nToSkipFromResumeAfter(const BSONObj& resumeAfter) {
 
     return nElt.numberInt();
 }
+
+// Keeps the documents whose _id is within the index bounds 'min' (inclusive) and 'max'
+// (exclusive) of a query hinting the _id index. Missing bounds are unbounded.
+BSONArray filterByIdRange(const BSONArray& results,
+                          const BSONElement& min,
+                          const BSONElement& max) {
+    BSONArrayBuilder filtered;
+    for (auto&& elem : results) {
+        auto id = elem.Obj()["_id"];
+        if (min && id.woCompare(min.Obj().firstElement(), false) < 0) {
+            continue;
+        }
+        if (max && id.woCompare(max.Obj().firstElement(), false) >= 0) {
+            continue;
+        }
+        filtered.append(elem.Obj());
+    }
+    return BSONArray(filtered.obj());
+}
 }  // namespace
 
 std::unique_ptr<DBClientCursor> MockDBClientConnection::bsonArrayToCursor(BSONArray results,
@@ -197,6 +216,12 @@ std::unique_ptr<mongo::DBClientCursor> MockDBClientConnection::query_DEPRECATED(
             provideResumeToken = true;
         }
 
+        // A simple mock implementation of a range query on the _id index.
+        if (querySettingsAsBSON.hasField("$min") || querySettingsAsBSON.hasField("$max")) {
+            result = filterByIdRange(
+                result, querySettingsAsBSON.getField("$min"), querySettingsAsBSON.getField("$max"));
+        }
+
 
         return bsonArrayToCursor(std::move(result), nToSkip, provideResumeToken, batchSize);
     } catch (const mongo::DBException&) {
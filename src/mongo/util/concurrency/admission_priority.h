@@ -0,0 +1,62 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+#pragma once
+
+#pragma once
+
+#include <cstddef>
+
+#include "mongo/base/status_with.h"
+#include "mongo/base/string_data.h"
+
+namespace mongo {
+
+/**
+ * The priority with which an operation is admitted when it has to queue for a ticket. Queued
+ * operations with a higher priority are admitted before queued operations with a lower priority,
+ * and operations with the same priority are admitted in the order in which they started waiting.
+ */
+enum class AdmissionPriority {
+    // Background work which is not latency sensitive, such as TTL deletes and index builds.
+    kLow = 0,
+    kNormal,
+    // Latency sensitive work, which should not queue behind other operations.
+    kHigh,
+};
+
+constexpr std::size_t kNumAdmissionPriorities = 3;
+
+StringData toString(AdmissionPriority priority);
+
+/**
+ * Parses one of the strings returned by toString(AdmissionPriority).
+ */
+StatusWith<AdmissionPriority> parseAdmissionPriority(StringData priority);
+
+}  // namespace mongo
@@ -27,236 +27,266 @@
  *    it in the license file.
  */
 
-#define MONGO_LOGV2_DEFAULT_COMPONENT ::mongo::logv2::LogComponent::kDefault
-
 #include "mongo/platform/basic.h"
 
 #include "mongo/util/concurrency/ticketholder.h"
 
-#include <iostream>
+#include <algorithm>
 
-#include "mongo/logv2/log.h"
+#include "mongo/util/concurrency/ticketholder_gen.h"
+#include "mongo/util/integer_histogram.h"
 #include "mongo/util/str.h"
+#include "mongo/util/timer.h"
 
 namespace mongo {
 
-#if defined(__linux__)
-namespace {
-
-/**
- * Accepts an errno code, prints its error message, and exits.
- */
-void failWithErrno(int err) {
-    LOGV2_FATAL(28604,
-                "error in Ticketholder: {errnoWithDescription_err}",
-                "errnoWithDescription_err"_attr = errnoWithDescription(err));
+StringData toString(AdmissionPriority priority) {
+    switch (priority) {
+        case AdmissionPriority::kLow:
+            return "low"_sd;
+        case AdmissionPriority::kNormal:
+            return "normal"_sd;
+        case AdmissionPriority::kHigh:
+            return "high"_sd;
+    }
+    MONGO_UNREACHABLE;
 }
 
-/*
- * Checks the return value from a Linux semaphore function call, and fails with the set errno if the
- * call was unsucessful.
- */
-void check(int ret) {
-    if (ret == 0)
-        return;
-    failWithErrno(errno);
+StatusWith<AdmissionPriority> parseAdmissionPriority(StringData priority) {
+    for (auto candidate :
+         {AdmissionPriority::kLow, AdmissionPriority::kNormal, AdmissionPriority::kHigh}) {
+        if (priority == toString(candidate)) {
+            return candidate;
+        }
+    }
+    return Status(ErrorCodes::BadValue,
+                  str::stream() << "Invalid admission priority '" << priority
+                                << "', expected one of 'low', 'normal' or 'high'");
 }
 
-/**
- * Takes a Date_t deadline and sets the appropriate values in a timespec structure.
- */
-void tsFromDate(const Date_t& deadline, struct timespec& ts) {
-    ts.tv_sec = deadline.toTimeT();
-    ts.tv_nsec = (deadline.toMillisSinceEpoch() % 1000) * 1'000'000;
-}
-}  // namespace
+struct TicketHolder::AdmissionStats {
+    AtomicWord<long long> totalQueued{0};
+    AtomicWord<long long> totalAdmitted{0};
+    AtomicWord<long long> totalCanceled{0};
+    AtomicWord<long long> totalTimeQueuedMicros{0};
 
-TicketHolder::TicketHolder(int num) : _outof(num) {
-    check(sem_init(&_sem, 0, num));
-}
+    // The length of the queue, including the new waiter, whenever a waiter is queued.
+    IntegerHistogram<10> queueDepth{"queueDepth", {2, 4, 8, 16, 32, 64, 128, 256, 512, 1024}};
+
+    // How long the admitted waiters spent in the queue.
+    IntegerHistogram<6> timeQueuedMicros{"timeQueuedMicros",
+                                         {100, 1000, 10'000, 100'000, 1'000'000, 10'000'000}};
+};
 
-TicketHolder::~TicketHolder() {
-    check(sem_destroy(&_sem));
+TicketHolder::TicketHolder(int num) : _available(num), _outof(num) {
+    for (auto& queue : _queues) {
+        queue.stats = std::make_unique<AdmissionStats>();
+    }
 }
 
+TicketHolder::~TicketHolder() = default;
+
 bool TicketHolder::tryAcquire() {
-    while (0 != sem_trywait(&_sem)) {
-        if (errno == EAGAIN)
-            return false;
-        if (errno != EINTR)
-            failWithErrno(errno);
+    // Don't take a ticket from under the feet of the queued waiters.
+    if (_numQueued.load() > 0) {
+        return false;
     }
-    return true;
+    return _tryTakeAvailableTicket();
 }
 
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
-    waitForTicketUntil(opCtx, Date_t::max());
+void TicketHolder::waitForTicket(OperationContext* opCtx, AdmissionPriority priority) {
+    invariant(waitForTicketUntil(opCtx, Date_t::max(), priority));
 }
 
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
-    // Attempt to get a ticket without waiting in order to avoid expensive time calculations.
-    if (sem_trywait(&_sem) == 0) {
+bool TicketHolder::waitForTicketUntil(OperationContext* opCtx,
+                                      Date_t until,
+                                      AdmissionPriority priority) {
+    if (tryAcquire()) {
         return true;
     }
 
-    const Milliseconds intervalMs(500);
-    struct timespec ts;
-
-    // To support interrupting ticket acquisition while still benefiting from semaphores, we do a
-    // timed wait on an interval to periodically check for interrupts.
-    // The wait period interval is the smaller of the default interval and the provided
-    // deadline.
-    Date_t deadline = std::min(until, Date_t::now() + intervalMs);
-    tsFromDate(deadline, ts);
-
-    while (0 != sem_timedwait(&_sem, &ts)) {
-        if (errno == ETIMEDOUT) {
-            // If we reached the deadline without being interrupted, we have completely timed out.
-            if (deadline == until)
-                return false;
-
-            deadline = std::min(until, Date_t::now() + intervalMs);
-            tsFromDate(deadline, ts);
-        } else if (errno != EINTR) {
-            failWithErrno(errno);
+    auto& queue = _queues[static_cast<size_t>(priority)];
+    Waiter waiter;
+    Timer timer;
+
+    stdx::unique_lock<Latch> lk(_mutex);
+    auto it = queue.waiters.insert(queue.waiters.end(), &waiter);
+    _numQueued.fetchAndAdd(1);
+    queue.stats->totalQueued.fetchAndAdd(1);
+    queue.stats->queueDepth.increment(queue.waiters.size());
+
+    // A ticket may have been released between our attempt to take one and '_numQueued' being
+    // incremented, in which case the releasing thread did not look at the queues.
+    _admitQueuedWaiters(lk);
+
+    auto isAdmitted = [&waiter] { return waiter.admitted; };
+    bool admitted = false;
+    try {
+        if (opCtx) {
+            admitted = opCtx->waitForConditionOrInterruptUntil(waiter.cv, lk, until, isAdmitted);
+        } else if (until == Date_t::max()) {
+            waiter.cv.wait(lk, isAdmitted);
+            admitted = true;
+        } else {
+            admitted = waiter.cv.wait_until(lk, until.toSystemTimePoint(), isAdmitted);
+        }
+    } catch (const DBException&) {
+        queue.stats->totalCanceled.fetchAndAdd(1);
+        if (waiter.admitted) {
+            // We were handed a ticket just as we got interrupted, so pass it on.
+            lk.unlock();
+            release();
+        } else {
+            _removeWaiter(lk, queue, it);
         }
+        throw;
+    }
 
-        // To correctly handle errors from sem_timedwait, we should check for interrupts last.
-        // It is possible to unset 'errno' after a call to checkForInterrupt().
-        if (opCtx)
-            opCtx->checkForInterrupt();
+    if (!admitted) {
+        queue.stats->totalCanceled.fetchAndAdd(1);
+        _removeWaiter(lk, queue, it);
+        return false;
     }
+
+    const auto timeQueuedMicros = timer.micros();
+    queue.stats->totalAdmitted.fetchAndAdd(1);
+    queue.stats->totalTimeQueuedMicros.fetchAndAdd(timeQueuedMicros);
+    queue.stats->timeQueuedMicros.increment(timeQueuedMicros);
     return true;
 }
 
 void TicketHolder::release() {
-    check(sem_post(&_sem));
+    _totalReleased.fetchAndAdd(1);
+    _available.fetchAndAdd(1);
+
+    // A waiter increments '_numQueued' before it checks for available tickets, so either it sees
+    // the ticket we just released, or we see it and hand the ticket over.
+    if (_numQueued.load() > 0) {
+        stdx::lock_guard<Latch> lk(_mutex);
+        _admitQueuedWaiters(lk);
+    }
 }
 
 Status TicketHolder::resize(int newSize) {
-    stdx::lock_guard<Latch> lk(_resizeMutex);
+    stdx::lock_guard<Latch> lk(_mutex);
 
     if (newSize < 5)
         return Status(ErrorCodes::BadValue,
-                      str::stream() << "Minimum value for semaphore is 5; given " << newSize);
+                      str::stream() << "Minimum value for the number of tickets is 5; given "
+                                    << newSize);
 
-    if (newSize > SEM_VALUE_MAX)
-        return Status(ErrorCodes::BadValue,
-                      str::stream() << "Maximum value for semaphore is " << SEM_VALUE_MAX
-                                    << "; given " << newSize);
-
-    while (_outof.load() < newSize) {
-        release();
-        _outof.fetchAndAdd(1);
-    }
-
-    while (_outof.load() > newSize) {
-        waitForTicket();
-        _outof.subtractAndFetch(1);
-    }
-
-    invariant(_outof.load() == newSize);
+    const int delta = newSize - _outof.load();
+    _outof.store(newSize);
+    _available.fetchAndAdd(delta);
+    _admitQueuedWaiters(lk);
     return Status::OK();
 }
 
 int TicketHolder::available() const {
-    int val = 0;
-    check(sem_getvalue(&_sem, &val));
-    return val;
+    return std::max(_available.load(), 0);
 }
 
 int TicketHolder::used() const {
-    return outof() - available();
+    return outof() - _available.load();
 }
 
 int TicketHolder::outof() const {
     return _outof.load();
 }
 
-#else
-
-TicketHolder::TicketHolder(int num) : _outof(num), _num(num) {}
-
-TicketHolder::~TicketHolder() = default;
-
-bool TicketHolder::tryAcquire() {
-    stdx::lock_guard<Latch> lk(_mutex);
-    return _tryAcquire();
+int TicketHolder::queued() const {
+    return _numQueued.load();
 }
 
-void TicketHolder::waitForTicket(OperationContext* opCtx) {
-    stdx::unique_lock<Latch> lk(_mutex);
-
-    if (opCtx) {
-        opCtx->waitForConditionOrInterrupt(_newTicket, lk, [this] { return _tryAcquire(); });
-    } else {
-        _newTicket.wait(lk, [this] { return _tryAcquire(); });
-    }
+long long TicketHolder::totalReleased() const {
+    return _totalReleased.load();
 }
 
-bool TicketHolder::waitForTicketUntil(OperationContext* opCtx, Date_t until) {
-    stdx::unique_lock<Latch> lk(_mutex);
-
-    if (opCtx) {
-        return opCtx->waitForConditionOrInterruptUntil(
-            _newTicket, lk, until, [this] { return _tryAcquire(); });
-    } else {
-        return _newTicket.wait_until(
-            lk, until.toSystemTimePoint(), [this] { return _tryAcquire(); });
+void TicketHolder::appendStats(BSONObjBuilder& b) const {
+    stdx::lock_guard<Latch> lk(_mutex);
+    for (size_t i = 0; i < kNumAdmissionPriorities; ++i) {
+        const auto& queue = _queues[i];
+        BSONObjBuilder bb(b.subobjStart(toString(static_cast<AdmissionPriority>(i))));
+        bb.append("queued", static_cast<int>(queue.waiters.size()));
+        bb.append("totalQueued", queue.stats->totalQueued.load());
+        bb.append("totalAdmitted", queue.stats->totalAdmitted.load());
+        bb.append("totalCanceled", queue.stats->totalCanceled.load());
+        bb.append("totalTimeQueuedMicros", queue.stats->totalTimeQueuedMicros.load());
+        queue.stats->queueDepth.append(bb, false);
+        queue.stats->timeQueuedMicros.append(bb, true);
+        bb.done();
     }
 }
 
-void TicketHolder::release() {
-    {
-        stdx::lock_guard<Latch> lk(_mutex);
-        _num++;
+bool TicketHolder::_tryTakeAvailableTicket() {
+    int available = _available.load();
+    while (available > 0) {
+        if (_available.compareAndSwap(&available, available - 1)) {
+            return true;
+        }
     }
-    _newTicket.notify_one();
+    return false;
 }
 
-Status TicketHolder::resize(int newSize) {
-    stdx::lock_guard<Latch> lk(_mutex);
-
-    int used = _outof.load() - _num;
-    if (used > newSize) {
-        std::stringstream ss;
-        ss << "can't resize since we're using (" << used << ") "
-           << "more than newSize(" << newSize << ")";
+void TicketHolder::_admitQueuedWaiters(WithLock lk) {
+    while (auto queue = _nextQueueToAdmit(lk)) {
+        if (!_tryTakeAvailableTicket()) {
+            return;
+        }
 
-        std::string errmsg = ss.str();
-        LOGV2(23120, "{errmsg}", "errmsg"_attr = errmsg);
-        return Status(ErrorCodes::BadValue, errmsg);
+        auto waiter = queue->waiters.front();
+        _removeWaiter(lk, *queue, queue->waiters.begin());
+        waiter->admitted = true;
+        waiter->cv.notify_one();
+
+        // Every non-empty queue of lower priority was passed over once more.
+        for (auto& lowerQueue : _queues) {
+            if (&lowerQueue == queue) {
+                break;
+            }
+            if (!lowerQueue.waiters.empty()) {
+                ++lowerQueue.numBypasses;
+            }
+        }
+        queue->numBypasses = 0;
     }
-
-    _outof.store(newSize);
-    _num = _outof.load() - used;
-
-    // Potentially wasteful, but easier to see is correct
-    _newTicket.notify_all();
-    return Status::OK();
-}
-
-int TicketHolder::available() const {
-    return _num;
 }
 
-int TicketHolder::used() const {
-    return outof() - _num;
-}
+TicketHolder::PriorityQueue* TicketHolder::_nextQueueToAdmit(WithLock) {
+    // '_queues' is ordered by increasing priority.
+    PriorityQueue* next = nullptr;
+    for (auto it = _queues.rbegin(); it != _queues.rend(); ++it) {
+        if (!it->waiters.empty()) {
+            next = &*it;
+            break;
+        }
+    }
+    if (!next) {
+        return nullptr;
+    }
 
-int TicketHolder::outof() const {
-    return _outof.load();
+    const int maxBypasses = gTicketHolderMaxPriorityBypasses.load();
+    if (maxBypasses > 0) {
+        for (auto& queue : _queues) {
+            if (&queue == next) {
+                break;
+            }
+            if (!queue.waiters.empty() && queue.numBypasses >= maxBypasses) {
+                return &queue;
+            }
+        }
+    }
+    return next;
 }
 
-bool TicketHolder::_tryAcquire() {
-    if (_num <= 0) {
-        if (_num < 0) {
-            std::cerr << "DISASTER! in TicketHolder" << std::endl;
-        }
-        return false;
+void TicketHolder::_removeWaiter(WithLock,
+                                 PriorityQueue& queue,
+                                 std::list<Waiter*>::iterator it) {
+    queue.waiters.erase(it);
+    _numQueued.subtractAndFetch(1);
+    if (queue.waiters.empty()) {
+        queue.numBypasses = 0;
     }
-    _num--;
-    return true;
 }
-#endif
+
 }  // namespace mongo
@@ -28,19 +28,33 @@
  */
 #pragma once
 
-#if defined(__linux__)
-#include <semaphore.h>
-#endif
+#include <array>
+#include <list>
+#include <memory>
 
+#include "mongo/bson/bsonobjbuilder.h"
 #include "mongo/db/operation_context.h"
+#include "mongo/platform/atomic_word.h"
 #include "mongo/platform/mutex.h"
 #include "mongo/stdx/condition_variable.h"
+#include "mongo/util/concurrency/admission_priority.h"
 #include "mongo/util/concurrency/mutex.h"
+#include "mongo/util/concurrency/with_lock.h"
 #include "mongo/util/hierarchical_acquisition.h"
 #include "mongo/util/time_support.h"
 
 namespace mongo {
 
+/**
+ * Hands out a fixed number of tickets. Operations that find no ticket available queue for one,
+ * with a separate first-in, first-out queue for each AdmissionPriority. A released ticket goes to
+ * the oldest waiter of the highest priority, except that a non-empty queue of lower priority which
+ * has been passed over 'ticketHolderMaxPriorityBypasses' times in a row gets the ticket instead,
+ * so that low priority work still makes progress under sustained load.
+ *
+ * Acquiring and releasing a ticket while nobody is queued only takes atomic operations on the
+ * number of available tickets.
+ */
 class TicketHolder {
     TicketHolder(const TicketHolder&) = delete;
     TicketHolder& operator=(const TicketHolder&) = delete;
@@ -49,6 +63,9 @@ public:
     explicit TicketHolder(int num);
     ~TicketHolder();
 
+    /**
+     * Acquires a ticket without waiting, if one is available and nobody is queued for one.
+     */
     bool tryAcquire();
 
     /**
@@ -56,7 +73,8 @@ public:
      * 'opCtx' is killed, throwing an AssertionException.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
      */
-    void waitForTicket(OperationContext* opCtx);
+    void waitForTicket(OperationContext* opCtx,
+                       AdmissionPriority priority = AdmissionPriority::kNormal);
     void waitForTicket() {
         waitForTicket(nullptr);
     }
@@ -68,12 +86,18 @@ public:
      * proceed.
      * If 'opCtx' is not provided or equal to nullptr, the wait is not interruptible.
      */
-    bool waitForTicketUntil(OperationContext* opCtx, Date_t until);
+    bool waitForTicketUntil(OperationContext* opCtx,
+                            Date_t until,
+                            AdmissionPriority priority = AdmissionPriority::kNormal);
     bool waitForTicketUntil(Date_t until) {
         return waitForTicketUntil(nullptr, until);
     }
     void release();
 
+    /**
+     * Changes the total number of tickets. Shrinking the pool does not wait for the tickets in use
+     * to be released; instead, no tickets are handed out until enough of them have been.
+     */
     Status resize(int newSize);
 
     int available() const;
@@ -82,22 +106,70 @@ public:
 
     int outof() const;
 
+    /**
+     * Returns the number of operations currently queued for a ticket.
+     */
+    int queued() const;
+
+    /**
+     * Returns the number of tickets released over the lifetime of this TicketHolder, which tracks
+     * the number of operations that completed while holding a ticket.
+     */
+    long long totalReleased() const;
+
+    /**
+     * Appends queueing statistics for each AdmissionPriority, which only account for the
+     * operations that had to queue for their ticket.
+     */
+    void appendStats(BSONObjBuilder& b) const;
+
 private:
-#if defined(__linux__)
-    mutable sem_t _sem;
+    struct Waiter {
+        stdx::condition_variable cv;
+        bool admitted = false;
+    };
 
-    // You can read _outof without a lock, but have to hold _resizeMutex to change.
-    AtomicWord<int> _outof;
-    Mutex _resizeMutex =
-        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_resizeMutex");
-#else
-    bool _tryAcquire();
+    struct AdmissionStats;
+
+    struct PriorityQueue {
+        std::list<Waiter*> waiters;
+        // The number of tickets handed to queues of higher priority since a waiter of this queue
+        // was last admitted.
+        int numBypasses = 0;
+        std::unique_ptr<AdmissionStats> stats;
+    };
+
+    /**
+     * Takes one of the available tickets, if there is any.
+     */
+    bool _tryTakeAvailableTicket();
 
+    /**
+     * Hands available tickets to queued waiters until either runs out.
+     */
+    void _admitQueuedWaiters(WithLock);
+
+    /**
+     * Returns the queue whose oldest waiter should get the next ticket, or nullptr if nobody is
+     * queued.
+     */
+    PriorityQueue* _nextQueueToAdmit(WithLock);
+
+    void _removeWaiter(WithLock, PriorityQueue& queue, std::list<Waiter*>::iterator it);
+
+    // The number of tickets which can be handed out right away. This is negative after the pool
+    // has been shrunk by more than the number of tickets that were available at that time.
+    AtomicWord<int> _available;
     AtomicWord<int> _outof;
-    int _num;
-    Mutex _mutex = MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_mutex");
-    stdx::condition_variable _newTicket;
-#endif
+    AtomicWord<long long> _totalReleased{0};
+
+    // The number of waiters in '_queues'. Only modified while holding '_mutex', but read without
+    // it in order to skip the queues when nobody is waiting.
+    AtomicWord<int> _numQueued{0};
+
+    mutable Mutex _mutex =
+        MONGO_MAKE_LATCH(HierarchicalAcquisitionLevel(0), "TicketHolder::_mutex");
+    std::array<PriorityQueue, kNumAdmissionPriorities> _queues;
 };
 
 class ScopedTicket {
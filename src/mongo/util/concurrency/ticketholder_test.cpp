@@ -32,8 +32,14 @@
 
 #include "mongo/platform/basic.h"
 
+#include <vector>
+
+#include "mongo/idl/server_parameter_test_util.h"
+#include "mongo/platform/mutex.h"
+#include "mongo/stdx/thread.h"
 #include "mongo/unittest/unittest.h"
 #include "mongo/util/concurrency/ticketholder.h"
+#include "mongo/util/time_support.h"
 
 namespace {
 using namespace mongo;
@@ -72,4 +78,151 @@ TEST(TicketholderTest, BasicTimeout) {
     holder.release();
     ASSERT_EQ(holder.used(), 0);
 }
+
+/**
+ * Queues waiters for a ticket one at a time, in the order given, and records the order in which
+ * they are admitted. Each waiter releases its ticket as soon as it has recorded its admission.
+ */
+class AdmissionOrderRecorder {
+public:
+    explicit AdmissionOrderRecorder(TicketHolder* holder) : _holder(holder) {}
+
+    ~AdmissionOrderRecorder() {
+        for (auto& thread : _threads) {
+            thread.join();
+        }
+    }
+
+    void queueWaiter(int id, AdmissionPriority priority) {
+        const int numQueued = _holder->queued();
+        _threads.emplace_back([this, id, priority] {
+            _holder->waitForTicket(nullptr, priority);
+            {
+                stdx::lock_guard<Latch> lk(_mutex);
+                _order.push_back(id);
+            }
+            _holder->release();
+        });
+        while (_holder->queued() <= numQueued) {
+            sleepmillis(1);
+        }
+    }
+
+    std::vector<int> waitForAdmissionOrder() {
+        for (auto& thread : _threads) {
+            thread.join();
+        }
+        _threads.clear();
+        return _order;
+    }
+
+private:
+    TicketHolder* const _holder;
+    std::vector<stdx::thread> _threads;
+    Mutex _mutex = MONGO_MAKE_LATCH("AdmissionOrderRecorder::_mutex");
+    std::vector<int> _order;
+};
+
+TEST(TicketholderTest, AdmitsHigherPriorityFirst) {
+    RAIIServerParameterControllerForTest maxBypasses("ticketHolderMaxPriorityBypasses", 0);
+    TicketHolder holder(1);
+    ASSERT(holder.tryAcquire());
+
+    AdmissionOrderRecorder recorder(&holder);
+    recorder.queueWaiter(0, AdmissionPriority::kLow);
+    recorder.queueWaiter(1, AdmissionPriority::kNormal);
+    recorder.queueWaiter(2, AdmissionPriority::kHigh);
+    ASSERT_EQ(holder.queued(), 3);
+
+    // New arrivals must not jump the queue while there are waiters.
+    ASSERT_FALSE(holder.tryAcquire());
+
+    holder.release();
+    ASSERT_EQ(recorder.waitForAdmissionOrder(), (std::vector<int>{2, 1, 0}));
+    ASSERT_EQ(holder.queued(), 0);
+    ASSERT_EQ(holder.used(), 0);
+}
+
+TEST(TicketholderTest, AdmitsSamePriorityInArrivalOrder) {
+    TicketHolder holder(1);
+    ASSERT(holder.tryAcquire());
+
+    AdmissionOrderRecorder recorder(&holder);
+    for (int i = 0; i < 4; ++i) {
+        recorder.queueWaiter(i, AdmissionPriority::kNormal);
+    }
+
+    holder.release();
+    ASSERT_EQ(recorder.waitForAdmissionOrder(), (std::vector<int>{0, 1, 2, 3}));
+}
+
+TEST(TicketholderTest, LowerPriorityIsNotStarved) {
+    RAIIServerParameterControllerForTest maxBypasses("ticketHolderMaxPriorityBypasses", 1);
+    TicketHolder holder(1);
+    ASSERT(holder.tryAcquire());
+
+    AdmissionOrderRecorder recorder(&holder);
+    recorder.queueWaiter(0, AdmissionPriority::kLow);
+    recorder.queueWaiter(1, AdmissionPriority::kHigh);
+    recorder.queueWaiter(2, AdmissionPriority::kHigh);
+
+    // The low priority waiter is admitted after having been passed over once.
+    holder.release();
+    ASSERT_EQ(recorder.waitForAdmissionOrder(), (std::vector<int>{1, 0, 2}));
+}
+
+TEST(TicketholderTest, ResizeAdmitsWaitersAndDoesNotBlock) {
+    TicketHolder holder(5);
+    for (int i = 0; i < 5; ++i) {
+        ASSERT(holder.tryAcquire());
+    }
+
+    AdmissionOrderRecorder recorder(&holder);
+    recorder.queueWaiter(0, AdmissionPriority::kNormal);
+
+    // Growing hands the new ticket straight to the waiter.
+    ASSERT_OK(holder.resize(6));
+    ASSERT_EQ(recorder.waitForAdmissionOrder(), (std::vector<int>{0}));
+    ASSERT_EQ(holder.used(), 5);
+    ASSERT_EQ(holder.available(), 1);
+
+    // Shrinking below the number of tickets in use returns immediately, and the excess tickets
+    // are retired as they are released.
+    ASSERT(holder.tryAcquire());
+    ASSERT_OK(holder.resize(5));
+    ASSERT_EQ(holder.outof(), 5);
+    ASSERT_EQ(holder.used(), 6);
+    ASSERT_EQ(holder.available(), 0);
+
+    holder.release();
+    ASSERT_FALSE(holder.tryAcquire());
+    holder.release();
+    ASSERT(holder.tryAcquire());
+
+    ASSERT_EQ(holder.resize(4).code(), ErrorCodes::BadValue);
+}
+
+TEST(TicketholderTest, ReportsPerPriorityStats) {
+    TicketHolder holder(1);
+    ASSERT(holder.tryAcquire());
+    ASSERT_FALSE(holder.waitForTicketUntil(
+        nullptr, Date_t::now() + Milliseconds(1), AdmissionPriority::kHigh));
+    holder.release();
+
+    BSONObjBuilder builder;
+    holder.appendStats(builder);
+    auto stats = builder.obj();
+    ASSERT_EQ(stats["high"]["totalQueued"].numberLong(), 1);
+    ASSERT_EQ(stats["high"]["totalCanceled"].numberLong(), 1);
+    ASSERT_EQ(stats["high"]["totalAdmitted"].numberLong(), 0);
+    ASSERT_EQ(stats["low"]["totalQueued"].numberLong(), 0);
+}
+
+TEST(TicketholderTest, ParseAdmissionPriority) {
+    for (auto priority :
+         {AdmissionPriority::kLow, AdmissionPriority::kNormal, AdmissionPriority::kHigh}) {
+        ASSERT(unittest::assertGet(parseAdmissionPriority(toString(priority))) == priority);
+    }
+    ASSERT_EQ(parseAdmissionPriority("urgent").getStatus().code(), ErrorCodes::BadValue);
+}
 }  // namespace
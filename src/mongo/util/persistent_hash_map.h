@@ -0,0 +1,452 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <absl/hash/hash.h>
+#include <bitset>
+#include <boost/container/small_vector.hpp>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace mongo {
+
+/**
+ * An unordered map with value semantics whose copies share structure.
+ *
+ * The map is a hash array mapped trie (HAMT) of immutable nodes. Each level of the trie consumes
+ * five bits of the key's hash and holds up to 32 slots, each of which is either an entry or a
+ * child node; a bitmap records which slots are present so that nodes only store the occupied
+ * ones. Lookups therefore cost one hash computation and one key comparison, with a trie depth that
+ * is logarithmic in base 32. Copying a PersistentHashMap copies a single pointer, and modifying a
+ * copy replaces only the nodes on the path to the modified entry; all other nodes stay shared with
+ * the copies made before the modification.
+ *
+ * Use PersistentMap instead when the entries must be visited in key order.
+ *
+ * Values are immutable once inserted. To change a value, insert a modified copy with
+ * insert_or_assign(). Iteration order is unspecified.
+ *
+ * Like other standard containers, this class is not thread safe. Distinct copies may be read and
+ * modified concurrently from different threads.
+ */
+template <typename Key,
+          typename T,
+          typename Hash = absl::Hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class PersistentHashMap {
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<const Key, T>;
+    using size_type = size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+
+private:
+    static constexpr int kBitsPerLevel = 5;
+    static constexpr uint64_t kLevelMask = (1 << kBitsPerLevel) - 1;
+
+    struct Node;
+    struct Leaf;
+    using NodePtr = std::shared_ptr<const Node>;
+    using LeafPtr = std::shared_ptr<const Leaf>;
+
+    /**
+     * The entries whose keys have the same full hash. Holds more than one entry only on hash
+     * collisions.
+     */
+    struct Leaf {
+        uint64_t hash;
+        std::vector<value_type> entries;
+    };
+
+    /**
+     * Either a leaf or a child node.
+     */
+    struct Slot {
+        LeafPtr leaf;
+        NodePtr child;
+    };
+
+    struct Node {
+        // Bit i is set if the slot for the hash bits i at this level is present. The slots are
+        // stored in the order of their bits.
+        uint32_t bitmap = 0;
+        std::vector<Slot> slots;
+    };
+
+public:
+    /**
+     * Forward iterator visiting every entry once, in unspecified order. Holds the path from the
+     * root to the current entry, so it remains valid as long as the map it was obtained from is
+     * neither modified nor destroyed.
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = PersistentHashMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        const_iterator() = default;
+
+        reference operator*() const {
+            return _leaf->entries[_entry];
+        }
+
+        pointer operator->() const {
+            return &_leaf->entries[_entry];
+        }
+
+        const_iterator& operator++() {
+            if (++_entry < _leaf->entries.size()) {
+                return *this;
+            }
+
+            _leaf = nullptr;
+            _entry = 0;
+            while (!_path.empty()) {
+                auto& [node, slot] = _path.back();
+                if (++slot == node->slots.size()) {
+                    _path.pop_back();
+                    continue;
+                }
+                _descend(&node->slots[slot]);
+                break;
+            }
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            auto old = *this;
+            ++(*this);
+            return old;
+        }
+
+        friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) {
+            return lhs._leaf == rhs._leaf && lhs._entry == rhs._entry;
+        }
+
+        friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs) {
+            return !(lhs == rhs);
+        }
+
+    private:
+        friend class PersistentHashMap;
+
+        /**
+         * Moves to the first entry under 'slot'. Nodes are never empty, so there always is one.
+         */
+        void _descend(const Slot* slot) {
+            while (!slot->leaf) {
+                _path.emplace_back(slot->child.get(), 0);
+                slot = &slot->child->slots.front();
+            }
+            _leaf = slot->leaf.get();
+        }
+
+        // The nodes from the root to the current leaf, each with the index of the slot taken.
+        boost::container::small_vector<std::pair<const Node*, size_t>, 13> _path;
+        const Leaf* _leaf = nullptr;
+        size_t _entry = 0;
+    };
+
+    using iterator = const_iterator;
+
+    PersistentHashMap() = default;
+
+    const_iterator begin() const {
+        const_iterator it;
+        if (_root) {
+            Slot root{nullptr, _root};
+            it._descend(&root);
+        }
+        return it;
+    }
+
+    const_iterator end() const {
+        return const_iterator();
+    }
+
+    size_type size() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    const_iterator find(const Key& key) const {
+        const_iterator it;
+        const uint64_t hash = _hash(key);
+        const Node* node = _root.get();
+        for (int shift = 0; node; shift += kBitsPerLevel) {
+            auto bit = _bit(hash, shift);
+            if (!(node->bitmap & bit)) {
+                break;
+            }
+            auto pos = _position(node->bitmap, bit);
+            it._path.emplace_back(node, pos);
+
+            const Slot& slot = node->slots[pos];
+            if (slot.child) {
+                node = slot.child.get();
+                continue;
+            }
+            if (slot.leaf->hash != hash) {
+                break;
+            }
+            for (size_t i = 0; i < slot.leaf->entries.size(); ++i) {
+                if (_equal(slot.leaf->entries[i].first, key)) {
+                    it._leaf = slot.leaf.get();
+                    it._entry = i;
+                    return it;
+                }
+            }
+            break;
+        }
+        return end();
+    }
+
+    bool contains(const Key& key) const {
+        return find(key) != end();
+    }
+
+    /**
+     * Inserts 'value' for 'key', replacing the value of an existing entry. Returns true if a new
+     * entry was inserted.
+     */
+    bool insert_or_assign(Key key, T value) {
+        bool inserted = false;
+        const uint64_t hash = _hash(key);
+        _root = _insert(_root.get(), 0, hash, std::move(key), std::move(value), &inserted);
+        if (inserted) {
+            ++_size;
+        }
+        return inserted;
+    }
+
+    /**
+     * Removes the entry for 'key', if any. Returns the number of entries removed.
+     */
+    size_type erase(const Key& key) {
+        if (!_root) {
+            return 0;
+        }
+        bool erased = false;
+        _root = _erase(_root, 0, _hash(key), key, &erased);
+        if (!erased) {
+            return 0;
+        }
+        --_size;
+        return 1;
+    }
+
+    void clear() {
+        _root.reset();
+        _size = 0;
+    }
+
+private:
+    /**
+     * Returns the bit of a node's bitmap for the hash bits of 'hash' at level 'shift'.
+     */
+    static uint32_t _bit(uint64_t hash, int shift) {
+        return uint32_t{1} << ((hash >> shift) & kLevelMask);
+    }
+
+    /**
+     * Returns the index in the slots of a node with 'bitmap' of the slot for 'bit'.
+     */
+    static size_t _position(uint32_t bitmap, uint32_t bit) {
+        return std::bitset<32>(bitmap & (bit - 1)).count();
+    }
+
+    uint64_t _hash(const Key& key) const {
+        // Finalize the hash as MurmurHash3 does, so that every level of the trie sees well-mixed
+        // bits even if 'Hash' only produces a narrow or poorly distributed value.
+        uint64_t hash = static_cast<uint64_t>(_hasher(key));
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+        hash *= 0xc4ceb9fe1a85ec53ULL;
+        hash ^= hash >> 33;
+        return hash;
+    }
+
+    static NodePtr _makeNode(uint32_t bitmap, std::vector<Slot> slots) {
+        return std::make_shared<const Node>(Node{bitmap, std::move(slots)});
+    }
+
+    /**
+     * Returns a node at level 'shift' holding the two leaves, which have different hashes.
+     */
+    static NodePtr _makeNodeForLeaves(int shift, LeafPtr first, LeafPtr second) {
+        auto firstBit = _bit(first->hash, shift);
+        auto secondBit = _bit(second->hash, shift);
+        if (firstBit == secondBit) {
+            return _makeNode(
+                firstBit,
+                {Slot{nullptr,
+                      _makeNodeForLeaves(
+                          shift + kBitsPerLevel, std::move(first), std::move(second))}});
+        }
+        if (secondBit < firstBit) {
+            std::swap(first, second);
+        }
+        return _makeNode(firstBit | secondBit,
+                         {Slot{std::move(first), nullptr}, Slot{std::move(second), nullptr}});
+    }
+
+    NodePtr _insert(
+        const Node* node, int shift, uint64_t hash, Key key, T value, bool* inserted) const {
+        if (!node) {
+            *inserted = true;
+            auto leaf = std::make_shared<const Leaf>(
+                Leaf{hash, {value_type(std::move(key), std::move(value))}});
+            return _makeNode(_bit(hash, shift), {Slot{std::move(leaf), nullptr}});
+        }
+
+        auto bit = _bit(hash, shift);
+        auto pos = _position(node->bitmap, bit);
+        std::vector<Slot> slots = node->slots;
+
+        if (!(node->bitmap & bit)) {
+            *inserted = true;
+            auto leaf = std::make_shared<const Leaf>(
+                Leaf{hash, {value_type(std::move(key), std::move(value))}});
+            slots.insert(slots.begin() + pos, Slot{std::move(leaf), nullptr});
+            return _makeNode(node->bitmap | bit, std::move(slots));
+        }
+
+        Slot& slot = slots[pos];
+        if (slot.child) {
+            slot.child = _insert(slot.child.get(),
+                                 shift + kBitsPerLevel,
+                                 hash,
+                                 std::move(key),
+                                 std::move(value),
+                                 inserted);
+        } else if (slot.leaf->hash == hash) {
+            std::vector<value_type> entries;
+            entries.reserve(slot.leaf->entries.size() + 1);
+            *inserted = true;
+            for (const auto& entry : slot.leaf->entries) {
+                if (*inserted && _equal(entry.first, key)) {
+                    *inserted = false;
+                    entries.emplace_back(entry.first, std::move(value));
+                } else {
+                    entries.push_back(entry);
+                }
+            }
+            if (*inserted) {
+                entries.emplace_back(std::move(key), std::move(value));
+            }
+            slot.leaf = std::make_shared<const Leaf>(Leaf{hash, std::move(entries)});
+        } else {
+            *inserted = true;
+            auto leaf = std::make_shared<const Leaf>(
+                Leaf{hash, {value_type(std::move(key), std::move(value))}});
+            slot.child =
+                _makeNodeForLeaves(shift + kBitsPerLevel, std::move(slot.leaf), std::move(leaf));
+            slot.leaf = nullptr;
+        }
+        return _makeNode(node->bitmap, std::move(slots));
+    }
+
+    /**
+     * Returns 'node' without the entry for 'key', or nullptr if that leaves 'node' empty. A child
+     * node left with a single leaf is replaced by that leaf, so that the trie stays as shallow as
+     * if the erased entry had never been inserted.
+     */
+    NodePtr _erase(
+        const NodePtr& node, int shift, uint64_t hash, const Key& key, bool* erased) const {
+        auto bit = _bit(hash, shift);
+        if (!(node->bitmap & bit)) {
+            return node;
+        }
+        auto pos = _position(node->bitmap, bit);
+        const Slot& slot = node->slots[pos];
+
+        Slot replacement;
+        if (slot.child) {
+            auto child = _erase(slot.child, shift + kBitsPerLevel, hash, key, erased);
+            if (!*erased) {
+                return node;
+            }
+            if (child && child->slots.size() == 1 && child->slots.front().leaf) {
+                replacement.leaf = child->slots.front().leaf;
+            } else {
+                replacement.child = std::move(child);
+            }
+        } else {
+            if (slot.leaf->hash != hash) {
+                return node;
+            }
+            std::vector<value_type> entries;
+            for (const auto& entry : slot.leaf->entries) {
+                if (!*erased && _equal(entry.first, key)) {
+                    *erased = true;
+                } else {
+                    entries.push_back(entry);
+                }
+            }
+            if (!*erased) {
+                return node;
+            }
+            if (!entries.empty()) {
+                replacement.leaf = std::make_shared<const Leaf>(Leaf{hash, std::move(entries)});
+            }
+        }
+
+        std::vector<Slot> slots = node->slots;
+        if (replacement.leaf || replacement.child) {
+            slots[pos] = std::move(replacement);
+            return _makeNode(node->bitmap, std::move(slots));
+        }
+        if (slots.size() == 1) {
+            return nullptr;
+        }
+        slots.erase(slots.begin() + pos);
+        return _makeNode(node->bitmap & ~bit, std::move(slots));
+    }
+
+    NodePtr _root;
+    size_type _size = 0;
+    Hash _hasher;
+    KeyEqual _equal;
+};
+
+}  // namespace mongo
@@ -0,0 +1,168 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "mongo/platform/random.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/persistent_hash_map.h"
+
+namespace mongo {
+namespace {
+
+using IntMap = PersistentHashMap<int, std::string>;
+
+/**
+ * Maps every key to one of a few hashes, so that most entries collide.
+ */
+struct CollidingHash {
+    size_t operator()(int key) const {
+        return key % 7;
+    }
+};
+
+template <typename Map>
+void assertMatches(const std::map<int, std::string>& expected, const Map& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+
+    // Iteration visits every entry exactly once, in unspecified order.
+    std::map<int, std::string> visited;
+    for (auto it = actual.begin(); it != actual.end(); ++it) {
+        ASSERT(visited.emplace(it->first, it->second).second);
+    }
+    ASSERT(expected == visited);
+
+    for (const auto& [key, value] : expected) {
+        auto it = actual.find(key);
+        ASSERT(it != actual.end());
+        ASSERT_EQ(value, it->second);
+    }
+}
+
+template <typename Map>
+void testAgainstStdMap(int numKeys) {
+    PseudoRandom random(1);
+    std::map<int, std::string> expected;
+    Map map;
+    std::vector<std::pair<std::map<int, std::string>, Map>> snapshots;
+
+    for (int i = 0; i < 20000; i++) {
+        int key = random.nextInt32(numKeys);
+        if (random.nextInt32(3) == 0) {
+            ASSERT_EQ(expected.erase(key), map.erase(key));
+            ASSERT_FALSE(map.contains(key));
+        } else {
+            auto value = std::to_string(i);
+            ASSERT_EQ(expected.insert_or_assign(key, value).second,
+                      map.insert_or_assign(key, value));
+        }
+
+        if (i % 2000 == 0) {
+            snapshots.emplace_back(expected, map);
+        }
+    }
+
+    assertMatches(expected, map);
+
+    // Earlier copies are not affected by later modifications.
+    for (const auto& [expectedSnapshot, snapshot] : snapshots) {
+        assertMatches(expectedSnapshot, snapshot);
+    }
+
+    // Erasing every entry leaves an empty map.
+    for (int key = 0; key < numKeys; key++) {
+        map.erase(key);
+    }
+    ASSERT(map.empty());
+    ASSERT(map.begin() == map.end());
+}
+
+TEST(PersistentHashMapTest, Empty) {
+    IntMap map;
+    ASSERT(map.empty());
+    ASSERT_EQ(0U, map.size());
+    ASSERT(map.begin() == map.end());
+    ASSERT(map.find(1) == map.end());
+    ASSERT_EQ(0U, map.erase(1));
+}
+
+TEST(PersistentHashMapTest, InsertFindErase) {
+    IntMap map;
+    ASSERT(map.insert_or_assign(1, "a"));
+    ASSERT(map.insert_or_assign(2, "b"));
+    ASSERT_FALSE(map.insert_or_assign(1, "c"));
+    ASSERT_EQ(2U, map.size());
+    ASSERT_EQ("c", map.find(1)->second);
+    ASSERT_EQ("b", map.find(2)->second);
+    ASSERT(map.find(3) == map.end());
+
+    ASSERT_EQ(1U, map.erase(1));
+    ASSERT_EQ(0U, map.erase(1));
+    ASSERT_FALSE(map.contains(1));
+    ASSERT(map.contains(2));
+    ASSERT_EQ(1U, map.size());
+}
+
+TEST(PersistentHashMapTest, CopiesAreIndependent) {
+    IntMap original;
+    for (int i = 0; i < 100; i++) {
+        original.insert_or_assign(i, std::to_string(i));
+    }
+
+    IntMap copy = original;
+    copy.erase(50);
+    copy.insert_or_assign(100, "100");
+    copy.insert_or_assign(0, "zero");
+
+    ASSERT_EQ(100U, original.size());
+    ASSERT(original.contains(50));
+    ASSERT_FALSE(original.contains(100));
+    ASSERT_EQ("0", original.find(0)->second);
+
+    ASSERT_EQ(100U, copy.size());
+    ASSERT_FALSE(copy.contains(50));
+    ASSERT_EQ("100", copy.find(100)->second);
+    ASSERT_EQ("zero", copy.find(0)->second);
+}
+
+TEST(PersistentHashMapTest, MatchesStdMapUnderRandomOperations) {
+    testAgainstStdMap<IntMap>(500);
+    testAgainstStdMap<IntMap>(100000);
+}
+
+TEST(PersistentHashMapTest, MatchesStdMapWithHashCollisions) {
+    testAgainstStdMap<PersistentHashMap<int, std::string, CollidingHash>>(300);
+}
+
+}  // namespace
+}  // namespace mongo
@@ -0,0 +1,360 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <boost/container/small_vector.hpp>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace mongo {
+
+/**
+ * An ordered map with value semantics whose copies share structure.
+ *
+ * The map is an AVL tree of immutable nodes. Copying a PersistentMap copies a single pointer, and
+ * modifying a copy replaces only the O(log n) nodes on the path to the modified entry; all other
+ * nodes stay shared with the copies made before the modification. This makes it suitable for
+ * copy-on-write snapshots of large maps, where the whole snapshot is copied for every write.
+ *
+ * Values are immutable once inserted. To change a value, insert a modified copy with
+ * insert_or_assign(). Lookups accept any key type that 'Compare' can compare with 'Key', so
+ * heterogeneous lookups need a transparent comparator.
+ *
+ * Like other standard containers, this class is not thread safe. Distinct copies may be read and
+ * modified concurrently from different threads.
+ */
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class PersistentMap {
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<const Key, T>;
+    using size_type = size_t;
+    using key_compare = Compare;
+
+private:
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+
+    struct Node {
+        Node(value_type v, NodePtr l, NodePtr r)
+            : value(std::move(v)),
+              left(std::move(l)),
+              right(std::move(r)),
+              height(1 + std::max(_height(left), _height(right))) {}
+
+        value_type value;
+        NodePtr left;
+        NodePtr right;
+        int height;
+    };
+
+public:
+    /**
+     * Forward iterator visiting the entries in key order. Holds the path from the root to the
+     * current entry, so it remains valid as long as the map it was obtained from is neither
+     * modified nor destroyed.
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = PersistentMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        const_iterator() = default;
+
+        reference operator*() const {
+            return _path.back()->value;
+        }
+
+        pointer operator->() const {
+            return &_path.back()->value;
+        }
+
+        const_iterator& operator++() {
+            const Node* node = _path.back();
+            _path.pop_back();
+            _pushLeftSpine(node->right.get());
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            auto old = *this;
+            ++(*this);
+            return old;
+        }
+
+        friend bool operator==(const const_iterator& lhs, const const_iterator& rhs) {
+            if (lhs._path.empty() || rhs._path.empty()) {
+                return lhs._path.empty() == rhs._path.empty();
+            }
+            return lhs._path.back() == rhs._path.back();
+        }
+
+        friend bool operator!=(const const_iterator& lhs, const const_iterator& rhs) {
+            return !(lhs == rhs);
+        }
+
+    private:
+        friend class PersistentMap;
+
+        void _pushLeftSpine(const Node* node) {
+            for (; node; node = node->left.get()) {
+                _path.push_back(node);
+            }
+        }
+
+        // Ancestors of the current entry whose left subtree contains it, followed by the current
+        // entry itself. Empty for the end iterator.
+        boost::container::small_vector<const Node*, 32> _path;
+    };
+
+    using iterator = const_iterator;
+
+    PersistentMap() = default;
+
+    const_iterator begin() const {
+        const_iterator it;
+        it._pushLeftSpine(_root.get());
+        return it;
+    }
+
+    const_iterator end() const {
+        return const_iterator();
+    }
+
+    size_type size() const {
+        return _size;
+    }
+
+    bool empty() const {
+        return _size == 0;
+    }
+
+    /**
+     * Returns an iterator to the first entry whose key is not less than 'key'.
+     */
+    template <typename K>
+    const_iterator lower_bound(const K& key) const {
+        const_iterator it;
+        for (const Node* node = _root.get(); node;) {
+            if (_compare(node->value.first, key)) {
+                node = node->right.get();
+            } else {
+                it._path.push_back(node);
+                node = node->left.get();
+            }
+        }
+        return it;
+    }
+
+    /**
+     * Returns an iterator to the first entry whose key is greater than 'key'.
+     */
+    template <typename K>
+    const_iterator upper_bound(const K& key) const {
+        const_iterator it;
+        for (const Node* node = _root.get(); node;) {
+            if (_compare(key, node->value.first)) {
+                it._path.push_back(node);
+                node = node->left.get();
+            } else {
+                node = node->right.get();
+            }
+        }
+        return it;
+    }
+
+    template <typename K>
+    const_iterator find(const K& key) const {
+        auto it = lower_bound(key);
+        if (it != end() && _compare(key, it->first)) {
+            return end();
+        }
+        return it;
+    }
+
+    template <typename K>
+    bool contains(const K& key) const {
+        for (const Node* node = _root.get(); node;) {
+            if (_compare(key, node->value.first)) {
+                node = node->left.get();
+            } else if (_compare(node->value.first, key)) {
+                node = node->right.get();
+            } else {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Inserts 'value' for 'key', replacing the value of an existing entry. Returns true if a new
+     * entry was inserted.
+     */
+    bool insert_or_assign(Key key, T value) {
+        bool inserted = false;
+        _root = _insert(_root, std::move(key), std::move(value), &inserted);
+        if (inserted) {
+            ++_size;
+        }
+        return inserted;
+    }
+
+    /**
+     * Removes the entry for 'key', if any. Returns the number of entries removed.
+     */
+    template <typename K>
+    size_type erase(const K& key) {
+        bool erased = false;
+        _root = _erase(_root, key, &erased);
+        if (!erased) {
+            return 0;
+        }
+        --_size;
+        return 1;
+    }
+
+    void clear() {
+        _root.reset();
+        _size = 0;
+    }
+
+private:
+    static int _height(const NodePtr& node) {
+        return node ? node->height : 0;
+    }
+
+    static NodePtr _makeNode(value_type value, NodePtr left, NodePtr right) {
+        return std::make_shared<const Node>(std::move(value), std::move(left), std::move(right));
+    }
+
+    /**
+     * Returns a new node for 'value' with the given subtrees, rotating to restore the AVL
+     * invariant if their heights differ by two.
+     */
+    static NodePtr _balance(const value_type& value, NodePtr left, NodePtr right) {
+        int leftHeight = _height(left);
+        int rightHeight = _height(right);
+
+        if (leftHeight > rightHeight + 1) {
+            if (_height(left->left) >= _height(left->right)) {
+                return _makeNode(left->value, left->left, _makeNode(value, left->right, right));
+            }
+            const Node* pivot = left->right.get();
+            return _makeNode(pivot->value,
+                             _makeNode(left->value, left->left, pivot->left),
+                             _makeNode(value, pivot->right, right));
+        }
+
+        if (rightHeight > leftHeight + 1) {
+            if (_height(right->right) >= _height(right->left)) {
+                return _makeNode(right->value, _makeNode(value, left, right->left), right->right);
+            }
+            const Node* pivot = right->left.get();
+            return _makeNode(pivot->value,
+                             _makeNode(value, left, pivot->left),
+                             _makeNode(right->value, pivot->right, right->right));
+        }
+
+        return _makeNode(value, std::move(left), std::move(right));
+    }
+
+    NodePtr _insert(const NodePtr& node, Key key, T value, bool* inserted) const {
+        if (!node) {
+            *inserted = true;
+            return _makeNode(value_type(std::move(key), std::move(value)), nullptr, nullptr);
+        }
+
+        if (_compare(key, node->value.first)) {
+            return _balance(node->value,
+                            _insert(node->left, std::move(key), std::move(value), inserted),
+                            node->right);
+        }
+
+        if (_compare(node->value.first, key)) {
+            return _balance(node->value,
+                            node->left,
+                            _insert(node->right, std::move(key), std::move(value), inserted));
+        }
+
+        return _makeNode(value_type(node->value.first, std::move(value)), node->left, node->right);
+    }
+
+    template <typename K>
+    NodePtr _erase(const NodePtr& node, const K& key, bool* erased) const {
+        if (!node) {
+            return node;
+        }
+
+        if (_compare(key, node->value.first)) {
+            auto left = _erase(node->left, key, erased);
+            return *erased ? _balance(node->value, std::move(left), node->right) : node;
+        }
+
+        if (_compare(node->value.first, key)) {
+            auto right = _erase(node->right, key, erased);
+            return *erased ? _balance(node->value, node->left, std::move(right)) : node;
+        }
+
+        *erased = true;
+        if (!node->left) {
+            return node->right;
+        }
+        if (!node->right) {
+            return node->left;
+        }
+
+        // Replace the erased entry by its in-order successor.
+        const Node* successor = node->right.get();
+        while (successor->left) {
+            successor = successor->left.get();
+        }
+        return _balance(successor->value, node->left, _eraseMin(node->right));
+    }
+
+    static NodePtr _eraseMin(const NodePtr& node) {
+        if (!node->left) {
+            return node->right;
+        }
+        return _balance(node->value, _eraseMin(node->left), node->right);
+    }
+
+    NodePtr _root;
+    size_type _size = 0;
+    Compare _compare;
+};
+
+}  // namespace mongo
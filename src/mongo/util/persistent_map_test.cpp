@@ -0,0 +1,167 @@
+/**
+ *    Copyright (C) 2022-present MongoDB, Inc.
+ *
+ *    This program is free software: you can redistribute it and/or modify
+ *    it under the terms of the Server Side Public License, version 1,
+ *    as published by MongoDB, Inc.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    Server Side Public License for more details.
+ *
+ *    You should have received a copy of the Server Side Public License
+ *    along with this program. If not, see
+ *    <http://www.mongodb.com/licensing/server-side-public-license>.
+ *
+ *    As a special exception, the copyright holders give permission to link the
+ *    code of portions of this program with the OpenSSL library under certain
+ *    conditions as described in each individual source file and distribute
+ *    linked combinations including the program with the OpenSSL library. You
+ *    must comply with the Server Side Public License in all respects for
+ *    all of the code used other than as permitted herein. If you modify file(s)
+ *    with this exception, you may extend this exception to your version of the
+ *    file(s), but you are not obligated to do so. If you do not wish to do so,
+ *    delete this exception statement from your version. If you delete this
+ *    exception statement from all source files in the program, then also delete
+ *    it in the license file.
+ */
+
+#include "mongo/platform/basic.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "mongo/base/string_data.h"
+#include "mongo/platform/random.h"
+#include "mongo/unittest/unittest.h"
+#include "mongo/util/persistent_map.h"
+
+namespace mongo {
+namespace {
+
+using IntMap = PersistentMap<int, std::string>;
+
+void assertMatches(const std::map<int, std::string>& expected, const IntMap& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    auto expectedIt = expected.begin();
+    for (auto it = actual.begin(); it != actual.end(); ++it, ++expectedIt) {
+        ASSERT_EQ(expectedIt->first, it->first);
+        ASSERT_EQ(expectedIt->second, it->second);
+    }
+    ASSERT(expectedIt == expected.end());
+}
+
+TEST(PersistentMapTest, Empty) {
+    IntMap map;
+    ASSERT(map.empty());
+    ASSERT_EQ(0U, map.size());
+    ASSERT(map.begin() == map.end());
+    ASSERT(map.find(1) == map.end());
+    ASSERT_FALSE(map.contains(1));
+    ASSERT_EQ(0U, map.erase(1));
+}
+
+TEST(PersistentMapTest, InsertFindErase) {
+    IntMap map;
+    ASSERT(map.insert_or_assign(2, "two"));
+    ASSERT(map.insert_or_assign(1, "one"));
+    ASSERT(map.insert_or_assign(3, "three"));
+    ASSERT_FALSE(map.insert_or_assign(2, "deux"));
+
+    ASSERT_EQ(3U, map.size());
+    ASSERT_EQ("deux", map.find(2)->second);
+    ASSERT(map.contains(3));
+    ASSERT(map.find(4) == map.end());
+
+    ASSERT_EQ(1U, map.erase(2));
+    ASSERT_EQ(0U, map.erase(2));
+    assertMatches({{1, "one"}, {3, "three"}}, map);
+}
+
+TEST(PersistentMapTest, Bounds) {
+    IntMap map;
+    for (int i = 0; i < 10; i++) {
+        map.insert_or_assign(i * 2, std::to_string(i * 2));
+    }
+
+    ASSERT_EQ(4, map.lower_bound(3)->first);
+    ASSERT_EQ(4, map.lower_bound(4)->first);
+    ASSERT_EQ(6, map.upper_bound(4)->first);
+    ASSERT_EQ(0, map.lower_bound(-1)->first);
+    ASSERT(map.lower_bound(19) == map.end());
+    ASSERT(map.upper_bound(18) == map.end());
+
+    // Iteration continues in order from a bound.
+    auto it = map.lower_bound(13);
+    ASSERT_EQ(14, (it++)->first);
+    ASSERT_EQ(16, it->first);
+    ASSERT_EQ(18, (++it)->first);
+    ASSERT(++it == map.end());
+}
+
+TEST(PersistentMapTest, CopiesAreIndependent) {
+    IntMap original;
+    for (int i = 0; i < 100; i++) {
+        original.insert_or_assign(i, std::to_string(i));
+    }
+
+    IntMap copy = original;
+    copy.erase(50);
+    copy.insert_or_assign(100, "100");
+    copy.insert_or_assign(0, "zero");
+
+    ASSERT_EQ(100U, original.size());
+    ASSERT(original.contains(50));
+    ASSERT_FALSE(original.contains(100));
+    ASSERT_EQ("0", original.find(0)->second);
+
+    ASSERT_EQ(100U, copy.size());
+    ASSERT_FALSE(copy.contains(50));
+    ASSERT_EQ("100", copy.find(100)->second);
+    ASSERT_EQ("zero", copy.find(0)->second);
+}
+
+TEST(PersistentMapTest, HeterogeneousLookup) {
+    PersistentMap<std::string, int, std::less<>> map;
+    map.insert_or_assign("a", 1);
+    map.insert_or_assign("b", 2);
+
+    ASSERT_EQ(2, map.find(StringData("b"))->second);
+    ASSERT(map.contains(StringData("a")));
+    ASSERT_EQ(1U, map.erase(StringData("a")));
+    ASSERT_FALSE(map.contains("a"));
+}
+
+TEST(PersistentMapTest, MatchesStdMapUnderRandomOperations) {
+    PseudoRandom random(1);
+    std::map<int, std::string> expected;
+    IntMap map;
+    std::vector<std::pair<std::map<int, std::string>, IntMap>> snapshots;
+
+    for (int i = 0; i < 5000; i++) {
+        int key = random.nextInt32(500);
+        if (random.nextInt32(3) == 0) {
+            ASSERT_EQ(expected.erase(key), map.erase(key));
+        } else {
+            auto value = std::to_string(i);
+            ASSERT_EQ(expected.insert_or_assign(key, value).second,
+                      map.insert_or_assign(key, value));
+        }
+
+        if (i % 500 == 0) {
+            snapshots.emplace_back(expected, map);
+        }
+    }
+
+    assertMatches(expected, map);
+
+    // Earlier copies are not affected by later modifications.
+    for (const auto& [expectedSnapshot, snapshot] : snapshots) {
+        assertMatches(expectedSnapshot, snapshot);
+    }
+}
+
+}  // namespace
+}  // namespace mongo